@@ -3,18 +3,22 @@
 #include <commctrl.h>
 #include <wchar.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "cpu/cpu_basic.h"
 #include "cpu/cpu_cores.h"
 #include "cpu/cpu_cache.h"
 #include "cpu/cpu_clock.h"
+#include "cpu/cpu_counters.h"
 #include "mainboard/mainboard_basic.h"
 #include "mainboard/mainboard_chipset.h"
 #include "mainboard/mainboard_bios.h"
 #include "memory/memory_general.h"
 #include "memory/memory_timings.h"
 #include "graphics/graphics.h"
+#include "bench/bench_cpu.h"
+#include "bench/bench_memory.h"
 
 #pragma comment(lib, "comctl32.lib")
 
@@ -38,6 +42,8 @@ enum {
     DC_LBL_C1,       IDC_BOX_C1_SIZE, IDC_BOX_C1_ASSOC,
     DC_LBL_C2,       IDC_BOX_C2_SIZE, IDC_BOX_C2_ASSOC,
     DC_LBL_C3,       IDC_BOX_C3_SIZE, IDC_BOX_C3_ASSOC,
+    IDC_LBL_CACHE_LOAD = 420, IDC_BOX_CACHE_LOAD,   // amostra dos contadores (PMU), a pedido
+    IDC_BTN_CACHE_LOAD,
 
     // Mainboard tab groups
     IDC_GRP_MOBO = 500, IDC_GRP_BIOS = 501,
@@ -83,8 +89,26 @@ enum {
     IDC_LBL_VRAM_VENDOR,    IDC_BOX_VRAM_VENDOR,
     IDC_LBL_VRAM_BUS_WIDTH, IDC_BOX_VRAM_BUS_WIDTH,
 
+    // Bench tab
+    IDC_GRP_BENCH = 900, IDC_BTN_BENCH_RUN, IDC_BTN_BENCH_MEM,
+    IDC_LBL_BENCH_ST = 920, IDC_BOX_BENCH_ST,
+    IDC_LBL_BENCH_MT,       IDC_BOX_BENCH_MT,
+    IDC_LBL_BENCH_RATIO,    IDC_BOX_BENCH_RATIO,
+    IDC_LBL_BENCH_THREADS,  IDC_BOX_BENCH_THREADS,
+    IDC_LBL_BENCH_MEM_READ, IDC_BOX_BENCH_MEM_READ,
+    IDC_LBL_BENCH_MEM_TRIAD, IDC_BOX_BENCH_MEM_TRIAD,
+    IDC_LBL_BENCH_STATUS,   IDC_BOX_BENCH_STATUS,
+
 };
 
+// Mensagens da thread do benchmark para a janela
+#define WM_APP_BENCH_PROGRESS (WM_APP + 1)   // wParam = %, lParam = fase (char*, liberar com free)
+#define WM_APP_BENCH_DONE     (WM_APP + 2)   // wParam = sucesso, lParam = BenchCpuResult*
+#define WM_APP_BENCH_MEM_DONE (WM_APP + 3)   // wParam = sucesso, lParam = BenchMemResult*
+#define WM_APP_PMU_DONE       (WM_APP + 4)   // wParam = sucesso, lParam = texto (wchar_t*, liberar com free)
+
+#define PMU_SAMPLE_MS 1000                  // janela da amostra dos contadores
+
 static const wchar_t* APP_TITLE = L"Ultra Mega Blaster Alpha Hardware Info: Ultimate 2025 Edition XYZ";
 static const wchar_t* WC_MAIN   = L"CPUZ_DEMO_CLASS";
 
@@ -95,6 +119,9 @@ static HWND hGroupProc, hGroupClock, hGroupCache;
 static HWND hLblVendor, hBoxVendor, hLblName, hBoxName, hLblPhys, hBoxPhys, hLblLogi, hBoxLogi;
 static HWND hLblClkCur, hBoxClkCur, hLblClkMax, hBoxClkMax, hLblClkLim, hBoxClkLim;
 static HWND hLblCache[4], hBoxCacheSize[4], hBoxCacheAssoc[4];
+static HWND hLblCacheLoad, hBoxCacheLoad, hBtnCacheLoad;
+static wchar_t        g_pmuText[128];       // última amostra, mantida entre trocas de aba
+static volatile LONG  g_pmuRunning;
 // Mainboard tab
 static HWND hGroupMobo, hGroupBios;
 static HWND hLblManu, hBoxManu, hLblModel, hBoxModel, hLblBus, hBoxBus;
@@ -122,6 +149,17 @@ static HWND hLblVramType,    hBoxVramType;
 static HWND hLblVramVendor,  hBoxVramVendor;
 static HWND hLblVramBusWidth, hBoxVramBusWidth;
 
+// Bench tab
+static HWND hGroupBench, hBtnBenchRun, hBtnBenchMem;
+static HWND hLblBenchSt, hBoxBenchSt, hLblBenchMt, hBoxBenchMt, hLblBenchRatio, hBoxBenchRatio;
+static HWND hLblBenchThreads, hBoxBenchThreads, hLblBenchStatus, hBoxBenchStatus;
+static HWND hLblBenchMemRead, hBoxBenchMemRead, hLblBenchMemTriad, hBoxBenchMemTriad;
+static BenchCpuResult g_benchResult;
+static BenchMemResult g_benchMemResult;
+static bool           g_benchMemHasResult;
+static volatile LONG  g_benchRunning;
+static bool           g_benchHasResult;
+
 static void CreateTabs(HWND hwnd) {
     hTab = CreateWindowExW(0, WC_TABCONTROLW, L"", WS_CHILD|WS_CLIPSIBLINGS|WS_VISIBLE,
                            0,0,0,0, hwnd, (HMENU)IDC_TAB, GetModuleHandle(NULL), NULL);
@@ -130,6 +168,7 @@ static void CreateTabs(HWND hwnd) {
     tie.pszText = L"Mainboard"; TabCtrl_InsertItem(hTab, 1, &tie);
     tie.pszText = L"Memory";    TabCtrl_InsertItem(hTab, 2, &tie);
     tie.pszText = L"Graphics";  TabCtrl_InsertItem(hTab, 3, &tie);
+    tie.pszText = L"Bench";     TabCtrl_InsertItem(hTab, 4, &tie);
     TabCtrl_SetCurSel(hTab, 0);
 }
 
@@ -141,6 +180,7 @@ static void DestroyCpuControls(void) {
         hLblCache[1], hBoxCacheSize[1], hBoxCacheAssoc[1],
         hLblCache[2], hBoxCacheSize[2], hBoxCacheAssoc[2],
         hLblCache[3], hBoxCacheSize[3], hBoxCacheAssoc[3],
+        hLblCacheLoad, hBoxCacheLoad, hBtnCacheLoad,
         hGroupProc, hGroupClock, hGroupCache
     };
     for (int i=0;i<(int)(sizeof(arr)/sizeof(arr[0]));++i) if (arr[i]) DestroyWindow(arr[i]);
@@ -150,6 +190,7 @@ static void DestroyCpuControls(void) {
     hGroupProc=hGroupClock=hGroupCache=NULL;
     hLblVendor=hBoxVendor=hLblName=hBoxName=hLblPhys=hBoxPhys=hLblLogi=hBoxLogi=NULL;
     hLblClkCur=hBoxClkCur=hLblClkMax=hBoxClkMax=hLblClkLim=hBoxClkLim=NULL;
+    hLblCacheLoad=hBoxCacheLoad=hBtnCacheLoad=NULL;
 }
 
 static void DestroyMainboardControls(void) {
@@ -224,6 +265,9 @@ static void Layout(HWND hwnd) {
         if (hBoxCacheAssoc[i])
             MoveWindow(hBoxCacheAssoc[i], leftX + lblW + 6 + sizeBoxW + 10, cacheBaseY + i*rowH, assocBoxW, boxH, TRUE);
     }
+    if (hLblCacheLoad) MoveWindow(hLblCacheLoad, leftX, cacheBaseY + 4*rowH, lblW, boxH, TRUE);
+    if (hBoxCacheLoad) MoveWindow(hBoxCacheLoad, leftX + lblW + 6, cacheBaseY + 4*rowH, sizeBoxW + 10 + assocBoxW, boxH, TRUE);
+    if (hBtnCacheLoad) MoveWindow(hBtnCacheLoad, leftX + lblW + 6 + sizeBoxW + 10 + assocBoxW + 10, cacheBaseY + 4*rowH, 80, boxH, TRUE);
 
     // Se a aba de memória estiver ativa (grupo de memória criado), posiciona controles
     if (hGroupMemGeneral) {
@@ -317,6 +361,22 @@ static void Layout(HWND hwnd) {
         if (hBoxVramBusWidth)
             MoveWindow(hBoxVramBusWidth, leftX + lblW + 6, vramBaseY + 3*rowH, boxW, boxH, TRUE);
     }
+
+    // Aba de benchmark: um grupo com as notas e o botão de execução
+    if (hGroupBench) {
+        int padX = 12, padY = 22, rowH = 24;
+        int lblW = 130, boxW = 320, boxH = 20;
+        int leftX = areaX + padX, baseY = areaY + padY;
+        HWND lbl[] = { hLblBenchSt, hLblBenchMt, hLblBenchRatio, hLblBenchThreads, hLblBenchMemRead, hLblBenchMemTriad, hLblBenchStatus };
+        HWND box[] = { hBoxBenchSt, hBoxBenchMt, hBoxBenchRatio, hBoxBenchThreads, hBoxBenchMemRead, hBoxBenchMemTriad, hBoxBenchStatus };
+        MoveWindow(hGroupBench, areaX, areaY, areaW, areaH, TRUE);
+        for (int i=0; i<7; ++i) {
+            MoveWindow(lbl[i], leftX, baseY + i*rowH, lblW, boxH, TRUE);
+            MoveWindow(box[i], leftX + lblW + 6, baseY + i*rowH, boxW, boxH, TRUE);
+        }
+        MoveWindow(hBtnBenchRun, leftX + lblW + 6, baseY + 7*rowH + 8, 120, 26, TRUE);
+        MoveWindow(hBtnBenchMem, leftX + lblW + 6 + 128, baseY + 7*rowH + 8, 120, 26, TRUE);
+    }
 }
 
 // Libera e remove todos os controles da aba de memória.
@@ -542,6 +602,185 @@ static void ShowBlankTab(HWND hwnd) {
     DestroyGraphicsControls();
 }
 
+static void DestroyBenchControls(void) {
+    HWND arr[] = {
+        hLblBenchSt, hBoxBenchSt, hLblBenchMt, hBoxBenchMt, hLblBenchRatio, hBoxBenchRatio,
+        hLblBenchThreads, hBoxBenchThreads, hLblBenchStatus, hBoxBenchStatus,
+        hLblBenchMemRead, hBoxBenchMemRead, hLblBenchMemTriad, hBoxBenchMemTriad,
+        hBtnBenchRun, hBtnBenchMem, hGroupBench
+    };
+    for (int i=0; i<(int)(sizeof(arr)/sizeof(arr[0])); ++i) {
+        if (arr[i]) DestroyWindow(arr[i]);
+    }
+    hGroupBench = hBtnBenchRun = hBtnBenchMem = NULL;
+    hLblBenchSt = hBoxBenchSt = hLblBenchMt = hBoxBenchMt = hLblBenchRatio = hBoxBenchRatio = NULL;
+    hLblBenchThreads = hBoxBenchThreads = hLblBenchStatus = hBoxBenchStatus = NULL;
+    hLblBenchMemRead = hBoxBenchMemRead = hLblBenchMemTriad = hBoxBenchMemTriad = NULL;
+}
+
+// Mostra as notas do último resultado (ou "-" antes da primeira execução)
+static void FillBenchResults(void) {
+    wchar_t tmp[96];
+    if (!hGroupBench) return;
+    if (g_benchMemHasResult) {
+        const BenchMemResult *m = &g_benchMemResult;
+        int k[2] = { BENCH_MEM_READ, BENCH_MEM_TRIAD };
+        HWND box[2] = { hBoxBenchMemRead, hBoxBenchMemTriad };
+        for (int i=0; i<2; ++i) {
+            if (m->peak_gbs > 0)
+                _snwprintf(tmp, 96, L"%.1f GB/s (%.0f%% of %.1f GB/s peak, %hs)", m->gbs[k[i]], m->pct_peak[k[i]], m->peak_gbs, bench_isa_name(m->isa));
+            else
+                _snwprintf(tmp, 96, L"%.1f GB/s (%hs)", m->gbs[k[i]], bench_isa_name(m->isa));
+            tmp[95]=L'\0';
+            SetWindowTextW(box[i], tmp);
+        }
+    } else {
+        SetWindowTextW(hBoxBenchMemRead, L"-");
+        SetWindowTextW(hBoxBenchMemTriad, L"-");
+    }
+    if (!g_benchHasResult) {
+        SetWindowTextW(hBoxBenchSt, L"-");
+        SetWindowTextW(hBoxBenchMt, L"-");
+        SetWindowTextW(hBoxBenchRatio, L"-");
+        SetWindowTextW(hBoxBenchThreads, L"-");
+        return;
+    }
+    const BenchCpuResult *r = &g_benchResult;
+    _snwprintf(tmp, 96, L"%.0f", r->st_total);          SetWindowTextW(hBoxBenchSt, tmp);
+    _snwprintf(tmp, 96, L"%.0f", r->mt_total);          SetWindowTextW(hBoxBenchMt, tmp);
+    _snwprintf(tmp, 96, L"%.2fx", r->mt_ratio);         SetWindowTextW(hBoxBenchRatio, tmp);
+    _snwprintf(tmp, 96, L"%lu", (unsigned long)r->threads); SetWindowTextW(hBoxBenchThreads, tmp);
+}
+
+static void BenchProgress(void *ctx, const char *stage, int pct) {
+    PostMessageW((HWND)ctx, WM_APP_BENCH_PROGRESS, (WPARAM)pct, (LPARAM)_strdup(stage));
+}
+
+// Roda fora da thread da interface; a janela recebe WM_APP_BENCH_DONE no fim
+static DWORD WINAPI BenchWorker(LPVOID param) {
+    HWND hwnd = (HWND)param;
+    static BenchCpuResult r;
+    bool ok = bench_cpu_run(BENCH_CPU_DEFAULT_SECS, &r, BenchProgress, hwnd);
+    PostMessageW(hwnd, WM_APP_BENCH_DONE, (WPARAM)ok, (LPARAM)&r);
+    return 0;
+}
+
+static DWORD WINAPI BenchMemWorker(LPVOID param) {
+    HWND hwnd = (HWND)param;
+    static BenchMemResult r;
+    bool ok = bench_memory_run(-1, &r, BenchProgress, hwnd);
+    PostMessageW(hwnd, WM_APP_BENCH_MEM_DONE, (WPARAM)ok, (LPARAM)&r);
+    return 0;
+}
+
+// Um benchmark por vez; os dois botões ficam desabilitados até o fim
+static void StartBench(HWND hwnd, LPTHREAD_START_ROUTINE worker) {
+    if (InterlockedCompareExchange(&g_benchRunning, 1, 0) != 0) return;
+    HANDLE th = CreateThread(NULL, 0, worker, hwnd, 0, NULL);
+    if (!th) {
+        InterlockedExchange(&g_benchRunning, 0);
+        if (hBoxBenchStatus) SetWindowTextW(hBoxBenchStatus, L"Failed to start");
+        return;
+    }
+    CloseHandle(th);
+    if (hBtnBenchRun) EnableWindow(hBtnBenchRun, FALSE);
+    if (hBtnBenchMem) EnableWindow(hBtnBenchMem, FALSE);
+    if (hBoxBenchStatus) SetWindowTextW(hBoxBenchStatus, L"Running...");
+}
+
+static void ShowBenchTab(HWND hwnd) {
+    wchar_t title[64];
+    _snwprintf(title, 64, L"CPU Benchmark (v%d)", BENCH_CPU_VERSION);
+    hGroupBench = CreateWindowExW(0, L"BUTTON", title, WS_CHILD|WS_VISIBLE|BS_GROUPBOX,
+                                  0,0,0,0, hwnd, (HMENU)IDC_GRP_BENCH, GetModuleHandle(NULL), NULL);
+
+    hLblBenchSt      = CreateWindowExW(0,L"STATIC",L"Single thread",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_BENCH_ST,GetModuleHandle(NULL),NULL);
+    hBoxBenchSt      = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_BENCH_ST,GetModuleHandle(NULL),NULL);
+    hLblBenchMt      = CreateWindowExW(0,L"STATIC",L"Multi thread",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_BENCH_MT,GetModuleHandle(NULL),NULL);
+    hBoxBenchMt      = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_BENCH_MT,GetModuleHandle(NULL),NULL);
+    hLblBenchRatio   = CreateWindowExW(0,L"STATIC",L"MT ratio",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_BENCH_RATIO,GetModuleHandle(NULL),NULL);
+    hBoxBenchRatio   = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_BENCH_RATIO,GetModuleHandle(NULL),NULL);
+    hLblBenchThreads = CreateWindowExW(0,L"STATIC",L"Threads",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_BENCH_THREADS,GetModuleHandle(NULL),NULL);
+    hBoxBenchThreads = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_BENCH_THREADS,GetModuleHandle(NULL),NULL);
+    hLblBenchMemRead = CreateWindowExW(0,L"STATIC",L"Memory read",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_BENCH_MEM_READ,GetModuleHandle(NULL),NULL);
+    hBoxBenchMemRead = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_BENCH_MEM_READ,GetModuleHandle(NULL),NULL);
+    hLblBenchMemTriad = CreateWindowExW(0,L"STATIC",L"Memory triad",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_BENCH_MEM_TRIAD,GetModuleHandle(NULL),NULL);
+    hBoxBenchMemTriad = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_BENCH_MEM_TRIAD,GetModuleHandle(NULL),NULL);
+    hLblBenchStatus  = CreateWindowExW(0,L"STATIC",L"Status",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_BENCH_STATUS,GetModuleHandle(NULL),NULL);
+    hBoxBenchStatus  = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_BENCH_STATUS,GetModuleHandle(NULL),NULL);
+
+    hBtnBenchRun = CreateWindowExW(0, L"BUTTON", L"Bench CPU", WS_CHILD|WS_VISIBLE|BS_PUSHBUTTON,
+                                   0,0,0,0, hwnd, (HMENU)IDC_BTN_BENCH_RUN, GetModuleHandle(NULL), NULL);
+    hBtnBenchMem = CreateWindowExW(0, L"BUTTON", L"Bench memory", WS_CHILD|WS_VISIBLE|BS_PUSHBUTTON,
+                                   0,0,0,0, hwnd, (HMENU)IDC_BTN_BENCH_MEM, GetModuleHandle(NULL), NULL);
+
+    Layout(hwnd);
+    FillBenchResults();
+    bool running = g_benchRunning != 0;
+    EnableWindow(hBtnBenchRun, !running);
+    EnableWindow(hBtnBenchMem, !running);
+    SetWindowTextW(hBoxBenchStatus, running ? L"Running..." : (g_benchHasResult || g_benchMemHasResult ? L"Done" : L"Idle"));
+}
+
+// IPC e taxas de falha de todos os processadores numa janela de PMU_SAMPLE_MS.
+// Só roda quando o usuário pede (carrega o driver e programa o PMU), fora da
+// thread da interface; a janela recebe WM_APP_PMU_DONE com o texto.
+static DWORD WINAPI PmuWorker(LPVOID param) {
+    HWND hwnd = (HWND)param;
+    static CpuCounters pmu;
+    static CpuCounterRates rates[CPU_COUNTERS_MAX];
+    wchar_t *tmp = (wchar_t*)malloc(128 * sizeof(wchar_t));
+    if (!tmp) { PostMessageW(hwnd, WM_APP_PMU_DONE, 0, 0); return 0; }
+    if (!cpu_counters_open(&pmu)) {
+        char reasonA[96];
+        _snprintf(reasonA, sizeof(reasonA), "N/A (%s)", cpu_counters_reason(&pmu));
+        reasonA[sizeof(reasonA)-1] = '\0';
+        mbstowcs(tmp, reasonA, 127); tmp[127]=L'\0';
+        PostMessageW(hwnd, WM_APP_PMU_DONE, 0, (LPARAM)tmp);
+        return 0;
+    }
+    Sleep(PMU_SAMPLE_MS);
+    DWORD n = cpu_counters_read(&pmu, rates, CPU_COUNTERS_MAX);
+    cpu_counters_close(&pmu);
+
+    // Média ponderada pelos ciclos: núcleos parados não puxam a média
+    double cyc = 0, ipc = 0, miss = 0, br = 0;
+    for (DWORD i = 0; i < n; ++i) {
+        cyc  += rates[i].cycles;
+        ipc  += rates[i].ipc * rates[i].cycles;
+        miss += rates[i].llc_miss_pct * rates[i].cycles;
+        br   += rates[i].branch_mpki * rates[i].cycles;
+    }
+    if (cyc <= 0)
+        _snwprintf(tmp, 128, L"N/A");
+    else if (pmu.has_llc)
+        _snwprintf(tmp, 128, L"IPC %.2f   LLC miss %.1f%%   branch miss %.2f/1k instr", ipc/cyc, miss/cyc, br/cyc);
+    else
+        _snwprintf(tmp, 128, L"IPC %.2f   branch miss %.2f/1k instr", ipc/cyc, br/cyc);
+    tmp[127]=L'\0';
+    PostMessageW(hwnd, WM_APP_PMU_DONE, 1, (LPARAM)tmp);
+    return 0;
+}
+
+static void StartPmuSample(HWND hwnd) {
+    if (InterlockedCompareExchange(&g_pmuRunning, 1, 0) != 0) return;
+    HANDLE th = CreateThread(NULL, 0, PmuWorker, hwnd, 0, NULL);
+    if (!th) {
+        InterlockedExchange(&g_pmuRunning, 0);
+        if (hBoxCacheLoad) SetWindowTextW(hBoxCacheLoad, L"Failed to start");
+        return;
+    }
+    CloseHandle(th);
+    if (hBtnCacheLoad) EnableWindow(hBtnCacheLoad, FALSE);
+    if (hBoxCacheLoad) SetWindowTextW(hBoxCacheLoad, L"Sampling...");
+}
+
+static void FillCacheLoad(void) {
+    bool running = g_pmuRunning != 0;
+    EnableWindow(hBtnCacheLoad, !running);
+    SetWindowTextW(hBoxCacheLoad, running ? L"Sampling..." : g_pmuText[0] ? g_pmuText : L"-");
+}
+
 static void ShowCpuTab(HWND hwnd) {
 
     // group boxes
@@ -581,7 +820,9 @@ static void ShowCpuTab(HWND hwnd) {
         hBoxCacheAssoc[i] = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,
                                             0,0,0,0, hwnd,(HMENU)(IDC_BOX_C0_ASSOC + i*3), GetModuleHandle(NULL),NULL);
     }
-
+    hLblCacheLoad = CreateWindowExW(0,L"STATIC",L"Counters",WS_CHILD|WS_VISIBLE|SS_LEFT,0,0,0,0,hwnd,(HMENU)IDC_LBL_CACHE_LOAD,GetModuleHandle(NULL),NULL);
+    hBoxCacheLoad = CreateWindowExW(WS_EX_CLIENTEDGE,L"EDIT",L"",WS_CHILD|WS_VISIBLE|ES_READONLY,0,0,0,0,hwnd,(HMENU)IDC_BOX_CACHE_LOAD,GetModuleHandle(NULL),NULL);
+    hBtnCacheLoad = CreateWindowExW(0,L"BUTTON",L"Sample",WS_CHILD|WS_VISIBLE|BS_PUSHBUTTON,0,0,0,0,hwnd,(HMENU)IDC_BTN_CACHE_LOAD,GetModuleHandle(NULL),NULL);
 
     // Layout
     Layout(hwnd);
@@ -627,6 +868,7 @@ static void ShowCpuTab(HWND hwnd) {
         ShowWindow(hBoxCacheSize[i], SW_HIDE);
         ShowWindow(hBoxCacheAssoc[i], SW_HIDE);
     }
+    FillCacheLoad();
 }
 
 static void ShowMainboardTab(HWND hwnd) {
@@ -806,6 +1048,7 @@ static void SwitchTab(HWND hwnd, int sel) {
     DestroyMainboardControls();
     DestroyMemoryControls();
     DestroyGraphicsControls();
+    DestroyBenchControls();
 
     if (sel == 0) {
         ShowCpuTab(hwnd);
@@ -815,6 +1058,8 @@ static void SwitchTab(HWND hwnd, int sel) {
         ShowMemoryTab(hwnd);
     } else if (sel == 3) {
         ShowGraphicsTab(hwnd);
+    } else if (sel == 4) {
+        ShowBenchTab(hwnd);
     } else {
         ShowBlankTab(hwnd);
     }
@@ -835,6 +1080,39 @@ static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPara
             SwitchTab(hwnd, TabCtrl_GetCurSel(hTab));
         }
         return 0;
+    case WM_COMMAND:
+        if (LOWORD(wParam) == IDC_BTN_BENCH_RUN && HIWORD(wParam) == BN_CLICKED) StartBench(hwnd, BenchWorker);
+        if (LOWORD(wParam) == IDC_BTN_BENCH_MEM && HIWORD(wParam) == BN_CLICKED) StartBench(hwnd, BenchMemWorker);
+        if (LOWORD(wParam) == IDC_BTN_CACHE_LOAD && HIWORD(wParam) == BN_CLICKED) StartPmuSample(hwnd);
+        return 0;
+    case WM_APP_BENCH_PROGRESS: {
+        char *stage = (char*)lParam;
+        if (hBoxBenchStatus && stage) {
+            wchar_t tmp[64], stageW[32];
+            mbstowcs(stageW, stage, 31); stageW[31]=L'\0';
+            _snwprintf(tmp, 64, L"Running... %d%% (%ls)", (int)wParam, stageW);
+            tmp[63]=L'\0';
+            SetWindowTextW(hBoxBenchStatus, tmp);
+        }
+        free(stage);
+        return 0;
+    }
+    case WM_APP_BENCH_DONE:
+    case WM_APP_BENCH_MEM_DONE:
+        InterlockedExchange(&g_benchRunning, 0);
+        if (wParam && msg == WM_APP_BENCH_DONE) { g_benchResult = *(const BenchCpuResult*)lParam; g_benchHasResult = true; }
+        if (wParam && msg == WM_APP_BENCH_MEM_DONE) { g_benchMemResult = *(const BenchMemResult*)lParam; g_benchMemHasResult = true; }
+        FillBenchResults();
+        if (hBtnBenchRun) EnableWindow(hBtnBenchRun, TRUE);
+        if (hBtnBenchMem) EnableWindow(hBtnBenchMem, TRUE);
+        if (hBoxBenchStatus) SetWindowTextW(hBoxBenchStatus, wParam ? L"Done" : L"Failed");
+        return 0;
+    case WM_APP_PMU_DONE:
+        InterlockedExchange(&g_pmuRunning, 0);
+        wcsncpy(g_pmuText, lParam ? (const wchar_t*)lParam : L"N/A", 127); g_pmuText[127]=L'\0';
+        free((void*)lParam);
+        if (hBoxCacheLoad) FillCacheLoad();
+        return 0;
     case WM_DESTROY:
         PostQuitMessage(0); return 0;
     }
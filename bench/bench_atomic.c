@@ -0,0 +1,192 @@
+// bench_atomic.c - Escalabilidade de atômicos e travas com a topologia
+// Cada degrau sobe um pool com as primeiras n threads da ordem de entrada. As
+// variáveis disputadas ficam em linhas de cache separadas de uma página alocada
+// no nó da primeira thread; as duas travas protegem um contador comum (numa
+// linha própria), conferido ao fim de cada rodada.
+#include "bench_atomic.h"
+#include "bench_pages.h"
+#include "bench_pool.h"
+#include "bench_timer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define LINE 128                // duas linhas: o prefetcher de pares não junta as vizinhas
+
+enum { LINE_COUNTER = 0, LINE_TICKET, LINE_MUTEX, LINE_DATA, LINES };
+
+static const char *const kind_names[BENCH_ATOMIC_KINDS] = { "add", "cas", "ticket", "srwlock" };
+static const char *const scope_names[4] = { "L3", "pacote", "sistema", "SMT" };
+
+const char *bench_atomic_kind_name(int kind) {
+    return kind >= 0 && kind < BENCH_ATOMIC_KINDS ? kind_names[kind] : "?";
+}
+
+const char *bench_atomic_scope_name(int scope) {
+    return scope >= 0 && scope < 4 ? scope_names[scope] : "?";
+}
+
+typedef struct {
+    volatile LONG next;         // próxima senha
+    volatile LONG serving;      // senha atendida
+} TicketLock;
+
+typedef struct {
+    char            *lines;
+    int              kind;
+    DWORD            ops;       // por thread
+    uint64_t         sum[BENCH_POOL_MAX];
+} AtomicJob;
+
+static volatile LONG64 *line_counter(AtomicJob *j) { return (volatile LONG64*)(j->lines + LINE_COUNTER * LINE); }
+static TicketLock *line_ticket(AtomicJob *j) { return (TicketLock*)(j->lines + LINE_TICKET * LINE); }
+static SRWLOCK *line_mutex(AtomicJob *j) { return (SRWLOCK*)(j->lines + LINE_MUTEX * LINE); }
+static volatile LONG64 *line_data(AtomicJob *j) { return (volatile LONG64*)(j->lines + LINE_DATA * LINE); }
+
+static void job_run(void *ctx, DWORD index) {
+    AtomicJob *j = (AtomicJob*)ctx;
+    volatile LONG64 *counter = line_counter(j), *data = line_data(j);
+    TicketLock *tl = line_ticket(j);
+    SRWLOCK *mutex = line_mutex(j);
+    uint64_t s = 0;
+    switch (j->kind) {
+    case BENCH_ATOMIC_ADD:
+        for (DWORD i = 0; i < j->ops; ++i) s += (uint64_t)InterlockedIncrement64(counter);
+        break;
+    case BENCH_ATOMIC_CAS:
+        for (DWORD i = 0; i < j->ops; ++i) {
+            LONG64 old;
+            do old = *counter;
+            while (InterlockedCompareExchange64(counter, old + 1, old) != old);
+            s += (uint64_t)old;
+        }
+        break;
+    case BENCH_ATOMIC_TICKET:
+        for (DWORD i = 0; i < j->ops; ++i) {
+            LONG my = InterlockedIncrement(&tl->next) - 1;
+            while (tl->serving != my) YieldProcessor();
+            *data = *data + 1;
+            s += (uint64_t)*data;
+            tl->serving = my + 1;   // só o dono escreve: basta a ordem das escritas do x86
+        }
+        break;
+    case BENCH_ATOMIC_MUTEX:
+        for (DWORD i = 0; i < j->ops; ++i) {
+            AcquireSRWLockExclusive(mutex);
+            *data = *data + 1;
+            s += (uint64_t)*data;
+            ReleaseSRWLockExclusive(mutex);
+        }
+        break;
+    }
+    j->sum[index] += s;
+}
+
+static void reset_lines(AtomicJob *j) {
+    memset(j->lines, 0, LINES * LINE);
+    InitializeSRWLock(line_mutex(j));
+}
+
+// Melhor rodada de uma primitiva com o pool atual; false se a trava deixou passar duas threads
+static bool measure(AtomicJob *j, BenchPool *pool, int kind, double *mops, double *ns) {
+    j->kind = kind;
+    uint64_t best = 0;
+    bool ok = true;
+    LONG64 expect = (LONG64)j->ops * pool->count;
+    for (int r = 0; r <= BENCH_ATOMIC_REPS; ++r) {
+        reset_lines(j);
+        uint64_t t = bench_pool_run(pool, job_run, j);
+        bool lock = kind == BENCH_ATOMIC_TICKET || kind == BENCH_ATOMIC_MUTEX;
+        if (lock ? *line_data(j) != expect : *line_counter(j) != expect) ok = false;
+        if (r > 0 && (best == 0 || t < best)) best = t;   // a rodada 0 aquece
+    }
+    double secs = (double)best / bench_hz();
+    *mops = secs > 0 ? (double)j->ops * pool->count / secs / 1e6 : 0;
+    *ns = (double)best * 1e9 / bench_hz() / j->ops;
+    return ok;
+}
+
+static int scope_of(const CpuLogical *c, const CpuLogical *first) {
+    if (c->smt != 0) return BENCH_ATOMIC_SCOPE_SMT;
+    if (c->package != first->package) return BENCH_ATOMIC_SCOPE_SYSTEM;
+    if (c->l3 != first->l3) return BENCH_ATOMIC_SCOPE_PACKAGE;
+    return BENCH_ATOMIC_SCOPE_L3;
+}
+
+static bool has_step(const BenchAtomicResult *r, DWORD n) {
+    for (DWORD i = 0; i < r->nsteps; ++i) if (r->steps[i].threads == n) return true;
+    return false;
+}
+
+static void add_step(BenchAtomicResult *r, DWORD n) {
+    if (n == 0 || n > r->count || has_step(r, n) || r->nsteps >= BENCH_ATOMIC_MAX_STEPS) return;
+    // Inserção ordenada
+    DWORD i = r->nsteps++;
+    while (i > 0 && r->steps[i - 1].threads > n) { r->steps[i] = r->steps[i - 1]; --i; }
+    memset(&r->steps[i], 0, sizeof(r->steps[i]));
+    r->steps[i].threads = n;
+}
+
+bool bench_atomic_run(BenchAtomicResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *first = topology_fastest_cpu(&topo);
+    if (!first) return false;
+
+    // Ordem de entrada: escopo a escopo, na ordem da topologia dentro de cada um
+    static const CpuLogical *order[CPU_TOPO_MAX];
+    for (int s = BENCH_ATOMIC_SCOPE_L3; s <= BENCH_ATOMIC_SCOPE_SMT; ++s) {
+        for (DWORD i = 0; i < topo.count; ++i)
+            if (scope_of(&topo.cpus[i], first) == s) order[out->count++] = &topo.cpus[i];
+        out->scope_end[s] = out->count;
+    }
+
+    // Potências de 2, o fim de cada escopo e todas as threads
+    for (DWORD n = 1; n < out->count; n *= 2) add_step(out, n);
+    for (int s = 0; s < 4; ++s) add_step(out, out->scope_end[s]);
+    add_step(out, out->count);
+
+    static AtomicJob job;
+    memset(&job, 0, sizeof(job));
+    size_t page;
+    job.lines = (char*)bench_pages_alloc(LINES * LINE, false, first->node, &page);
+    if (!job.lines) return false;
+
+    static BenchPool pool;
+    char stage[32];
+    bool ok = true;
+    out->locks_ok = true;
+    DWORD steps = out->nsteps * BENCH_ATOMIC_KINDS, step = 0;
+    for (DWORD i = 0; ok && i < out->nsteps; ++i) {
+        BenchAtomicStep *st = &out->steps[i];
+        st->scope = scope_of(order[st->threads - 1], first);
+        if (!bench_pool_start(&pool, order, st->threads)) { ok = false; break; }
+        DWORD ops = BENCH_ATOMIC_OPS / st->threads;
+        job.ops = ops < BENCH_ATOMIC_MIN_OPS ? BENCH_ATOMIC_MIN_OPS : ops;
+        for (int k = 0; k < BENCH_ATOMIC_KINDS; ++k) {
+            snprintf(stage, sizeof(stage), "%s %u thr", kind_names[k], st->threads);
+            if (progress) progress(ctx, stage, (int)(100 * step++ / steps));
+            if (!measure(&job, &pool, k, &st->mops[k], &st->ns[k])) out->locks_ok = false;
+        }
+        bench_pool_stop(&pool);
+    }
+    if (progress) progress(ctx, "done", 100);
+    for (DWORD i = 0; i < BENCH_POOL_MAX; ++i) out->checksum += job.sum[i];
+    bench_pages_free(job.lines);
+
+    for (int k = 0; k < BENCH_ATOMIC_KINDS; ++k) {
+        DWORD peak = 0;
+        for (DWORD i = 1; i < out->nsteps; ++i)
+            if (out->steps[i].mops[k] > out->steps[peak].mops[k]) peak = i;
+        out->peak_threads[k] = out->steps[peak].threads;
+        out->peak_mops[k] = out->steps[peak].mops[k];
+        for (DWORD i = peak + 1; i < out->nsteps; ++i)
+            if (out->steps[i].mops[k] < BENCH_ATOMIC_COLLAPSE * out->peak_mops[k]) {
+                out->collapse_threads[k] = out->steps[i].threads;
+                break;
+            }
+    }
+    return ok;
+}
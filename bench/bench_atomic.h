@@ -0,0 +1,62 @@
+// bench_atomic.h - Escalabilidade de atômicos e travas com a topologia
+// Quatro primitivas disputadas por 1..N threads: incremento atômico de um
+// contador compartilhado, laço de compare-and-swap, trava de senha (ticket) e
+// SRWLOCK (a trava do Windows que gira um pouco e depois dorme, como um mutex
+// sobre futex). As threads entram na ordem da topologia: primeiro os núcleos
+// físicos do domínio de L3 do núcleo mais rápido, depois os outros domínios do
+// mesmo pacote, depois os outros pacotes e por fim as threads SMT. Cada degrau
+// mede a vazão total (Mops/s) e o tempo médio de uma operação vista por uma
+// thread; a curva mostra onde a disputa desaba.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "../cpu/cpu_topology.h"
+
+#define BENCH_ATOMIC_OPS        (1u << 18)  // operações por rodada (soma das threads)
+#define BENCH_ATOMIC_MIN_OPS    4096        // por thread
+#define BENCH_ATOMIC_REPS       2           // melhor de N rodadas, depois de uma de aquecimento
+#define BENCH_ATOMIC_MAX_STEPS  32
+#define BENCH_ATOMIC_COLLAPSE   0.5         // vazão abaixo desta fração do pico = desabou
+
+enum {
+    BENCH_ATOMIC_ADD = 0,
+    BENCH_ATOMIC_CAS,
+    BENCH_ATOMIC_TICKET,
+    BENCH_ATOMIC_MUTEX,
+    BENCH_ATOMIC_KINDS
+};
+
+// Até onde as threads de um degrau se espalham
+enum {
+    BENCH_ATOMIC_SCOPE_L3 = 0,      // um domínio de L3
+    BENCH_ATOMIC_SCOPE_PACKAGE,     // vários domínios do mesmo pacote
+    BENCH_ATOMIC_SCOPE_SYSTEM,      // vários pacotes
+    BENCH_ATOMIC_SCOPE_SMT          // inclui a segunda thread de núcleos já usados
+};
+
+typedef struct {
+    DWORD  threads;
+    int    scope;
+    double mops[BENCH_ATOMIC_KINDS];    // vazão total
+    double ns[BENCH_ATOMIC_KINDS];      // tempo médio de uma operação numa thread
+} BenchAtomicStep;
+
+typedef struct {
+    DWORD           count;                          // processadores lógicos na ordem de entrada
+    DWORD           scope_end[4];                   // threads ao fim de cada escopo
+    DWORD           nsteps;
+    BenchAtomicStep steps[BENCH_ATOMIC_MAX_STEPS];
+    DWORD           peak_threads[BENCH_ATOMIC_KINDS];
+    double          peak_mops[BENCH_ATOMIC_KINDS];
+    DWORD           collapse_threads[BENCH_ATOMIC_KINDS];   // primeiro degrau após o pico abaixo do limite (0 = não desabou)
+    bool            locks_ok;                       // as travas protegeram o contador (soma conferida)
+    uint64_t        checksum;
+} BenchAtomicResult;
+
+bool bench_atomic_run(BenchAtomicResult *out, BenchProgressFn progress, void *ctx);
+
+const char *bench_atomic_kind_name(int kind);
+const char *bench_atomic_scope_name(int scope);
@@ -0,0 +1,182 @@
+// bench_c2c.c - Latência núcleo a núcleo (ping-pong de uma linha de cache)
+#include "bench_c2c.h"
+#include "bench_pool.h"
+#include "bench_timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLOT_BYTES 256      // uma linha por par, longe das vizinhas (e do prefetcher de pares)
+
+typedef struct {
+    DWORD          n;
+    int            partner[BENCH_POOL_MAX];     // -1 = sem par nesta rodada
+    char          *slots;                       // SLOT_BYTES por par, indexado pelo menor índice
+    double        *ns;
+} C2cJob;
+
+static void job_pingpong(void *ctx, DWORD idx) {
+    C2cJob *j = (C2cJob*)ctx;
+    int p = j->partner[idx];
+    if (p < 0) return;
+    bool first = (int)idx < p;
+    volatile LONG *flag = (volatile LONG*)(j->slots + (size_t)(first ? idx : (DWORD)p) * SLOT_BYTES);
+
+    // Ida: a primeira thread passa de 2k para 2k+1; volta: a outra de 2k+1 para 2k+2
+    uint64_t best = 0;
+    LONG v = first ? 0 : 1;
+    for (int s = 0; s < BENCH_C2C_SAMPLES; ++s) {
+        uint64_t t0 = bench_now();
+        for (int i = 0; i < BENCH_C2C_ITER; ++i, v += 2) {
+            while (*flag != v) YieldProcessor();
+            InterlockedExchange(flag, v + 1);
+        }
+        uint64_t t = bench_now() - t0;
+        if (best == 0 || t < best) best = t;
+    }
+    if (first) {
+        double ns = bench_ticks_to_ns(best) / (2.0 * BENCH_C2C_ITER);
+        j->ns[(size_t)idx * j->n + p] = ns;
+        j->ns[(size_t)p * j->n + idx] = ns;
+    }
+}
+
+// Rodada r do método do círculo com m posições (m par); posições >= n folgam
+static void round_pairs(C2cJob *j, DWORD m, DWORD r) {
+    for (DWORD i = 0; i < j->n; ++i) j->partner[i] = -1;
+    DWORD a = m - 1, b = r;
+    if (a < j->n && b < j->n) { j->partner[a] = (int)b; j->partner[b] = (int)a; }
+    for (DWORD k = 1; k < m / 2; ++k) {
+        a = (r + k) % (m - 1);
+        b = (r + m - 1 - k) % (m - 1);
+        if (a < j->n && b < j->n) { j->partner[a] = (int)b; j->partner[b] = (int)a; }
+    }
+}
+
+static void summarize(BenchC2cResult *r) {
+    double sum[3] = { 0, 0, 0 };
+    DWORD cnt[3] = { 0, 0, 0 };
+    r->min_ns = r->max_ns = 0;
+    for (DWORD i = 0; i < r->count; ++i) {
+        for (DWORD j = i + 1; j < r->count; ++j) {
+            double v = bench_c2c_at(r, i, j);
+            if (v <= 0) continue;
+            if (r->min_ns == 0 || v < r->min_ns) r->min_ns = v;
+            if (v > r->max_ns) r->max_ns = v;
+            const CpuLogical *a = &r->cpus[i], *b = &r->cpus[j];
+            int rel = a->package != b->package ? 2 : a->l3 != b->l3 ? 1 : 0;
+            sum[rel] += v;
+            cnt[rel]++;
+        }
+    }
+    r->avg_same_l3 = cnt[0] ? sum[0] / cnt[0] : 0;
+    r->avg_cross_l3 = cnt[1] ? sum[1] / cnt[1] : 0;
+    r->avg_cross_package = cnt[2] ? sum[2] / cnt[2] : 0;
+}
+
+bool bench_c2c_run(BenchC2cResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *cores[CPU_TOPO_MAX];
+    DWORD n = 0;
+    for (DWORD i = 0; i < topo.count; ++i) {
+        if (topo.cpus[i].smt != 0) continue;
+        out->cpus[n] = topo.cpus[i];
+        cores[n++] = &topo.cpus[i];
+    }
+    out->count = n;
+    if (n < 2) return false;
+
+    static C2cJob job;
+    memset(&job, 0, sizeof(job));
+    job.n = n;
+    job.ns = out->ns = (double*)calloc((size_t)n * n, sizeof(double));
+    job.slots = (char*)VirtualAlloc(NULL, (size_t)n * SLOT_BYTES, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    static BenchPool pool;
+    if (!job.ns || !job.slots || !bench_pool_start(&pool, cores, n)) {
+        if (job.slots) VirtualFree(job.slots, 0, MEM_RELEASE);
+        bench_c2c_free(out);
+        return false;
+    }
+
+    DWORD m = n + (n & 1);
+    char stage[32];
+    for (DWORD r = 0; r < m - 1; ++r) {
+        snprintf(stage, sizeof(stage), "rodada %lu/%lu", (unsigned long)(r + 1), (unsigned long)(m - 1));
+        if (progress) progress(ctx, stage, (int)(100 * r / (m - 1)));
+        round_pairs(&job, m, r);
+        memset(job.slots, 0, (size_t)n * SLOT_BYTES);
+        bench_pool_run(&pool, job_pingpong, &job);
+    }
+    if (progress) progress(ctx, "done", 100);
+    bench_pool_stop(&pool);
+    VirtualFree(job.slots, 0, MEM_RELEASE);
+
+    summarize(out);
+    return true;
+}
+
+void bench_c2c_free(BenchC2cResult *r) {
+    free(r->ns);
+    r->ns = NULL;
+}
+
+bool bench_c2c_write_csv(const BenchC2cResult *r, const wchar_t *path) {
+    FILE *f = _wfopen(path, L"w");
+    if (!f) return false;
+    fprintf(f, "cpu");
+    for (DWORD j = 0; j < r->count; ++j) fprintf(f, ",%u:%u", r->cpus[j].group, r->cpus[j].number);
+    fprintf(f, "\n");
+    for (DWORD i = 0; i < r->count; ++i) {
+        fprintf(f, "%u:%u", r->cpus[i].group, r->cpus[i].number);
+        for (DWORD j = 0; j < r->count; ++j) fprintf(f, ",%.1f", bench_c2c_at(r, i, j));
+        fprintf(f, "\n");
+    }
+    return fclose(f) == 0;
+}
+
+// Verde (mais rápido) -> amarelo -> vermelho (mais lento); diagonal preta
+static void heat_color(const BenchC2cResult *r, double v, BYTE bgr[3]) {
+    if (v <= 0) { bgr[0] = bgr[1] = bgr[2] = 0; return; }
+    double t = r->max_ns > r->min_ns ? (v - r->min_ns) / (r->max_ns - r->min_ns) : 0;
+    bgr[0] = 0;
+    bgr[1] = (BYTE)(t < 0.5 ? 255 : 510 * (1 - t));
+    bgr[2] = (BYTE)(t < 0.5 ? 510 * t : 255);
+}
+
+bool bench_c2c_write_bmp(const BenchC2cResult *r, const wchar_t *path) {
+    int cell = r->count >= 256 ? 2 : 512 / (int)r->count;
+    if (cell < 2) cell = 2;
+    int w = cell * (int)r->count, h = w;
+    int stride = (w * 3 + 3) & ~3;
+    BITMAPFILEHEADER fh;
+    BITMAPINFOHEADER ih;
+    memset(&fh, 0, sizeof(fh));
+    memset(&ih, 0, sizeof(ih));
+    fh.bfType = 0x4D42;     // "BM"
+    fh.bfOffBits = sizeof(fh) + sizeof(ih);
+    fh.bfSize = fh.bfOffBits + (DWORD)stride * h;
+    ih.biSize = sizeof(ih);
+    ih.biWidth = w;
+    ih.biHeight = -h;       // de cima para baixo: linha 0 = núcleo 0
+    ih.biPlanes = 1;
+    ih.biBitCount = 24;
+    ih.biCompression = BI_RGB;
+
+    BYTE *row = (BYTE*)calloc(1, stride);
+    FILE *f = row ? _wfopen(path, L"wb") : NULL;
+    if (!f) { free(row); return false; }
+    fwrite(&fh, sizeof(fh), 1, f);
+    fwrite(&ih, sizeof(ih), 1, f);
+    for (int y = 0; y < h; ++y) {
+        DWORD i = (DWORD)(y / cell);
+        for (int x = 0; x < w; ++x) heat_color(r, bench_c2c_at(r, i, (DWORD)(x / cell)), row + 3 * x);
+        fwrite(row, 1, stride, f);
+    }
+    free(row);
+    return fclose(f) == 0;
+}
@@ -0,0 +1,36 @@
+// bench_c2c.h - Latência núcleo a núcleo (ping-pong de uma linha de cache)
+// Duas threads fixadas em núcleos diferentes alternam a escrita atômica de
+// uma mesma linha; metade do tempo de ida e volta é a latência de uma
+// transferência. Os pares são agendados em rodadas de pares disjuntos
+// (método do círculo de um torneio): com N núcleos são N - 1 rodadas com N/2
+// pares medindo ao mesmo tempo, em vez de N(N-1)/2 medições em série.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+
+#include "bench_common.h"
+#include "../cpu/cpu_topology.h"
+
+#define BENCH_C2C_ITER    2000      // idas e voltas por amostra
+#define BENCH_C2C_SAMPLES 5         // fica a amostra mais rápida
+
+typedef struct {
+    DWORD      count;                   // núcleos medidos (primeira thread de cada um)
+    CpuLogical cpus[CPU_TOPO_MAX];
+    double    *ns;                      // count x count, latência de ida em ns (diagonal 0)
+    double     min_ns, max_ns;
+    double     avg_same_l3;             // média por relação entre os núcleos (0 se não houver pares)
+    double     avg_cross_l3;            // mesmo pacote, L3 diferente
+    double     avg_cross_package;
+} BenchC2cResult;
+
+bool bench_c2c_run(BenchC2cResult *out, BenchProgressFn progress, void *ctx);
+void bench_c2c_free(BenchC2cResult *r);
+
+static inline double bench_c2c_at(const BenchC2cResult *r, DWORD i, DWORD j) {
+    return r->ns[(size_t)i * r->count + j];
+}
+
+// Exporta a matriz em CSV ou como mapa de calor (BMP de 24 bits)
+bool bench_c2c_write_csv(const BenchC2cResult *r, const wchar_t *path);
+bool bench_c2c_write_bmp(const BenchC2cResult *r, const wchar_t *path);
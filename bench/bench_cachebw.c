@@ -0,0 +1,214 @@
+// bench_cachebw.c - Banda de cada nível de cache (L1, L2, L3 e DRAM)
+// Cada thread aloca no próprio nó um bloco do tamanho do maior conjunto de
+// trabalho da fase e usa o começo dele para os níveis menores. Uma passada
+// move sempre o conjunto inteiro: leitura e escrita percorrem n doubles,
+// cópia lê a primeira metade e escreve na segunda.
+#include "bench_cachebw.h"
+#include "bench_memory.h"
+#include "bench_pages.h"
+#include "bench_pool.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_cache.h"
+#include "../cpu/cpu_topology.h"
+
+#include <immintrin.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BW_STAGGER  1024        // desloca o destino da cópia para não cair no mesmo conjunto da origem
+#define BW_ALIGN    512         // cópia: n/2 múltiplo de 32 doubles; leitura: n múltiplo de 64
+
+static const char *const kernel_names[BENCH_BW_KERNELS] = { "load", "store", "copy" };
+
+// Leitura com oito acumuladores: a de bench_memory (quatro) para em uma carga
+// por ciclo pela latência da soma, e o L1 dos núcleos atuais faz duas ou três
+#define BW_LOAD(sfx, target, VT, LANES, LOAD, STOREU, ADD, SET1)                     \
+BENCH_TARGET(target) static double load_##sfx(double *a, double *b, double *c, size_t n) { \
+    (void)b; (void)c;                                                               \
+    VT s0 = SET1(0.0), s1 = s0, s2 = s0, s3 = s0, s4 = s0, s5 = s0, s6 = s0, s7 = s0; \
+    for (size_t i = 0; i < n; i += 8 * LANES) {                                     \
+        s0 = ADD(s0, LOAD(a + i));                                                  \
+        s1 = ADD(s1, LOAD(a + i + LANES));                                          \
+        s2 = ADD(s2, LOAD(a + i + 2 * LANES));                                      \
+        s3 = ADD(s3, LOAD(a + i + 3 * LANES));                                      \
+        s4 = ADD(s4, LOAD(a + i + 4 * LANES));                                      \
+        s5 = ADD(s5, LOAD(a + i + 5 * LANES));                                      \
+        s6 = ADD(s6, LOAD(a + i + 6 * LANES));                                      \
+        s7 = ADD(s7, LOAD(a + i + 7 * LANES));                                      \
+    }                                                                               \
+    double tmp[LANES], sum = 0;                                                     \
+    STOREU(tmp, ADD(ADD(ADD(s0, s1), ADD(s2, s3)), ADD(ADD(s4, s5), ADD(s6, s7)))); \
+    for (int l = 0; l < LANES; ++l) sum += tmp[l];                                  \
+    return sum;                                                                     \
+}
+
+BW_LOAD(sse2, "sse2", __m128d, 2, _mm_load_pd, _mm_storeu_pd, _mm_add_pd, _mm_set1_pd)
+BW_LOAD(avx2, "avx2", __m256d, 4, _mm256_load_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_set1_pd)
+BW_LOAD(avx512, "avx512f", __m512d, 8, _mm512_load_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_set1_pd)
+
+static const BenchMemKernelFn load_kernels[BENCH_ISA_COUNT] = { load_sse2, load_avx2, load_avx512 };
+
+// Escrita e cópia: as de bench_memory (limitadas a uma escrita por ciclo)
+static BenchMemKernelFn kernel_for(BenchIsa isa, int kernel) {
+    if (kernel == BENCH_BW_LOAD) return load_kernels[isa];
+    return bench_memory_kernel(isa, kernel == BENCH_BW_STORE ? BENCH_MEM_WRITE : BENCH_MEM_COPY);
+}
+
+const char *bench_cachebw_kernel_name(int kernel) {
+    return kernel >= 0 && kernel < BENCH_BW_KERNELS ? kernel_names[kernel] : "?";
+}
+
+typedef struct {
+    BenchPool       *pool;
+    double          *base[BENCH_POOL_MAX];
+    size_t           alloc;                 // bytes alocados por thread
+    size_t           bytes;                 // conjunto de trabalho do nível atual
+    size_t           passes;
+    bool             copy;
+    BenchMemKernelFn fn;
+    double           sum[BENCH_POOL_MAX];
+    double           hz[BENCH_POOL_MAX];
+} BwJob;
+
+static void job_alloc(void *ctx, DWORD index) {
+    BwJob *j = (BwJob*)ctx;
+    size_t page;
+    double *p = (double*)bench_pages_alloc(j->alloc + BW_STAGGER, false, j->pool->cpus[index]->node, &page);
+    j->base[index] = p;
+    // Toca todas as páginas: sem isso a leitura acertaria sempre a página zero
+    if (p) for (size_t i = 0; i < (j->alloc + BW_STAGGER) / sizeof(double); ++i) p[i] = 1.0;
+}
+
+static void job_free(void *ctx, DWORD index) {
+    BwJob *j = (BwJob*)ctx;
+    if (j->base[index]) bench_pages_free(j->base[index]);
+    j->base[index] = NULL;
+}
+
+static void job_kernel(void *ctx, DWORD index) {
+    BwJob *j = (BwJob*)ctx;
+    double *a = j->base[index];
+    double *c = (double*)((char*)a + j->bytes / 2 + BW_STAGGER);
+    size_t n = j->bytes / (j->copy ? 2 * sizeof(double) : sizeof(double));
+    double s = 0;
+    for (size_t p = 0; p < j->passes; ++p) s += j->fn(a, a, c, n);
+    j->sum[index] += s;
+}
+
+static void job_clock(void *ctx, DWORD index) {
+    BwJob *j = (BwJob*)ctx;
+    j->hz[index] = bench_core_hz_sample();
+}
+
+static size_t align_down(size_t v) {
+    return v / BW_ALIGN * BW_ALIGN;
+}
+
+// Mede uma fase: conjuntos de bytes[] por thread, todas as cargas
+static bool run_phase(const CpuLogical *const *cpus, DWORD nthreads, BenchIsa isa, BenchBwPhase *ph,
+                      const char *label, int *step, int steps, BenchProgressFn progress, void *ctx, double *checksum) {
+    static BwJob job;
+    static BenchPool pool;
+    memset(&job, 0, sizeof(job));
+    job.pool = &pool;
+    for (int l = 0; l < BENCH_LAT_LEVELS; ++l) if (ph->bytes[l] > job.alloc) job.alloc = ph->bytes[l];
+    if (!bench_pool_start(&pool, cpus, nthreads)) return false;
+
+    bench_pool_run(&pool, job_alloc, &job);
+    bool ok = true;
+    for (DWORD i = 0; i < nthreads; ++i) if (!job.base[i]) ok = false;
+
+    char stage[32];
+    double hz_sum = 0;
+    int hz_n = 0;
+    for (int l = 0; ok && l < BENCH_LAT_LEVELS; ++l) {
+        if (ph->bytes[l] == 0) { *step += BENCH_BW_KERNELS; continue; }
+        job.bytes = ph->bytes[l];
+        job.passes = BENCH_BW_ROUND_BYTES / job.bytes;
+        if (job.passes == 0) job.passes = 1;
+        for (int k = 0; k < BENCH_BW_KERNELS; ++k) {
+            snprintf(stage, sizeof(stage), "%s %s %s", label, bench_latency_level_name(l), kernel_names[k]);
+            if (progress) progress(ctx, stage, 100 * (*step)++ / steps);
+            job.fn = kernel_for(isa, k);
+            job.copy = k == BENCH_BW_COPY;
+            bench_pool_run(&pool, job_kernel, &job);        // aquecimento (cache, TLB, clock)
+            uint64_t best = 0;
+            for (int r = 0; r < BENCH_BW_REPS; ++r) {
+                uint64_t t = bench_pool_run(&pool, job_kernel, &job);
+                if (best == 0 || t < best) best = t;
+            }
+            // Clock logo depois da carga, em cada núcleo
+            bench_pool_run(&pool, job_clock, &job);
+            double hz = 0;
+            for (DWORD i = 0; i < nthreads; ++i) hz += job.hz[i];
+            hz /= nthreads;
+            hz_sum += hz;
+            hz_n++;
+
+            double secs = (double)best / bench_hz();
+            if (secs <= 0) continue;
+            BenchBwCell *cell = &ph->cell[l][k];
+            double per_core = (double)job.bytes * job.passes / secs;
+            cell->gbs = per_core * nthreads / 1e9;
+            cell->gbs_per_core = per_core / 1e9;
+            cell->bytes_per_cycle = hz > 0 ? per_core / hz : 0;
+        }
+    }
+    if (hz_n) ph->ghz = hz_sum / hz_n / 1e9;
+
+    bench_pool_run(&pool, job_free, &job);
+    bench_pool_stop(&pool);
+    for (DWORD i = 0; i < nthreads; ++i) *checksum += job.sum[i];
+    return ok;
+}
+
+bool bench_cachebw_run(int isa, BenchCacheBwResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (isa < 0) isa = bench_isa_best();
+    if (isa >= BENCH_ISA_COUNT || !bench_isa_supported((BenchIsa)isa)) return false;
+    out->isa = (BenchIsa)isa;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *fastest = topology_fastest_cpu(&topo);
+    if (!fastest) return false;
+
+    CacheLevelInfo caches[8];
+    size_t nc = get_cache_levels(caches, 8);
+    for (unsigned l = 1; l <= 3; ++l) out->cache_bytes[l - 1] = cache_level_bytes(caches, nc, l);
+    if (!out->cache_bytes[1] && topo.l2_bytes) out->cache_bytes[1] = topo.l2_bytes;
+    if (!out->cache_bytes[2] && topo.l3_bytes) out->cache_bytes[2] = topo.l3_bytes;
+    size_t l1 = out->cache_bytes[0], l2 = out->cache_bytes[1], l3 = out->cache_bytes[2];
+    if (!l1 || !l2) return false;
+
+    // Núcleos físicos do domínio de L3 do núcleo mais rápido
+    const CpuLogical *cores[CPU_TOPO_MAX];
+    DWORD n = 0;
+    out->l3_domain = fastest->l3;
+    for (DWORD i = 0; i < topo.count; ++i)
+        if (topo.cpus[i].smt == 0 && topo.cpus[i].l3 == fastest->l3) cores[n++] = &topo.cpus[i];
+    if (n == 0) cores[n++] = fastest;
+    out->threads = n;
+
+    // Metade de cada cache: sobra espaço para pilha, tabelas de página e o deslocamento da cópia.
+    // Todas as threads juntas usam 3/4 do L3 e 4x o L3 na DRAM.
+    size_t dram = l3 * 4 > BENCH_BW_DRAM_MIN ? l3 * 4 : BENCH_BW_DRAM_MIN;
+    BenchBwPhase *st = &out->st, *mt = &out->mt;
+    st->bytes[BENCH_LAT_L1] = mt->bytes[BENCH_LAT_L1] = align_down(l1 / 2);
+    st->bytes[BENCH_LAT_L2] = mt->bytes[BENCH_LAT_L2] = align_down(l2 / 2);
+    if (l3) {
+        st->bytes[BENCH_LAT_L3] = align_down(l3 / 2);
+        mt->bytes[BENCH_LAT_L3] = align_down(l3 * 3 / 4 / n);
+        st->fits_l2[BENCH_LAT_L3] = st->bytes[BENCH_LAT_L3] < 2 * l2;
+        mt->fits_l2[BENCH_LAT_L3] = mt->bytes[BENCH_LAT_L3] < 2 * l2;
+    }
+    st->bytes[BENCH_LAT_DRAM] = align_down(dram);
+    mt->bytes[BENCH_LAT_DRAM] = align_down(dram / n);
+
+    int steps = 2 * BENCH_LAT_LEVELS * BENCH_BW_KERNELS, step = 0;
+    bool ok = run_phase(&fastest, 1, out->isa, st, "ST", &step, steps, progress, ctx, &out->checksum)
+           && run_phase(cores, n, out->isa, mt, "MT", &step, steps, progress, ctx, &out->checksum);
+    if (progress) progress(ctx, "done", 100);
+    return ok;
+}
@@ -0,0 +1,54 @@
+// bench_cachebw.h - Banda de cada nível de cache (L1, L2, L3 e DRAM)
+// Cargas vetoriais de leitura, escrita e cópia (as duas últimas de bench_memory)
+// repetidas sobre um conjunto de trabalho dimensionado para caber em cada nível, pelos
+// tamanhos da topologia (L1/L2 de um núcleo, L3 de um domínio). Mede numa
+// thread fixada no núcleo mais rápido e depois numa thread por núcleo físico
+// do mesmo domínio de L3 (cada uma com o seu pedaço). Reporta GB/s, GB/s por
+// núcleo e bytes por ciclo, no clock de cada núcleo medido logo após a carga.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "bench_common.h"
+#include "bench_isa.h"
+#include "bench_latency.h"
+
+#define BENCH_BW_REPS         5                       // melhor de N rodadas
+#define BENCH_BW_ROUND_BYTES  ((size_t)256 << 20)     // bytes movidos por thread numa rodada
+#define BENCH_BW_DRAM_MIN     ((size_t)64 << 20)
+
+enum {
+    BENCH_BW_LOAD = 0,
+    BENCH_BW_STORE,
+    BENCH_BW_COPY,
+    BENCH_BW_KERNELS
+};
+
+typedef struct {
+    double gbs;                 // soma das threads (10^9 bytes/s)
+    double gbs_per_core;
+    double bytes_per_cycle;     // por núcleo
+} BenchBwCell;
+
+typedef struct {
+    size_t      bytes[BENCH_LAT_LEVELS];            // conjunto de trabalho por thread
+    bool        fits_l2[BENCH_LAT_LEVELS];          // pedaço do L3 cabe no L2 (banda do L2, não do L3)
+    BenchBwCell cell[BENCH_LAT_LEVELS][BENCH_BW_KERNELS];
+    double      ghz;                                // clock médio dos núcleos durante as cargas
+} BenchBwPhase;
+
+typedef struct {
+    BenchIsa     isa;
+    DWORD        cache_bytes[3];    // L1D, L2, L3 de uma instância (0 = ausente)
+    DWORD        l3_domain;         // domínio do núcleo mais rápido
+    DWORD        threads;           // núcleos físicos nesse domínio
+    BenchBwPhase st;
+    BenchBwPhase mt;
+    double       checksum;
+} BenchCacheBwResult;
+
+// isa = -1: o melhor conjunto disponível
+bool bench_cachebw_run(int isa, BenchCacheBwResult *out, BenchProgressFn progress, void *ctx);
+
+const char *bench_cachebw_kernel_name(int kernel);
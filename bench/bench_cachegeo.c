@@ -0,0 +1,191 @@
+// bench_cachegeo.c - Geometria das caches medida, comparada com a informada
+#include "bench_cachegeo.h"
+#include "bench_pages.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_cache.h"
+#include "../cpu/cpu_topology.h"
+
+#include <string.h>
+
+// Passos múltiplos do tamanho de uma via (4 KB no L1, até 1 MB no L2). No L1
+// cada linha fica numa página que não divide o conjunto do TLB com as demais
+// (com passo de 1 MB e páginas de 4 KB o TLB lotaria antes do L1).
+#define L1_WAY_STRIDE   (68u * 1024)
+#define L2_WAY_STRIDE   (1u << 20)
+#define WAY_LOADS       (1u << 18)
+#define PAIR_BLOCK      1024
+#define PAIR_LOADS      (1u << 20)
+#define FLAT            1.3         // mesma faixa de latência
+#define JUMP            1.5         // salto de nível
+#define CLIMB           1.15        // ainda subindo depois de um salto
+
+// Progresso das três fases numa escala só
+typedef struct {
+    BenchProgressFn fn;
+    void           *ctx;
+    int             from, to;
+} PhaseProgress;
+
+static void phase_progress(void *ctx, const char *stage, int pct) {
+    PhaseProgress *p = (PhaseProgress*)ctx;
+    if (p->fn && pct < 100) p->fn(p->ctx, stage, p->from + (p->to - p->from) * pct / 100);
+}
+
+// Platôs da curva: a base de um platô é a menor latência dele; um ponto JUMP
+// vezes acima da base abre o próximo, cuja base só é fixada quando a curva
+// para de subir (transições graduais não viram dois níveis). O tamanho do
+// nível é o maior ponto da transição ainda abaixo do meio entre as duas
+// bases: no tamanho exato da cache metade das cargas já falha.
+static DWORD transition_size(const BenchLatResult *lat, DWORD from, DWORD to, double lo, double hi) {
+    DWORD best = from;
+    for (DWORD i = from; i <= to; ++i)
+        if (lat->points[i].ns <= (lo + hi) / 2) best = i;
+    return (DWORD)lat->points[best].bytes;
+}
+
+static int find_levels(const BenchLatResult *lat, DWORD sizes[3]) {
+    int found = 0;
+    if (lat->npoints == 0) return 0;
+    double base = lat->points[0].ns, old_base = 0;
+    DWORD last_flat = 0, jump_from = 0;
+    bool climbing = false;
+    for (DWORD i = 1; i < lat->npoints && found < 3; ++i) {
+        double ns = lat->points[i].ns;
+        if (!climbing) {
+            if (ns <= base * FLAT) {
+                if (ns < base) base = ns;
+                last_flat = i;
+                continue;
+            }
+            if (ns <= base * JUMP) continue;
+            climbing = true;
+            old_base = base;
+            jump_from = last_flat;
+        }
+        // Subindo: o novo platô começa no primeiro ponto em que a curva estabiliza
+        if (i + 1 < lat->npoints && lat->points[i + 1].ns > ns * CLIMB) continue;
+        climbing = false;
+        base = ns;
+        last_flat = i;
+        sizes[found++] = transition_size(lat, jump_from, i, old_base, ns);
+    }
+    return found;
+}
+
+// N linhas espaçadas de stride, percorridas em ciclo (pior caso para LRU)
+static double way_chain_ns(char *buf, size_t stride, int n) {
+    for (int k = 0; k < n; ++k)
+        *(void**)(buf + (size_t)k * stride) = buf + (size_t)((k + 1) % n) * stride;
+    return bench_ticks_to_ns(1) * bench_chain_ticks(buf, WAY_LOADS, 3);
+}
+
+static void way_sweep(char *buf, size_t stride, double *ns) {
+    for (int n = 1; n <= BENCH_GEO_MAX_WAYS; ++n) ns[n] = way_chain_ns(buf, stride, n);
+}
+
+// Primeiro N a partir de 'from' cuja latência salta sobre a de 'from'; retorna N - 1
+static DWORD first_jump(const double *ns, int from) {
+    if (from > BENCH_GEO_MAX_WAYS) return 0;
+    for (int n = from + 1; n <= BENCH_GEO_MAX_WAYS; ++n)
+        if (ns[n] > ns[from] * JUMP) return (DWORD)(n - 1);
+    return 0;
+}
+
+// Blocos em ordem aleatória; em cada um, carga em +d e depois em +0 (de trás
+// para frente, para o prefetcher da próxima linha não antecipar a segunda)
+static double pair_chain_ns(char *buf, size_t bytes, size_t d) {
+    char *start = (char*)bench_chain_build(buf, bytes, PAIR_BLOCK, 0x51ED2701ull + d);
+    if (!start) return 0;
+    for (size_t b = 0; b + PAIR_BLOCK <= bytes; b += PAIR_BLOCK) {
+        char *blk = buf + b, *next = (char*)*(void**)blk;
+        *(void**)(blk + d) = blk;
+        *(void**)blk = next + d;
+    }
+    return bench_ticks_to_ns(1) * bench_chain_ticks(start + d, PAIR_LOADS, 3);
+}
+
+static bool size_differs(DWORD reported, DWORD measured) {
+    if (!reported || !measured) return reported != measured;
+    return measured * 2 < reported || measured > reported * 2;
+}
+
+bool bench_cachegeo_run(BenchCacheGeoResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+
+    CacheLevelInfo caches[8];
+    size_t nc = get_cache_levels(caches, 8);
+    for (size_t i = 0; i < nc; ++i) {
+        if (caches[i].instruction || caches[i].level < 1 || caches[i].level > 3) continue;
+        BenchCacheGeoLevel *l = &out->level[caches[i].level - 1];
+        if (l->present) continue;
+        l->present = true;
+        l->reported_size = caches[i].size;
+        l->reported_assoc = caches[i].assoc;
+        l->reported_line = caches[i].line;
+    }
+
+    // Tamanhos: curva de latência
+    PhaseProgress pp = { progress, ctx, 0, 80 };
+    if (!bench_latency_run(&out->latency, phase_progress, &pp)) return false;
+    DWORD sizes[3] = { 0, 0, 0 };
+    int nlevels = find_levels(&out->latency, sizes);
+    for (int l = 0; l < nlevels; ++l) {
+        out->level[l].present = true;
+        out->level[l].measured_size = sizes[l];
+    }
+
+    // Vias: a thread continua fixada no núcleo escolhido por bench_latency_run
+    if (progress) progress(ctx, "associativity", 80);
+    char *ways = (char*)bench_pages_alloc((size_t)BENCH_GEO_MAX_WAYS * L1_WAY_STRIDE, false, BENCH_NODE_ANY, NULL);
+    if (ways) {
+        way_sweep(ways, L1_WAY_STRIDE, out->l1_way_ns);
+        bench_pages_free(ways);
+        out->level[0].measured_assoc = first_jump(out->l1_way_ns, 1);
+        if (!out->level[0].measured_assoc) out->level[0].assoc_note = "nenhum salto ate 40 linhas";
+    } else {
+        out->level[0].assoc_note = "memoria insuficiente";
+    }
+
+    // No L2 o conjunto vem do endereço físico: só com páginas grandes
+    size_t page = 0;
+    ways = (char*)bench_pages_alloc((size_t)BENCH_GEO_MAX_WAYS * L2_WAY_STRIDE, true, BENCH_NODE_ANY, &page);
+    if (ways && page >= L2_WAY_STRIDE && out->level[0].measured_assoc) {
+        // Todas as linhas também caem no mesmo conjunto do L1: o primeiro salto é o do L1
+        way_sweep(ways, L2_WAY_STRIDE, out->l2_way_ns);
+        DWORD l1 = first_jump(out->l2_way_ns, 1);
+        out->level[1].measured_assoc = l1 ? first_jump(out->l2_way_ns, (int)l1 + 2) : 0;
+        if (!out->level[1].measured_assoc) out->level[1].assoc_note = "nenhum salto ate 40 linhas";
+    } else {
+        out->level[1].assoc_note = !ways ? "memoria insuficiente" :
+                                   page < L2_WAY_STRIDE ? "requer paginas grandes" : "sem medida do L1";
+    }
+    bench_pages_free(ways);
+    out->level[2].assoc_note = "fatias com hash de endereco";
+
+    // Linha: buffer que cabe no L2 e não no L1
+    if (progress) progress(ctx, "line size", 95);
+    DWORD l1 = out->level[0].reported_size ? out->level[0].reported_size : 32 * 1024;
+    DWORD l2 = out->level[1].reported_size ? out->level[1].reported_size : 256 * 1024;
+    size_t pair_bytes = l2 / 2 > 4 * l1 ? l2 / 2 : 4 * l1;
+    char *pb = (char*)bench_pages_alloc(pair_bytes, false, BENCH_NODE_ANY, NULL);
+    if (pb) {
+        for (int i = 0; i < BENCH_GEO_DISTANCES; ++i) out->pair_ns[i] = pair_chain_ns(pb, pair_bytes, (size_t)8 << i);
+        bench_pages_free(pb);
+        // Primeira distância em que a segunda carga deixa de acertar a mesma linha
+        for (int i = 1; i < BENCH_GEO_DISTANCES && !out->measured_line; ++i)
+            if (out->pair_ns[i] > out->pair_ns[0] * FLAT) out->measured_line = 8u << i;
+    }
+    if (progress) progress(ctx, "done", 100);
+
+    for (int i = 0; i < 3; ++i) {
+        BenchCacheGeoLevel *l = &out->level[i];
+        if (!l->present) continue;
+        l->size_mismatch = size_differs(l->reported_size, l->measured_size);
+        l->assoc_mismatch = l->measured_assoc && l->reported_assoc && l->reported_assoc != 0xFF &&
+                            l->measured_assoc != l->reported_assoc;
+        l->line_mismatch = out->measured_line && l->reported_line && out->measured_line != l->reported_line;
+        out->mismatches += l->size_mismatch + l->assoc_mismatch + l->line_mismatch;
+    }
+    return true;
+}
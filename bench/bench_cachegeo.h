@@ -0,0 +1,46 @@
+// bench_cachegeo.h - Geometria das caches medida, comparada com a informada
+// O Windows (e, em máquina virtual, o hipervisor) informa tamanho, vias e
+// linha de cada cache; aqui os três são medidos:
+//   tamanho: fim de cada platô da curva de latência (bench_latency)
+//   vias:    N linhas que caem no mesmo conjunto da cache cabem nela
+//            enquanto N <= vias; com N + 1 a latência salta
+//   linha:   pares de cargas a distância d (8 a 512 bytes) em blocos
+//            aleatórios dentro do L2; enquanto d é menor que a linha a
+//            segunda carga acerta o L1 e a média fica abaixo da latência do L2
+// As vias do L2 só são medidas com páginas grandes (com páginas de 4 KB o
+// conjunto depende do endereço físico); o L3 é dividido em fatias por hash
+// de endereço e não tem as vias medidas.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+
+#include "bench_common.h"
+#include "bench_latency.h"
+
+#define BENCH_GEO_MAX_WAYS 40
+#define BENCH_GEO_DISTANCES 7
+
+typedef struct {
+    bool        present;            // nível informado pelo sistema ou encontrado na curva
+    DWORD       reported_size;      // bytes (0 = não informado)
+    DWORD       measured_size;      // último tamanho antes do salto de latência (0 = não encontrado)
+    DWORD       reported_assoc;     // 0 = "unknown"
+    DWORD       measured_assoc;     // 0 = não medido
+    DWORD       reported_line;
+    bool        size_mismatch;
+    bool        assoc_mismatch;
+    bool        line_mismatch;
+    const char *assoc_note;         // por que as vias não foram medidas
+} BenchCacheGeoLevel;
+
+typedef struct {
+    BenchCacheGeoLevel level[3];            // L1D, L2, L3
+    DWORD              measured_line;       // linha da L1 (0 = não encontrada)
+    double             l1_way_ns[BENCH_GEO_MAX_WAYS + 1];   // ns com N linhas no mesmo conjunto do L1
+    double             l2_way_ns[BENCH_GEO_MAX_WAYS + 1];   // idem L2 (0 sem páginas grandes)
+    double             pair_ns[BENCH_GEO_DISTANCES];        // ns por carga com d = 8, 16, ... 512 bytes
+    int                mismatches;
+    BenchLatResult     latency;
+} BenchCacheGeoResult;
+
+bool bench_cachegeo_run(BenchCacheGeoResult *out, BenchProgressFn progress, void *ctx);
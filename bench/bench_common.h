@@ -0,0 +1,20 @@
+// bench_common.h - Definições comuns aos benchmarks
+#pragma once
+
+// Progresso: fase atual ("ST integer", "triad AVX2"...) e porcentagem total
+typedef void (*BenchProgressFn)(void *ctx, const char *stage, int pct);
+
+// Compila uma função para um conjunto de instruções específico, sem exigir a
+// flag no arquivo todo (o despacho em tempo de execução escolhe a versão)
+#if defined(__GNUC__)
+#define BENCH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define BENCH_TARGET(isa)
+#endif
+
+// Mantém um laço escalar: sem isso o -O2 dos GCC recentes vetoriza com SSE2
+#if defined(__GNUC__) && !defined(__clang__)
+#define BENCH_NO_VECTORIZE __attribute__((optimize("no-tree-vectorize")))
+#else
+#define BENCH_NO_VECTORIZE
+#endif
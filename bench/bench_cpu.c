@@ -0,0 +1,313 @@
+// bench_cpu.c - Benchmark de CPU (uma thread e todas as threads)
+// Cada carga executa uma "unidade" de trabalho de tamanho fixo por chamada; a
+// thread repete unidades até o prazo e conta quantas completou.
+#include "bench_cpu.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_topology.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UNIT_STEPS      4096
+#define BRANCH_BYTES    (16 * 1024)
+#define MEMORY_ENTRIES  (64 * 1024)         // 256 KB de índices: cabe no L2
+
+// Vazão da máquina de referência (unidades/s numa thread) = 1000 pontos
+static const double reference_rate[BENCH_CPU_KERNELS] = { 66000.0, 70000.0, 150000.0, 41000.0 };
+
+static const char *const kernel_names[BENCH_CPU_KERNELS] = { "integer", "float", "branch", "memory" };
+
+const char *bench_cpu_kernel_name(int kernel) {
+    return kernel >= 0 && kernel < BENCH_CPU_KERNELS ? kernel_names[kernel] : "?";
+}
+
+// Dados próprios de cada thread (nada compartilhado durante a medição)
+typedef struct {
+    uint8_t  *bytes;        // entrada aleatória da carga de desvios
+    uint32_t *table;        // permutação da carga de memória
+    uint64_t  seed;
+} BenchWork;
+
+static uint64_t xorshift64(uint64_t *s) {
+    uint64_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *s = x;
+}
+
+// Inteiros: mistura de multiplicações, rotações e divisões
+static uint64_t unit_integer(BenchWork *w) {
+    uint64_t s = w->seed, h = 0xCBF29CE484222325ull;
+    for (int i = 0; i < UNIT_STEPS; ++i) {
+        uint64_t a = xorshift64(&s);
+        h = (h ^ a) * 0x100000001B3ull;
+        h += (a >> 7) / ((a & 0xFFF) | 1);
+        h = (h << 27) | (h >> 37);
+    }
+    w->seed = s;
+    return h;
+}
+
+// Ponto flutuante: órbitas de Mandelbrot (mul/add dependentes) e uma raiz por ponto
+static uint64_t unit_float(BenchWork *w) {
+    double acc = 0;
+    double cr = -0.75 + (double)(w->seed & 0xFF) / 4096.0, ci = 0.1;
+    for (int p = 0; p < UNIT_STEPS / 64; ++p) {
+        double zr = 0, zi = 0;
+        for (int i = 0; i < 64; ++i) {
+            double t = zr * zr - zi * zi + cr;
+            zi = 2.0 * zr * zi + ci;
+            zr = t;
+            if (zr * zr + zi * zi > 4.0) { zr *= 0.5; zi *= 0.5; }
+        }
+        acc += sqrt(zr * zr + zi * zi + 1.0);
+        cr += 1.0 / 1024.0;
+        ci -= 1.0 / 2048.0;
+    }
+    w->seed++;
+    uint64_t bits;
+    memcpy(&bits, &acc, sizeof(bits));
+    return bits;
+}
+
+// Desvios: máquina de estados guiada por bytes aleatórios (imprevisível)
+static uint64_t unit_branch(BenchWork *w) {
+    uint64_t h = 0;
+    unsigned state = 0;
+    size_t pos = (size_t)(w->seed % BRANCH_BYTES);
+    for (int i = 0; i < UNIT_STEPS; ++i) {
+        uint8_t b = w->bytes[pos];
+        pos = (pos + 1) & (BRANCH_BYTES - 1);
+        if (b < 128) {
+            if (b & 1) state += 3;
+            else       state ^= b;
+        } else if (b < 192) {
+            state = (state >> 1) + b;
+        } else if (state & 4) {
+            h += state;
+        } else {
+            h ^= (uint64_t)b << (state & 31);
+        }
+    }
+    w->seed += 7;
+    return h + state;
+}
+
+// Memória leve: cadeia de índices dependentes dentro de 256 KB
+static uint64_t unit_memory(BenchWork *w) {
+    uint32_t idx = (uint32_t)(w->seed & (MEMORY_ENTRIES - 1));
+    uint64_t h = 0;
+    for (int i = 0; i < UNIT_STEPS; ++i) {
+        idx = w->table[idx ^ (i & 7)];
+        h += idx;
+    }
+    w->seed = idx;
+    return h;
+}
+
+typedef uint64_t (*UnitFn)(BenchWork *w);
+static const UnitFn units[BENCH_CPU_KERNELS] = { unit_integer, unit_float, unit_branch, unit_memory };
+
+static bool work_init(BenchWork *w, uint64_t seed) {
+    memset(w, 0, sizeof(*w));
+    // Alocado pela própria thread: páginas no nó NUMA dela
+    w->bytes = (uint8_t*)malloc(BRANCH_BYTES);
+    w->table = (uint32_t*)malloc(sizeof(uint32_t) * MEMORY_ENTRIES);
+    if (!w->bytes || !w->table) return false;
+    uint64_t s = seed | 1;
+    for (int i = 0; i < BRANCH_BYTES; ++i) w->bytes[i] = (uint8_t)xorshift64(&s);
+    // Permutação aleatória (Sattolo): um único ciclo por toda a tabela
+    for (uint32_t i = 0; i < MEMORY_ENTRIES; ++i) w->table[i] = i;
+    for (uint32_t i = MEMORY_ENTRIES - 1; i > 0; --i) {
+        uint32_t j = (uint32_t)(xorshift64(&s) % i);
+        uint32_t t = w->table[i]; w->table[i] = w->table[j]; w->table[j] = t;
+    }
+    w->seed = seed;
+    return true;
+}
+
+static void work_free(BenchWork *w) {
+    free(w->bytes);
+    free(w->table);
+}
+
+// Uma thread de medição
+typedef struct {
+    const CpuLogical *cpu;
+    int               kernel;
+    uint64_t          seed;
+    volatile LONG    *ready;        // threads prontas
+    volatile LONG    *go;           // largada
+    uint64_t          deadline;     // em ticks de bench_now(), definido na largada
+    uint64_t          units;
+    uint64_t          checksum;
+    uint64_t          end;
+    bool              ok;
+} BenchThread;
+
+static DWORD WINAPI bench_thread(LPVOID param) {
+    BenchThread *t = (BenchThread*)param;
+    topology_pin_thread(GetCurrentThread(), t->cpu);
+    BenchWork w;
+    t->ok = work_init(&w, t->seed);
+    // Aquecimento fora do tempo: caches, preditor e clock sobem antes da largada
+    if (t->ok) for (int i = 0; i < 8; ++i) t->checksum += units[t->kernel](&w);
+
+    InterlockedIncrement(t->ready);
+    while (!*t->go) YieldProcessor();
+
+    uint64_t deadline = t->deadline, now = 0, n = 0, h = 0;
+    UnitFn fn = units[t->kernel];
+    if (t->ok) {
+        do {
+            h += fn(&w);
+            n++;
+            now = bench_now();
+        } while (now < deadline);
+    }
+    t->units = n;
+    t->checksum += h;
+    t->end = now;
+    work_free(&w);
+    return 0;
+}
+
+// Roda uma carga em nthreads processadores; retorna unidades por segundo
+static double run_kernel(int kernel, const CpuLogical *const *cpus, DWORD nthreads, double seconds, uint64_t *checksum) {
+    BenchThread *t = (BenchThread*)calloc(nthreads, sizeof(BenchThread));
+    HANDLE *h = (HANDLE*)calloc(nthreads, sizeof(HANDLE));
+    if (!t || !h) { free(t); free(h); return 0; }
+    volatile LONG ready = 0, go = 0;
+
+    DWORD started = 0;
+    for (DWORD i = 0; i < nthreads; ++i) {
+        t[i].cpu = cpus[i];
+        t[i].kernel = kernel;
+        t[i].seed = 0x1234567ull * (i + 1) + (uint64_t)kernel;
+        t[i].ready = &ready;
+        t[i].go = &go;
+        h[i] = CreateThread(NULL, 0, bench_thread, &t[i], 0, NULL);
+        if (!h[i]) break;
+        started++;
+    }
+    while ((DWORD)ready < started) Sleep(1);
+
+    uint64_t start = bench_now();
+    uint64_t deadline = start + (uint64_t)(seconds * bench_hz());
+    for (DWORD i = 0; i < started; ++i) t[i].deadline = deadline;
+    MemoryBarrier();
+    InterlockedExchange(&go, 1);
+    // WaitForMultipleObjects para em 64 handles
+    for (DWORD i = 0; i < started; ++i) WaitForSingleObject(h[i], INFINITE);
+
+    // Vazão somada; cada thread conta até o próprio fim (a última unidade passa do prazo)
+    double rate = 0;
+    for (DWORD i = 0; i < started; ++i) {
+        CloseHandle(h[i]);
+        if (!t[i].ok || t[i].end <= start) continue;
+        rate += (double)t[i].units * bench_hz() / (double)(t[i].end - start);
+        *checksum += t[i].checksum;
+    }
+    free(t);
+    free(h);
+    return started == nthreads ? rate : 0;
+}
+
+double bench_cpu_kernel_rate(int kernel, double seconds, uint64_t *checksum) {
+    if (kernel < 0 || kernel >= BENCH_CPU_KERNELS || seconds <= 0) return 0;
+    BenchWork w;
+    if (!work_init(&w, 0x1234567ull + (uint64_t)kernel)) { work_free(&w); return 0; }
+    UnitFn fn = units[kernel];
+    uint64_t h = 0, n = 0;
+    for (int i = 0; i < 8; ++i) h += fn(&w);
+
+    uint64_t start = bench_now(), now;
+    uint64_t deadline = start + (uint64_t)(seconds * bench_hz());
+    do {
+        h += fn(&w);
+        n++;
+        now = bench_now();
+    } while (now < deadline);
+    work_free(&w);
+    if (checksum) *checksum += h;
+    return (double)n * bench_hz() / (double)(now - start);
+}
+
+double bench_cpu_kernel_rate_sync(int kernel, double seconds, BenchCpuSync *sync, uint64_t *checksum) {
+    if (kernel < 0 || kernel >= BENCH_CPU_KERNELS || seconds <= 0 || !sync) return 0;
+    BenchWork w;
+    bool ok = work_init(&w, 0x1234567ull + (uint64_t)kernel);
+    UnitFn fn = units[kernel];
+    uint64_t h = 0, n = 0;
+    if (ok) for (int i = 0; i < 8; ++i) h += fn(&w);
+
+    // Chega à barreira mesmo sem memória, para não prender as outras
+    if (InterlockedIncrement(&sync->ready) == sync->threads)
+        InterlockedExchange64(&sync->start, (LONG64)bench_now());
+    while (!sync->start) YieldProcessor();
+
+    uint64_t start = (uint64_t)sync->start, now;
+    uint64_t end = start + (uint64_t)(seconds * bench_hz());
+    if (ok) {
+        do {
+            h += fn(&w);
+            now = bench_now();
+            if (now <= end) n++;    // a última unidade passa do fim e fica de fora
+        } while (now < end);
+    }
+    work_free(&w);
+    if (checksum) *checksum += h;
+    return ok ? (double)n * bench_hz() / (double)(end - start) : 0;
+}
+
+static double geomean(const double *v, int n) {
+    double s = 0;
+    for (int i = 0; i < n; ++i) {
+        if (v[i] <= 0) return 0;
+        s += log(v[i]);
+    }
+    return exp(s / n);
+}
+
+bool bench_cpu_run(double seconds, BenchCpuResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (seconds <= 0) seconds = BENCH_CPU_DEFAULT_SECS;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *all[CPU_TOPO_MAX];
+    for (DWORD i = 0; i < topo.count; ++i) all[i] = &topo.cpus[i];
+    const CpuLogical *fastest = topology_fastest_cpu(&topo);
+
+    out->version = BENCH_CPU_VERSION;
+    out->threads = topo.count;
+    out->tsc_invariant = bench_tsc_invariant();
+    out->tsc_ghz = bench_tsc_hz() / 1e9;
+
+    char stage[32];
+    int steps = 2 * BENCH_CPU_KERNELS, step = 0;
+    for (int k = 0; k < BENCH_CPU_KERNELS; ++k) {
+        snprintf(stage, sizeof(stage), "ST %s", kernel_names[k]);
+        if (progress) progress(ctx, stage, 100 * step++ / steps);
+        out->st_rate[k] = run_kernel(k, &fastest, 1, seconds, &out->checksum);
+    }
+    for (int k = 0; k < BENCH_CPU_KERNELS; ++k) {
+        snprintf(stage, sizeof(stage), "MT %s", kernel_names[k]);
+        if (progress) progress(ctx, stage, 100 * step++ / steps);
+        out->mt_rate[k] = run_kernel(k, all, topo.count, seconds, &out->checksum);
+    }
+    if (progress) progress(ctx, "done", 100);
+
+    for (int k = 0; k < BENCH_CPU_KERNELS; ++k) {
+        out->st_score[k] = 1000.0 * out->st_rate[k] / reference_rate[k];
+        out->mt_score[k] = 1000.0 * out->mt_rate[k] / reference_rate[k];
+    }
+    out->st_total = geomean(out->st_score, BENCH_CPU_KERNELS);
+    out->mt_total = geomean(out->mt_score, BENCH_CPU_KERNELS);
+    out->mt_ratio = out->st_total > 0 ? out->mt_total / out->st_total : 0;
+    return out->st_total > 0 && out->mt_total > 0;
+}
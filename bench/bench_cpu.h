@@ -0,0 +1,59 @@
+// bench_cpu.h - Benchmark de CPU (uma thread e todas as threads)
+// Mistura fixa de cargas (inteiros, ponto flutuante, desvios imprevisíveis e
+// memória leve, dentro do L2). Cada carga roda por um tempo fixo numa thread
+// fixada no núcleo mais rápido e depois numa thread por processador lógico. A
+// nota é a vazão relativa à máquina de referência (1000 pontos por carga).
+// Mudou a carga, muda BENCH_CPU_VERSION: notas de versões diferentes não se
+// comparam.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+
+#define BENCH_CPU_VERSION        1
+#define BENCH_CPU_DEFAULT_SECS   1.0    // por carga e por fase
+
+enum {
+    BENCH_CPU_INTEGER = 0,
+    BENCH_CPU_FLOAT,
+    BENCH_CPU_BRANCH,
+    BENCH_CPU_MEMORY,
+    BENCH_CPU_KERNELS
+};
+
+typedef struct {
+    DWORD    version;
+    DWORD    threads;
+    double   st_rate[BENCH_CPU_KERNELS];    // unidades de trabalho por segundo
+    double   mt_rate[BENCH_CPU_KERNELS];
+    double   st_score[BENCH_CPU_KERNELS];
+    double   mt_score[BENCH_CPU_KERNELS];
+    double   st_total;                      // média geométrica das cargas
+    double   mt_total;
+    double   mt_ratio;                      // mt_total / st_total
+    bool     tsc_invariant;
+    double   tsc_ghz;
+    uint64_t checksum;                      // resultado das cargas (impede que o compilador as elimine)
+} BenchCpuResult;
+
+// Roda o benchmark completo; seconds = duração de cada carga em cada fase
+bool bench_cpu_run(double seconds, BenchCpuResult *out, BenchProgressFn progress, void *ctx);
+
+// Uma medição de uma carga na thread chamadora (já fixada), sem criar threads;
+// retorna unidades por segundo. Usada pelas repetições de bench_stats
+double bench_cpu_kernel_rate(int kernel, double seconds, uint64_t *checksum);
+
+// Largada comum de threads que medem juntas (zerada, com threads preenchido)
+typedef struct {
+    LONG              threads;
+    volatile LONG     ready;        // threads aquecidas
+    volatile LONG64   start;        // bench_now() da largada, marcado pela última a ficar pronta
+} BenchCpuSync;
+
+// Como bench_cpu_kernel_rate, mas cada thread aquece antes da barreira e
+// todas contam só as unidades terminadas no mesmo intervalo [start, start + seconds]
+double bench_cpu_kernel_rate_sync(int kernel, double seconds, BenchCpuSync *sync, uint64_t *checksum);
+
+const char *bench_cpu_kernel_name(int kernel);
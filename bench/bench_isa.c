@@ -0,0 +1,32 @@
+// bench_isa.c - Conjuntos de instruções para as variantes dos benchmarks
+#include "bench_isa.h"
+#include "../cpu/cpu_features.h"
+
+static const char *const isa_names[BENCH_ISA_COUNT] = { "SSE2", "AVX2", "AVX-512" };
+static const int isa_width[BENCH_ISA_COUNT] = { 16, 32, 64 };
+
+const char *bench_isa_name(BenchIsa isa) {
+    return (unsigned)isa < BENCH_ISA_COUNT ? isa_names[isa] : "?";
+}
+
+int bench_isa_width(BenchIsa isa) {
+    return (unsigned)isa < BENCH_ISA_COUNT ? isa_width[isa] : 0;
+}
+
+// Requisitos de cada variante, da preferida para a mais simples; o estado
+// dos registradores salvo pelo SO já entra em cpu_has
+static const CpuDispatchEntry isa_table[BENCH_ISA_COUNT] = {
+    { "AVX-512", { CPU_FEAT_AVX512F, CPU_FEAT_AVX2, CPU_FEAT_FMA } },
+    { "AVX2",    { CPU_FEAT_AVX2, CPU_FEAT_FMA } },
+    { "SSE2",    { CPU_FEAT_SSE2 } },
+};
+
+bool bench_isa_supported(BenchIsa isa) {
+    if ((unsigned)isa >= BENCH_ISA_COUNT) return false;
+    return cpu_dispatch_ok(&isa_table[BENCH_ISA_COUNT - 1 - isa]);
+}
+
+BenchIsa bench_isa_best(void) {
+    int i = cpu_dispatch(isa_table, BENCH_ISA_COUNT);
+    return i < 0 ? BENCH_ISA_SSE2 : (BenchIsa)(BENCH_ISA_COUNT - 1 - i);
+}
@@ -0,0 +1,19 @@
+// bench_isa.h - Conjuntos de instruções para as variantes dos benchmarks
+// Uma variante só é usada se a CPU tem as instruções e o Windows salva os
+// registradores correspondentes; a escolha usa o despacho de cpu_features.
+#pragma once
+#include <stdbool.h>
+
+typedef enum {
+    BENCH_ISA_SSE2 = 0,
+    BENCH_ISA_AVX2,
+    BENCH_ISA_AVX512,
+    BENCH_ISA_COUNT
+} BenchIsa;
+
+bool        bench_isa_supported(BenchIsa isa);
+BenchIsa    bench_isa_best(void);
+const char *bench_isa_name(BenchIsa isa);
+
+// Largura do vetor em bytes
+int         bench_isa_width(BenchIsa isa);
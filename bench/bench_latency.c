@@ -0,0 +1,183 @@
+// bench_latency.c - Latência de memória por tamanho do conjunto de trabalho
+// Pontos em 2^k e 1,5 x 2^k bytes. Um buffer do maior tamanho é alocado uma
+// vez; cada ponto monta a cadeia no seu começo.
+#include "bench_latency.h"
+#include "bench_pages.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_cache.h"
+#include "../cpu/cpu_topology.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_LOADS   (1u << 21)      // cargas por medição, no mínimo
+#define REPS        3
+
+static const char *const level_names[BENCH_LAT_LEVELS] = { "L1", "L2", "L3", "DRAM" };
+
+const char *bench_latency_level_name(int level) {
+    return level >= 0 && level < BENCH_LAT_LEVELS ? level_names[level] : "?";
+}
+
+static uint64_t xorshift64(uint64_t *s) {
+    uint64_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *s = x;
+}
+
+void *bench_chain_build(void *buf, size_t bytes, size_t stride, uint64_t seed) {
+    size_t n = bytes / stride;
+    if (n < 2) return NULL;
+    uint32_t *order = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (!order) return NULL;
+    // Permutação aleatória (Sattolo): um único ciclo passando por todos os elementos
+    uint64_t s = seed | 1;
+    for (size_t i = 0; i < n; ++i) order[i] = (uint32_t)i;
+    for (size_t i = n - 1; i > 0; --i) {
+        size_t j = (size_t)(xorshift64(&s) % i);
+        uint32_t t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+    char *base = (char*)buf;
+    for (size_t i = 0; i < n; ++i)
+        *(void**)(base + (size_t)i * stride) = base + (size_t)order[i] * stride;
+    free(order);
+    return base;
+}
+
+void *bench_chain_walk(void *p, size_t loads) {
+    void **q = (void**)p;
+    for (size_t i = 0; i < loads; i += 16) {
+        q = (void**)*q; q = (void**)*q; q = (void**)*q; q = (void**)*q;
+        q = (void**)*q; q = (void**)*q; q = (void**)*q; q = (void**)*q;
+        q = (void**)*q; q = (void**)*q; q = (void**)*q; q = (void**)*q;
+        q = (void**)*q; q = (void**)*q; q = (void**)*q; q = (void**)*q;
+    }
+    return q;
+}
+
+static void *volatile g_chain_sink;
+
+double bench_chain_ticks(void *start, size_t loads, int reps) {
+    loads = (loads + 15) & ~(size_t)15;
+    void *p = bench_chain_walk(start, loads);        // aquecimento: caches e TLB
+    uint64_t best = 0;
+    for (int r = 0; r < reps; ++r) {
+        uint64_t t0 = bench_now();
+        p = bench_chain_walk(p, loads);
+        uint64_t t = bench_now() - t0;
+        if (best == 0 || t < best) best = t;
+    }
+    g_chain_sink = p;
+    return (double)best / (double)loads;
+}
+
+static int level_of(const BenchLatResult *r, size_t bytes) {
+    for (int l = 0; l < 3; ++l)
+        if (r->cache_bytes[l] && bytes <= r->cache_bytes[l]) return l;
+    return BENCH_LAT_DRAM;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Platô de cada nível: mediana dos pontos entre o nível anterior e metade
+// deste (longe das transições); DRAM a partir de 2x a última cache
+static void find_plateaus(BenchLatResult *r) {
+    DWORD llc = 0;
+    for (int l = 0; l < 3; ++l) if (r->cache_bytes[l]) llc = r->cache_bytes[l];
+    size_t lo = 0;
+    for (int l = 0; l < BENCH_LAT_LEVELS; ++l) {
+        size_t hi;
+        if (l < 3) {
+            if (!r->cache_bytes[l]) continue;
+            hi = r->cache_bytes[l] / 2;
+        } else {
+            lo = (size_t)llc * 2 - 1;
+            hi = (size_t)-1;
+        }
+        double ns[BENCH_LAT_MAX_POINTS], cyc[BENCH_LAT_MAX_POINTS];
+        int n = 0;
+        for (DWORD i = 0; i < r->npoints; ++i) {
+            if (r->points[i].bytes > lo && r->points[i].bytes <= hi) {
+                ns[n] = r->points[i].ns;
+                cyc[n] = r->points[i].cycles;
+                n++;
+            }
+        }
+        if (n > 0) {
+            qsort(ns, n, sizeof(double), cmp_double);
+            qsort(cyc, n, sizeof(double), cmp_double);
+            r->plateau_ns[l] = ns[n / 2];
+            r->plateau_cycles[l] = cyc[n / 2];
+        }
+        if (l < 3) lo = r->cache_bytes[l];
+    }
+}
+
+bool bench_latency_run(BenchLatResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+
+    CacheLevelInfo caches[8];
+    size_t nc = get_cache_levels(caches, 8);
+    for (unsigned l = 1; l <= 3; ++l) out->cache_bytes[l - 1] = cache_level_bytes(caches, nc, l);
+    DWORD llc = out->cache_bytes[2] ? out->cache_bytes[2] : out->cache_bytes[1];
+    if (!llc) llc = 8u << 20;
+    size_t max_bytes = (size_t)llc * BENCH_LAT_LLC_FACTOR;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *fastest = topology_fastest_cpu(&topo);
+    // Fixa no núcleo mais rápido e devolve a afinidade anterior no fim: os
+    // comandos seguintes do mesmo processo não herdam a fixação
+    HANDLE self = GetCurrentThread();
+    GROUP_AFFINITY pin, old;
+    memset(&pin, 0, sizeof(pin));
+    pin.Group = fastest->group;
+    pin.Mask = (KAFFINITY)1 << fastest->number;
+    bool pinned = SetThreadGroupAffinity(self, &pin, &old) != FALSE;
+
+    void *buf = bench_pages_alloc(max_bytes, true, fastest->node, &out->page_bytes);
+    if (!buf) {
+        if (pinned) SetThreadGroupAffinity(self, &old, NULL);
+        return false;
+    }
+    out->large_pages = out->page_bytes > 4096;
+    if (!out->large_pages) out->large_pages_reason = bench_large_pages_reason();
+
+    // Tamanhos: 4K, 6K, 8K, 12K, 16K, ... até max_bytes
+    size_t sizes[BENCH_LAT_MAX_POINTS];
+    DWORD n = 0;
+    for (size_t b = BENCH_LAT_MIN_BYTES; b <= max_bytes && n < BENCH_LAT_MAX_POINTS; b *= 2) {
+        sizes[n++] = b;
+        if (b + b / 2 <= max_bytes && n < BENCH_LAT_MAX_POINTS) sizes[n++] = b + b / 2;
+    }
+
+    out->core_ghz = bench_core_hz() / 1e9;
+    double tick_ns = 1e9 / bench_hz();
+    char stage[32];
+    for (DWORD i = 0; i < n; ++i) {
+        snprintf(stage, sizeof(stage), "%lu KB", (unsigned long)(sizes[i] >> 10));
+        if (progress) progress(ctx, stage, (int)(100 * i / n));
+        void *start = bench_chain_build(buf, sizes[i], BENCH_LAT_LINE, 0x9E3779B97F4A7C15ull + i);
+        if (!start) break;
+        size_t lines = sizes[i] / BENCH_LAT_LINE;
+        double ticks = bench_chain_ticks(start, lines > MIN_LOADS ? lines : MIN_LOADS, REPS);
+        BenchLatPoint *p = &out->points[out->npoints++];
+        p->bytes = sizes[i];
+        p->ns = ticks * tick_ns;
+        p->cycles = p->ns * out->core_ghz;
+        p->level = level_of(out, sizes[i]);
+    }
+    if (progress) progress(ctx, "done", 100);
+    bench_pages_free(buf);
+    if (pinned) SetThreadGroupAffinity(self, &old, NULL);
+
+    find_plateaus(out);
+    return out->npoints > 0;
+}
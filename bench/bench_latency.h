@@ -0,0 +1,59 @@
+// bench_latency.h - Latência de memória por tamanho do conjunto de trabalho
+// Cadeia de ponteiros em ordem aleatória, um ponteiro por linha de cache: cada
+// carga depende da anterior e o endereço seguinte é imprevisível, então os
+// prefetchers não ajudam. Varre de 4 KB a 4x a última cache, numa thread
+// fixada no núcleo mais rápido, em páginas grandes quando possível. Cada ponto
+// é rotulado pela cache em que cabe (tamanhos de build_cache_rows_kv2).
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+
+#define BENCH_LAT_MIN_BYTES   (4 * 1024)
+#define BENCH_LAT_LLC_FACTOR  4
+#define BENCH_LAT_MAX_POINTS  64
+#define BENCH_LAT_LINE        64
+
+enum {
+    BENCH_LAT_L1 = 0,
+    BENCH_LAT_L2,
+    BENCH_LAT_L3,
+    BENCH_LAT_DRAM,
+    BENCH_LAT_LEVELS
+};
+
+typedef struct {
+    size_t bytes;
+    double ns;              // por carga
+    double cycles;          // por carga, no clock medido do núcleo
+    int    level;           // BENCH_LAT_L1..BENCH_LAT_DRAM
+} BenchLatPoint;
+
+typedef struct {
+    BenchLatPoint points[BENCH_LAT_MAX_POINTS];
+    DWORD         npoints;
+    DWORD         cache_bytes[3];                   // L1D, L2, L3 de uma instância (0 = ausente)
+    double        plateau_ns[BENCH_LAT_LEVELS];     // mediana dos pontos bem dentro de cada nível
+    double        plateau_cycles[BENCH_LAT_LEVELS];
+    double        core_ghz;
+    bool          large_pages;
+    size_t        page_bytes;
+    const char   *large_pages_reason;               // se large_pages == false
+} BenchLatResult;
+
+// Monta uma cadeia circular aleatória com um ponteiro a cada stride bytes nos
+// primeiros bytes de buf; retorna o início (NULL se faltar memória)
+void *bench_chain_build(void *buf, size_t bytes, size_t stride, uint64_t seed);
+
+// Segue loads ponteiros (múltiplo de 16) a partir de p; retorna onde parou
+void *bench_chain_walk(void *p, size_t loads);
+
+// Ticks de bench_now() por carga: melhor de reps percursos de loads cargas
+double bench_chain_ticks(void *start, size_t loads, int reps);
+
+bool bench_latency_run(BenchLatResult *out, BenchProgressFn progress, void *ctx);
+
+const char *bench_latency_level_name(int level);
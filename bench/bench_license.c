@@ -0,0 +1,267 @@
+// bench_license.c - Vazão e clock por conjunto de instruções
+// As variantes saem da mesma macro, como as cargas de bench_memory. O clock é
+// amostrado entre blocos da carga com bench_core_hz_sample: a licença baixa
+// do clock dura alguns milissegundos depois da última instrução larga, então a
+// amostra (dezenas de microssegundos, só inteiros) vê o clock da carga sem
+// mudá-lo. O tempo das amostras fica fora da vazão.
+#include "bench_license.h"
+#include "bench_isa.h"
+#include "bench_pages.h"
+#include "bench_pool.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_topology.h"
+
+#include <immintrin.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LIC_ELEMS     1024          // x e y: 16 KB, cabem no L1
+#define LIC_DEGREE    16            // coeficientes do polinômio
+#define LIC_FLOPS     (2.0 * (LIC_DEGREE - 1) * LIC_ELEMS)   // por chamada
+#define WARM_SECS     0.1           // antes da contagem: clock e licença se acomodam
+#define SAMPLE_MS     10            // intervalo mínimo entre amostras de clock
+#define REST_MS       200           // pausa entre variantes
+
+// Coeficientes em (0, 1) e x em [0,25, 0,75]: os valores ficam limitados e
+// nunca chegam a subnormais, que deixariam a carga lenta por outro motivo
+static const double coef[LIC_DEGREE] = {
+    0.50, 0.33, 0.25, 0.20, 0.17, 0.14, 0.125, 0.11,
+    0.10, 0.09, 0.083, 0.077, 0.071, 0.067, 0.0625, 0.059,
+};
+
+static const char *const variant_names[BENCH_VEC_VARIANTS] = { "scalar", "SSE2", "AVX2", "AVX-512" };
+
+const char *bench_vec_variant_name(int variant) {
+    return variant >= 0 && variant < BENCH_VEC_VARIANTS ? variant_names[variant] : "?";
+}
+
+// n é múltiplo de 8 vetores; oito cadeias independentes escondem a latência
+// da multiplicação-soma (acumuladores nomeados: num vetor o GCC os leva à pilha)
+#define LIC_KERNEL(sfx, ATTR, VT, LANES, LOAD, STORE, MULADD, SET1)                \
+ATTR static void horner_##sfx(const double *x, double *y, size_t n) {               \
+    for (size_t i = 0; i < n; i += 8 * LANES) {                                     \
+        VT x0 = LOAD(x + i),             x1 = LOAD(x + i + LANES);                  \
+        VT x2 = LOAD(x + i + 2 * LANES), x3 = LOAD(x + i + 3 * LANES);              \
+        VT x4 = LOAD(x + i + 4 * LANES), x5 = LOAD(x + i + 5 * LANES);              \
+        VT x6 = LOAD(x + i + 6 * LANES), x7 = LOAD(x + i + 7 * LANES);              \
+        VT p0 = SET1(coef[0]), p1 = p0, p2 = p0, p3 = p0;                           \
+        VT p4 = p0, p5 = p0, p6 = p0, p7 = p0;                                      \
+        for (int d = 1; d < LIC_DEGREE; ++d) {                                      \
+            VT c = SET1(coef[d]);                                                   \
+            p0 = MULADD(p0, x0, c); p1 = MULADD(p1, x1, c);                         \
+            p2 = MULADD(p2, x2, c); p3 = MULADD(p3, x3, c);                         \
+            p4 = MULADD(p4, x4, c); p5 = MULADD(p5, x5, c);                         \
+            p6 = MULADD(p6, x6, c); p7 = MULADD(p7, x7, c);                         \
+        }                                                                           \
+        STORE(y + i, p0);             STORE(y + i + LANES, p1);                     \
+        STORE(y + i + 2 * LANES, p2); STORE(y + i + 3 * LANES, p3);                 \
+        STORE(y + i + 4 * LANES, p4); STORE(y + i + 5 * LANES, p5);                 \
+        STORE(y + i + 6 * LANES, p6); STORE(y + i + 7 * LANES, p7);                 \
+    }                                                                               \
+}
+
+#define SCALAR_LOAD(p)          (*(p))
+#define SCALAR_STORE(p, v)      (*(p) = (v))
+#define SCALAR_MULADD(a, b, c)  ((a) * (b) + (c))
+#define SCALAR_SET1(v)          (v)
+#define SSE2_MULADD(a, b, c)    _mm_add_pd(_mm_mul_pd(a, b), c)
+
+LIC_KERNEL(scalar, BENCH_NO_VECTORIZE, double, 1, SCALAR_LOAD, SCALAR_STORE, SCALAR_MULADD, SCALAR_SET1)
+LIC_KERNEL(sse2, BENCH_TARGET("sse2"), __m128d, 2, _mm_load_pd, _mm_store_pd, SSE2_MULADD, _mm_set1_pd)
+LIC_KERNEL(avx2, BENCH_TARGET("avx2,fma"), __m256d, 4, _mm256_load_pd, _mm256_store_pd, _mm256_fmadd_pd, _mm256_set1_pd)
+LIC_KERNEL(avx512, BENCH_TARGET("avx512f"), __m512d, 8, _mm512_load_pd, _mm512_store_pd, _mm512_fmadd_pd, _mm512_set1_pd)
+
+static const BenchHornerFn kernels[BENCH_VEC_VARIANTS] = { horner_scalar, horner_sse2, horner_avx2, horner_avx512 };
+
+BenchHornerFn bench_license_kernel(int variant) {
+    return variant >= 0 && variant < BENCH_VEC_VARIANTS ? kernels[variant] : NULL;
+}
+
+static bool variant_supported(int v) {
+    return v == BENCH_VEC_SCALAR || bench_isa_supported((BenchIsa)(v - 1));
+}
+
+typedef struct {
+    BenchHornerFn fn;
+    uint64_t      warm_end, end;        // em ticks de bench_now()
+    uint64_t      sample_ticks;
+    double       *x[BENCH_POOL_MAX];    // x e y no mesmo bloco, alocado pela thread
+    uint64_t      calls[BENCH_POOL_MAX];
+    uint64_t      busy[BENCH_POOL_MAX]; // ticks contados, sem as amostras
+    double        sum[BENCH_POOL_MAX];
+    DWORD         nsamples[BENCH_POOL_MAX];
+    double        samples[BENCH_POOL_MAX][BENCH_LICENSE_MAX_SAMPLES];
+} LicJob;
+
+static void job_alloc(void *ctx, DWORD index) {
+    LicJob *j = (LicJob*)ctx;
+    size_t page;
+    double *x = (double*)bench_pages_alloc(2 * LIC_ELEMS * sizeof(double), false, BENCH_NODE_ANY, &page);
+    j->x[index] = x;
+    if (!x) return;
+    for (int i = 0; i < LIC_ELEMS; ++i) x[i] = 0.25 + 0.5 * (double)((i * 37 + (int)index) % LIC_ELEMS) / LIC_ELEMS;
+}
+
+static void job_free(void *ctx, DWORD index) {
+    LicJob *j = (LicJob*)ctx;
+    if (j->x[index]) bench_pages_free(j->x[index]);
+    j->x[index] = NULL;
+}
+
+static void job_run(void *ctx, DWORD index) {
+    LicJob *j = (LicJob*)ctx;
+    double *x = j->x[index], *y = x + LIC_ELEMS;
+    BenchHornerFn fn = j->fn;
+    uint64_t now = bench_now();
+    while (now < j->warm_end) {
+        fn(x, y, LIC_ELEMS);
+        now = bench_now();
+    }
+
+    uint64_t start = now, next = now + j->sample_ticks, paused = 0, n = 0;
+    DWORD ns = 0;
+    while (now < j->end) {
+        fn(x, y, LIC_ELEMS);
+        n++;
+        now = bench_now();
+        if (now >= next) {
+            if (ns < BENCH_LICENSE_MAX_SAMPLES) j->samples[index][ns++] = bench_core_hz_sample();
+            uint64_t after = bench_now();
+            paused += after - now;
+            now = after;
+            next = now + j->sample_ticks;
+        }
+    }
+    j->calls[index] = n;
+    j->busy[index] = now - start - paused;
+    j->nsamples[index] = ns;
+    j->sum[index] += y[0] + y[LIC_ELEMS - 1];
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Roda uma variante no pool e preenche a fase; false se faltar memória
+static bool run_phase(LicJob *j, BenchPool *pool, BenchHornerFn fn, double seconds, BenchLicensePhase *ph, uint64_t *checksum) {
+    memset(j, 0, sizeof(*j));
+    j->fn = fn;
+    bench_pool_run(pool, job_alloc, j);
+    bool ok = true;
+    for (DWORD i = 0; i < pool->count; ++i) if (!j->x[i]) ok = false;
+    if (ok) {
+        double hz = bench_hz();
+        double sample_secs = seconds / BENCH_LICENSE_MAX_SAMPLES;
+        if (sample_secs < SAMPLE_MS / 1000.0) sample_secs = SAMPLE_MS / 1000.0;
+        j->sample_ticks = (uint64_t)(sample_secs * hz);
+        j->warm_end = bench_now() + (uint64_t)(WARM_SECS * hz);
+        j->end = j->warm_end + (uint64_t)(seconds * hz);
+        bench_pool_run(pool, job_run, j);
+
+        double ghz_sum = 0;
+        DWORD counted = 0;
+        for (DWORD i = 0; i < pool->count; ++i) {
+            if (j->busy[i]) ph->gflops += (double)j->calls[i] * LIC_FLOPS * hz / (double)j->busy[i] / 1e9;
+            DWORD ns = j->nsamples[i];
+            ph->samples += ns;
+            if (ns) {
+                qsort(j->samples[i], ns, sizeof(double), cmp_double);
+                double ghz = j->samples[i][ns / 2] / 1e9;
+                ghz_sum += ghz;
+                if (counted++ == 0 || ghz < ph->ghz_min) ph->ghz_min = ghz;
+            }
+            uint64_t bits;
+            memcpy(&bits, &j->sum[i], sizeof(bits));
+            *checksum += bits;
+        }
+        if (counted) ph->ghz = ghz_sum / counted;
+    }
+    bench_pool_run(pool, job_free, j);
+    return ok;
+}
+
+bool bench_license_phase(int variant, const CpuLogical *const *cpus, DWORD count, double seconds,
+                         BenchLicensePhase *ph, uint64_t *checksum) {
+    if (!ph || variant < 0 || variant >= BENCH_VEC_VARIANTS || !variant_supported(variant)) return false;
+    memset(ph, 0, sizeof(*ph));
+    if (seconds <= 0) seconds = BENCH_LICENSE_DEFAULT_SECS;
+    LicJob *job = (LicJob*)calloc(1, sizeof(LicJob));
+    if (!job) return false;
+    static BenchPool pool;
+    bool ok = bench_pool_start(&pool, cpus, count);
+    uint64_t sum = 0;
+    if (ok) {
+        ok = run_phase(job, &pool, kernels[variant], seconds, ph, &sum);
+        bench_pool_stop(&pool);
+    }
+    free(job);
+    if (checksum) *checksum += sum;
+    return ok;
+}
+
+// Escalar como referência de cada fase; melhor variante pela vazão
+static void derive(BenchLicenseResult *out) {
+    const BenchLicenseVariant *base = &out->v[BENCH_VEC_SCALAR];
+    for (int v = 0; v < BENCH_VEC_VARIANTS; ++v) {
+        BenchLicenseVariant *r = &out->v[v];
+        if (!r->available) continue;
+        if (base->st.ghz > 0)    r->st.clock_pct = 100.0 * r->st.ghz / base->st.ghz;
+        if (base->mt.ghz > 0)    r->mt.clock_pct = 100.0 * r->mt.ghz / base->mt.ghz;
+        if (base->st.gflops > 0) r->st.speedup = r->st.gflops / base->st.gflops;
+        if (base->mt.gflops > 0) r->mt.speedup = r->mt.gflops / base->mt.gflops;
+        if (r->st.gflops > out->v[out->best_st].st.gflops) out->best_st = v;
+        if (r->mt.gflops > out->v[out->best_mt].mt.gflops) out->best_mt = v;
+    }
+}
+
+bool bench_license_run(double seconds, BenchLicenseResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (seconds <= 0) seconds = BENCH_LICENSE_DEFAULT_SECS;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *fastest = topology_fastest_cpu(&topo);
+    const CpuLogical *cores[CPU_TOPO_MAX];
+    DWORD ncores = 0;
+    for (DWORD i = 0; i < topo.count; ++i)
+        if (topo.cpus[i].smt == 0) cores[ncores++] = &topo.cpus[i];
+    out->threads = ncores;
+
+    // Clock ocioso no núcleo mais rápido; depois a chamadora volta à afinidade
+    // original para não disputar o núcleo com a thread do pool
+    HANDLE self = GetCurrentThread();
+    GROUP_AFFINITY old;
+    bool pinned = GetThreadGroupAffinity(self, &old) && topology_pin_thread(self, fastest);
+    out->idle_ghz = bench_core_hz() / 1e9;
+    if (pinned) SetThreadGroupAffinity(self, &old, NULL);
+
+    LicJob *job = (LicJob*)calloc(1, sizeof(LicJob));
+    if (!job) return false;
+    bool ok = true;
+    char stage[32];
+    int steps = 2 * BENCH_VEC_VARIANTS, step = 0;
+    for (int phase = 0; phase < 2 && ok; ++phase) {
+        static BenchPool pool;
+        bool started = phase == 0 ? bench_pool_start(&pool, &fastest, 1)
+                                  : bench_pool_start(&pool, cores, ncores);
+        if (!started) { ok = false; break; }
+        for (int v = 0; v < BENCH_VEC_VARIANTS; ++v) {
+            snprintf(stage, sizeof(stage), "%s %s", phase == 0 ? "ST" : "MT", variant_names[v]);
+            if (progress) progress(ctx, stage, 100 * step++ / steps);
+            out->v[v].available = variant_supported(v);
+            if (!out->v[v].available) continue;
+            BenchLicensePhase *ph = phase == 0 ? &out->v[v].st : &out->v[v].mt;
+            if (!run_phase(job, &pool, kernels[v], seconds, ph, &out->checksum)) { ok = false; break; }
+            Sleep(REST_MS);
+        }
+        bench_pool_stop(&pool);
+    }
+    free(job);
+    if (progress) progress(ctx, "done", 100);
+    if (!ok) return false;
+    derive(out);
+    return out->v[BENCH_VEC_SCALAR].st.gflops > 0 && out->v[BENCH_VEC_SCALAR].mt.gflops > 0;
+}
@@ -0,0 +1,67 @@
+// bench_license.h - Vazão e clock por conjunto de instruções
+// O mesmo trabalho (polinômio de grau fixo avaliado por Horner sobre um vetor
+// que cabe no L1, limitado só pelas unidades de ponto flutuante) em versão
+// escalar, SSE2, AVX2 e AVX-512, numa thread fixada no núcleo mais rápido e
+// numa thread por núcleo físico. Enquanto a carga roda, cada thread amostra o
+// clock efetivo do próprio núcleo: algumas CPUs baixam o clock ("licença de
+// frequência") com vetores largos, e o ganho real de uma variante é a vazão
+// dela já com esse clock.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "../cpu/cpu_topology.h"
+
+#define BENCH_LICENSE_DEFAULT_SECS  1.0     // por variante e por fase
+#define BENCH_LICENSE_MAX_SAMPLES   256     // amostras de clock por thread
+
+typedef enum {
+    BENCH_VEC_SCALAR = 0,
+    BENCH_VEC_SSE2,
+    BENCH_VEC_AVX2,
+    BENCH_VEC_AVX512,
+    BENCH_VEC_VARIANTS
+} BenchVecVariant;
+
+// Uma fase (ST ou MT) de uma variante
+typedef struct {
+    double gflops;          // somado entre as threads
+    double ghz;             // mediana das amostras de clock (média entre as threads)
+    double ghz_min;         // menor mediana entre as threads
+    double clock_pct;       // ghz / ghz da variante escalar na mesma fase
+    double speedup;         // gflops / gflops da variante escalar na mesma fase
+    DWORD  samples;
+} BenchLicensePhase;
+
+typedef struct {
+    bool              available;    // a CPU e o SO suportam a variante
+    BenchLicensePhase st, mt;
+} BenchLicenseVariant;
+
+typedef struct {
+    DWORD               threads;    // núcleos físicos na fase MT
+    double              idle_ghz;   // clock do núcleo mais rápido antes das cargas
+    BenchLicenseVariant v[BENCH_VEC_VARIANTS];
+    int                 best_st;    // variante de maior vazão em cada fase
+    int                 best_mt;
+    uint64_t            checksum;
+} BenchLicenseResult;
+
+// Carga de uma variante (NULL se inválida): y[i] = polinômio em x[i], com x
+// em [0,25, 0,75], vetores alinhados em 64 bytes e n múltiplo de 64
+typedef void (*BenchHornerFn)(const double *x, double *y, size_t n);
+BenchHornerFn bench_license_kernel(int variant);
+
+// Uma fase de uma variante, uma thread fixada em cada processador da lista, com
+// a mesma amostragem de clock da medição completa; false se a variante não for
+// suportada ou faltar memória. clock_pct e speedup ficam zerados
+bool bench_license_phase(int variant, const CpuLogical *const *cpus, DWORD count, double seconds,
+                         BenchLicensePhase *ph, uint64_t *checksum);
+
+// seconds = duração de cada variante em cada fase
+bool bench_license_run(double seconds, BenchLicenseResult *out, BenchProgressFn progress, void *ctx);
+
+const char *bench_vec_variant_name(int variant);
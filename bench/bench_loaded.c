@@ -0,0 +1,265 @@
+// bench_loaded.c - Latência de memória sob carga (curva latência x banda)
+// Os injetores são threads próprias (não o pool), que rodam sem parar entre os
+// degraus e só leem a espera atual da estrutura compartilhada; a thread
+// chamadora é a sonda. Cada injetor aloca e toca o seu bloco no nó medido e o
+// percorre de 4 KB em 4 KB com as cargas de bench_memory; entre dois blocos
+// espera delay pausas. A banda conta só os bytes dos injetores, não os da sonda.
+// Toda a memória é pedida sem cair para outro nó e conferida depois de tocada;
+// um nó que não comporta a cadeia e os blocos fica de fora (nskipped).
+#include "bench_loaded.h"
+#include "bench_latency.h"
+#include "bench_memory.h"
+#include "bench_pages.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_topology.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_BYTES  4096
+#define BLOCK_ELEMS  (BLOCK_BYTES / sizeof(double))
+#define SLICE_ALIGN  (64 * 1024)
+
+// Pausas entre blocos em cada degrau, da banda mais baixa à máxima; o custo de
+// uma pausa varia de ~10 a ~140 ciclos entre gerações, daí a faixa larga
+static const int step_delays[BENCH_LOADED_STEPS] = {
+    -1, 20000, 10000, 5000, 2500, 1200, 600, 300, 150, 80, 40, 20, 0
+};
+
+typedef struct {
+    BenchMemKernelFn fn;
+    bool             rw;            // triad: três regiões, 24 bytes por elemento
+    DWORD            node;
+    size_t           bytes;         // bloco de cada injetor
+    volatile LONG    ready;
+    volatile LONG    delay;         // -1 = parado
+    volatile LONG    stop;
+} LoadedShared;
+
+typedef struct {
+    LoadedShared      *sh;
+    const CpuLogical  *cpu;
+    volatile uint64_t  bytes;       // movidos até agora
+    double             sum;
+    bool               ok;
+    bool               off_node;    // bloco não coube no nó medido
+} LoadedThread;
+
+static DWORD WINAPI injector_thread(LPVOID param) {
+    LoadedThread *t = (LoadedThread*)param;
+    LoadedShared *sh = t->sh;
+    topology_pin_thread(GetCurrentThread(), t->cpu);
+
+    size_t page;
+    double *mem = (double*)bench_pages_alloc_node(sh->bytes, false, sh->node, &page);
+    size_t elems = sh->bytes / sizeof(double);
+    if (mem) for (size_t i = 0; i < elems; ++i) mem[i] = 1.0;
+    if (mem && !bench_pages_on_node(mem, sh->bytes, sh->node)) {
+        bench_pages_free(mem);
+        mem = NULL;
+    }
+    t->ok = mem != NULL;
+    t->off_node = mem == NULL;
+    InterlockedIncrement(&sh->ready);
+
+    // rw: a (escrita), b e c (leitura) em terços do bloco
+    size_t region = sh->rw ? elems / 3 / BLOCK_ELEMS * BLOCK_ELEMS : elems;
+    size_t moved = sh->rw ? 3 * BLOCK_BYTES : BLOCK_BYTES;
+    size_t pos = 0;
+    double sum = 0;
+    while (t->ok && !sh->stop) {
+        LONG delay = sh->delay;
+        if (delay < 0) { Sleep(1); continue; }
+        double *a = mem + pos;
+        sum += sh->fn(a, a + region, a + 2 * region, BLOCK_ELEMS);
+        t->bytes += moved;
+        pos += BLOCK_ELEMS;
+        if (pos >= region) pos = 0;
+        for (LONG d = 0; d < delay; ++d) YieldProcessor();
+    }
+    t->sum = sum;
+    if (mem) bench_pages_free(mem);
+    return 0;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+static uint64_t injected_bytes(const LoadedThread *t, DWORD n) {
+    uint64_t b = 0;
+    for (DWORD i = 0; i < n; ++i) b += t[i].bytes;
+    return b;
+}
+
+// Um degrau: amostras da sonda (ns por carga) e banda somada dos injetores
+static void measure_step(void **chain, LoadedThread *t, DWORD n, double *samples, BenchLoadedPoint *pt) {
+    double hz = bench_hz();
+    uint64_t t0 = bench_now(), b0 = injected_bytes(t, n);
+    uint64_t end = t0 + (uint64_t)(hz * BENCH_LOADED_STEP_MS / 1000.0);
+    DWORD count = 0;
+    void *p = *chain;
+    uint64_t now = t0;
+    while (now < end && count < BENCH_LOADED_SAMPLES) {
+        p = bench_chain_walk(p, BENCH_LOADED_LOADS);
+        uint64_t t1 = bench_now();
+        samples[count++] = (double)(t1 - now) * 1e9 / hz / BENCH_LOADED_LOADS;
+        now = t1;
+    }
+    uint64_t b1 = injected_bytes(t, n);
+    *chain = p;
+
+    double secs = (double)(now - t0) / hz;
+    pt->gbs = secs > 0 ? (double)(b1 - b0) / secs / 1e9 : 0;
+    pt->samples = count;
+    if (count == 0) return;
+    qsort(samples, count, sizeof(double), cmp_double);
+    pt->ns = samples[count / 2];
+    pt->p99_ns = samples[(DWORD)((count - 1) * 0.99)];
+}
+
+// false com *off_node = true se a memória da sonda ou de um injetor não coube no nó
+static bool run_node(BenchLoadedResult *out, BenchLoadedNode *nd, const CpuLogical *const *cores, DWORD ncores,
+                     size_t total, double *samples, DWORD *step, DWORD steps, BenchProgressFn progress, void *ctx,
+                     bool *off_node) {
+    *off_node = false;
+    // Sonda primeiro: a cadeia é montada antes de os injetores tocarem o nó
+    topology_pin_thread(GetCurrentThread(), cores[0]);
+    size_t page = 0;
+    void *buf = bench_pages_alloc_node(total, true, nd->node, &page);
+    if (!buf) { *off_node = true; return false; }
+    void *chain = bench_chain_build(buf, total, BENCH_LAT_LINE, 0x9E3779B97F4A7C15ull + nd->node);
+    if (!chain) { bench_pages_free(buf); return false; }
+    if (!bench_pages_on_node(buf, total, nd->node)) {
+        bench_pages_free(buf);
+        *off_node = true;
+        return false;
+    }
+    if (page > out->page_bytes) out->page_bytes = page;
+
+    DWORD n = ncores - 1;
+    nd->injectors = n;
+    static LoadedShared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.rw = out->mix == BENCH_LOADED_RW;
+    sh.fn = bench_memory_kernel(out->isa, sh.rw ? BENCH_MEM_TRIAD : BENCH_MEM_READ);
+    sh.node = nd->node;
+    sh.delay = -1;
+    if (n) {
+        sh.bytes = total / n;
+        sh.bytes = (sh.bytes + SLICE_ALIGN - 1) / SLICE_ALIGN * SLICE_ALIGN;
+    }
+    LoadedThread *t = (LoadedThread*)calloc(n ? n : 1, sizeof(LoadedThread));
+    HANDLE *h = (HANDLE*)calloc(n ? n : 1, sizeof(HANDLE));
+    bool ok = t && h && sh.fn;
+    DWORD started = 0;
+    for (DWORD i = 0; ok && i < n; ++i) {
+        t[i].sh = &sh;
+        t[i].cpu = cores[i + 1];
+        h[i] = CreateThread(NULL, 0, injector_thread, &t[i], 0, NULL);
+        if (!h[i]) { ok = false; break; }
+        started++;
+    }
+    while ((DWORD)sh.ready < started) Sleep(1);
+    for (DWORD i = 0; i < started; ++i) {
+        if (!t[i].ok) ok = false;
+        if (t[i].off_node) *off_node = true;
+    }
+
+    // Sem injetores só o degrau ocioso faz sentido
+    DWORD npoints = n ? BENCH_LOADED_STEPS : 1;
+    bench_chain_walk(chain, BENCH_LOADED_LOADS * 1024);     // aquecimento: TLB e clock
+    char stage[32];
+    for (DWORD s = 0; ok && s < npoints; ++s) {
+        snprintf(stage, sizeof(stage), "node %u step %u", nd->node, s);
+        if (progress) progress(ctx, stage, (int)(100 * (*step)++ / steps));
+        BenchLoadedPoint *pt = &nd->points[nd->npoints];
+        memset(pt, 0, sizeof(*pt));
+        pt->delay = step_delays[s];
+        InterlockedExchange(&sh.delay, step_delays[s]);
+        Sleep(BENCH_LOADED_WARM_MS);
+        measure_step(&chain, t, started, samples, pt);
+        if (pt->samples) nd->npoints++;
+    }
+    *step += BENCH_LOADED_STEPS - npoints;
+
+    InterlockedExchange(&sh.stop, 1);
+    // WaitForMultipleObjects para em 64 handles
+    for (DWORD i = 0; i < started; ++i) {
+        WaitForSingleObject(h[i], INFINITE);
+        CloseHandle(h[i]);
+        out->checksum += t[i].sum;
+    }
+    free(t);
+    free(h);
+    bench_pages_free(buf);
+
+    if (nd->npoints == 0) return false;
+    nd->idle_ns = nd->points[0].ns;
+    nd->idle_p99_ns = nd->points[0].p99_ns;
+    for (DWORD p = 1; p < nd->npoints; ++p)
+        if (nd->points[p].p99_ns > BENCH_LOADED_KNEE * nd->idle_p99_ns) {
+            nd->knee_gbs = nd->points[p].gbs;
+            nd->knee_found = true;
+            break;
+        }
+    return ok;
+}
+
+bool bench_loaded_run(BenchLoadedMix mix, BenchLoadedResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    out->mix = mix;
+    out->isa = bench_isa_best();
+    static MemNumaInfo info;
+    if (!get_numa_info(&info)) return false;
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+
+    // Cadeia e blocos dos injetores: 4x o L3 de um domínio, no mínimo BENCH_LOADED_MIN_MB
+    size_t total = (size_t)topo.l3_bytes * 4;
+    if (total < (size_t)BENCH_LOADED_MIN_MB << 20) total = (size_t)BENCH_LOADED_MIN_MB << 20;
+    out->chain_mb = (DWORD)(total >> 20);
+
+    double *samples = (double*)malloc(BENCH_LOADED_SAMPLES * sizeof(double));
+    if (!samples) return false;
+    DWORD steps = 0, step = 0;
+    for (DWORD c = 0; c < info.count; ++c)
+        if (info.has_cpus[c]) steps += BENCH_LOADED_STEPS;
+
+    bool ok = true;
+    for (DWORD c = 0; c < info.count; ++c) {
+        if (!info.has_cpus[c]) continue;
+        const CpuLogical *cores[CPU_TOPO_MAX];
+        DWORD n = 0;
+        for (DWORD i = 0; i < topo.count; ++i)
+            if (topo.cpus[i].smt == 0 && topo.cpus[i].node == info.node[c]) cores[n++] = &topo.cpus[i];
+        if (n == 0) { step += BENCH_LOADED_STEPS; continue; }
+        if (info.available[c] / 2 < (ULONGLONG)total * 2) {
+            out->skipped[out->nskipped++] = info.node[c];
+            step += BENCH_LOADED_STEPS;
+            continue;
+        }
+        BenchLoadedNode *nd = &out->nodes[out->nnodes];
+        memset(nd, 0, sizeof(*nd));
+        nd->node = info.node[c];
+        DWORD first_step = step;
+        bool off_node;
+        if (run_node(out, nd, cores, n, total, samples, &step, steps, progress, ctx, &off_node)) {
+            out->nnodes++;
+        } else if (off_node) {
+            out->skipped[out->nskipped++] = info.node[c];
+            step = first_step + BENCH_LOADED_STEPS;
+        } else {
+            ok = false;
+        }
+    }
+    free(samples);
+    if (progress) progress(ctx, "done", 100);
+
+    out->large_pages = out->page_bytes > 4096;
+    if (!out->large_pages) out->large_pages_reason = bench_large_pages_reason();
+    return ok && out->nnodes > 0;
+}
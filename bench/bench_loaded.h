@@ -0,0 +1,66 @@
+// bench_loaded.h - Latência de memória sob carga (curva latência x banda)
+// Em cada nó NUMA com CPUs, uma thread sonda fixada no primeiro núcleo físico
+// do nó percorre uma cadeia de ponteiros na memória do nó enquanto os outros
+// núcleos físicos do nó ("injetores") leem (ou leem e escrevem) blocos de 4 KB
+// da mesma memória com uma espera entre blocos. A espera começa longa e cai
+// até zero, então a banda injetada sobe em degraus; em cada degrau a sonda
+// registra a latência de grupos de cargas (mediana e p99) e os injetores
+// contam os bytes movidos. O ponto em que o p99 passa de
+// BENCH_LOADED_KNEE x o p99 ocioso marca a banda útil do nó.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "bench_common.h"
+#include "bench_isa.h"
+#include "../memory/memory_numa.h"
+
+#define BENCH_LOADED_STEPS      13          // degrau 0 = sem injetores
+#define BENCH_LOADED_STEP_MS    250         // medição de cada degrau
+#define BENCH_LOADED_WARM_MS    50          // injetores estabilizam antes de cada medição
+#define BENCH_LOADED_MIN_MB     64          // cadeia e soma dos blocos dos injetores
+#define BENCH_LOADED_LOADS      64          // cargas por amostra da sonda
+#define BENCH_LOADED_SAMPLES    8192        // amostras guardadas por degrau
+#define BENCH_LOADED_KNEE       2.0
+
+typedef enum {
+    BENCH_LOADED_READ = 0,                  // só leitura
+    BENCH_LOADED_RW                         // 2 leituras : 1 escrita (triad)
+} BenchLoadedMix;
+
+typedef struct {
+    int    delay;               // espera entre blocos de cada injetor (-1 = injetores parados)
+    double gbs;                 // banda dos injetores, somada
+    double ns;                  // mediana da latência da sonda
+    double p99_ns;
+    DWORD  samples;             // grupos de cargas medidos
+} BenchLoadedPoint;
+
+typedef struct {
+    USHORT           node;
+    DWORD            injectors;
+    BenchLoadedPoint points[BENCH_LOADED_STEPS];
+    DWORD            npoints;
+    double           idle_ns;       // mediana sem injetores
+    double           idle_p99_ns;
+    double           knee_gbs;  // banda do primeiro degrau com p99 acima do limite
+    bool             knee_found;    // false: o p99 não passou do limite nem na banda máxima
+} BenchLoadedNode;
+
+typedef struct {
+    BenchLoadedMix  mix;
+    BenchIsa        isa;
+    DWORD           nnodes;
+    BenchLoadedNode nodes[MEM_NUMA_MAX];
+    DWORD           nskipped;
+    USHORT          skipped[MEM_NUMA_MAX];  // nós sem memória livre para a medição ou com páginas em outro nó
+    DWORD           chain_mb;
+    bool            large_pages;
+    size_t          page_bytes;
+    const char     *large_pages_reason;     // se large_pages == false
+    double          checksum;
+} BenchLoadedResult;
+
+// Mede a curva de cada nó com CPUs; false se a topologia ou os nós não puderem ser lidos
+bool bench_loaded_run(BenchLoadedMix mix, BenchLoadedResult *out, BenchProgressFn progress, void *ctx);
@@ -0,0 +1,229 @@
+// bench_memory.c - Banda de memória no estilo STREAM
+// As cargas existem em uma versão por conjunto de instruções, geradas pela
+// mesma macro; cada thread percorre só o próprio pedaço dos vetores.
+#include "bench_memory.h"
+#include "bench_pool.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_topology.h"
+#include "../memory/memory_general.h"
+#include "../memory/memory_timings.h"
+
+#include <immintrin.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SLICE_ALIGN   (64 * 1024)   // pedaço de cada thread: múltiplo de 64 KB
+#define ARRAY_STAGGER 1024          // desloca b e c para não caírem no mesmo conjunto da cache que a
+
+static const char *const kernel_names[BENCH_MEM_KERNELS] = { "read", "write", "copy", "triad", "nt-write" };
+
+// Bytes contados por elemento, como no STREAM
+static const double bytes_per_elem[BENCH_MEM_KERNELS] = { 8, 8, 16, 24, 8 };
+
+const char *bench_memory_kernel_name(int kernel) {
+    return kernel >= 0 && kernel < BENCH_MEM_KERNELS ? kernel_names[kernel] : "?";
+}
+
+// n é múltiplo de 4 vetores; quatro acumuladores escondem a latência da soma
+#define MEM_KERNELS(sfx, target, VT, LANES, LOAD, STORE, STOREU, STREAM, ADD, MUL, SET1) \
+BENCH_TARGET(target) static double read_##sfx(double *a, double *b, double *c, size_t n) { \
+    (void)b; (void)c;                                                               \
+    VT s0 = SET1(0.0), s1 = s0, s2 = s0, s3 = s0;                                   \
+    for (size_t i = 0; i < n; i += 4 * LANES) {                                     \
+        s0 = ADD(s0, LOAD(a + i));                                                  \
+        s1 = ADD(s1, LOAD(a + i + LANES));                                          \
+        s2 = ADD(s2, LOAD(a + i + 2 * LANES));                                      \
+        s3 = ADD(s3, LOAD(a + i + 3 * LANES));                                      \
+    }                                                                               \
+    double tmp[LANES], sum = 0;                                                     \
+    STOREU(tmp, ADD(ADD(s0, s1), ADD(s2, s3)));                                     \
+    for (int l = 0; l < LANES; ++l) sum += tmp[l];                                  \
+    return sum;                                                                     \
+}                                                                                   \
+BENCH_TARGET(target) static double write_##sfx(double *a, double *b, double *c, size_t n) { \
+    (void)b; (void)c;                                                               \
+    VT v = SET1(1.0);                                                               \
+    for (size_t i = 0; i < n; i += 4 * LANES) {                                     \
+        STORE(a + i, v);                                                            \
+        STORE(a + i + LANES, v);                                                    \
+        STORE(a + i + 2 * LANES, v);                                                \
+        STORE(a + i + 3 * LANES, v);                                                \
+    }                                                                               \
+    return a[n - 1];                                                                \
+}                                                                                   \
+BENCH_TARGET(target) static double copy_##sfx(double *a, double *b, double *c, size_t n) { \
+    (void)b;                                                                        \
+    for (size_t i = 0; i < n; i += 4 * LANES) {                                     \
+        STORE(c + i, LOAD(a + i));                                                  \
+        STORE(c + i + LANES, LOAD(a + i + LANES));                                  \
+        STORE(c + i + 2 * LANES, LOAD(a + i + 2 * LANES));                          \
+        STORE(c + i + 3 * LANES, LOAD(a + i + 3 * LANES));                          \
+    }                                                                               \
+    return c[n - 1];                                                                \
+}                                                                                   \
+BENCH_TARGET(target) static double triad_##sfx(double *a, double *b, double *c, size_t n) { \
+    VT s = SET1(3.0);                                                               \
+    for (size_t i = 0; i < n; i += 4 * LANES) {                                     \
+        STORE(a + i, ADD(LOAD(b + i), MUL(s, LOAD(c + i))));                        \
+        STORE(a + i + LANES, ADD(LOAD(b + i + LANES), MUL(s, LOAD(c + i + LANES)))); \
+        STORE(a + i + 2 * LANES, ADD(LOAD(b + i + 2 * LANES), MUL(s, LOAD(c + i + 2 * LANES)))); \
+        STORE(a + i + 3 * LANES, ADD(LOAD(b + i + 3 * LANES), MUL(s, LOAD(c + i + 3 * LANES)))); \
+    }                                                                               \
+    return a[n - 1];                                                                \
+}                                                                                   \
+BENCH_TARGET(target) static double ntwrite_##sfx(double *a, double *b, double *c, size_t n) { \
+    (void)b; (void)c;                                                               \
+    VT v = SET1(1.0);                                                               \
+    for (size_t i = 0; i < n; i += 4 * LANES) {                                     \
+        STREAM(a + i, v);                                                           \
+        STREAM(a + i + LANES, v);                                                   \
+        STREAM(a + i + 2 * LANES, v);                                               \
+        STREAM(a + i + 3 * LANES, v);                                               \
+    }                                                                               \
+    _mm_sfence();                                                                   \
+    return a[n - 1];                                                                \
+}
+
+MEM_KERNELS(sse2, "sse2", __m128d, 2, _mm_load_pd, _mm_store_pd, _mm_storeu_pd,
+            _mm_stream_pd, _mm_add_pd, _mm_mul_pd, _mm_set1_pd)
+MEM_KERNELS(avx2, "avx2", __m256d, 4, _mm256_load_pd, _mm256_store_pd, _mm256_storeu_pd,
+            _mm256_stream_pd, _mm256_add_pd, _mm256_mul_pd, _mm256_set1_pd)
+MEM_KERNELS(avx512, "avx512f", __m512d, 8, _mm512_load_pd, _mm512_store_pd, _mm512_storeu_pd,
+            _mm512_stream_pd, _mm512_add_pd, _mm512_mul_pd, _mm512_set1_pd)
+
+static const BenchMemKernelFn kernels[BENCH_ISA_COUNT][BENCH_MEM_KERNELS] = {
+    { read_sse2,   write_sse2,   copy_sse2,   triad_sse2,   ntwrite_sse2 },
+    { read_avx2,   write_avx2,   copy_avx2,   triad_avx2,   ntwrite_avx2 },
+    { read_avx512, write_avx512, copy_avx512, triad_avx512, ntwrite_avx512 },
+};
+
+BenchMemKernelFn bench_memory_kernel(BenchIsa isa, int kernel) {
+    if ((unsigned)isa >= BENCH_ISA_COUNT || kernel < 0 || kernel >= BENCH_MEM_KERNELS) return NULL;
+    return kernels[isa][kernel];
+}
+
+// Pedaço de uma thread: a, b e c num único bloco alocado no nó dela
+typedef struct {
+    void   *base;
+    double *a, *b, *c;
+    double  sum;
+} MemSlice;
+
+typedef struct {
+    BenchPool  *pool;
+    MemSlice    slices[BENCH_POOL_MAX];
+    size_t      bytes;          // por vetor, por thread
+    BenchMemKernelFn fn;
+} MemJob;
+
+// Roda em cada thread: aloca no nó NUMA do processador e toca as páginas
+static void job_alloc(void *ctx, DWORD index) {
+    MemJob *j = (MemJob*)ctx;
+    MemSlice *s = &j->slices[index];
+    SIZE_T total = 3 * j->bytes + 2 * ARRAY_STAGGER;
+    s->base = VirtualAllocExNuma(GetCurrentProcess(), NULL, total, MEM_RESERVE | MEM_COMMIT,
+                                 PAGE_READWRITE, j->pool->cpus[index]->node);
+    if (!s->base) s->base = VirtualAlloc(NULL, total, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!s->base) return;
+    s->a = (double*)s->base;
+    s->b = (double*)((char*)s->base + j->bytes + ARRAY_STAGGER);
+    s->c = (double*)((char*)s->base + 2 * j->bytes + 2 * ARRAY_STAGGER);
+    size_t n = j->bytes / sizeof(double);
+    for (size_t i = 0; i < n; ++i) {
+        s->a[i] = 1.0;
+        s->b[i] = 2.0;
+        s->c[i] = 0.5;
+    }
+}
+
+static void job_kernel(void *ctx, DWORD index) {
+    MemJob *j = (MemJob*)ctx;
+    MemSlice *s = &j->slices[index];
+    s->sum += j->fn(s->a, s->b, s->c, j->bytes / sizeof(double));
+}
+
+// Pico teórico: MT/s x canais x largura. O WMI informa módulos, não canais;
+// assume-se um módulo por canal (com dois por canal o pico sai em dobro).
+static void dram_peak(BenchMemResult *out) {
+    char buf[64];
+    double mhz = 0;
+    unsigned n = 0, w = 0;
+    if (get_dram_frequency(buf, sizeof(buf)) && sscanf(buf, "%lf", &mhz) == 1)
+        out->dram_mts = (DWORD)(2.0 * mhz + 0.5);
+    if (get_memory_channels(buf, sizeof(buf)) && sscanf(buf, "%u x %u-bit", &n, &w) == 2) {
+        out->channels = n;
+        out->width_bits = w;
+    }
+    if (out->dram_mts && out->channels && out->width_bits)
+        out->peak_gbs = out->dram_mts * 1e6 * out->channels * (out->width_bits / 8.0) / 1e9;
+}
+
+bool bench_memory_run(int isa, BenchMemResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (isa < 0) isa = bench_isa_best();
+    if (isa >= BENCH_ISA_COUNT || !bench_isa_supported((BenchIsa)isa)) return false;
+    out->isa = (BenchIsa)isa;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *cores[CPU_TOPO_MAX];
+    DWORD nthreads = 0;
+    for (DWORD i = 0; i < topo.count; ++i)
+        if (topo.cpus[i].smt == 0) cores[nthreads++] = &topo.cpus[i];
+    out->threads = nthreads;
+    out->nodes = topo.nnodes ? topo.nnodes : 1;
+
+    // Cada vetor: 4x o L3 total, no mínimo BENCH_MEM_MIN_MB, até 1/6 da memória livre
+    unsigned long long array = (unsigned long long)topo.l3_bytes * (topo.nl3 ? topo.nl3 : 1) * 4;
+    if (array < (unsigned long long)BENCH_MEM_MIN_MB << 20) array = (unsigned long long)BENCH_MEM_MIN_MB << 20;
+    MEMORYSTATUSEX ms;
+    ms.dwLength = sizeof(ms);
+    if (GlobalMemoryStatusEx(&ms) && array > ms.ullAvailPhys / 6) array = ms.ullAvailPhys / 6;
+    size_t slice = (size_t)(array / nthreads);
+    slice = (slice + SLICE_ALIGN - 1) / SLICE_ALIGN * SLICE_ALIGN;
+    if (slice < SLICE_ALIGN) slice = SLICE_ALIGN;
+    out->array_mb = (DWORD)(((unsigned long long)slice * nthreads) >> 20);
+
+    static MemJob job;
+    static BenchPool pool;
+    memset(&job, 0, sizeof(job));
+    job.pool = &pool;
+    job.bytes = slice;
+    if (!bench_pool_start(&pool, cores, nthreads)) return false;
+
+    char stage[32];
+    int steps = BENCH_MEM_KERNELS + 1, step = 0;
+    if (progress) progress(ctx, "alloc", 100 * step++ / steps);
+    bench_pool_run(&pool, job_alloc, &job);
+    bool ok = true;
+    for (DWORD i = 0; i < nthreads; ++i) if (!job.slices[i].base) ok = false;
+
+    for (int k = 0; ok && k < BENCH_MEM_KERNELS; ++k) {
+        snprintf(stage, sizeof(stage), "%s %s", kernel_names[k], bench_isa_name(out->isa));
+        if (progress) progress(ctx, stage, 100 * step++ / steps);
+        job.fn = kernels[isa][k];
+        bench_pool_run(&pool, job_kernel, &job);        // aquecimento (TLB, clock)
+        uint64_t best = 0;
+        for (int r = 0; r < BENCH_MEM_REPS; ++r) {
+            uint64_t t = bench_pool_run(&pool, job_kernel, &job);
+            if (best == 0 || t < best) best = t;
+        }
+        double secs = (double)best / bench_hz();
+        double elems = (double)(slice / sizeof(double)) * nthreads;
+        if (secs > 0) out->gbs[k] = elems * bytes_per_elem[k] / secs / 1e9;
+    }
+    if (progress) progress(ctx, "done", 100);
+
+    bench_pool_stop(&pool);
+    for (DWORD i = 0; i < nthreads; ++i) {
+        out->checksum += job.slices[i].sum;
+        if (job.slices[i].base) VirtualFree(job.slices[i].base, 0, MEM_RELEASE);
+    }
+    if (!ok) return false;
+
+    dram_peak(out);
+    for (int k = 0; k < BENCH_MEM_KERNELS; ++k)
+        if (out->peak_gbs > 0) out->pct_peak[k] = 100.0 * out->gbs[k] / out->peak_gbs;
+    return true;
+}
@@ -0,0 +1,51 @@
+// bench_memory.h - Banda de memória no estilo STREAM
+// Cargas de leitura, escrita, cópia, triad (a = b + s*c) e escrita
+// não-temporal (sem ler a linha antes), em SSE2, AVX2 ou AVX-512 conforme a
+// CPU. Uma thread fixada por núcleo físico; cada thread aloca e toca primeiro
+// o seu pedaço dos vetores no próprio nó NUMA. Os vetores têm pelo menos 4x o
+// L3 total, então a medição é da DRAM. Bytes por elemento seguem o STREAM
+// (a leitura da linha antes da escrita não conta).
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "bench_common.h"
+#include "bench_isa.h"
+
+#define BENCH_MEM_REPS       5       // melhor de N repetições por carga
+#define BENCH_MEM_MIN_MB     64      // tamanho mínimo de cada vetor
+
+enum {
+    BENCH_MEM_READ = 0,
+    BENCH_MEM_WRITE,
+    BENCH_MEM_COPY,
+    BENCH_MEM_TRIAD,
+    BENCH_MEM_NT_WRITE,
+    BENCH_MEM_KERNELS
+};
+
+typedef struct {
+    BenchIsa isa;
+    DWORD    threads;
+    DWORD    nodes;
+    DWORD    array_mb;                      // tamanho de cada vetor (soma das threads)
+    double   gbs[BENCH_MEM_KERNELS];        // GB/s (10^9 bytes)
+    double   pct_peak[BENCH_MEM_KERNELS];   // % do pico teórico (0 se desconhecido)
+    double   peak_gbs;                      // MT/s x canais x largura
+    DWORD    dram_mts;
+    DWORD    channels;
+    DWORD    width_bits;
+    double   checksum;
+} BenchMemResult;
+
+// Roda todas as cargas com o conjunto de instruções indicado (-1 = o melhor
+// disponível); false se o conjunto não for suportado ou faltar memória
+bool bench_memory_run(int isa, BenchMemResult *out, BenchProgressFn progress, void *ctx);
+
+const char *bench_memory_kernel_name(int kernel);
+
+// Uma carga isolada, para outros benchmarks: a, b e c com n doubles cada,
+// alinhados a 64 bytes, n múltiplo de 32. Retorna um valor que depende da carga.
+typedef double (*BenchMemKernelFn)(double *a, double *b, double *c, size_t n);
+BenchMemKernelFn bench_memory_kernel(BenchIsa isa, int kernel);
@@ -0,0 +1,161 @@
+// bench_numa.c - Banda e latência entre nós NUMA
+// A memória de cada par é pedida com VirtualAllocExNuma no nó da memória, que
+// vale também quando as páginas são tocadas primeiro por threads de outro nó.
+// Sem cair para outro nó: se o pedido falhar, se o nó não tiver folga ou se
+// as páginas tocadas não estiverem nele, o par fica sem medição ("-").
+#include "bench_numa.h"
+#include "bench_latency.h"
+#include "bench_memory.h"
+#include "bench_pages.h"
+#include "bench_pool.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_topology.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SLICE_ALIGN (64 * 1024)
+
+typedef struct {
+    BenchPool       *pool;
+    DWORD            mem_node;
+    size_t           bytes;         // por thread
+    void            *slices[BENCH_POOL_MAX];
+    double           sum[BENCH_POOL_MAX];
+    BenchMemKernelFn fn;
+} NumaJob;
+
+static void job_alloc(void *ctx, DWORD index) {
+    NumaJob *j = (NumaJob*)ctx;
+    size_t page;
+    double *a = (double*)bench_pages_alloc_node(j->bytes, false, j->mem_node, &page);
+    j->slices[index] = a;
+    if (!a) return;
+    size_t n = j->bytes / sizeof(double);
+    for (size_t i = 0; i < n; ++i) a[i] = 1.0;
+    if (!bench_pages_on_node(a, j->bytes, j->mem_node)) {
+        bench_pages_free(a);
+        j->slices[index] = NULL;
+    }
+}
+
+static void job_read(void *ctx, DWORD index) {
+    NumaJob *j = (NumaJob*)ctx;
+    double *a = (double*)j->slices[index];
+    j->sum[index] += j->fn(a, a, a, j->bytes / sizeof(double));
+}
+
+static void job_free(void *ctx, DWORD index) {
+    NumaJob *j = (NumaJob*)ctx;
+    if (j->slices[index]) bench_pages_free(j->slices[index]);
+    j->slices[index] = NULL;
+}
+
+// Banda de leitura do pool (núcleos de um nó) na memória de mem_node; 0 se faltar memória
+static double measure_read(NumaJob *j, BenchPool *pool) {
+    bench_pool_run(pool, job_alloc, j);
+    bool ok = true;
+    for (DWORD i = 0; i < pool->count; ++i) if (!j->slices[i]) ok = false;
+    uint64_t best = 0;
+    if (ok) {
+        bench_pool_run(pool, job_read, j);              // aquecimento (TLB, clock)
+        for (int r = 0; r < BENCH_NUMA_REPS; ++r) {
+            uint64_t t = bench_pool_run(pool, job_read, j);
+            if (best == 0 || t < best) best = t;
+        }
+    }
+    bench_pool_run(pool, job_free, j);
+    if (!best) return 0;
+    double secs = (double)best / bench_hz();
+    return (double)j->bytes * pool->count / secs / 1e9;
+}
+
+// Latência ociosa da thread atual (já fixada) até a memória de mem_node; 0 se
+// faltar memória no nó ou se as páginas ficarem em outro
+static double measure_latency(BenchNumaResult *out, size_t bytes, DWORD mem_node, uint64_t seed) {
+    size_t page = 0;
+    void *buf = bench_pages_alloc_node(bytes, true, mem_node, &page);
+    if (!buf) return 0;
+    if (page > out->page_bytes) out->page_bytes = page;
+    double ns = 0;
+    void *start = bench_chain_build(buf, bytes, BENCH_LAT_LINE, seed);
+    if (start && bench_pages_on_node(buf, bytes, mem_node)) ns = bench_chain_ticks(start, BENCH_NUMA_LOADS, BENCH_NUMA_REPS) * 1e9 / bench_hz();
+    bench_pages_free(buf);
+    return ns;
+}
+
+bool bench_numa_run(BenchNumaResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (!get_numa_info(&out->info)) return false;
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    out->isa = bench_isa_best();
+    static NumaJob job;
+    memset(&job, 0, sizeof(job));
+    job.fn = bench_memory_kernel(out->isa, BENCH_MEM_READ);
+    if (!job.fn) return false;
+
+    // Vetores e cadeia: 4x o L3 de um domínio, no mínimo BENCH_NUMA_MIN_MB
+    size_t total = (size_t)topo.l3_bytes * 4;
+    if (total < (size_t)BENCH_NUMA_MIN_MB << 20) total = (size_t)BENCH_NUMA_MIN_MB << 20;
+    out->chain_mb = (DWORD)(total >> 20);
+
+    const MemNumaInfo *info = &out->info;
+    DWORD steps = 0, step = 0;
+    for (DWORD c = 0; c < info->count; ++c)
+        if (info->has_cpus[c]) steps += 2 * info->count;
+
+    char stage[32];
+    static BenchPool pool;
+    // A latência fixa a chamadora num núcleo do nó; antes do pool ela volta à
+    // afinidade original, para não disputar o núcleo com a thread 0
+    HANDLE self = GetCurrentThread();
+    GROUP_AFFINITY old;
+    bool restore = GetThreadGroupAffinity(self, &old) != FALSE;
+    for (DWORD c = 0; c < info->count; ++c) {
+        if (!info->has_cpus[c]) continue;
+        const CpuLogical *cores[CPU_TOPO_MAX];
+        DWORD n = 0;
+        for (DWORD i = 0; i < topo.count; ++i)
+            if (topo.cpus[i].smt == 0 && topo.cpus[i].node == info->node[c]) cores[n++] = &topo.cpus[i];
+        if (n == 0) { step += 2 * info->count; continue; }
+        out->threads[c] = n;
+
+        // Latência primeiro, com o pool parado para não disputar o nó
+        topology_pin_thread(GetCurrentThread(), cores[0]);
+        for (DWORD m = 0; m < info->count; ++m, ++step) {
+            if (!info->available[m]) continue;
+            // Mesma folga da banda: com o nó quase cheio a cadeia iria para outro
+            if (info->available[m] / 2 < (ULONGLONG)total) { out->skipped++; continue; }
+            snprintf(stage, sizeof(stage), "lat %u->%u", info->node[c], info->node[m]);
+            if (progress) progress(ctx, stage, (int)(100 * step / steps));
+            out->ns[c][m] = measure_latency(out, total, info->node[m], 0x9E3779B97F4A7C15ull + c * MEM_NUMA_MAX + m);
+            if (out->ns[c][m] <= 0) out->skipped++;
+        }
+        if (restore) SetThreadGroupAffinity(self, &old, NULL);
+
+        size_t slice = total / n;
+        slice = (slice + SLICE_ALIGN - 1) / SLICE_ALIGN * SLICE_ALIGN;
+        job.bytes = slice;
+        job.pool = &pool;
+        out->array_mb = (DWORD)(((unsigned long long)slice * n) >> 20);
+        if (!bench_pool_start(&pool, cores, n)) return false;
+        for (DWORD m = 0; m < info->count; ++m, ++step) {
+            if (!info->available[m]) continue;
+            if (info->available[m] / 2 < (ULONGLONG)slice * n) { out->skipped++; continue; }
+            snprintf(stage, sizeof(stage), "read %u->%u", info->node[c], info->node[m]);
+            if (progress) progress(ctx, stage, (int)(100 * step / steps));
+            job.mem_node = info->node[m];
+            out->gbs[c][m] = measure_read(&job, &pool);
+            if (out->gbs[c][m] <= 0) out->skipped++;
+        }
+        bench_pool_stop(&pool);
+    }
+    if (progress) progress(ctx, "done", 100);
+
+    for (DWORD i = 0; i < BENCH_POOL_MAX; ++i) out->checksum += job.sum[i];
+    out->large_pages = out->page_bytes > 4096;
+    if (!out->large_pages) out->large_pages_reason = bench_large_pages_reason();
+    return true;
+}
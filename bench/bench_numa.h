@@ -0,0 +1,36 @@
+// bench_numa.h - Banda e latência entre nós NUMA
+// Para cada par (nó da CPU, nó da memória): banda de leitura com uma thread
+// por núcleo físico do nó da CPU lendo vetores alocados no nó da memória, e
+// latência ociosa (cadeia de ponteiros) de um núcleo do nó da CPU até a
+// memória do outro nó. As matrizes usam as mesmas posições de MemNumaInfo,
+// para serem mostradas ao lado das distâncias da SLIT.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "bench_common.h"
+#include "bench_isa.h"
+#include "../memory/memory_numa.h"
+
+#define BENCH_NUMA_REPS      3       // melhor de N leituras por par
+#define BENCH_NUMA_MIN_MB    64      // tamanho mínimo dos vetores e da cadeia
+#define BENCH_NUMA_LOADS     (1u << 20)
+
+typedef struct {
+    MemNumaInfo info;
+    BenchIsa    isa;
+    DWORD       threads[MEM_NUMA_MAX];                  // núcleos usados por nó de CPU (0 = nó sem CPU)
+    double      gbs[MEM_NUMA_MAX][MEM_NUMA_MAX];        // [nó da CPU][nó da memória], 0 = não medido
+    double      ns[MEM_NUMA_MAX][MEM_NUMA_MAX];
+    DWORD       array_mb;                               // vetor lido em cada par (soma das threads)
+    DWORD       chain_mb;                               // cadeia da latência
+    DWORD       skipped;                                // pares sem folga no nó ou com páginas fora dele
+    bool        large_pages;
+    size_t      page_bytes;
+    const char *large_pages_reason;                     // se large_pages == false
+    double      checksum;
+} BenchNumaResult;
+
+// Mede todos os pares; false se a topologia ou os nós não puderem ser lidos
+bool bench_numa_run(BenchNumaResult *out, BenchProgressFn progress, void *ctx);
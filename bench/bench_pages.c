@@ -0,0 +1,178 @@
+// bench_pages.c - Alocação dos buffers dos benchmarks (páginas grandes e nó NUMA)
+#include "bench_pages.h"
+#include "../cpu/cpu_features.h"
+
+#include <psapi.h>
+
+#define HUGE_PAGE_BYTES ((size_t)1 << 30)
+#define NODE_SAMPLES    64      // páginas conferidas por bench_pages_on_node
+
+// MEM_EXTENDED_PARAMETER com o tipo nos 8 bits baixos da primeira palavra
+typedef struct {
+    DWORD64 type;
+    DWORD64 value;
+} ExtParam;
+
+// Valores de MEM_EXTENDED_PARAMETER_TYPE (o 1 é AddressRequirements, que espera ponteiro)
+#define EXT_PARAM_NUMA_NODE   2     // MemExtendedParameterNumaNode
+#define EXT_PARAM_ATTRIBUTES  5     // MemExtendedParameterAttributeFlags
+#define EXT_ATTR_NONPAGED_HUGE 0x10
+
+typedef PVOID (WINAPI *VirtualAlloc2Fn)(HANDLE, PVOID, SIZE_T, ULONG, ULONG, ExtParam*, ULONG);
+
+static struct {
+    bool        ok;
+    size_t      size;
+    const char *reason;
+} g_large;
+
+static INIT_ONCE g_large_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK large_init(PINIT_ONCE once, PVOID param, PVOID *ctx) {
+    (void)once; (void)param; (void)ctx;
+    g_large.size = GetLargePageMinimum();
+    if (g_large.size == 0) {
+        g_large.reason = "processador sem paginas grandes";
+        return TRUE;
+    }
+    HANDLE token;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+        g_large.reason = "token do processo inacessivel";
+        return TRUE;
+    }
+    TOKEN_PRIVILEGES tp;
+    tp.PrivilegeCount = 1;
+    tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    if (!LookupPrivilegeValueW(NULL, SE_LOCK_MEMORY_NAME, &tp.Privileges[0].Luid)) {
+        g_large.reason = "privilegio SeLockMemoryPrivilege desconhecido";
+    } else if (!AdjustTokenPrivileges(token, FALSE, &tp, 0, NULL, NULL) ||
+               GetLastError() == ERROR_NOT_ALL_ASSIGNED) {
+        // AdjustTokenPrivileges "funciona" mesmo sem o privilégio concedido
+        g_large.reason = "sem o direito 'Bloquear paginas na memoria' (secpol.msc)";
+    } else {
+        g_large.ok = true;
+    }
+    CloseHandle(token);
+    return TRUE;
+}
+
+bool bench_large_pages_available(void) {
+    InitOnceExecuteOnce(&g_large_once, large_init, NULL, NULL);
+    return g_large.ok;
+}
+
+const char *bench_large_pages_reason(void) {
+    if (bench_large_pages_available()) return "";
+    return g_large.reason ? g_large.reason : "indisponivel";
+}
+
+size_t bench_large_page_size(void) {
+    return bench_large_pages_available() ? g_large.size : 0;
+}
+
+static void *alloc_on(size_t bytes, DWORD flags, DWORD node) {
+    if (node == BENCH_NODE_ANY)
+        return VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT | flags, PAGE_READWRITE);
+    return VirtualAllocExNuma(GetCurrentProcess(), NULL, bytes, MEM_RESERVE | MEM_COMMIT | flags,
+                              PAGE_READWRITE, node);
+}
+
+static void *alloc_pages(size_t bytes, bool large, DWORD node, bool any_node, size_t *page_bytes) {
+    void *p = NULL;
+    if (large && bench_large_pages_available()) {
+        size_t lp = g_large.size;
+        p = alloc_on((bytes + lp - 1) / lp * lp, MEM_LARGE_PAGES, node);
+        if (p) {
+            if (page_bytes) *page_bytes = lp;
+            return p;
+        }
+    }
+    p = alloc_on(bytes, 0, node);
+    // Nó inválido ou sem memória livre nele: qualquer nó
+    if (!p && node != BENCH_NODE_ANY && any_node) p = alloc_on(bytes, 0, BENCH_NODE_ANY);
+    if (p && page_bytes) {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        *page_bytes = si.dwPageSize;
+    }
+    return p;
+}
+
+void *bench_pages_alloc(size_t bytes, bool large, DWORD node, size_t *page_bytes) {
+    return alloc_pages(bytes, large, node, true, page_bytes);
+}
+
+void *bench_pages_alloc_node(size_t bytes, bool large, DWORD node, size_t *page_bytes) {
+    return alloc_pages(bytes, large, node, false, page_bytes);
+}
+
+bool bench_pages_on_node(const void *p, size_t bytes, DWORD node) {
+    if (!p || node == BENCH_NODE_ANY) return p != NULL;
+    PSAPI_WORKING_SET_EX_INFORMATION ws[NODE_SAMPLES];
+    size_t step = bytes / NODE_SAMPLES;
+    if (step == 0) step = 1;
+    DWORD n = 0;
+    for (size_t off = 0; off < bytes && n < NODE_SAMPLES; off += step)
+        ws[n++].VirtualAddress = (PVOID)((const char*)p + off);
+    if (!QueryWorkingSetEx(GetCurrentProcess(), ws, n * sizeof(ws[0]))) return false;
+    DWORD resident = 0;
+    for (DWORD i = 0; i < n; ++i) {
+        if (!ws[i].VirtualAttributes.Valid) continue;   // fora do working set: sem nó
+        if (ws[i].VirtualAttributes.Node != node) return false;
+        resident++;
+    }
+    return resident > 0;
+}
+
+static struct {
+    VirtualAlloc2Fn alloc2;
+    const char     *reason;
+} g_huge;
+
+static INIT_ONCE g_huge_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK huge_init(PINIT_ONCE once, PVOID param, PVOID *ctx) {
+    (void)once; (void)param; (void)ctx;
+    if (!cpu_has(CPU_FEAT_PDPE1GB)) {
+        g_huge.reason = "processador sem paginas de 1 GB";
+        return TRUE;
+    }
+    if (!bench_large_pages_available()) {
+        g_huge.reason = bench_large_pages_reason();
+        return TRUE;
+    }
+    HMODULE k = GetModuleHandleW(L"kernelbase.dll");
+    if (k) g_huge.alloc2 = (VirtualAlloc2Fn)GetProcAddress(k, "VirtualAlloc2");
+    if (!g_huge.alloc2) g_huge.reason = "VirtualAlloc2 indisponivel (Windows 10 1803 ou mais novo)";
+    return TRUE;
+}
+
+size_t bench_huge_page_size(void) {
+    InitOnceExecuteOnce(&g_huge_once, huge_init, NULL, NULL);
+    return g_huge.alloc2 ? HUGE_PAGE_BYTES : 0;
+}
+
+const char *bench_huge_pages_reason(void) {
+    if (bench_huge_page_size()) return "";
+    return g_huge.reason ? g_huge.reason : "indisponivel";
+}
+
+void *bench_pages_alloc_huge(size_t bytes, DWORD node) {
+    if (!bench_huge_page_size()) return NULL;
+    ExtParam params[2];
+    ULONG count = 1;
+    params[0].type = EXT_PARAM_ATTRIBUTES;
+    params[0].value = EXT_ATTR_NONPAGED_HUGE;
+    if (node != BENCH_NODE_ANY) {
+        params[1].type = EXT_PARAM_NUMA_NODE;
+        params[1].value = node;
+        count = 2;
+    }
+    bytes = (bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+    return g_huge.alloc2(GetCurrentProcess(), NULL, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                         PAGE_READWRITE, params, count);
+}
+
+void bench_pages_free(void *p) {
+    if (p) VirtualFree(p, 0, MEM_RELEASE);
+}
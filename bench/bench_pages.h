@@ -0,0 +1,45 @@
+// bench_pages.h - Alocação dos buffers dos benchmarks (páginas grandes e nó NUMA)
+// Páginas grandes no Windows exigem o privilégio "Bloquear páginas na memória"
+// (SeLockMemoryPrivilege) concedido ao usuário pela política local; o programa
+// só consegue habilitá-lo no token se ele já tiver sido concedido. Sem ele,
+// ou sem memória contígua livre, a alocação cai para páginas de 4 KB.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define BENCH_NODE_ANY ((DWORD)-1)
+
+// true se páginas grandes podem ser pedidas (privilégio habilitado na primeira chamada)
+bool bench_large_pages_available(void);
+
+// Motivo da indisponibilidade (texto curto, para exibição)
+const char *bench_large_pages_reason(void);
+
+// Tamanho de uma página grande (0 se indisponível)
+size_t bench_large_page_size(void);
+
+// Aloca bytes (zerados) no nó indicado; com large = true tenta páginas grandes
+// antes das normais. *page_bytes recebe o tamanho de página obtido.
+void *bench_pages_alloc(size_t bytes, bool large, DWORD node, size_t *page_bytes);
+
+// Como bench_pages_alloc, mas sem cair para outro nó: NULL se o pedido no nó
+// falhar (para medições que rotulam o resultado com o nó da memória)
+void *bench_pages_alloc_node(size_t bytes, bool large, DWORD node, size_t *page_bytes);
+
+// O nó pedido na alocação é só preferência: confere (QueryWorkingSetEx) se as
+// páginas já tocadas de uma amostra do bloco estão em node; false se alguma
+// estiver em outro nó ou se não der para conferir
+bool bench_pages_on_node(const void *p, size_t bytes, DWORD node);
+
+// Páginas de 1 GB: VirtualAlloc2 (Windows 10 1803+) com o atributo
+// MEM_EXTENDED_PARAMETER_NONPAGED_HUGE; exigem o mesmo privilégio das páginas
+// grandes e CPU com páginas de 1 GB. 0 se indisponível.
+size_t bench_huge_page_size(void);
+const char *bench_huge_pages_reason(void);
+
+// Aloca bytes (arredondados para 1 GB) em páginas de 1 GB; NULL se não houver
+// memória física contígua livre ou se indisponível
+void *bench_pages_alloc_huge(size_t bytes, DWORD node);
+
+void bench_pages_free(void *p);
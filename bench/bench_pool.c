@@ -0,0 +1,81 @@
+// bench_pool.c - Threads de medição fixadas, reutilizadas entre rodadas
+// Entre rodadas cada thread gira SPIN_BEFORE_SLEEP vezes (largada precisa
+// quando as rodadas vêm em sequência) e depois bloqueia em WaitOnAddress sobre
+// generation, sem ocupar o núcleo; bench_pool_run e bench_pool_stop acordam
+// todas com WakeByAddressAll. A chamadora também espera bloqueada em done: ela
+// pode estar no mesmo processador de uma das threads, e o tempo da rodada vem
+// do fim de cada thread, não de quando a chamadora acorda.
+#include "bench_pool.h"
+#include "bench_timer.h"
+
+#include <string.h>
+
+#define SPIN_BEFORE_SLEEP 200000
+
+static DWORD WINAPI pool_thread(LPVOID param) {
+    BenchPoolSlot *s = (BenchPoolSlot*)param;
+    BenchPool *p = s->pool;
+    topology_pin_thread(GetCurrentThread(), p->cpus[s->index]);
+    LONG seen = 0;
+    for (;;) {
+        // Gira um pouco (largada precisa), depois dorme até a próxima rodada
+        unsigned spins = 0;
+        while (p->generation == seen && !p->quit) {
+            if (++spins < SPIN_BEFORE_SLEEP) YieldProcessor();
+            else WaitOnAddress(&p->generation, &seen, sizeof(seen), INFINITE);
+        }
+        if (p->quit) break;
+        seen = p->generation;
+        p->fn(p->ctx, s->index);
+        s->end = bench_now();
+        if ((DWORD)InterlockedIncrement(&p->done) == p->count) WakeByAddressAll((PVOID)&p->done);
+    }
+    return 0;
+}
+
+bool bench_pool_start(BenchPool *p, const CpuLogical *const *cpus, DWORD count) {
+    memset(p, 0, sizeof(*p));
+    if (count == 0 || count > BENCH_POOL_MAX) return false;
+    for (DWORD i = 0; i < count; ++i) {
+        p->cpus[i] = cpus[i];
+        p->slots[i].pool = p;
+        p->slots[i].index = i;
+        p->threads[i] = CreateThread(NULL, 0, pool_thread, &p->slots[i], 0, NULL);
+        if (!p->threads[i]) {
+            bench_pool_stop(p);
+            return false;
+        }
+        p->count++;
+    }
+    return true;
+}
+
+uint64_t bench_pool_run(BenchPool *p, BenchJobFn fn, void *ctx) {
+    p->fn = fn;
+    p->ctx = ctx;
+    p->done = 0;
+    MemoryBarrier();
+    uint64_t start = bench_now();
+    InterlockedIncrement(&p->generation);
+    WakeByAddressAll((PVOID)&p->generation);
+    LONG done;
+    while ((DWORD)(done = p->done) < p->count) WaitOnAddress(&p->done, &done, sizeof(done), INFINITE);
+
+    uint64_t last = start;
+    for (DWORD i = 0; i < p->count; ++i)
+        if (p->slots[i].end > last) last = p->slots[i].end;
+    return last - start;
+}
+
+void bench_pool_stop(BenchPool *p) {
+    InterlockedExchange(&p->quit, 1);
+    // Muda generation para que nenhuma thread volte a dormir depois de olhar quit
+    InterlockedIncrement(&p->generation);
+    WakeByAddressAll((PVOID)&p->generation);
+    // WaitForMultipleObjects para em 64 handles
+    for (DWORD i = 0; i < p->count; ++i) {
+        WaitForSingleObject(p->threads[i], INFINITE);
+        CloseHandle(p->threads[i]);
+    }
+    p->count = 0;
+}
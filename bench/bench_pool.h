@@ -0,0 +1,45 @@
+// bench_pool.h - Threads de medição fixadas, reutilizadas entre rodadas
+// Cada thread fica presa a um processador lógico durante toda a vida do pool,
+// então a memória que ela toca primeiro (first-touch) fica no nó NUMA dela.
+// bench_pool_run solta todas as threads ao mesmo tempo e mede até a última
+// terminar, com a chamadora bloqueada; entre rodadas as threads esperam
+// girando e depois bloqueadas (WaitOnAddress), sem ocupar os núcleos.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../cpu/cpu_topology.h"
+
+#define BENCH_POOL_MAX CPU_TOPO_MAX
+
+// Trabalho de uma rodada, chamado em cada thread com o índice dela no pool
+typedef void (*BenchJobFn)(void *ctx, DWORD index);
+
+typedef struct BenchPool BenchPool;
+
+typedef struct {
+    BenchPool *pool;
+    DWORD      index;
+    uint64_t   end;             // bench_now() ao terminar a última rodada
+} BenchPoolSlot;
+
+struct BenchPool {
+    HANDLE            threads[BENCH_POOL_MAX];
+    const CpuLogical *cpus[BENCH_POOL_MAX];
+    BenchPoolSlot     slots[BENCH_POOL_MAX];
+    DWORD             count;
+    BenchJobFn        fn;
+    void             *ctx;
+    volatile LONG     generation;   // incrementado a cada rodada
+    volatile LONG     done;         // threads que terminaram a rodada
+    volatile LONG     quit;
+};
+
+// Cria uma thread fixada por processador da lista; false se alguma falhar
+bool bench_pool_start(BenchPool *p, const CpuLogical *const *cpus, DWORD count);
+
+// Roda fn em todas as threads; retorna ticks de bench_now() da largada ao fim da última
+uint64_t bench_pool_run(BenchPool *p, BenchJobFn fn, void *ctx);
+
+void bench_pool_stop(BenchPool *p);
@@ -0,0 +1,220 @@
+// bench_providers.c - Custo de coleta de cada provedor de informação
+// Cada entrada da tabela embrulha um getter com os buffers que a interface
+// usa; o retorno diz só se o getter informou sucesso.
+#include "bench_providers.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_basic.h"
+#include "../cpu/cpu_cores.h"
+#include "../cpu/cpu_cache.h"
+#include "../cpu/cpu_clock.h"
+#include "../cpu/cpu_load.h"
+#include "../cpu/cpu_thermal.h"
+#include "../cpu/cpu_msr.h"
+#include "../cpu/cpu_tlb.h"
+#include "../cpu/cpu_topology.h"
+#include "../cpu/cpu_features.h"
+#include "../memory/memory_general.h"
+#include "../memory/memory_timings.h"
+#include "../memory/memory_numa.h"
+#include "../mainboard/mainboard_basic.h"
+#include "../mainboard/mainboard_bios.h"
+#include "../mainboard/mainboard_chipset.h"
+#include "../graphics/graphics.h"
+
+#include <string.h>
+
+#define PROV_BUF    256
+#define PROV_HEAPS  64
+
+typedef bool (*ProvFn)(void);
+
+typedef struct {
+    const char *name;
+    const char *group;
+    ProvFn      fn;
+} Provider;
+
+// Getters de texto: (buf, tamanho) -> sucesso
+#define PROV_TEXT(getter) \
+    static bool prov_##getter(void) { char buf[PROV_BUF]; return getter(buf, sizeof(buf)) != 0; }
+
+PROV_TEXT(get_memory_type)
+PROV_TEXT(get_memory_size)
+PROV_TEXT(get_memory_channels)
+PROV_TEXT(get_dram_frequency)
+PROV_TEXT(get_motherboard_manufacturer)
+PROV_TEXT(get_motherboard_model)
+PROV_TEXT(get_motherboard_bus_specs)
+PROV_TEXT(get_bios_brand)
+PROV_TEXT(get_bios_version)
+PROV_TEXT(get_bios_date)
+PROV_TEXT(get_gpu_name)
+PROV_TEXT(get_gpu_board_manufacturer)
+PROV_TEXT(get_gpu_tdp)
+PROV_TEXT(get_gpu_base_clock)
+PROV_TEXT(get_vram_size)
+PROV_TEXT(get_vram_type)
+PROV_TEXT(get_vram_vendor)
+PROV_TEXT(get_vram_bus_width)
+
+static bool prov_get_cpu_vendor(void) { char v[13]; get_cpu_vendor(v); return v[0] != '\0'; }
+static bool prov_get_cpu_brand(void) { char b[49]; get_cpu_brand(b); return b[0] != '\0'; }
+static bool prov_count_physical_cores(void) { return count_physical_cores() > 0; }
+static bool prov_count_logical_processors(void) { return count_logical_processors() > 0; }
+static bool prov_build_cache_string(void) { wchar_t s[PROV_BUF]; s[0] = L'\0'; build_cache_string(s, PROV_BUF); return s[0] != L'\0'; }
+static bool prov_get_cache_levels(void) { CacheLevelInfo rows[16]; return get_cache_levels(rows, 16) > 0; }
+static bool prov_get_cpu0_clock(void) { DWORD cur, max, lim; return get_cpu0_clock(&cur, &max, &lim); }
+static bool prov_get_cpu_features(void) { CpuFeatures f; return get_cpu_features(&f); }
+static bool prov_build_feature_string(void) { char s[PROV_BUF]; build_feature_string(s, sizeof(s)); return s[0] != '\0'; }
+static bool prov_msr_available(void) { msr_available(); return true; }
+static bool prov_get_tlb_info(void) { TlbInfo t[TLB_MAX]; return get_tlb_info(t, TLB_MAX) > 0; }
+
+static bool prov_get_cpu_clocks(void) {
+    static CpuClock c[CPU_TOPO_MAX];
+    return get_cpu_clocks(c, CPU_TOPO_MAX) > 0;
+}
+
+// Com estado: a primeira chamada só guarda os contadores
+static bool prov_get_cpu_loads(void) {
+    static CpuLoadState st;
+    static double pct[CPU_LOAD_MAX];
+    get_cpu_loads(&st, pct, CPU_LOAD_MAX);
+    return true;
+}
+
+static bool prov_get_cpu_thermals(void) {
+    static CpuThermal t[CPU_THERMAL_MAX];
+    return get_cpu_thermals(t, CPU_THERMAL_MAX) > 0;
+}
+
+static bool prov_get_cpu_power(void) {
+    static CpuPowerState st;
+    CpuPower p;
+    return get_cpu_power(&st, &p);
+}
+
+static bool prov_get_cpu_topology(void) {
+    static CpuTopology t;
+    return get_cpu_topology(&t);
+}
+
+static bool prov_get_numa_info(void) {
+    static MemNumaInfo n;
+    return get_numa_info(&n);
+}
+
+static bool prov_get_chipset_info(void) { ChipsetInfo c; return get_chipset_info(&c, 1) > 0; }
+static bool prov_get_southbridge_info(void) { ChipsetInfo c; return get_southbridge_info(&c, 1) > 0; }
+
+#define PROV(group, getter) { #getter, group, prov_##getter }
+
+// Na ordem em que a interface coleta
+static const Provider providers[] = {
+    PROV("cpu",       get_cpu_vendor),
+    PROV("cpu",       get_cpu_brand),
+    PROV("cpu",       count_physical_cores),
+    PROV("cpu",       count_logical_processors),
+    PROV("cpu",       build_cache_string),
+    PROV("cpu",       get_cache_levels),
+    PROV("cpu",       get_cpu0_clock),
+    PROV("cpu",       get_cpu_clocks),
+    PROV("cpu",       get_cpu_loads),
+    PROV("cpu",       get_cpu_features),
+    PROV("cpu",       build_feature_string),
+    PROV("cpu",       get_cpu_topology),
+    PROV("cpu",       get_tlb_info),
+    PROV("cpu",       msr_available),
+    PROV("cpu",       get_cpu_thermals),
+    PROV("cpu",       get_cpu_power),
+    PROV("memory",    get_memory_type),
+    PROV("memory",    get_memory_size),
+    PROV("memory",    get_memory_channels),
+    PROV("memory",    get_dram_frequency),
+    PROV("memory",    get_numa_info),
+    PROV("mainboard", get_motherboard_manufacturer),
+    PROV("mainboard", get_motherboard_model),
+    PROV("mainboard", get_motherboard_bus_specs),
+    PROV("mainboard", get_bios_brand),
+    PROV("mainboard", get_bios_version),
+    PROV("mainboard", get_bios_date),
+    PROV("mainboard", get_chipset_info),
+    PROV("mainboard", get_southbridge_info),
+    PROV("graphics",  get_gpu_name),
+    PROV("graphics",  get_gpu_board_manufacturer),
+    PROV("graphics",  get_gpu_tdp),
+    PROV("graphics",  get_gpu_base_clock),
+    PROV("graphics",  get_vram_size),
+    PROV("graphics",  get_vram_type),
+    PROV("graphics",  get_vram_vendor),
+    PROV("graphics",  get_vram_bus_width),
+};
+
+#define PROVIDERS ((DWORD)(sizeof(providers) / sizeof(providers[0])))
+
+// Blocos ocupados e bytes em todos os heaps do processo
+static bool heap_usage(int64_t *blocks, int64_t *bytes) {
+    HANDLE heaps[PROV_HEAPS];
+    DWORD n = GetProcessHeaps(PROV_HEAPS, heaps);
+    if (n == 0 || n > PROV_HEAPS) return false;
+    *blocks = *bytes = 0;
+    for (DWORD i = 0; i < n; ++i) {
+        if (!HeapLock(heaps[i])) continue;
+        PROCESS_HEAP_ENTRY e;
+        e.lpData = NULL;
+        while (HeapWalk(heaps[i], &e)) {
+            if (!(e.wFlags & PROCESS_HEAP_ENTRY_BUSY)) continue;
+            (*blocks)++;
+            *bytes += e.cbData;
+        }
+        HeapUnlock(heaps[i]);
+    }
+    return true;
+}
+
+static double call_us(ProvFn fn, bool *ok) {
+    uint64_t t0 = bench_now();
+    bool r = fn();
+    uint64_t t1 = bench_now();
+    if (ok) *ok = r;
+    return (double)(t1 - t0) * 1e6 / bench_hz();
+}
+
+bool bench_providers_run(DWORD calls, const char *only, BenchProvReport *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (calls == 0) calls = BENCH_PROV_DEFAULT_CALLS;
+    if (calls > BENCH_STATS_MAX_REPS) calls = BENCH_STATS_MAX_REPS;
+    out->calls = calls;
+    out->heap_ok = true;
+
+    for (DWORD i = 0; i < PROVIDERS && out->count < BENCH_PROV_MAX; ++i) {
+        const Provider *p = &providers[i];
+        if (only && strcmp(only, p->name) != 0 && strcmp(only, p->group) != 0) continue;
+        if (progress) progress(ctx, p->name, (int)(100 * i / PROVIDERS));
+        BenchProvResult *r = &out->p[out->count++];
+        r->name = p->name;
+        r->group = p->group;
+
+        int64_t b0 = 0, s0 = 0, b1 = 0, s1 = 0, b2 = 0, s2 = 0;
+        bool heap = heap_usage(&b0, &s0);
+        r->cold_us = call_us(p->fn, &r->ok);
+        heap = heap && heap_usage(&b1, &s1);
+        for (DWORD c = 0; c < calls; ++c) r->warm.values[r->warm.reps++] = call_us(p->fn, NULL);
+        heap = heap && heap_usage(&b2, &s2);
+
+        if (heap) {
+            r->cold_blocks = b1 - b0;
+            r->cold_bytes = s1 - s0;
+            r->warm_blocks = (double)(b2 - b1) / calls;
+            r->warm_bytes = (double)(s2 - s1) / calls;
+        } else {
+            out->heap_ok = false;
+        }
+        bench_stats_summarize(&r->warm);
+        r->warm.converged = true;
+        out->cold_ms += r->cold_us / 1000.0;
+        out->warm_ms += r->warm.median / 1000.0;
+    }
+    if (progress) progress(ctx, "done", 100);
+    return out->count > 0;
+}
@@ -0,0 +1,44 @@
+// bench_providers.h - Custo de coleta de cada provedor de informação
+// Chama cada getter público (CPUID, registro, WMI, SetupAPI, NVML/ADL/IGCL,
+// MSR, contadores do SO) uma vez "a frio" e depois N vezes "a quente", na
+// thread chamadora. A frio é a primeira chamada do processo: paga carregar
+// DLLs, abrir sessões COM/WMI e preencher caches; os provedores rodam na ordem
+// da tabela, então um getter que reaproveita a inicialização de outro aparece
+// mais barato. Para cada um mede a latência das chamadas (mediana, MAD, máximo
+// via bench_stats) e os blocos que ficaram vivos nos heaps do processo
+// (HeapWalk antes e depois), o que acusa vazamentos e caches que só crescem.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "bench_stats.h"
+
+#define BENCH_PROV_DEFAULT_CALLS    20
+#define BENCH_PROV_MAX              48
+#define BENCH_PROV_THRESHOLD_PCT    25.0    // piora da mediana a quente que reprova
+
+typedef struct {
+    const char *name;               // nome do getter ("get_gpu_board_manufacturer")
+    const char *group;              // "cpu", "memory", "mainboard", "graphics"
+    bool        ok;                 // o getter informou sucesso na chamada a frio
+    double      cold_us;
+    BenchStats  warm;               // latência de cada chamada a quente, em us
+    int64_t     cold_blocks;        // blocos vivos a mais depois da chamada a frio
+    int64_t     cold_bytes;
+    double      warm_blocks;        // blocos vivos a mais por chamada a quente
+    double      warm_bytes;
+} BenchProvResult;
+
+typedef struct {
+    DWORD           count;
+    DWORD           calls;          // chamadas a quente por provedor
+    double          cold_ms;        // soma das chamadas a frio
+    double          warm_ms;        // soma das medianas a quente (uma coleta completa)
+    bool            heap_ok;        // false se o HeapWalk falhou (sem contagem de blocos)
+    BenchProvResult p[BENCH_PROV_MAX];
+} BenchProvReport;
+
+// Roda todos os provedores (only != NULL: só o de mesmo nome ou grupo)
+bool bench_providers_run(DWORD calls, const char *only, BenchProvReport *out, BenchProgressFn progress, void *ctx);
@@ -0,0 +1,363 @@
+// bench_refdb.c - Base de referência das notas do benchmark de CPU
+#define _CRT_SECURE_NO_WARNINGS
+#include "bench_refdb.h"
+#include "../cpu/cpu_basic.h"
+#include "../cpu/cpu_features.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CSV_LINE   1024
+#define MIX_STEPS  60       // bissecções ao inverter a distribuição misturada
+
+static const double quantile_pct[REFDB_QUANTILES] = { 0, 5, 10, 25, 50, 75, 90, 95, 100 };
+
+// ---- Chave ----
+
+void refdb_key_make(RefDbKey *k, const char *brand, DWORD family, DWORD model, DWORD stepping) {
+    memset(k, 0, sizeof(*k));
+    size_t n = 0;
+    for (const char *p = brand; *p && n < REFDB_BRAND - 1; ++p) {
+        if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            if (n && k->brand[n - 1] != ' ') k->brand[n++] = ' ';
+        } else {
+            k->brand[n++] = *p;
+        }
+    }
+    while (n && k->brand[n - 1] == ' ') k->brand[--n] = '\0';
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < n; ++i) h = (h ^ (uint8_t)k->brand[i]) * 0x100000001B3ull;
+    k->brand_hash = h;
+    k->fms = (family & 0xFFFF) << 16 | (model & 0xFF) << 8 | (stepping & 0xFF);
+}
+
+void refdb_key_current(RefDbKey *k) {
+    char brand[49];
+    get_cpu_brand(brand);
+    const CpuFeatures *f = cpu_features();
+    refdb_key_make(k, brand, f->family, f->model, f->stepping);
+}
+
+void refdb_sample_from_result(RefDbSample *s, const RefDbKey *k, const BenchCpuResult *r) {
+    memset(s, 0, sizeof(*s));
+    s->key = *k;
+    s->v[REFDB_ST] = r->st_total;
+    s->v[REFDB_MT] = r->mt_total;
+    for (int i = 0; i < BENCH_CPU_KERNELS; ++i) {
+        s->v[REFDB_ST_KERNEL + i] = r->st_score[i];
+        s->v[REFDB_MT_KERNEL + i] = r->mt_score[i];
+    }
+}
+
+const char *refdb_metric_name(int metric, char *buf, size_t n) {
+    if (metric == REFDB_ST) snprintf(buf, n, "ST");
+    else if (metric == REFDB_MT) snprintf(buf, n, "MT");
+    else if (metric >= REFDB_ST_KERNEL && metric < REFDB_MT_KERNEL)
+        snprintf(buf, n, "ST %s", bench_cpu_kernel_name(metric - REFDB_ST_KERNEL));
+    else if (metric >= REFDB_MT_KERNEL && metric < REFDB_METRICS)
+        snprintf(buf, n, "MT %s", bench_cpu_kernel_name(metric - REFDB_MT_KERNEL));
+    else snprintf(buf, n, "?");
+    return buf;
+}
+
+static int key_cmp(uint64_t ha, uint32_t fa, uint64_t hb, uint32_t fb) {
+    if (ha != hb) return ha < hb ? -1 : 1;
+    if (fa != fb) return fa < fb ? -1 : 1;
+    return 0;
+}
+
+// ---- Consulta ----
+
+bool refdb_open(RefDb *db, const wchar_t *path) {
+    memset(db, 0, sizeof(*db));
+    // FILE_SHARE_DELETE: uma gravação pode trocar o arquivo enquanto esta consulta o mantém mapeado
+    db->file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, NULL);
+    if (db->file == INVALID_HANDLE_VALUE) { db->file = NULL; return false; }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(db->file, &size) || (uint64_t)size.QuadPart < sizeof(RefDbHeader)) { refdb_close(db); return false; }
+    db->map = CreateFileMappingW(db->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!db->map) { refdb_close(db); return false; }
+    db->hdr = (const RefDbHeader*)MapViewOfFile(db->map, FILE_MAP_READ, 0, 0, 0);
+    if (!db->hdr) { refdb_close(db); return false; }
+
+    const RefDbHeader *h = db->hdr;
+    if (memcmp(h->magic, REFDB_MAGIC, 8) != 0 || h->version != REFDB_VERSION ||
+        h->entry_size != sizeof(RefDbEntry) || h->metrics != REFDB_METRICS ||
+        (uint64_t)size.QuadPart != sizeof(RefDbHeader) + (uint64_t)h->count * sizeof(RefDbEntry)) {
+        refdb_close(db);
+        return false;
+    }
+    db->entries = (const RefDbEntry*)(h + 1);
+    db->count = h->count;
+    return true;
+}
+
+void refdb_close(RefDb *db) {
+    if (db->hdr) UnmapViewOfFile(db->hdr);
+    if (db->map) CloseHandle(db->map);
+    if (db->file) CloseHandle(db->file);
+    memset(db, 0, sizeof(*db));
+}
+
+// Primeira entrada com chave >= (hash, fms)
+static uint32_t lower_bound(const RefDbEntry *e, uint32_t count, uint64_t hash, uint32_t fms) {
+    uint32_t lo = 0, hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (key_cmp(e[mid].brand_hash, e[mid].fms, hash, fms) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+const RefDbEntry *refdb_find(const RefDb *db, const RefDbKey *k, bool *exact) {
+    if (exact) *exact = false;
+    if (!db->entries) return NULL;
+    uint32_t i = lower_bound(db->entries, db->count, k->brand_hash, k->fms);
+    if (i < db->count && db->entries[i].brand_hash == k->brand_hash && db->entries[i].fms == k->fms) {
+        if (exact) *exact = true;
+        return &db->entries[i];
+    }
+    // Mesma marca, outro stepping: o vizinho de fms mais próximo
+    const RefDbEntry *best = NULL;
+    uint32_t best_d = 0;
+    if (i < db->count && db->entries[i].brand_hash == k->brand_hash) {
+        best = &db->entries[i];
+        best_d = best->fms - k->fms;
+    }
+    if (i > 0 && db->entries[i - 1].brand_hash == k->brand_hash) {
+        uint32_t d = k->fms - db->entries[i - 1].fms;
+        if (!best || d < best_d) best = &db->entries[i - 1];
+    }
+    return best;
+}
+
+double refdb_percentile(const RefDbStat *s, double value) {
+    const float *q = s->q;
+    if (s->count == 0) return 0;
+    if (q[0] == q[REFDB_QUANTILES - 1]) return value < q[0] ? 0 : value > q[0] ? 100 : 50;
+    for (int i = 0; i + 1 < REFDB_QUANTILES; ++i) {
+        if (value >= q[i + 1]) continue;
+        if (value < q[i]) return quantile_pct[i];
+        return quantile_pct[i] + (quantile_pct[i + 1] - quantile_pct[i]) * (value - q[i]) / (q[i + 1] - q[i]);
+    }
+    return 100;
+}
+
+// ---- Frota (CSV) ----
+// familia,modelo,stepping,versao,<REFDB_METRICS notas>,marca (a marca por
+// último: pode conter vírgulas)
+
+bool refdb_append_csv(const wchar_t *path, const RefDbSample *s) {
+    FILE *f = _wfopen(path, L"a");
+    if (!f) return false;
+    fprintf(f, "%lu,%lu,%lu,%d", (unsigned long)(s->key.fms >> 16), (unsigned long)((s->key.fms >> 8) & 0xFF),
+            (unsigned long)(s->key.fms & 0xFF), BENCH_CPU_VERSION);
+    for (int m = 0; m < REFDB_METRICS; ++m) fprintf(f, ",%.2f", s->v[m]);
+    fprintf(f, ",%s\n", s->key.brand);
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+static bool parse_line(const char *line, RefDbSample *s) {
+    char *end;
+    unsigned long f[4];
+    const char *p = line;
+    for (int i = 0; i < 4; ++i) {
+        f[i] = strtoul(p, &end, 10);
+        if (end == p || *end != ',') return false;
+        p = end + 1;
+    }
+    if (f[3] != BENCH_CPU_VERSION) return false;
+    for (int m = 0; m < REFDB_METRICS; ++m) {
+        s->v[m] = strtod(p, &end);
+        if (end == p || *end != ',' || s->v[m] <= 0) return false;
+        p = end + 1;
+    }
+    refdb_key_make(&s->key, p, (DWORD)f[0], (DWORD)f[1], (DWORD)f[2]);
+    return s->key.brand[0] != '\0';
+}
+
+size_t refdb_read_csv(const wchar_t *path, RefDbSample **out, size_t *skipped) {
+    *out = NULL;
+    if (skipped) *skipped = 0;
+    FILE *f = _wfopen(path, L"r");
+    if (!f) return 0;
+    size_t n = 0, cap = 0;
+    char line[CSV_LINE];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '\n' || line[0] == '\r' || line[0] == '#') continue;
+        if (n == cap) {
+            size_t grow = cap ? cap * 2 : 256;
+            RefDbSample *p = (RefDbSample*)realloc(*out, grow * sizeof(RefDbSample));
+            if (!p) break;
+            *out = p;
+            cap = grow;
+        }
+        if (parse_line(line, &(*out)[n])) n++;
+        else if (skipped) (*skipped)++;
+    }
+    fclose(f);
+    return n;
+}
+
+// ---- Mescla ----
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+static int cmp_sample(const void *a, const void *b) {
+    const RefDbKey *x = &((const RefDbSample*)a)->key, *y = &((const RefDbSample*)b)->key;
+    return key_cmp(x->brand_hash, x->fms, y->brand_hash, y->fms);
+}
+
+// Quantis de n valores (interpolação linear entre os vizinhos ordenados)
+static void stat_from_values(RefDbStat *s, double *v, size_t n) {
+    qsort(v, n, sizeof(double), cmp_double);
+    s->count = (uint32_t)n;
+    for (int i = 0; i < REFDB_QUANTILES; ++i) {
+        double pos = quantile_pct[i] / 100.0 * (double)(n - 1);
+        size_t lo = (size_t)pos;
+        double frac = pos - (double)lo;
+        s->q[i] = (float)(lo + 1 < n ? v[lo] + (v[lo + 1] - v[lo]) * frac : v[lo]);
+    }
+}
+
+// Distribuição acumulada (0-1) da mistura de a e b, pesadas pelo número de máquinas
+static double mix_cdf(const RefDbStat *a, const RefDbStat *b, double x) {
+    double na = a->count, nb = b->count;
+    return (na * refdb_percentile(a, x) + nb * refdb_percentile(b, x)) / (100.0 * (na + nb));
+}
+
+static void stat_merge(RefDbStat *a, const RefDbStat *b) {
+    if (b->count == 0) return;
+    if (a->count == 0) { *a = *b; return; }
+    RefDbStat m;
+    m.count = a->count + b->count;
+    double lo = a->q[0] < b->q[0] ? a->q[0] : b->q[0];
+    double hi = a->q[REFDB_QUANTILES - 1] > b->q[REFDB_QUANTILES - 1] ? a->q[REFDB_QUANTILES - 1] : b->q[REFDB_QUANTILES - 1];
+    m.q[0] = (float)lo;
+    m.q[REFDB_QUANTILES - 1] = (float)hi;
+    // Cada quantil interno: menor x com F(x) >= p, por bissecção
+    for (int i = 1; i + 1 < REFDB_QUANTILES; ++i) {
+        double p = quantile_pct[i] / 100.0, l = lo, h = hi;
+        for (int it = 0; it < MIX_STEPS; ++it) {
+            double mid = 0.5 * (l + h);
+            if (mix_cdf(a, b, mid) < p) l = mid;
+            else h = mid;
+        }
+        m.q[i] = (float)h;
+    }
+    *a = m;
+}
+
+static bool write_db(const wchar_t *path, const RefDbEntry *e, uint32_t count) {
+    wchar_t tmp[MAX_PATH];
+    if (_snwprintf(tmp, MAX_PATH, L"%s.tmp", path) < 0) return false;
+    tmp[MAX_PATH - 1] = L'\0';
+    HANDLE f = CreateFileW(tmp, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (f == INVALID_HANDLE_VALUE) return false;
+
+    RefDbHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, REFDB_MAGIC, 8);
+    h.version = REFDB_VERSION;
+    h.bench_version = BENCH_CPU_VERSION;
+    h.entry_size = sizeof(RefDbEntry);
+    h.metrics = REFDB_METRICS;
+    h.count = count;
+    DWORD wrote;
+    bool ok = WriteFile(f, &h, sizeof(h), &wrote, NULL) && wrote == sizeof(h);
+    // Em pedaços: WriteFile recebe DWORD
+    const uint8_t *p = (const uint8_t*)e;
+    size_t left = (size_t)count * sizeof(RefDbEntry);
+    while (ok && left) {
+        DWORD chunk = left > (1u << 30) ? (1u << 30) : (DWORD)left;
+        ok = WriteFile(f, p, chunk, &wrote, NULL) && wrote == chunk;
+        p += chunk;
+        left -= chunk;
+    }
+    CloseHandle(f);
+    // Troca pelo nome, sem base pela metade: uma consulta já aberta segue com a
+    // base antiga mapeada, as seguintes abrem a nova. Se o sistema recusar
+    // substituir o arquivo aberto, a gravação falha e a base antiga fica intacta.
+    if (ok) ok = MoveFileExW(tmp, path, MOVEFILE_REPLACE_EXISTING) != 0;
+    if (!ok) DeleteFileW(tmp);
+    return ok;
+}
+
+// Entradas novas de um grupo de amostras com a mesma chave
+static void entry_from_group(RefDbEntry *e, const RefDbSample *s, size_t n, double *scratch) {
+    memset(e, 0, sizeof(*e));
+    e->brand_hash = s[0].key.brand_hash;
+    e->fms = s[0].key.fms;
+    e->machines = (uint32_t)n;
+    memcpy(e->brand, s[0].key.brand, REFDB_BRAND);
+    for (int m = 0; m < REFDB_METRICS; ++m) {
+        for (size_t i = 0; i < n; ++i) scratch[i] = s[i].v[m];
+        stat_from_values(&e->stat[m], scratch, n);
+    }
+}
+
+bool refdb_merge(const wchar_t *path, const RefDbSample *samples, size_t n, DWORD *added, DWORD *updated) {
+    if (added) *added = 0;
+    if (updated) *updated = 0;
+
+    // Base atual (pode não existir); de outra versão do benchmark, não mistura
+    RefDb db;
+    uint32_t old_count = 0;
+    RefDbEntry *old = NULL;
+    if (refdb_open(&db, path)) {
+        if (db.hdr->bench_version != BENCH_CPU_VERSION) { refdb_close(&db); return false; }
+        old_count = db.count;
+        old = (RefDbEntry*)malloc((size_t)old_count * sizeof(RefDbEntry) + 1);
+        if (old) memcpy(old, db.entries, (size_t)old_count * sizeof(RefDbEntry));
+        refdb_close(&db);
+        if (!old) return false;
+    } else if (GetFileAttributesW(path) != INVALID_FILE_ATTRIBUTES) {
+        return false;                                   // existe mas não é uma base válida
+    }
+
+    RefDbSample *sorted = (RefDbSample*)malloc(n * sizeof(RefDbSample) + 1);
+    double *scratch = (double*)malloc(n * sizeof(double) + 1);
+    RefDbEntry *out = (RefDbEntry*)malloc(((size_t)old_count + n) * sizeof(RefDbEntry) + 1);
+    bool ok = sorted && scratch && out;
+    uint32_t count = 0;
+    if (ok) {
+        memcpy(sorted, samples, n * sizeof(RefDbSample));
+        qsort(sorted, n, sizeof(RefDbSample), cmp_sample);
+        // Junta duas listas ordenadas: a base e os grupos de amostras
+        uint32_t i = 0;
+        size_t j = 0;
+        while (i < old_count || j < n) {
+            int c = j >= n ? -1 : i >= old_count ? 1
+                  : key_cmp(old[i].brand_hash, old[i].fms, sorted[j].key.brand_hash, sorted[j].key.fms);
+            if (c < 0) { out[count++] = old[i++]; continue; }
+            size_t g = j;
+            while (g < n && cmp_sample(&sorted[g], &sorted[j]) == 0) g++;
+            RefDbEntry *e = &out[count++];
+            entry_from_group(e, &sorted[j], g - j, scratch);
+            if (c == 0) {
+                RefDbEntry fresh = *e;
+                *e = old[i++];
+                e->machines += fresh.machines;
+                for (int m = 0; m < REFDB_METRICS; ++m) stat_merge(&e->stat[m], &fresh.stat[m]);
+                if (updated) (*updated)++;
+            } else if (added) {
+                (*added)++;
+            }
+            j = g;
+        }
+        ok = write_db(path, out, count);
+    }
+    free(old);
+    free(sorted);
+    free(scratch);
+    free(out);
+    return ok;
+}
@@ -0,0 +1,110 @@
+// bench_refdb.h - Base de referência das notas do benchmark de CPU
+// Arquivo binário com uma entrada por modelo de CPU (marca normalizada da
+// CPUID + família/modelo/stepping), ordenado pela chave: a consulta mapeia o
+// arquivo e faz busca binária, sem ler as outras entradas. Cada entrada guarda,
+// para cada nota de bench_cpu, o número de máquinas e os quantis 0, 5, 10, 25,
+// 50, 75, 90, 95 e 100 (mediana em q[4], dispersão pelo intervalo q[3]..q[5]).
+// Os resultados da frota chegam em CSV (uma linha por máquina, gravada por
+// "bench --csv") e são mesclados na base: a distribuição de cada modelo vira a
+// mistura das distribuições antiga e nova, pesadas pelo número de máquinas.
+// Notas de outra BENCH_CPU_VERSION não se misturam.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bench_cpu.h"
+
+#define REFDB_MAGIC      "CPZREF01"
+#define REFDB_VERSION    1
+#define REFDB_QUANTILES  9
+#define REFDB_BRAND      48
+
+// Notas guardadas: totais e cada carga, em uma thread e em todas
+enum {
+    REFDB_ST = 0,
+    REFDB_MT,
+    REFDB_ST_KERNEL,                                // + BENCH_CPU_*
+    REFDB_MT_KERNEL = REFDB_ST_KERNEL + BENCH_CPU_KERNELS,
+    REFDB_METRICS = REFDB_MT_KERNEL + BENCH_CPU_KERNELS
+};
+
+typedef struct {
+    uint64_t brand_hash;            // FNV-1a da marca normalizada
+    uint32_t fms;                   // família << 16 | modelo << 8 | stepping
+    char     brand[REFDB_BRAND];
+} RefDbKey;
+
+typedef struct {
+    uint32_t count;
+    float    q[REFDB_QUANTILES];
+} RefDbStat;
+
+typedef struct {
+    uint64_t  brand_hash;
+    uint32_t  fms;
+    uint32_t  machines;
+    char      brand[REFDB_BRAND];
+    RefDbStat stat[REFDB_METRICS];
+} RefDbEntry;
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t bench_version;         // BENCH_CPU_VERSION das notas
+    uint32_t entry_size;
+    uint32_t metrics;
+    uint32_t count;
+    uint32_t reserved;
+} RefDbHeader;
+
+// Base aberta para consulta (arquivo mapeado, só leitura)
+typedef struct {
+    HANDLE             file;
+    HANDLE             map;
+    const RefDbHeader *hdr;
+    const RefDbEntry  *entries;
+    uint32_t           count;
+} RefDb;
+
+// Resultado de uma máquina, como lido do CSV da frota
+typedef struct {
+    RefDbKey key;
+    double   v[REFDB_METRICS];
+} RefDbSample;
+
+// Chave de um modelo; a marca é normalizada (espaços repetidos e nas pontas)
+void refdb_key_make(RefDbKey *k, const char *brand, DWORD family, DWORD model, DWORD stepping);
+
+// Chave desta máquina (get_cpu_brand e família/modelo/stepping da CPUID)
+void refdb_key_current(RefDbKey *k);
+
+// Notas de um resultado de bench_cpu na ordem REFDB_*
+void refdb_sample_from_result(RefDbSample *s, const RefDbKey *k, const BenchCpuResult *r);
+
+bool refdb_open(RefDb *db, const wchar_t *path);
+void refdb_close(RefDb *db);
+
+// Entrada do modelo; sem a mesma família/modelo/stepping, devolve a de mesma
+// marca mais próxima e *exact = false. NULL se a marca não estiver na base.
+const RefDbEntry *refdb_find(const RefDb *db, const RefDbKey *k, bool *exact);
+
+// Percentil (0-100) de um valor na distribuição guardada
+double refdb_percentile(const RefDbStat *s, double value);
+
+// Nome curto de uma nota ("ST", "MT integer"...)
+const char *refdb_metric_name(int metric, char *buf, size_t n);
+
+// ---- Frota ----
+
+// Acrescenta uma linha ao CSV (cria o arquivo se preciso)
+bool refdb_append_csv(const wchar_t *path, const RefDbSample *s);
+
+// Lê as linhas do CSV com a BENCH_CPU_VERSION atual; *skipped = linhas
+// ignoradas (inválidas ou de outra versão). O chamador libera *out com free()
+size_t refdb_read_csv(const wchar_t *path, RefDbSample **out, size_t *skipped);
+
+// Mescla as amostras na base (criada se não existir) e regrava o arquivo
+// ordenado; *added = modelos novos, *updated = modelos que já existiam
+bool refdb_merge(const wchar_t *path, const RefDbSample *samples, size_t n, DWORD *added, DWORD *updated);
@@ -0,0 +1,122 @@
+// bench_smt.c - Interferência entre as duas threads de um núcleo (SMT)
+// A thread chamadora roda na thread 0 do núcleo e uma thread auxiliar na
+// thread 1; cada uma aquece a sua carga e as duas contam o trabalho no mesmo
+// intervalo, aberto pela última a ficar pronta (sem tempo sozinha). Cada
+// fração mantida é medida duas vezes (a carga na thread 0 e na thread 1) e a
+// matriz mostra a média.
+#include "bench_smt.h"
+#include "bench_timer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    const CpuLogical *cpu;
+    int               kernel;
+    double            seconds;
+    BenchCpuSync      sync;
+    double            rate;
+    uint64_t          checksum;
+} SmtSibling;
+
+static DWORD WINAPI sibling_thread(LPVOID param) {
+    SmtSibling *s = (SmtSibling*)param;
+    topology_pin_thread(GetCurrentThread(), s->cpu);
+    s->rate = bench_cpu_kernel_rate_sync(s->kernel, s->seconds, &s->sync, &s->checksum);
+    return 0;
+}
+
+// Carga a na thread chamadora (já fixada) e b na vizinha, no mesmo intervalo
+static bool run_pair(const CpuLogical *sibling, int a, int b, double seconds, double rate[2], uint64_t *checksum) {
+    static SmtSibling s;
+    memset(&s, 0, sizeof(s));
+    s.cpu = sibling;
+    s.kernel = b;
+    s.seconds = seconds;
+    s.sync.threads = 2;
+    HANDLE h = CreateThread(NULL, 0, sibling_thread, &s, 0, NULL);
+    if (!h) return false;
+    rate[0] = bench_cpu_kernel_rate_sync(a, seconds, &s.sync, checksum);
+    WaitForSingleObject(h, INFINITE);
+    CloseHandle(h);
+    rate[1] = s.rate;
+    *checksum += s.checksum;
+    return rate[0] > 0 && rate[1] > 0;
+}
+
+// Outra thread lógica do mesmo núcleo físico de c (NULL se o núcleo não tem SMT)
+static const CpuLogical *sibling_of(const CpuTopology *topo, const CpuLogical *c) {
+    for (DWORD i = 0; i < topo->count; ++i) {
+        const CpuLogical *d = &topo->cpus[i];
+        if (d != c && d->package == c->package && d->core == c->core) return d;
+    }
+    return NULL;
+}
+
+// Núcleo com duas threads lógicas: o do processador mais rápido, senão o de
+// maior classe de eficiência que tiver SMT
+static bool find_siblings(const CpuTopology *topo, const CpuLogical *pair[2]) {
+    const CpuLogical *fastest = topology_fastest_cpu(topo);
+    pair[0] = NULL;
+    if (fastest && sibling_of(topo, fastest)) {
+        pair[0] = fastest;
+    } else {
+        for (DWORD i = 0; i < topo->count; ++i) {
+            const CpuLogical *c = &topo->cpus[i];
+            if (c->smt != 0 || !sibling_of(topo, c)) continue;
+            if (!pair[0] || c->efficiency > pair[0]->efficiency) pair[0] = c;
+        }
+    }
+    if (!pair[0]) return false;
+    pair[1] = sibling_of(topo, pair[0]);
+    return true;
+}
+
+bool bench_smt_run(double seconds, BenchSmtResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (seconds <= 0) seconds = BENCH_SMT_DEFAULT_SECS;
+    out->seconds = seconds;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *cpus[2];
+    if (!find_siblings(&topo, cpus)) return false;
+    out->has_smt = true;
+    bench_hz();             // calibra o relógio fora da primeira medição
+    out->cpus[0] = *cpus[0];
+    out->cpus[1] = *cpus[1];
+
+    const int K = BENCH_CPU_KERNELS;
+    int steps = 2 * K + K * K, step = 0;
+    char stage[40];
+
+    // Sozinha em cada thread, a vizinha ociosa
+    for (int t = 0; t < 2; ++t) {
+        topology_pin_thread(GetCurrentThread(), cpus[t]);
+        for (int k = 0; k < K; ++k) {
+            snprintf(stage, sizeof(stage), "%s solo", bench_cpu_kernel_name(k));
+            if (progress) progress(ctx, stage, 100 * step++ / steps);
+            out->alone[t][k] = bench_cpu_kernel_rate(k, seconds, &out->checksum);
+            if (out->alone[t][k] <= 0) return false;
+        }
+    }
+
+    topology_pin_thread(GetCurrentThread(), cpus[0]);
+    for (int a = 0; a < K; ++a)
+        for (int b = 0; b < K; ++b) {
+            snprintf(stage, sizeof(stage), "%s+%s", bench_cpu_kernel_name(a), bench_cpu_kernel_name(b));
+            if (progress) progress(ctx, stage, 100 * step++ / steps);
+            if (!run_pair(cpus[1], a, b, seconds, out->pair[a][b], &out->checksum)) return false;
+        }
+    if (progress) progress(ctx, "done", 100);
+
+    // [a][b]: a na thread 0 com b na 1, e a na thread 1 com b na 0
+    for (int a = 0; a < K; ++a)
+        for (int b = 0; b < K; ++b)
+            out->retained[a][b] = (out->pair[a][b][0] / out->alone[0][a] + out->pair[b][a][1] / out->alone[1][a]) / 2;
+    for (int a = 0; a < K; ++a)
+        for (int b = 0; b < K; ++b)
+            out->yield[a][b] = out->retained[a][b] + out->retained[b][a];
+    return true;
+}
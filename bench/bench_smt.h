@@ -0,0 +1,31 @@
+// bench_smt.h - Interferência entre as duas threads de um núcleo (SMT)
+// Usa as quatro cargas do bench de CPU (inteiros, ponto flutuante, desvios
+// imprevisíveis e memória dentro do L2) num núcleo físico com SMT: cada carga
+// sozinha numa das threads do núcleo (a outra ociosa) e depois cada par de
+// cargas, uma em cada thread, largadas juntas. Para cada par reporta a vazão
+// que cada carga mantém em relação a ela sozinha e o rendimento do núcleo (a
+// soma das duas frações: acima de 1 o SMT rende mais que uma thread só).
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "bench_cpu.h"
+#include "../cpu/cpu_topology.h"
+
+#define BENCH_SMT_DEFAULT_SECS  0.5     // por medição
+
+typedef struct {
+    bool       has_smt;                                         // algum núcleo com duas threads lógicas
+    CpuLogical cpus[2];                                         // as duas threads do núcleo medido
+    double     seconds;
+    double     alone[2][BENCH_CPU_KERNELS];                     // unidades/s, sozinha em cada thread
+    double     pair[BENCH_CPU_KERNELS][BENCH_CPU_KERNELS][2];   // [carga da thread 0][da thread 1][thread]
+    double     retained[BENCH_CPU_KERNELS][BENCH_CPU_KERNELS];  // fração de [linha] com [coluna] na vizinha
+    double     yield[BENCH_CPU_KERNELS][BENCH_CPU_KERNELS];     // retained[a][b] + retained[b][a]
+    uint64_t   checksum;
+} BenchSmtResult;
+
+// false se não houver núcleo com duas threads lógicas ou se a medição falhar
+bool bench_smt_run(double seconds, BenchSmtResult *out, BenchProgressFn progress, void *ctx);
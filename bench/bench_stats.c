@@ -0,0 +1,286 @@
+// bench_stats.c - Repetições com critério estatístico e detecção de ruído
+#define _CRT_SECURE_NO_WARNINGS
+#include "bench_stats.h"
+#include "bench_timer.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define Z95         1.959964    // quantil 97,5% da normal
+#define STATS_LINE  (BENCH_STATS_MAX_REPS * 24 + 128)
+#define STATS_NAME  64
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double median_sorted(const double *v, DWORD n) {
+    return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+void bench_stats_default_config(BenchStatsConfig *c) {
+    memset(c, 0, sizeof(*c));
+    c->warmup = BENCH_STATS_WARMUP;
+    c->min_reps = BENCH_STATS_MIN_REPS;
+    c->max_reps = BENCH_STATS_MAX_REPS;
+    c->ci_pct = BENCH_STATS_CI_PCT;
+    c->budget_secs = BENCH_STATS_BUDGET_SECS;
+}
+
+void bench_stats_summarize(BenchStats *s) {
+    DWORD n = s->reps;
+    s->median = s->mad = s->mean = s->min = s->max = 0;
+    s->ci_lo = s->ci_hi = s->ci_pct = 0;
+    if (n == 0) return;
+
+    double sorted[BENCH_STATS_MAX_REPS], dev[BENCH_STATS_MAX_REPS];
+    memcpy(sorted, s->values, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), cmp_double);
+    double sum = 0;
+    for (DWORD i = 0; i < n; ++i) sum += sorted[i];
+    s->mean = sum / n;
+    s->min = sorted[0];
+    s->max = sorted[n - 1];
+    s->median = median_sorted(sorted, n);
+    for (DWORD i = 0; i < n; ++i) dev[i] = fabs(sorted[i] - s->median);
+    qsort(dev, n, sizeof(double), cmp_double);
+    s->mad = median_sorted(dev, n);
+
+    // IC da mediana sem supor distribuição: o número de repetições abaixo da
+    // mediana verdadeira é binomial(n, 1/2); postos n/2 -+ 1,96 * sqrt(n)/2
+    double half = Z95 * sqrt((double)n) / 2.0;
+    long lo = (long)floor(n / 2.0 - half), hi = (long)ceil(n / 2.0 + half);
+    if (lo < 0) lo = 0;
+    if (hi > (long)n - 1) hi = (long)n - 1;
+    s->ci_lo = sorted[lo];
+    s->ci_hi = sorted[hi];
+    s->ci_pct = s->median > 0 ? 100.0 * 0.5 * (s->ci_hi - s->ci_lo) / s->median : 0;
+}
+
+// CPU ocupada pela máquina toda e pelo próprio processo, em unidades de 100 ns
+typedef struct {
+    uint64_t busy;
+    uint64_t own;
+} LoadSample;
+
+static uint64_t ft64(const FILETIME *f) {
+    return ((uint64_t)f->dwHighDateTime << 32) | f->dwLowDateTime;
+}
+
+static bool load_sample(LoadSample *l) {
+    FILETIME idle, kernel, user, created, exited, pkernel, puser;
+    if (!GetSystemTimes(&idle, &kernel, &user)) return false;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &pkernel, &puser)) return false;
+    // O tempo de kernel do sistema inclui o ocioso
+    l->busy = ft64(&kernel) - ft64(&idle) + ft64(&user);
+    l->own = ft64(&pkernel) + ft64(&puser);
+    return true;
+}
+
+static bool same_processor(const PROCESSOR_NUMBER *a, const PROCESSOR_NUMBER *b) {
+    return a->Group == b->Group && a->Number == b->Number;
+}
+
+bool bench_stats_run(const BenchStatsConfig *cfg, BenchRepFn fn, void *ctx, BenchStats *out) {
+    if (!out || !fn) return false;
+    memset(out, 0, sizeof(*out));
+    BenchStatsConfig c;
+    if (cfg) c = *cfg;
+    else bench_stats_default_config(&c);
+    if (c.max_reps == 0 || c.max_reps > BENCH_STATS_MAX_REPS) c.max_reps = BENCH_STATS_MAX_REPS;
+    if (c.min_reps < 3) c.min_reps = 3;
+    if (c.min_reps > c.max_reps) c.min_reps = c.max_reps;
+
+    HANDLE self = GetCurrentThread();
+    GROUP_AFFINITY old;
+    bool pinned = c.cpu && GetThreadGroupAffinity(self, &old) && topology_pin_thread(self, c.cpu);
+
+    // Aquecimento: caches, preditor, páginas e clock antes de contar
+    for (DWORD i = 0; i < c.warmup; ++i) fn(ctx);
+    out->warmup = c.warmup;
+
+    double clock[BENCH_STATS_MAX_REPS];
+    LoadSample l0, l1;
+    bool have_load = load_sample(&l0);
+    uint64_t start = bench_now();
+    uint64_t budget = (uint64_t)(c.budget_secs * bench_hz());
+    DWORD failed = 0;
+
+    while (out->reps < c.max_reps) {
+        PROCESSOR_NUMBER before, after;
+        GetCurrentProcessorNumberEx(&before);
+        double v = fn(ctx);
+        GetCurrentProcessorNumberEx(&after);
+        // Clock logo depois da repetição, no mesmo núcleo
+        double hz = bench_core_hz_sample();
+        if (pinned && !same_processor(&before, &after)) out->migrations++;
+
+        if (v > 0) {
+            clock[out->reps] = hz;
+            out->values[out->reps++] = v;
+        } else if (++failed > c.max_reps) {
+            break;
+        }
+
+        if (out->reps >= c.min_reps) {
+            bench_stats_summarize(out);
+            if (out->ci_pct <= c.ci_pct) { out->converged = true; break; }
+        }
+        if (bench_now() - start >= budget) break;
+    }
+    out->seconds = (double)(bench_now() - start) / bench_hz();
+
+    if (have_load && load_sample(&l1) && out->seconds > 0) {
+        DWORD_PTR cpus = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+        double busy = (double)(l1.busy - l0.busy), own = (double)(l1.own - l0.own);
+        double other = busy > own ? busy - own : 0;
+        double capacity = out->seconds * 1e7 * (double)(cpus ? cpus : 1);
+        out->other_load_pct = 100.0 * other / capacity;
+    }
+    if (pinned) SetThreadGroupAffinity(self, &old, NULL);
+    if (out->reps == 0) return false;
+
+    bench_stats_summarize(out);
+    double sorted[BENCH_STATS_MAX_REPS];
+    memcpy(sorted, clock, out->reps * sizeof(double));
+    qsort(sorted, out->reps, sizeof(double), cmp_double);
+    double mid = median_sorted(sorted, out->reps);
+    out->clock_min_ghz = sorted[0] / 1e9;
+    out->clock_max_ghz = sorted[out->reps - 1] / 1e9;
+    out->clock_spread_pct = mid > 0 ? 100.0 * (sorted[out->reps - 1] - sorted[0]) / mid : 0;
+
+    if (out->other_load_pct > BENCH_STATS_LOAD_PCT) out->noise |= BENCH_NOISE_LOAD;
+    if (out->clock_spread_pct > BENCH_STATS_CLOCK_PCT) out->noise |= BENCH_NOISE_CLOCK;
+    if (out->migrations) out->noise |= BENCH_NOISE_MIGRATION;
+    if (!out->converged) out->noise |= BENCH_NOISE_NOT_CONVERGED;
+    return true;
+}
+
+// ---- Comparação ----
+
+typedef struct {
+    double v;
+    int    group;
+} RankItem;
+
+static int cmp_rank(const void *a, const void *b) {
+    return cmp_double(&((const RankItem*)a)->v, &((const RankItem*)b)->v);
+}
+
+// Mann-Whitney U, aproximação normal com correção de empates e de continuidade
+static double mann_whitney_p(const double *a, DWORD na, const double *b, DWORD nb) {
+    DWORD n = na + nb;
+    RankItem items[2 * BENCH_STATS_MAX_REPS];
+    for (DWORD i = 0; i < na; ++i) { items[i].v = a[i]; items[i].group = 0; }
+    for (DWORD i = 0; i < nb; ++i) { items[na + i].v = b[i]; items[na + i].group = 1; }
+    qsort(items, n, sizeof(RankItem), cmp_rank);
+
+    double ra = 0, ties = 0;
+    for (DWORD i = 0; i < n;) {
+        DWORD j = i;
+        while (j + 1 < n && items[j + 1].v == items[i].v) j++;
+        double rank = 0.5 * (double)(i + j) + 1.0;     // posto médio do grupo empatado
+        double t = (double)(j - i + 1);
+        ties += t * t * t - t;
+        for (DWORD k = i; k <= j; ++k) if (items[k].group == 0) ra += rank;
+        i = j + 1;
+    }
+    double u = ra - (double)na * (na + 1) / 2.0;
+    double mu = (double)na * nb / 2.0;
+    double var = (double)na * nb / 12.0 * ((n + 1) - ties / ((double)n * (n - 1)));
+    if (var <= 0) return 1.0;
+    double d = fabs(u - mu) - 0.5;
+    if (d < 0) d = 0;
+    return erfc(d / sqrt(var) / sqrt(2.0));
+}
+
+void bench_stats_compare(const BenchStats *base, const BenchStats *cur, bool higher_is_better, BenchCompare *out) {
+    memset(out, 0, sizeof(*out));
+    out->p_value = 1.0;
+    if (base->reps < 2 || cur->reps < 2 || base->median <= 0) return;
+    out->delta_pct = 100.0 * (cur->median - base->median) / base->median;
+    out->p_value = mann_whitney_p(base->values, base->reps, cur->values, cur->reps);
+    if (out->p_value >= BENCH_STATS_ALPHA || fabs(out->delta_pct) < BENCH_STATS_EFFECT_PCT) return;
+    bool up = out->delta_pct > 0;
+    out->verdict = up == higher_is_better ? BENCH_CMP_BETTER : BENCH_CMP_WORSE;
+}
+
+// ---- Linha de base ----
+
+// Nome da linha (até o primeiro espaço); false se a linha estiver vazia
+static bool line_name(const char *line, char *name) {
+    size_t n = strcspn(line, " \t\r\n");
+    if (n == 0 || n >= STATS_NAME) return false;
+    memcpy(name, line, n);
+    name[n] = '\0';
+    return true;
+}
+
+bool bench_stats_save(const wchar_t *path, const char *name, const BenchStats *s) {
+    if (!name || !*name || strlen(name) >= STATS_NAME || strcspn(name, " \t\r\n") != strlen(name)) return false;
+    wchar_t tmp[MAX_PATH];
+    if (_snwprintf(tmp, MAX_PATH, L"%s.tmp", path) < 0) return false;
+    tmp[MAX_PATH - 1] = L'\0';
+    FILE *out = _wfopen(tmp, L"w");
+    if (!out) return false;
+
+    // Copia as outras medições e troca (ou acrescenta) a linha desta
+    static char line[STATS_LINE];
+    char other[STATS_NAME];
+    FILE *in = _wfopen(path, L"r");
+    if (in) {
+        while (fgets(line, sizeof(line), in))
+            if (line_name(line, other) && strcmp(other, name) != 0) fputs(line, out);
+        fclose(in);
+    }
+    fprintf(out, "%s %lu", name, (unsigned long)s->reps);
+    for (DWORD i = 0; i < s->reps; ++i) fprintf(out, " %.9g", s->values[i]);
+    fputc('\n', out);
+    bool ok = fclose(out) == 0;
+    if (ok) ok = MoveFileExW(tmp, path, MOVEFILE_REPLACE_EXISTING) != 0;
+    if (!ok) DeleteFileW(tmp);
+    return ok;
+}
+
+bool bench_stats_load(const wchar_t *path, const char *name, BenchStats *s) {
+    memset(s, 0, sizeof(*s));
+    FILE *f = _wfopen(path, L"r");
+    if (!f) return false;
+    static char line[STATS_LINE];
+    char other[STATS_NAME];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), f)) {
+        if (!line_name(line, other) || strcmp(other, name) != 0) continue;
+        char *p = line + strlen(other), *end;
+        unsigned long n = strtoul(p, &end, 10);
+        if (end == p || n == 0 || n > BENCH_STATS_MAX_REPS) break;
+        p = end;
+        DWORD got = 0;
+        while (got < n) {
+            double v = strtod(p, &end);
+            if (end == p) break;
+            s->values[got++] = v;
+            p = end;
+        }
+        s->reps = got;
+        found = got == n;
+    }
+    fclose(f);
+    if (!found) { s->reps = 0; return false; }
+    bench_stats_summarize(s);
+    s->converged = true;
+    return true;
+}
+
+const char *bench_noise_name(DWORD flag) {
+    switch (flag) {
+    case BENCH_NOISE_LOAD:          return "carga de outros processos";
+    case BENCH_NOISE_CLOCK:         return "clock variou";
+    case BENCH_NOISE_MIGRATION:     return "thread migrou";
+    case BENCH_NOISE_NOT_CONVERGED: return "IC alvo nao atingido";
+    default:                        return "?";
+    }
+}
@@ -0,0 +1,93 @@
+// bench_stats.h - Repetições com critério estatístico e detecção de ruído
+// Roda uma medição (uma "repetição") várias vezes numa thread fixada: descarta
+// as primeiras (aquecimento) e repete até o intervalo de confiança de 95% da
+// mediana ficar mais estreito que o alvo, ou até acabar o orçamento de
+// repetições/tempo. Reporta mediana, MAD e o intervalo, e marca o resultado
+// como ruidoso quando, durante as repetições, outros processos usaram a CPU
+// (GetSystemTimes menos o próprio processo), o clock do núcleo variou
+// (amostrado depois de cada repetição) ou a thread trocou de processador.
+// A comparação com uma linha de base usa o teste de Mann-Whitney sobre as
+// repetições das duas execuções: só há regressão quando a diferença é
+// estatisticamente significativa e maior que um efeito mínimo.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../cpu/cpu_topology.h"
+
+#define BENCH_STATS_MAX_REPS     256
+#define BENCH_STATS_WARMUP       3
+#define BENCH_STATS_MIN_REPS     10
+#define BENCH_STATS_CI_PCT       1.0     // meia-largura do IC 95% da mediana, em % da mediana
+#define BENCH_STATS_BUDGET_SECS  30.0
+#define BENCH_STATS_LOAD_PCT     5.0     // CPU de outros processos (% da máquina) tratada como ruído
+#define BENCH_STATS_CLOCK_PCT    5.0     // variação do clock entre repetições tratada como ruído
+#define BENCH_STATS_ALPHA        0.01    // nível de significância da comparação
+#define BENCH_STATS_EFFECT_PCT   1.0     // diferença mínima entre medianas para contar
+
+// Fontes de ruído (máscara)
+enum {
+    BENCH_NOISE_LOAD          = 1 << 0,
+    BENCH_NOISE_CLOCK         = 1 << 1,
+    BENCH_NOISE_MIGRATION     = 1 << 2,
+    BENCH_NOISE_NOT_CONVERGED = 1 << 3,     // orçamento acabou antes do IC alvo
+};
+
+// Uma repetição; retorna a medida (> 0) ou 0 se falhou
+typedef double (*BenchRepFn)(void *ctx);
+
+typedef struct {
+    const CpuLogical *cpu;          // processador onde fixar a thread (NULL = não fixa nem conta migrações)
+    DWORD             warmup;
+    DWORD             min_reps;
+    DWORD             max_reps;     // até BENCH_STATS_MAX_REPS
+    double            ci_pct;
+    double            budget_secs;
+} BenchStatsConfig;
+
+typedef struct {
+    double values[BENCH_STATS_MAX_REPS];    // repetições válidas, na ordem em que rodaram
+    DWORD  reps;
+    DWORD  warmup;
+    double median;
+    double mad;                     // mediana dos desvios absolutos
+    double mean, min, max;
+    double ci_lo, ci_hi;            // IC 95% da mediana (postos da binomial)
+    double ci_pct;                  // meia-largura do IC em % da mediana
+    bool   converged;
+    double seconds;
+    double other_load_pct;          // CPU dos outros processos, % da máquina
+    double clock_min_ghz, clock_max_ghz;
+    double clock_spread_pct;        // (max - min) / mediana do clock
+    DWORD  migrations;
+    DWORD  noise;                   // BENCH_NOISE_*
+} BenchStats;
+
+typedef enum {
+    BENCH_CMP_SAME = 0,
+    BENCH_CMP_BETTER,
+    BENCH_CMP_WORSE
+} BenchCmpVerdict;
+
+typedef struct {
+    double          delta_pct;      // mediana atual vs base, em %
+    double          p_value;        // Mann-Whitney, bicaudal
+    BenchCmpVerdict verdict;
+} BenchCompare;
+
+void bench_stats_default_config(BenchStatsConfig *c);
+
+bool bench_stats_run(const BenchStatsConfig *cfg, BenchRepFn fn, void *ctx, BenchStats *out);
+
+// Recalcula mediana, MAD, média e IC a partir de values/reps
+void bench_stats_summarize(BenchStats *s);
+
+void bench_stats_compare(const BenchStats *base, const BenchStats *cur, bool higher_is_better, BenchCompare *out);
+
+// Linha de base em texto: uma linha "nome n v1 ... vn" por medição.
+// save substitui a linha de mesmo nome; load preenche values/reps e resume.
+bool bench_stats_save(const wchar_t *path, const char *name, const BenchStats *s);
+bool bench_stats_load(const wchar_t *path, const char *name, BenchStats *s);
+
+const char *bench_noise_name(DWORD flag);
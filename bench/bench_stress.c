@@ -0,0 +1,234 @@
+// bench_stress.c - Teste de estresse com verificação dos resultados
+// Cada thread roda fpu, integer e memory em sequência até o fim; a thread
+// chamadora só acorda uma vez por segundo para somar o andamento.
+#include "bench_stress.h"
+#include "bench_isa.h"
+#include "bench_license.h"
+#include "bench_pages.h"
+#include "../cpu/cpu_topology.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FPU_ELEMS     1024          // x, y e a referência: 24 KB, no L1/L2
+#define FPU_CALLS     256           // chamadas conferidas por rodada
+#define INT_STEPS     (1 << 16)     // passos da cadeia de inteiros, ida e volta
+#define INT_MUL       0x9E3779B97F4A7C15ull    // ímpar: tem inverso módulo 2^64
+#define INT_ADD       0x632BE59BD9B4E019ull
+#define INT_ROT       17
+#define MEM_ALIGN     (64 * 1024)
+#define MEM_MIN       (1u << 20)    // pedaço mínimo de uma thread
+
+static const char *const kernel_names[BENCH_STRESS_KERNELS] = { "fpu", "integer", "memory" };
+
+const char *bench_stress_kernel_name(int kernel) {
+    return kernel >= 0 && kernel < BENCH_STRESS_KERNELS ? kernel_names[kernel] : "?";
+}
+
+typedef struct {
+    BenchHornerFn    fpu;
+    const double    *fpu_x;         // entrada e saída esperada, calculadas antes da largada
+    const double    *fpu_ref;
+    uint64_t         int_inv;       // inverso de INT_MUL
+    size_t           mem_bytes;     // por thread
+    volatile LONG    ready;
+    volatile LONG    go;
+    volatile LONG    stop;
+    volatile LONG    first_error;   // 0 até o primeiro erro
+    BenchStressResult *out;
+} StressShared;
+
+typedef struct {
+    StressShared      *sh;
+    const CpuLogical  *cpu;
+    DWORD              index;
+    volatile uint64_t  rounds[BENCH_STRESS_KERNELS];
+    volatile uint64_t  errors[BENCH_STRESS_KERNELS];
+    bool               ok;
+} StressThread;
+
+static uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+static uint64_t rotr64(uint64_t x, int r) { return (x >> r) | (x << (64 - r)); }
+
+// Inverso módulo 2^64 de um ímpar (Newton: cada passo dobra os bits corretos)
+static uint64_t inverse64(uint64_t a) {
+    uint64_t x = a;
+    for (int i = 0; i < 5; ++i) x *= 2 - a * x;
+    return x;
+}
+
+static void report_error(StressThread *t, int kernel, uint64_t n) {
+    t->errors[kernel] += n;
+    StressShared *sh = t->sh;
+    if (InterlockedCompareExchange(&sh->first_error, 1, 0) == 0) {
+        sh->out->first_error_thread = t->index;
+        sh->out->first_error_kernel = kernel;
+        sh->out->first_error_round = t->rounds[kernel];
+    }
+}
+
+// Cada chamada refaz a mesma conta; a saída inteira é comparada com a referência
+static uint64_t round_fpu(StressThread *t, const double *x, double *y) {
+    uint64_t bad = 0;
+    for (int c = 0; c < FPU_CALLS; ++c) {
+        t->sh->fpu(x, y, FPU_ELEMS);
+        if (memcmp(y, t->sh->fpu_ref, FPU_ELEMS * sizeof(double)) != 0) bad++;
+    }
+    return bad;
+}
+
+static uint64_t round_integer(StressThread *t) {
+    uint64_t seed = (t->rounds[BENCH_STRESS_INTEGER] + 1) * 0xD1B54A32D192ED03ull ^ t->index;
+    uint64_t x = seed, inv = t->sh->int_inv;
+    for (int i = 0; i < INT_STEPS; ++i) x = rotl64(x * INT_MUL + INT_ADD, INT_ROT);
+    for (int i = 0; i < INT_STEPS; ++i) x = (rotr64(x, INT_ROT) - INT_ADD) * inv;
+    return x != seed;
+}
+
+static uint64_t mem_pattern(size_t i, uint64_t key) {
+    return ((uint64_t)i ^ key) * 0xBF58476D1CE4E5B9ull + rotl64((uint64_t)i, 32);
+}
+
+// Escreve o pedaço todo e só então relê: a releitura vem da memória, não da cache
+static uint64_t round_memory(StressThread *t, uint64_t *mem, size_t words) {
+    uint64_t key = (t->rounds[BENCH_STRESS_MEMORY] + 1) * 0x94D049BB133111EBull + t->index;
+    for (size_t i = 0; i < words; ++i) mem[i] = mem_pattern(i, key);
+    const volatile uint64_t *v = mem;   // impede que o compilador deduza a releitura
+    uint64_t bad = 0;
+    for (size_t i = 0; i < words; ++i) bad += v[i] != mem_pattern(i, key);
+    return bad;
+}
+
+static DWORD WINAPI stress_thread(LPVOID param) {
+    StressThread *t = (StressThread*)param;
+    StressShared *sh = t->sh;
+    topology_pin_thread(GetCurrentThread(), t->cpu);
+
+    // Alocado pela própria thread: páginas no nó NUMA dela
+    size_t page;
+    double *fpu = (double*)bench_pages_alloc(2 * FPU_ELEMS * sizeof(double), false, BENCH_NODE_ANY, &page);
+    uint64_t *mem = (uint64_t*)bench_pages_alloc(sh->mem_bytes, false, BENCH_NODE_ANY, &page);
+    t->ok = fpu && mem;
+    if (t->ok) memcpy(fpu, sh->fpu_x, FPU_ELEMS * sizeof(double));
+
+    InterlockedIncrement(&sh->ready);
+    while (!sh->go) YieldProcessor();
+
+    size_t words = sh->mem_bytes / sizeof(uint64_t);
+    while (t->ok && !sh->stop) {
+        uint64_t bad = round_fpu(t, fpu, fpu + FPU_ELEMS);
+        if (bad) report_error(t, BENCH_STRESS_FPU, bad);
+        t->rounds[BENCH_STRESS_FPU]++;
+        if (sh->stop) break;
+
+        bad = round_integer(t);
+        if (bad) report_error(t, BENCH_STRESS_INTEGER, bad);
+        t->rounds[BENCH_STRESS_INTEGER]++;
+        if (sh->stop) break;
+
+        bad = round_memory(t, mem, words);
+        if (bad) report_error(t, BENCH_STRESS_MEMORY, bad);
+        t->rounds[BENCH_STRESS_MEMORY]++;
+    }
+    if (fpu) bench_pages_free(fpu);
+    if (mem) bench_pages_free(mem);
+    return 0;
+}
+
+static void sum_status(const StressThread *t, DWORD n, BenchStressStatus *st) {
+    memset(st->rounds, 0, sizeof(st->rounds));
+    st->errors = 0;
+    for (DWORD i = 0; i < n; ++i)
+        for (int k = 0; k < BENCH_STRESS_KERNELS; ++k) {
+            st->rounds[k] += t[i].rounds[k];
+            st->errors += t[i].errors[k];
+        }
+}
+
+bool bench_stress_run(DWORD seconds, BenchStressResult *out, BenchStressTickFn tick, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (seconds == 0) seconds = BENCH_STRESS_DEFAULT_SECS;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    out->threads = topo.count;
+    out->seconds = seconds;
+
+    // Memória: BENCH_STRESS_MEMORY_MB no total, até 1/4 da memória livre
+    size_t total = (size_t)BENCH_STRESS_MEMORY_MB << 20;
+    MEMORYSTATUSEX ms;
+    ms.dwLength = sizeof(ms);
+    if (GlobalMemoryStatusEx(&ms) && total > ms.ullAvailPhys / 4) total = (size_t)(ms.ullAvailPhys / 4);
+    size_t per = total / topo.count / MEM_ALIGN * MEM_ALIGN;
+    if (per < MEM_MIN) per = MEM_MIN;
+    out->memory_mb = (DWORD)((per * topo.count) >> 20);
+
+    // Referência da carga fpu, calculada uma vez nesta thread
+    out->variant = BENCH_VEC_SCALAR + 1 + bench_isa_best();
+    size_t page;
+    double *fpu = (double*)bench_pages_alloc(2 * FPU_ELEMS * sizeof(double), false, BENCH_NODE_ANY, &page);
+    StressThread *t = (StressThread*)calloc(topo.count, sizeof(StressThread));
+    HANDLE *h = (HANDLE*)calloc(topo.count, sizeof(HANDLE));
+    if (!fpu || !t || !h) {
+        if (fpu) bench_pages_free(fpu);
+        free(t);
+        free(h);
+        return false;
+    }
+    for (int i = 0; i < FPU_ELEMS; ++i) fpu[i] = 0.25 + 0.5 * (double)((i * 37) % FPU_ELEMS) / FPU_ELEMS;
+    static StressShared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.fpu = bench_license_kernel(out->variant);
+    sh.fpu(fpu, fpu + FPU_ELEMS, FPU_ELEMS);
+    sh.fpu_x = fpu;
+    sh.fpu_ref = fpu + FPU_ELEMS;
+    sh.int_inv = inverse64(INT_MUL);
+    sh.mem_bytes = per;
+    sh.out = out;
+
+    DWORD started = 0;
+    for (DWORD i = 0; i < topo.count; ++i) {
+        t[i].sh = &sh;
+        t[i].cpu = &topo.cpus[i];
+        t[i].index = i;
+        h[i] = CreateThread(NULL, 0, stress_thread, &t[i], 0, NULL);
+        if (!h[i]) break;
+        started++;
+    }
+    while ((DWORD)sh.ready < started) Sleep(1);
+    bool ok = started == topo.count;
+    for (DWORD i = 0; i < started; ++i) if (!t[i].ok) ok = false;
+
+    // Um tick por segundo, contado da largada (o atraso de um Sleep não acumula)
+    InterlockedExchange(&sh.go, 1);
+    ULONGLONG start = GetTickCount64();
+    BenchStressStatus st;
+    st.seconds = seconds;
+    for (DWORD s = 1; ok && s <= seconds; ++s) {
+        ULONGLONG due = start + (ULONGLONG)s * 1000, now = GetTickCount64();
+        if (due > now) Sleep((DWORD)(due - now));
+        st.elapsed_s = s;
+        sum_status(t, started, &st);
+        out->elapsed_s = s;
+        if (tick && !tick(ctx, &st)) { out->aborted = s < seconds; break; }
+    }
+    InterlockedExchange(&sh.stop, 1);
+    // WaitForMultipleObjects para em 64 handles
+    for (DWORD i = 0; i < started; ++i) {
+        WaitForSingleObject(h[i], INFINITE);
+        CloseHandle(h[i]);
+    }
+
+    for (DWORD i = 0; i < started; ++i)
+        for (int k = 0; k < BENCH_STRESS_KERNELS; ++k) {
+            out->rounds[k] += t[i].rounds[k];
+            out->errors[k] += t[i].errors[k];
+        }
+    out->has_error = sh.first_error != 0;
+    out->passed = ok && !out->aborted && !out->has_error;
+    bench_pages_free(fpu);
+    free(t);
+    free(h);
+    return ok;
+}
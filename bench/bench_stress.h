@@ -0,0 +1,57 @@
+// bench_stress.h - Teste de estresse com verificação dos resultados
+// Uma thread por processador lógico, cada uma fixada no seu, alternando três
+// cargas determinísticas que se conferem sozinhas:
+//  - fpu: polinômio de bench_license na variante mais larga disponível; o
+//    hash da saída tem de ser igual, bit a bit, ao calculado antes da largada
+//  - integer: cadeia de multiplicações/rotações percorrida para a frente e
+//    desfeita com o inverso modular; tem de voltar à semente
+//  - memory: padrão dependente do endereço e da rodada escrito num pedaço
+//    próprio da thread (juntos, bem maiores que a última cache) e relido
+// Qualquer diferença conta como erro; um único erro reprova a máquina.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+
+#define BENCH_STRESS_DEFAULT_SECS  600
+#define BENCH_STRESS_MEMORY_MB     512     // total entre as threads, até 1/4 da memória livre
+
+enum {
+    BENCH_STRESS_FPU = 0,
+    BENCH_STRESS_INTEGER,
+    BENCH_STRESS_MEMORY,
+    BENCH_STRESS_KERNELS
+};
+
+// Andamento, entregue uma vez por segundo
+typedef struct {
+    DWORD    elapsed_s;
+    DWORD    seconds;
+    uint64_t rounds[BENCH_STRESS_KERNELS];  // somadas entre as threads
+    uint64_t errors;
+} BenchStressStatus;
+
+// Chamado a cada segundo na thread que chamou bench_stress_run; false interrompe
+typedef bool (*BenchStressTickFn)(void *ctx, const BenchStressStatus *st);
+
+typedef struct {
+    DWORD    threads;
+    DWORD    seconds;                       // duração pedida
+    DWORD    elapsed_s;                     // duração real
+    int      variant;                       // variante da carga fpu (BenchVecVariant)
+    DWORD    memory_mb;                     // total entre as threads
+    uint64_t rounds[BENCH_STRESS_KERNELS];
+    uint64_t errors[BENCH_STRESS_KERNELS];
+    bool     has_error;
+    DWORD    first_error_thread;            // processador lógico (índice na topologia)
+    int      first_error_kernel;
+    uint64_t first_error_round;
+    bool     aborted;                       // interrompido pelo tick antes do fim
+    bool     passed;                        // rodou até o fim sem nenhum erro
+} BenchStressResult;
+
+bool bench_stress_run(DWORD seconds, BenchStressResult *out, BenchStressTickFn tick, void *ctx);
+
+const char *bench_stress_kernel_name(int kernel);
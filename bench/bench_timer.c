@@ -0,0 +1,101 @@
+// bench_timer.c - Relógio dos benchmarks
+#include "bench_timer.h"
+
+static double g_tsc_hz;
+static int    g_invariant = -1;
+
+bool bench_tsc_invariant(void) {
+    if (g_invariant < 0) {
+        int r[4];
+        __cpuid(r, 0x80000000);
+        g_invariant = 0;
+        if ((unsigned)r[0] >= 0x80000007) {
+            __cpuid(r, 0x80000007);
+            g_invariant = (r[3] >> 8) & 1;
+        }
+    }
+    return g_invariant == 1;
+}
+
+// Mede ~50 ms de TSC contra o QPC; repete até duas medidas concordarem em 0,1%
+double bench_tsc_hz(void) {
+    if (g_tsc_hz > 0) return g_tsc_hz;
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    double prev = 0;
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        LARGE_INTEGER q0, q1;
+        QueryPerformanceCounter(&q0);
+        uint64_t t0 = __rdtsc();
+        Sleep(50);
+        QueryPerformanceCounter(&q1);
+        uint64_t t1 = __rdtsc();
+        double hz = (double)(t1 - t0) * (double)f.QuadPart / (double)(q1.QuadPart - q0.QuadPart);
+        if (prev > 0 && hz > prev * 0.999 && hz < prev * 1.001) { prev = hz; break; }
+        prev = hz;
+    }
+    g_tsc_hz = prev;
+    return g_tsc_hz;
+}
+
+uint64_t bench_now(void) {
+    if (bench_tsc_invariant()) return __rdtsc();
+    LARGE_INTEGER q;
+    QueryPerformanceCounter(&q);
+    return (uint64_t)q.QuadPart;
+}
+
+double bench_hz(void) {
+    if (bench_tsc_invariant()) return bench_tsc_hz();
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    return (double)f.QuadPart;
+}
+
+double bench_ticks_to_ns(uint64_t ticks) {
+    return (double)ticks * 1e9 / bench_hz();
+}
+
+// Cadeia de multiplicações dependentes: IMUL de 64 bits tem latência de 3
+// ciclos nos x86-64 atuais (Intel desde Sandy Bridge, AMD desde Zen)
+#define CORE_HZ_MULS      (1 << 22)
+#define CORE_SAMPLE_MULS  (1 << 15)
+#define CORE_QUICK_MULS   (1 << 11)
+#define IMUL_LATENCY      3.0
+
+static volatile uint64_t g_core_sink;
+
+// Ticks de bench_now() para muls multiplicações dependentes
+static uint64_t imul_chain_ticks(int muls) {
+    volatile uint64_t seed = 3;
+    // x *= x: com um fator fixo o compilador juntaria as multiplicações
+    uint64_t x = seed;
+    uint64_t t0 = bench_now();
+    for (int i = 0; i < muls; i += 8) {
+        x *= x; x *= x; x *= x; x *= x;
+        x *= x; x *= x; x *= x; x *= x;
+    }
+    uint64_t t = bench_now() - t0;
+    g_core_sink = x;
+    return t;
+}
+
+double bench_core_hz(void) {
+    uint64_t best = 0;
+    // A primeira rodada só acorda o núcleo; fica a mais rápida das demais
+    for (int attempt = 0; attempt < 6; ++attempt) {
+        uint64_t t = imul_chain_ticks(CORE_HZ_MULS);
+        if (attempt > 0 && (best == 0 || t < best)) best = t;
+    }
+    return best ? IMUL_LATENCY * CORE_HZ_MULS * bench_hz() / (double)best : 0;
+}
+
+double bench_core_hz_sample(void) {
+    uint64_t t = imul_chain_ticks(CORE_SAMPLE_MULS);
+    return t ? IMUL_LATENCY * CORE_SAMPLE_MULS * bench_hz() / (double)t : 0;
+}
+
+double bench_core_hz_quick(void) {
+    uint64_t t = imul_chain_ticks(CORE_QUICK_MULS);
+    return t ? IMUL_LATENCY * CORE_QUICK_MULS * bench_hz() / (double)t : 0;
+}
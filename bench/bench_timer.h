@@ -0,0 +1,36 @@
+// bench_timer.h - Relógio dos benchmarks
+// TSC quando ele é invariante (não muda com o clock nem para em estados de
+// economia), senão QueryPerformanceCounter. Os valores só fazem sentido em
+// diferenças, convertidas com bench_ticks_to_ns.
+#pragma once
+#include <windows.h>
+#include <intrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// true se o TSC é invariante (CPUID 0x80000007 EDX[8])
+bool bench_tsc_invariant(void);
+
+// Frequência do TSC em Hz, calibrada uma vez contra QueryPerformanceCounter
+double bench_tsc_hz(void);
+
+// Instante atual em ticks do relógio escolhido
+uint64_t bench_now(void);
+
+// Ticks por segundo do relógio escolhido
+double bench_hz(void);
+
+double bench_ticks_to_ns(uint64_t ticks);
+
+// Clock atual do núcleo da thread chamadora (Hz), estimado por uma cadeia de
+// instruções de latência conhecida; chamar com a thread já fixada
+double bench_core_hz(void);
+
+// Uma amostra curta (~100 mil ciclos) do clock atual, sem aquecimento: mede o
+// clock que o núcleo está usando agora, p.ex. logo depois de uma carga AVX
+double bench_core_hz_sample(void);
+
+// Amostra mínima (~6 mil ciclos, poucos microssegundos) para acompanhar a
+// subida do clock logo depois de o núcleo acordar; precisa do TSC invariante
+// para ter resolução
+double bench_core_hz_quick(void);
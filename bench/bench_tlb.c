@@ -0,0 +1,222 @@
+// bench_tlb.c - Custo de acesso por tamanho de página e alcance das TLBs
+#include "bench_tlb.h"
+#include "bench_latency.h"
+#include "bench_pages.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_topology.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SMALL_PAGE    4096
+#define SWEEP_LOADS   (1u << 19)    // cargas por ponto da varredura, no mínimo
+#define BIG_LOADS     (1u << 20)    // cargas da latência no buffer grande
+#define CHAIN_LOADS   (1u << 18)    // cargas por cadeia na banda aleatória
+#define REPS          3
+#define STEP_CYCLES   2.0           // diferença mínima que conta como falta na TLB
+
+static const char *const kind_names[BENCH_PAGE_KINDS] = { "4 KB", "2 MB", "1 GB" };
+
+const char *bench_page_kind_name(int kind) {
+    return kind >= 0 && kind < BENCH_PAGE_KINDS ? kind_names[kind] : "?";
+}
+
+static uint64_t xorshift64(uint64_t *s) {
+    uint64_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *s = x;
+}
+
+// Linha da carga dentro da página p: (p + p / 64) % 64. Páginas vizinhas caem
+// em conjuntos diferentes da L1, e em memória contígua (páginas grandes) as
+// primeiras 2048 páginas caem em 2048 conjuntos diferentes da L2.
+static char *page_line(char *buf, DWORD p) {
+    return buf + (size_t)p * SMALL_PAGE + ((p + p / 64) % 64) * 64;
+}
+
+// Cadeia aleatória (Sattolo) passando por uma linha de cada uma das n páginas
+static void *page_chain_build(char *buf, DWORD n, uint64_t seed) {
+    DWORD *order = (DWORD*)malloc((size_t)n * sizeof(DWORD));
+    if (!order) return NULL;
+    uint64_t s = seed | 1;
+    for (DWORD i = 0; i < n; ++i) order[i] = i;
+    for (DWORD i = n - 1; i > 0; --i) {
+        DWORD j = (DWORD)(xorshift64(&s) % i);
+        DWORD t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+    for (DWORD i = 0; i < n; ++i) *(void**)page_line(buf, i) = page_line(buf, order[i]);
+    free(order);
+    return page_line(buf, 0);
+}
+
+static double sweep_cycles(char *buf, DWORD pages, double cycles_per_tick) {
+    void *start = page_chain_build(buf, pages, 0x9E3779B97F4A7C15ull + pages);
+    if (!start) return 0;
+    size_t loads = (size_t)pages * 8;
+    if (loads < SWEEP_LOADS) loads = SWEEP_LOADS;
+    return bench_chain_ticks(start, loads, REPS) * cycles_per_tick;
+}
+
+// Alcance: último ponto antes da diferença passar de STEP_CYCLES em dois pontos seguidos
+static DWORD first_step(const BenchTlbResult *r, DWORD from, double limit) {
+    for (DWORD i = from; i < r->npoints; ++i) {
+        double d = r->points[i].cycles_small - r->points[i].cycles_large;
+        double next = i + 1 < r->npoints ? r->points[i + 1].cycles_small - r->points[i + 1].cycles_large : d;
+        if (d > limit && next > limit) return i;
+    }
+    return r->npoints;
+}
+
+// DTLB: primeiro degrau. STLB: o custo de acerto na STLB é a diferença a 2x o
+// alcance da DTLB; o segundo degrau é quando ela passa do dobro disso.
+static void derive_reach(BenchTlbResult *r) {
+    if (r->npoints == 0) return;
+    DWORD i = first_step(r, 0, STEP_CYCLES);
+    if (i == 0 || i >= r->npoints) return;
+    r->dtlb_reach_pages = r->points[i - 1].pages;
+
+    DWORD j = i;
+    while (j < r->npoints && r->points[j].pages < 2 * r->dtlb_reach_pages) j++;
+    if (j >= r->npoints) return;
+    r->stlb_hit_cycles = r->points[j].cycles_small - r->points[j].cycles_large;
+    const BenchTlbPoint *last = &r->points[r->npoints - 1];
+    r->walk_cycles = last->cycles_small - last->cycles_large;
+
+    DWORD k = first_step(r, j + 1, 2 * r->stlb_hit_cycles + STEP_CYCLES);
+    if (k < r->npoints) r->stlb_reach_pages = r->points[k - 1].pages;
+    else r->walk_cycles = 0;                    // STLB não estourou dentro da varredura
+}
+
+static void sweep(BenchTlbResult *out, double cycles_per_tick, BenchProgressFn progress, void *ctx) {
+    size_t bytes = (size_t)BENCH_TLB_MAX_PAGES * SMALL_PAGE;
+    size_t page = 0;
+    char *small = (char*)bench_pages_alloc(bytes, false, BENCH_NODE_ANY, &page);
+    char *large = (char*)bench_pages_alloc(bytes, true, BENCH_NODE_ANY, &page);
+    if (large && page <= SMALL_PAGE) {
+        bench_pages_free(large);
+        large = NULL;
+    }
+    out->has_baseline = large != NULL;
+    if (!large)
+        out->baseline_reason = bench_large_pages_available() ? "sem memoria fisica contigua livre"
+                                                             : bench_large_pages_reason();
+    if (!small) {
+        bench_pages_free(large);
+        return;
+    }
+
+    DWORD sizes[BENCH_TLB_MAX_POINTS];
+    DWORD n = 0;
+    for (DWORD p = BENCH_TLB_MIN_PAGES; p <= BENCH_TLB_MAX_PAGES && n < BENCH_TLB_MAX_POINTS; p *= 2) {
+        sizes[n++] = p;
+        if (p + p / 2 <= BENCH_TLB_MAX_PAGES && n < BENCH_TLB_MAX_POINTS) sizes[n++] = p + p / 2;
+    }
+
+    char stage[32];
+    for (DWORD i = 0; i < n; ++i) {
+        snprintf(stage, sizeof(stage), "%lu paginas", (unsigned long)sizes[i]);
+        if (progress) progress(ctx, stage, (int)(60 * i / n));
+        BenchTlbPoint *pt = &out->points[out->npoints++];
+        pt->pages = sizes[i];
+        pt->cycles_small = sweep_cycles(small, sizes[i], cycles_per_tick);
+        if (large) pt->cycles_large = sweep_cycles(large, sizes[i], cycles_per_tick);
+    }
+    bench_pages_free(small);
+    bench_pages_free(large);
+    if (out->has_baseline) derive_reach(out);
+}
+
+static void *volatile g_sink;
+
+// BENCH_TLB_CHAINS cadeias independentes no mesmo ciclo, a partir de linhas aleatórias
+static double random_read_gbs(char *buf, size_t bytes) {
+    void *cur[BENCH_TLB_CHAINS];
+    uint64_t s = 0xD1B54A32D192ED03ull;
+    size_t lines = bytes / BENCH_LAT_LINE;
+    for (int k = 0; k < BENCH_TLB_CHAINS; ++k)
+        cur[k] = buf + (size_t)(xorshift64(&s) % lines) * BENCH_LAT_LINE;
+    uint64_t best = 0;
+    for (int r = 0; r <= REPS; ++r) {               // a primeira é aquecimento
+        uint64_t t0 = bench_now();
+        for (size_t i = 0; i < CHAIN_LOADS; ++i)
+            for (int k = 0; k < BENCH_TLB_CHAINS; ++k) cur[k] = *(void**)cur[k];
+        uint64_t t = bench_now() - t0;
+        if (r > 0 && (best == 0 || t < best)) best = t;
+    }
+    for (int k = 0; k < BENCH_TLB_CHAINS; ++k) g_sink = cur[k];
+    double secs = (double)best / bench_hz();
+    return secs > 0 ? (double)CHAIN_LOADS * BENCH_TLB_CHAINS * BENCH_LAT_LINE / secs / 1e9 : 0;
+}
+
+static char *alloc_kind(BenchTlbResult *out, int kind, size_t bytes) {
+    size_t page = 0;
+    char *p = NULL;
+    if (kind == BENCH_PAGE_HUGE) {
+        if (!bench_huge_page_size()) { out->reason[kind] = bench_huge_pages_reason(); return NULL; }
+        if (bytes < ((size_t)1 << 30)) { out->reason[kind] = "memoria livre insuficiente para 1 GB"; return NULL; }
+        p = (char*)bench_pages_alloc_huge(bytes, BENCH_NODE_ANY);
+        page = (size_t)1 << 30;
+    } else {
+        if (kind == BENCH_PAGE_LARGE && !bench_large_pages_available()) {
+            out->reason[kind] = bench_large_pages_reason();
+            return NULL;
+        }
+        p = (char*)bench_pages_alloc(bytes, kind == BENCH_PAGE_LARGE, BENCH_NODE_ANY, &page);
+        if (p && kind == BENCH_PAGE_LARGE && page <= SMALL_PAGE) {
+            bench_pages_free(p);
+            p = NULL;
+        }
+    }
+    if (!p) { out->reason[kind] = "sem memoria fisica contigua livre"; return NULL; }
+    out->page_bytes[kind] = page;
+    return p;
+}
+
+bool bench_tlb_run(BenchTlbResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    out->ntlb = get_tlb_info(out->tlb, TLB_MAX);
+    out->cpuid_dtlb_4k = tlb_data_entries(out->tlb, out->ntlb, 1, TLB_PAGE_4K);
+    out->cpuid_stlb_4k = tlb_data_entries(out->tlb, out->ntlb, 2, TLB_PAGE_4K);
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    topology_pin_thread(GetCurrentThread(), topology_fastest_cpu(&topo));
+    double core_hz = bench_core_hz();
+    out->core_ghz = core_hz / 1e9;
+    double cycles_per_tick = core_hz / bench_hz();
+
+    sweep(out, cycles_per_tick, progress, ctx);
+    if (out->npoints == 0) return false;
+
+    // Buffer grande: BENCH_TLB_BUFFER_MB, até 1/4 da memória livre
+    size_t bytes = (size_t)BENCH_TLB_BUFFER_MB << 20;
+    MEMORYSTATUSEX ms;
+    ms.dwLength = sizeof(ms);
+    if (GlobalMemoryStatusEx(&ms) && bytes > ms.ullAvailPhys / 4)
+        bytes = (size_t)(ms.ullAvailPhys / 4) & ~(((size_t)2 << 20) - 1);
+    out->buffer_mb = (DWORD)(bytes >> 20);
+
+    double tick_ns = 1e9 / bench_hz();
+    char stage[32];
+    for (int kind = 0; kind < BENCH_PAGE_KINDS; ++kind) {
+        snprintf(stage, sizeof(stage), "paginas de %s", kind_names[kind]);
+        if (progress) progress(ctx, stage, 60 + 40 * kind / BENCH_PAGE_KINDS);
+        char *buf = alloc_kind(out, kind, bytes);
+        if (!buf) continue;
+        void *start = bench_chain_build(buf, bytes, BENCH_LAT_LINE, 0x2545F4914F6CDD1Dull);
+        if (start) {
+            out->available[kind] = true;
+            out->lat_ns[kind] = bench_chain_ticks(start, BIG_LOADS, REPS) * tick_ns;
+            out->gbs[kind] = random_read_gbs(buf, bytes);
+        } else {
+            out->reason[kind] = "sem memoria para montar a cadeia";
+        }
+        bench_pages_free(buf);
+    }
+    if (progress) progress(ctx, "done", 100);
+    return true;
+}
@@ -0,0 +1,70 @@
+// bench_tlb.h - Custo de acesso por tamanho de página e alcance das TLBs
+// Duas medições, numa thread fixada no núcleo mais rápido:
+//  - Varredura: cadeia aleatória com uma carga por página de 4 KB (linha
+//    deslocada a cada página, para não cair sempre no mesmo conjunto da cache),
+//    de 8 a 32768 páginas, feita em páginas de 4 KB e repetida com o mesmo
+//    layout em páginas grandes. As cargas e a ocupação das caches são iguais
+//    nas duas; a diferença por carga é o custo das faltas na TLB. O alcance
+//    medido da DTLB e da STLB é o último ponto antes de cada degrau.
+//  - Buffer grande (1 GB) percorrido aleatoriamente em páginas de 4 KB, 2 MB
+//    e 1 GB: latência (uma cadeia) e banda de leitura aleatória (16 cadeias
+//    independentes).
+// O resultado traz também as TLBs da CPUID para comparação.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "bench_common.h"
+#include "../cpu/cpu_tlb.h"
+
+#define BENCH_TLB_MIN_PAGES   8
+#define BENCH_TLB_MAX_PAGES   32768
+#define BENCH_TLB_MAX_POINTS  32
+#define BENCH_TLB_BUFFER_MB   1024
+#define BENCH_TLB_CHAINS      16
+
+enum {
+    BENCH_PAGE_4K = 0,
+    BENCH_PAGE_LARGE,       // 2 MB (GetLargePageMinimum)
+    BENCH_PAGE_HUGE,        // 1 GB
+    BENCH_PAGE_KINDS
+};
+
+typedef struct {
+    DWORD  pages;
+    double cycles_small;    // por carga, páginas de 4 KB
+    double cycles_large;    // por carga, páginas grandes (0 se indisponível)
+} BenchTlbPoint;
+
+typedef struct {
+    double        core_ghz;
+
+    // Varredura
+    BenchTlbPoint points[BENCH_TLB_MAX_POINTS];
+    DWORD         npoints;
+    bool          has_baseline;             // varredura em páginas grandes feita
+    const char   *baseline_reason;          // se !has_baseline
+    DWORD         dtlb_reach_pages;         // medido (0 = não determinado)
+    DWORD         stlb_reach_pages;
+    double        stlb_hit_cycles;          // custo extra por carga com acerto na STLB
+    double        walk_cycles;              // custo extra com page walk (maior ponto)
+
+    // Buffer grande
+    DWORD         buffer_mb;
+    bool          available[BENCH_PAGE_KINDS];
+    size_t        page_bytes[BENCH_PAGE_KINDS];
+    const char   *reason[BENCH_PAGE_KINDS];  // se !available
+    double        lat_ns[BENCH_PAGE_KINDS];
+    double        gbs[BENCH_PAGE_KINDS];
+
+    // CPUID
+    TlbInfo       tlb[TLB_MAX];
+    size_t        ntlb;
+    DWORD         cpuid_dtlb_4k;            // entradas da L1 DTLB para 4 KB
+    DWORD         cpuid_stlb_4k;
+} BenchTlbResult;
+
+bool bench_tlb_run(BenchTlbResult *out, BenchProgressFn progress, void *ctx);
+
+const char *bench_page_kind_name(int kind);
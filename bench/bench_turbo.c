@@ -0,0 +1,95 @@
+// bench_turbo.c - Clock sustentado x núcleos ativos (tabela de turbo)
+// A thread chamadora espera girando enquanto o pool roda; para não ligar um
+// núcleo a mais, ela fica fixada na outra thread SMT do primeiro núcleo ativo
+// (ou no próprio, sem SMT), que já conta como ativo em todos os degraus.
+#include "bench_turbo.h"
+#include "bench_isa.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_topology.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static bool has_count(const BenchTurboResult *r, DWORD n) {
+    for (DWORD i = 0; i < r->nsteps; ++i) if (r->steps[i].cores == n) return true;
+    return false;
+}
+
+static void add_count(BenchTurboResult *r, DWORD n) {
+    if (n == 0 || n > r->ncores || has_count(r, n) || r->nsteps >= BENCH_TURBO_MAX_STEPS) return;
+    DWORD i = r->nsteps++;
+    while (i > 0 && r->steps[i - 1].cores > n) { r->steps[i] = r->steps[i - 1]; --i; }
+    memset(&r->steps[i], 0, sizeof(r->steps[i]));
+    r->steps[i].cores = n;
+}
+
+// Onde a chamadora espera (bloqueada em bench_pool_run) durante um degrau: o
+// último núcleo físico, fora dos active primeiros; NULL se todos estão ativos,
+// e aí ela volta à afinidade original. Nunca um núcleo ativo nem a vizinha SMT
+// de um, que tiraria ciclos e clock da carga.
+static const CpuLogical *waiter_cpu(const CpuLogical *const *cores, DWORD ncores, DWORD active) {
+    return active < ncores ? cores[ncores - 1] : NULL;
+}
+
+bool bench_turbo_run(double seconds, bool vector, BenchTurboResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (seconds <= 0) seconds = BENCH_TURBO_DEFAULT_SECS;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *fastest = topology_fastest_cpu(&topo);
+    if (!fastest) return false;
+
+    // Núcleos físicos, classe de eficiência decrescente e ordem da topologia dentro dela
+    static const CpuLogical *cores[CPU_TOPO_MAX];
+    for (int e = topo.max_efficiency; e >= 0; --e)
+        for (DWORD i = 0; i < topo.count; ++i)
+            if (topo.cpus[i].smt == 0 && topo.cpus[i].efficiency == e) cores[out->ncores++] = &topo.cpus[i];
+    if (out->ncores == 0) return false;
+    for (DWORD i = 0; i < out->ncores; ++i)
+        if (cores[i]->efficiency == topo.max_efficiency) out->fast_cores++;
+
+    // 1, 2, 4, ..., o fim dos núcleos rápidos e todos
+    for (DWORD n = 1; n < out->ncores; n *= 2) add_count(out, n);
+    add_count(out, out->fast_cores);
+    add_count(out, out->ncores);
+
+    out->measured[BENCH_VEC_SCALAR] = true;
+    if (vector) {
+        out->measured[BENCH_VEC_AVX2] = bench_isa_supported(BENCH_ISA_AVX2);
+        out->measured[BENCH_VEC_AVX512] = bench_isa_supported(BENCH_ISA_AVX512);
+    }
+
+    HANDLE self = GetCurrentThread();
+    GROUP_AFFINITY old;
+    bool restore = GetThreadGroupAffinity(self, &old) != FALSE;
+    topology_pin_thread(self, fastest);
+    out->idle_ghz = bench_core_hz() / 1e9;
+
+    int steps = 0, step = 0;
+    for (int v = 0; v < BENCH_VEC_VARIANTS; ++v) if (out->measured[v]) steps += out->nsteps;
+    char stage[32];
+    for (int v = 0; v < BENCH_VEC_VARIANTS; ++v) {
+        if (!out->measured[v]) continue;
+        for (DWORD i = 0; i < out->nsteps; ++i) {
+            BenchTurboStep *st = &out->steps[i];
+            snprintf(stage, sizeof(stage), "%s %u cores", bench_vec_variant_name(v), st->cores);
+            if (progress) progress(ctx, stage, 100 * step++ / steps);
+            const CpuLogical *waiter = waiter_cpu(cores, out->ncores, st->cores);
+            if (waiter) topology_pin_thread(self, waiter);
+            else if (restore) SetThreadGroupAffinity(self, &old, NULL);
+            BenchLicensePhase ph;
+            if (!bench_license_phase(v, cores, st->cores, seconds, &ph, &out->checksum)) {
+                if (restore) SetThreadGroupAffinity(self, &old, NULL);
+                return false;
+            }
+            st->ghz[v] = ph.ghz;
+            st->ghz_min[v] = ph.ghz_min;
+            Sleep(BENCH_TURBO_REST_MS);
+        }
+    }
+    if (restore) SetThreadGroupAffinity(self, &old, NULL);
+    if (progress) progress(ctx, "done", 100);
+    return out->steps[0].ghz[BENCH_VEC_SCALAR] > 0;
+}
@@ -0,0 +1,37 @@
+// bench_turbo.h - Clock sustentado x núcleos ativos (tabela de turbo)
+// Ativa 1, 2, 4, ... N núcleos físicos (os de maior classe de eficiência
+// primeiro) com a carga de ponto flutuante de bench_license e mede o clock
+// efetivo de cada núcleo ativo enquanto a carga roda. A carga escalar é sempre
+// medida; AVX2 e AVX-512 são opcionais, porque várias CPUs têm degraus de
+// turbo próprios para vetores largos. O "Max" do processador é o degrau de um
+// núcleo; a tabela mostra quanto sobra com a concorrência real.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "bench_license.h"
+
+#define BENCH_TURBO_DEFAULT_SECS  1.0       // por degrau e variante
+#define BENCH_TURBO_MAX_STEPS     24
+#define BENCH_TURBO_REST_MS       300       // pausa entre degraus: o turbo volta ao degrau de 1 núcleo
+
+typedef struct {
+    DWORD  cores;                           // núcleos físicos ativos
+    double ghz[BENCH_VEC_VARIANTS];         // média das medianas dos núcleos ativos (0 = não medido)
+    double ghz_min[BENCH_VEC_VARIANTS];     // núcleo mais lento
+} BenchTurboStep;
+
+typedef struct {
+    DWORD          ncores;                  // núcleos físicos usados
+    DWORD          fast_cores;              // de maior classe de eficiência (os primeiros da ordem)
+    bool           measured[BENCH_VEC_VARIANTS];
+    double         idle_ghz;                // núcleo mais rápido antes das cargas
+    DWORD          nsteps;
+    BenchTurboStep steps[BENCH_TURBO_MAX_STEPS];
+    uint64_t       checksum;
+} BenchTurboResult;
+
+// vector: também mede AVX2 e AVX-512 (as que a CPU e o SO suportam)
+bool bench_turbo_run(double seconds, bool vector, BenchTurboResult *out, BenchProgressFn progress, void *ctx);
@@ -0,0 +1,342 @@
+// bench_wake.c - Latência de saída do ocioso e subida do clock
+// A thread chamadora é a que acorda: ela fica fixada no núcleo escolhido para
+// isso, dorme a maior parte de esperas longas num timer de alta resolução (o
+// Sleep comum arredonda para o tick de ~15,6 ms) e gira o final, para sinalizar
+// na hora certa. Sem esse timer, gira o último tick inteiro; o tempo ocioso
+// obtido é medido em toda acordada. A thread que dorme é criada a cada tempo
+// de ociosidade; ela lê os contadores de residência antes de dormir e depois
+// da janela de subida do clock (o trabalho da janela não soma residência).
+#include "bench_wake.h"
+#include "bench_timer.h"
+#include "../cpu/cpu_basic.h"
+#include "../cpu/cpu_msr.h"
+
+#include <powrprof.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPIN_MS     1           // esperas: timer de alta resolução até faltar isso, depois gira
+#define COARSE_MS   16          // idem com o timer comum (um tick)
+#define SETTLE_MS   500         // depois de trocar de plano de energia
+
+static const DWORD default_idle_us[] = { 50, 200, 1000, 5000, 20000, 100000 };
+static const DWORD bin_end_us[BENCH_WAKE_BINS] = { 10, 25, 50, 100, 250, 500, 1000, BENCH_WAKE_RAMP_US };
+static const char *const state_names[BENCH_WAKE_STATES] = { "C1", "C3", "C6", "C7", "?" };
+static const DWORD state_msrs[3] = { MSR_CORE_C3_RESIDENCY, MSR_CORE_C6_RESIDENCY, MSR_CORE_C7_RESIDENCY };
+
+// Configurações do processador no plano (winnt.h, repetidas para não depender de initguid)
+static const GUID sub_processor  = { 0x54533251, 0x82be, 0x4824, { 0x96, 0xc1, 0x47, 0xb6, 0x0b, 0x74, 0x0d, 0x00 } };
+static const GUID set_min_state  = { 0x893dee8e, 0x2bef, 0x41e0, { 0x89, 0xc6, 0xb5, 0x5d, 0x09, 0x29, 0x96, 0x4c } };
+static const GUID set_idle_off   = { 0x5d76a2ca, 0xe8c0, 0x402f, { 0xa1, 0x33, 0x21, 0x58, 0x49, 0x2d, 0x58, 0xad } };
+static const GUID set_boost_mode = { 0xbe337238, 0x0d82, 0x4146, { 0xa9, 0x60, 0x4f, 0x37, 0x49, 0xd4, 0x70, 0xc7 } };
+
+const char *bench_wake_state_name(int state) {
+    return state >= 0 && state < BENCH_WAKE_STATES ? state_names[state] : "?";
+}
+
+DWORD bench_wake_bin_end_us(int bin) {
+    return bin >= 0 && bin < BENCH_WAKE_BINS ? bin_end_us[bin] : 0;
+}
+
+typedef struct {
+    const CpuLogical *cpu;
+    HANDLE            event;
+    HANDLE            timer;
+    bool              hires;
+    DWORD             samples;
+    bool              msr[3];       // quais contadores de residência leem
+    volatile LONG     armed;        // última acordada armada pela thread que dorme
+    volatile LONG     done;         // última acordada medida
+    volatile uint64_t t_set;        // bench_now() do SetEvent
+    double            hot_hz;
+    double            lat_us[BENCH_WAKE_MAX_SAMPLES];
+    double            idle_us[BENCH_WAKE_MAX_SAMPLES];  // obtido
+    double            first_ghz[BENCH_WAKE_MAX_SAMPLES];
+    double            ramp_us[BENCH_WAKE_MAX_SAMPLES];  // só as que chegaram
+    DWORD             nramp;
+    int               state[BENCH_WAKE_MAX_SAMPLES];
+    double            bin_sum[BENCH_WAKE_BINS];
+    DWORD             bin_n[BENCH_WAKE_BINS];
+} WakeShared;
+
+static bool read_residency(const WakeShared *sh, uint64_t r[3]) {
+    DWORD index[3];
+    uint64_t v[3];
+    int n = 0;
+    for (int i = 0; i < 3; ++i) if (sh->msr[i]) index[n++] = state_msrs[i];
+    if (n == 0 || !msr_read_group(sh->cpu->number, index, v, n)) return false;
+    for (int i = 0, k = 0; i < 3; ++i) r[i] = sh->msr[i] ? v[k++] : 0;
+    return true;
+}
+
+// Estado em que o núcleo passou mais tempo na espera
+static int classify(const uint64_t r0[3], const uint64_t r1[3]) {
+    int best = -1;
+    uint64_t most = 0;
+    for (int i = 0; i < 3; ++i)
+        if (r1[i] > r0[i] && r1[i] - r0[i] > most) { most = r1[i] - r0[i]; best = i; }
+    return best < 0 ? BENCH_WAKE_C1 : BENCH_WAKE_C3 + best;
+}
+
+// Subida do clock: amostras curtas até o fim da janela
+static void trace_ramp(WakeShared *sh, DWORD s, uint64_t t_wake) {
+    double hz = bench_hz();
+    uint64_t end = t_wake + (uint64_t)(hz * BENCH_WAKE_RAMP_US / 1e6);
+    bool reached = false;
+    int bin = 0;
+    for (uint64_t now = t_wake; now < end; ) {
+        double ghz = bench_core_hz_quick() / 1e9;
+        now = bench_now();
+        double us = (double)(now - t_wake) * 1e6 / hz;
+        if (s < sh->samples && sh->first_ghz[s] == 0) sh->first_ghz[s] = ghz;
+        if (!reached && ghz * 1e9 >= sh->hot_hz * BENCH_WAKE_RAMP_PCT / 100) {
+            sh->ramp_us[sh->nramp++] = us;
+            reached = true;
+        }
+        while (bin < BENCH_WAKE_BINS - 1 && us > bin_end_us[bin]) bin++;
+        sh->bin_sum[bin] += ghz;
+        sh->bin_n[bin]++;
+    }
+}
+
+static DWORD WINAPI sleeper_thread(LPVOID param) {
+    WakeShared *sh = (WakeShared*)param;
+    topology_pin_thread(GetCurrentThread(), sh->cpu);
+    sh->hot_hz = bench_core_hz();
+    for (DWORD s = 0; s < sh->samples; ++s) {
+        uint64_t r0[3], r1[3];
+        bool msr = read_residency(sh, r0);
+        InterlockedExchange(&sh->armed, (LONG)s + 1);
+        WaitForSingleObject(sh->event, INFINITE);
+        uint64_t t_wake = bench_now();
+        sh->lat_us[s] = (double)(t_wake - sh->t_set) * 1e6 / bench_hz();
+        trace_ramp(sh, s, t_wake);
+        sh->state[s] = msr && read_residency(sh, r1) ? classify(r0, r1) : BENCH_WAKE_UNKNOWN;
+        InterlockedExchange(&sh->done, (LONG)s + 1);
+    }
+    return 0;
+}
+
+// Espera até o instante due (ticks de bench_now): dorme o grosso no timer, gira o fim
+static uint64_t wait_until(const WakeShared *sh, uint64_t due) {
+    double hz = bench_hz();
+    uint64_t now = bench_now();
+    double slack = sh->hires ? SPIN_MS : COARSE_MS;
+    if (due > now) {
+        double ms = (double)(due - now) * 1000.0 / hz;
+        if (ms > slack) {
+            LARGE_INTEGER rel;
+            rel.QuadPart = -(LONGLONG)((ms - slack) * 10000.0);    // negativo = relativo, 100 ns
+            if (SetWaitableTimer(sh->timer, &rel, 0, NULL, NULL, FALSE))
+                WaitForSingleObject(sh->timer, INFINITE);
+        }
+    }
+    while ((now = bench_now()) < due) YieldProcessor();
+    return now;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+static double median(double *v, DWORD n) {
+    if (n == 0) return 0;
+    qsort(v, n, sizeof(double), cmp_double);
+    return v[n / 2];
+}
+
+static void summarize(WakeShared *sh, BenchWakeIdle *r) {
+    static double tmp[BENCH_WAKE_MAX_SAMPLES];
+    DWORD n = sh->samples;
+    r->samples = n;
+    for (int st = 0; st < BENCH_WAKE_STATES; ++st) {
+        DWORD k = 0;
+        for (DWORD s = 0; s < n; ++s) if (sh->state[s] == st) tmp[k++] = sh->lat_us[s];
+        r->state_count[st] = k;
+        r->state_lat_us[st] = median(tmp, k);
+    }
+    memcpy(tmp, sh->idle_us, n * sizeof(double));
+    r->idle_real_us = median(tmp, n);
+    memcpy(tmp, sh->lat_us, n * sizeof(double));
+    r->lat_us = median(tmp, n);
+    r->lat_p99_us = tmp[(DWORD)((n - 1) * 0.99)];
+    memcpy(tmp, sh->first_ghz, n * sizeof(double));
+    r->first_ghz = median(tmp, n);
+    r->ramp_reached = sh->nramp;
+    r->ramp_us = median(sh->ramp_us, sh->nramp);
+    for (int b = 0; b < BENCH_WAKE_BINS; ++b)
+        r->bin_ghz[b] = sh->bin_n[b] ? sh->bin_sum[b] / sh->bin_n[b] : 0;
+}
+
+// Um tempo de ociosidade no plano atual
+static bool measure_idle(WakeShared *sh, DWORD idle_us, BenchWakeIdle *r) {
+    HANDLE event = sh->event, timer = sh->timer;
+    bool hires = sh->hires;
+    const CpuLogical *cpu = sh->cpu;
+    DWORD samples = sh->samples;
+    bool msr[3];
+    memcpy(msr, sh->msr, sizeof(msr));
+    memset(sh, 0, sizeof(*sh));
+    sh->event = event;
+    sh->timer = timer;
+    sh->hires = hires;
+    sh->cpu = cpu;
+    sh->samples = samples;
+    memcpy(sh->msr, msr, sizeof(msr));
+
+    HANDLE h = CreateThread(NULL, 0, sleeper_thread, sh, 0, NULL);
+    if (!h) return false;
+    double hz = bench_hz();
+    uint64_t idle = (uint64_t)(hz * idle_us / 1e6);
+    for (DWORD s = 0; s < samples; ++s) {
+        while (sh->armed != (LONG)s + 1) YieldProcessor();
+        uint64_t t_arm = bench_now();
+        uint64_t t_set = wait_until(sh, t_arm + idle);
+        sh->t_set = t_set;
+        sh->idle_us[s] = (double)(t_set - t_arm) * 1e6 / hz;
+        SetEvent(event);
+        while (sh->done != (LONG)s + 1) Sleep(0);
+    }
+    WaitForSingleObject(h, INFINITE);
+    CloseHandle(h);
+    r->idle_us = idle_us;
+    summarize(sh, r);
+    return true;
+}
+
+static void read_plan(const GUID *scheme, bool dc, BenchWakePlan *p) {
+    DWORD size = sizeof(p->name);
+    if (PowerReadFriendlyName(NULL, scheme, NULL, NULL, (UCHAR*)p->name, &size) != ERROR_SUCCESS)
+        wcscpy(p->name, L"?");
+    DWORD (WINAPI *read)(HKEY, const GUID*, const GUID*, const GUID*, LPDWORD) =
+        dc ? PowerReadDCValueIndex : PowerReadACValueIndex;
+    DWORD min_state = 0, idle_off = 0, boost = 0;
+    p->settings_ok = read(NULL, scheme, &sub_processor, &set_min_state, &min_state) == ERROR_SUCCESS;
+    read(NULL, scheme, &sub_processor, &set_idle_off, &idle_off);
+    read(NULL, scheme, &sub_processor, &set_boost_mode, &boost);
+    p->min_state_pct = min_state;
+    p->idle_disabled = idle_off != 0;
+    p->boost_mode = boost;
+}
+
+// Outro núcleo físico para a thread que acorda: o irmão SMT do alvo o manteria acordado
+static const CpuLogical *pick_waker(const CpuTopology *topo, const CpuLogical *target) {
+    for (DWORD i = 0; i < topo->count; ++i) {
+        const CpuLogical *c = &topo->cpus[i];
+        if (c->smt == 0 && (c->package != target->package || c->core != target->core)) return c;
+    }
+    return NULL;
+}
+
+static bool measure_plan(WakeShared *sh, const DWORD *idle_us, DWORD nidle, const volatile LONG *stop,
+                         BenchWakePlan *p, int *step, int steps, BenchProgressFn progress, void *ctx) {
+    char stage[48];
+    for (DWORD i = 0; i < nidle && !(stop && *stop); ++i) {
+        snprintf(stage, sizeof(stage), "%ls %lu us", p->name, (unsigned long)idle_us[i]);
+        if (progress) progress(ctx, stage, 100 * (*step)++ / steps);
+        if (!measure_idle(sh, idle_us[i], &p->idle[p->nidle])) return false;
+        if (p->nidle == 0) p->hot_ghz = sh->hot_hz / 1e9;
+        p->nidle++;
+    }
+    return true;
+}
+
+bool bench_wake_run(const DWORD *idle_us, DWORD nidle, DWORD samples, bool all_plans, const volatile LONG *stop,
+                    BenchWakeResult *out, BenchProgressFn progress, void *ctx) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (!idle_us || nidle == 0) {
+        idle_us = default_idle_us;
+        nidle = sizeof(default_idle_us) / sizeof(default_idle_us[0]);
+    }
+    if (nidle > BENCH_WAKE_MAX_IDLES) nidle = BENCH_WAKE_MAX_IDLES;
+    if (samples == 0) samples = BENCH_WAKE_DEFAULT_SAMPLES;
+    if (samples > BENCH_WAKE_MAX_SAMPLES) samples = BENCH_WAKE_MAX_SAMPLES;
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) return false;
+    const CpuLogical *target = topology_fastest_cpu(&topo);
+    const CpuLogical *waker = target ? pick_waker(&topo, target) : NULL;
+    if (!waker) return false;
+    out->target = *target;
+    out->waker = *waker;
+    topology_pin_thread(GetCurrentThread(), waker);
+
+    static WakeShared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.cpu = &out->target;
+    sh.samples = samples;
+
+    // Contadores de residência: Intel, driver de MSR, processador no grupo 0
+    char vendor[13];
+    get_cpu_vendor(vendor);
+    if (strcmp(vendor, "GenuineIntel") != 0) out->state_reason = "contadores de residencia so na Intel";
+    else if (!msr_available()) out->state_reason = msr_unavailable_reason();
+    else if (target->group != 0) out->state_reason = "nucleo fora do grupo 0";
+    else {
+        for (int i = 0; i < 3; ++i) {
+            uint64_t v;
+            sh.msr[i] = msr_read(target->number, state_msrs[i], &v);
+            if (sh.msr[i]) out->state_msr = true;
+        }
+        if (!out->state_msr) out->state_reason = "MSR de residencia nao suportado";
+    }
+
+    SYSTEM_POWER_STATUS ps;
+    out->on_battery = GetSystemPowerStatus(&ps) && ps.ACLineStatus == 0;
+
+    sh.event = CreateEventW(NULL, FALSE, FALSE, NULL);
+    sh.timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    sh.hires = sh.timer != NULL;
+    if (!sh.timer) sh.timer = CreateWaitableTimerW(NULL, FALSE, NULL);
+    if (!sh.event || !sh.timer) {
+        if (sh.event) CloseHandle(sh.event);
+        if (sh.timer) CloseHandle(sh.timer);
+        return false;
+    }
+    out->hires_timer = sh.hires;
+
+    GUID *active = NULL;
+    if (PowerGetActiveScheme(NULL, &active) != ERROR_SUCCESS) active = NULL;
+
+    // Planos: só o ativo, ou todos os instalados (até BENCH_WAKE_MAX_PLANS)
+    GUID schemes[BENCH_WAKE_MAX_PLANS];
+    DWORD nschemes = 0;
+    if (all_plans && active) {
+        for (ULONG i = 0; nschemes < BENCH_WAKE_MAX_PLANS; ++i) {
+            DWORD size = sizeof(GUID);
+            if (PowerEnumerate(NULL, NULL, NULL, ACCESS_SCHEME, i, (UCHAR*)&schemes[nschemes], &size) != ERROR_SUCCESS) break;
+            nschemes++;
+        }
+    }
+
+    bool ok = true;
+    int steps = (int)(nidle * (nschemes ? nschemes : 1)), step = 0;
+    if (nschemes == 0) {
+        BenchWakePlan *p = &out->plans[out->nplans++];
+        if (active) read_plan(active, out->on_battery, p);
+        else wcscpy(p->name, L"?");
+        out->plans_restored = true;     // nenhum plano foi trocado
+        ok = measure_plan(&sh, idle_us, nidle, stop, p, &step, steps, progress, ctx);
+    } else {
+        // O plano é do sistema e persiste: o ativo volta mesmo com falha ou interrupção
+        for (DWORD i = 0; ok && i < nschemes && !(stop && *stop); ++i) {
+            BenchWakePlan *p = &out->plans[out->nplans++];
+            read_plan(&schemes[i], out->on_battery, p);
+            if (PowerSetActiveScheme(NULL, &schemes[i]) != ERROR_SUCCESS) { out->nplans--; step += nidle; continue; }
+            Sleep(SETTLE_MS);
+            ok = measure_plan(&sh, idle_us, nidle, stop, p, &step, steps, progress, ctx);
+        }
+        out->plans_restored = PowerSetActiveScheme(NULL, active) == ERROR_SUCCESS;
+    }
+    if (active) LocalFree(active);
+    CloseHandle(sh.event);
+    CloseHandle(sh.timer);
+    out->interrupted = stop && *stop;
+    // Interrompido antes do primeiro tempo de um plano: o plano fica fora do resultado
+    while (out->nplans > 0 && out->plans[out->nplans - 1].nidle == 0) out->nplans--;
+    if (progress) progress(ctx, "done", 100);
+    return ok && out->nplans > 0;
+}
@@ -0,0 +1,86 @@
+// bench_wake.h - Latência de saída do ocioso e subida do clock
+// Uma thread fixada no núcleo mais rápido dorme num evento; outra, noutro
+// núcleo físico, espera o tempo de ociosidade pedido e sinaliza o evento. A
+// latência vai do SetEvent até a thread acordada ler o relógio (agendador do
+// SO + saída do estado ocioso). Logo depois de acordar, a thread amostra o
+// clock a cada poucos microssegundos por BENCH_WAKE_RAMP_US e registra quanto
+// tempo levou para chegar a 90% do clock com o núcleo já quente.
+// Cada acordada é classificada pelo estado ocioso em que o núcleo passou mais
+// tempo (contadores de residência C3/C6/C7 da Intel, via MSR; C1 quando
+// nenhum andou). O equivalente no Windows ao "governor" é o plano de energia:
+// o plano ativo é lido (estado mínimo do processador, ocioso desabilitado,
+// modo de boost) e, a pedido, a medição se repete em cada plano instalado,
+// restaurando o ativo no fim.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "../cpu/cpu_topology.h"
+
+#define BENCH_WAKE_MAX_IDLES      8
+#define BENCH_WAKE_MAX_SAMPLES    200
+#define BENCH_WAKE_DEFAULT_SAMPLES 40       // acordadas por tempo de ociosidade
+#define BENCH_WAKE_MAX_PLANS      8
+#define BENCH_WAKE_RAMP_US        5000      // janela da subida do clock
+#define BENCH_WAKE_RAMP_PCT       90.0
+#define BENCH_WAKE_BINS           8         // faixas da curva de subida
+
+enum {
+    BENCH_WAKE_C1 = 0,          // nenhum contador de C3+ andou na espera
+    BENCH_WAKE_C3,
+    BENCH_WAKE_C6,
+    BENCH_WAKE_C7,
+    BENCH_WAKE_UNKNOWN,         // sem os contadores (MSR indisponível, AMD)
+    BENCH_WAKE_STATES
+};
+
+typedef struct {
+    DWORD  idle_us;                             // pedido
+    double idle_real_us;                        // mediana do obtido (thread pronta -> SetEvent)
+    DWORD  samples;
+    double lat_us;                              // mediana SetEvent -> thread rodando
+    double lat_p99_us;
+    double first_ghz;                           // mediana da primeira amostra de clock
+    double ramp_us;                             // mediana do tempo até BENCH_WAKE_RAMP_PCT do clock quente
+    DWORD  ramp_reached;                        // acordadas que chegaram lá dentro da janela
+    double bin_ghz[BENCH_WAKE_BINS];            // clock médio em cada faixa depois de acordar
+    DWORD  state_count[BENCH_WAKE_STATES];
+    double state_lat_us[BENCH_WAKE_STATES];     // mediana da latência por estado
+} BenchWakeIdle;
+
+typedef struct {
+    wchar_t       name[64];                     // nome amigável do plano de energia
+    bool          settings_ok;
+    DWORD         min_state_pct;                // estado mínimo do processador
+    bool          idle_disabled;                // "idle=poll": o núcleo nunca entra em estado ocioso
+    DWORD         boost_mode;                   // 0 = desabilitado, 1 = habilitado, 2 = agressivo...
+    double        hot_ghz;                      // clock do núcleo já quente
+    DWORD         nidle;
+    BenchWakeIdle idle[BENCH_WAKE_MAX_IDLES];
+} BenchWakePlan;
+
+typedef struct {
+    CpuLogical    target;                       // núcleo que dorme
+    CpuLogical    waker;
+    bool          on_battery;                   // valores DC do plano em vez de AC
+    bool          state_msr;                    // contadores de residência disponíveis
+    const char   *state_reason;                 // se state_msr == false
+    bool          hires_timer;                  // espera com timer de alta resolução (senão, giro mais longo)
+    bool          plans_restored;               // plano original de volta (com all_plans)
+    bool          interrupted;                  // *stop ligado: parou entre dois tempos de ociosidade
+    DWORD         nplans;
+    BenchWakePlan plans[BENCH_WAKE_MAX_PLANS];
+} BenchWakeResult;
+
+// idle_us: tempos de ociosidade (NULL = padrão); all_plans: repete em cada plano de energia.
+// stop (opcional) é conferido entre dois tempos de ociosidade; o plano ativo é
+// restaurado também quando a medição é interrompida.
+bool bench_wake_run(const DWORD *idle_us, DWORD nidle, DWORD samples, bool all_plans, const volatile LONG *stop,
+                    BenchWakeResult *out, BenchProgressFn progress, void *ctx);
+
+const char *bench_wake_state_name(int state);
+
+// Limite superior, em us depois de acordar, da faixa bin de bin_ghz
+DWORD bench_wake_bin_end_us(int bin);
@@ -0,0 +1,1855 @@
+// cli_win.c - Versão de linha de comando (cpuz-cli)
+// Modos de uso contínuo/sem janela: monitoramento dos sensores, benchmarks, etc.
+#define _CRT_SECURE_NO_WARNINGS
+#include <windows.h>
+#include <wchar.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "monitor/monitor_sampler.h"
+#include "monitor/monitor_ring.h"
+#include "monitor/monitor_sensors.h"
+#include "monitor/monitor_recorder.h"
+#include "monitor/monitor_query.h"
+#include "monitor/monitor_throttle.h"
+#include "cpu/cpu_clock.h"
+#include "cpu/cpu_msr.h"
+#include "cpu/cpu_counters.h"
+#include "cpu/cpu_features.h"
+#include "bench/bench_cpu.h"
+#include "bench/bench_refdb.h"
+#include "bench/bench_stats.h"
+#include "bench/bench_providers.h"
+#include "bench/bench_timer.h"
+#include "bench/bench_pages.h"
+#include "bench/bench_memory.h"
+#include "bench/bench_license.h"
+#include "bench/bench_stress.h"
+#include "bench/bench_latency.h"
+#include "bench/bench_cachebw.h"
+#include "bench/bench_cachegeo.h"
+#include "bench/bench_c2c.h"
+#include "bench/bench_numa.h"
+#include "bench/bench_loaded.h"
+#include "bench/bench_smt.h"
+#include "bench/bench_atomic.h"
+#include "bench/bench_turbo.h"
+#include "bench/bench_wake.h"
+#include "bench/bench_tlb.h"
+
+// O sampler publica no anel; os consumidores leem no seu próprio ritmo
+static void ring_sink(void *ctx, const SensorSample *samples, size_t count) {
+    ring_publish_batch((SampleRing*)ctx, samples, count);
+}
+
+static void print_sampler_stats(Sampler *s) {
+    SamplerStats st;
+    sampler_get_stats(s, &st);
+    printf("| ----------------------------------------------\n");
+    printf("| Sampler\n");
+    printf("| %-22s : %llu\n", "Wakeups", (unsigned long long)st.wakeups);
+    printf("| %-22s : %llu\n", "Sensor reads", (unsigned long long)st.reads);
+    printf("| %-22s : %llu\n", "Samples", (unsigned long long)st.samples);
+    printf("| %-22s : %llu\n", "Late ticks", (unsigned long long)st.late_ticks);
+    printf("| %-22s : %.1f ms em %.1f s\n", "CPU time", st.cpu_ms, st.wall_ms / 1000.0);
+    printf("| %-22s : %.4f%% de um nucleo (orcamento %.1f%%)%s\n", "Overhead",
+           st.overhead_pct, SAMPLER_BUDGET_PCT, st.over_budget ? "  ACIMA DO ORCAMENTO" : "");
+}
+
+// cpuz-cli monitor [segundos]
+static int cmd_monitor(int argc, wchar_t **argv) {
+    int seconds = argc > 0 ? _wtoi(argv[0]) : 10;
+    if (seconds <= 0) seconds = 10;
+
+    static Sampler sampler;
+    static SampleRing ring;
+    static SensorSample buf[4096];
+    if (!ring_init(&ring, 65536)) {
+        fprintf(stderr, "monitor: memoria insuficiente\n");
+        return 1;
+    }
+    sampler_init(&sampler, ring_sink, &ring);
+    RingReader rd;
+    ring_reader_init(&ring, &rd, false);
+    if (sensors_register_defaults(&sampler) == 0 || !sampler_start(&sampler)) {
+        fprintf(stderr, "monitor: nao foi possivel iniciar o sampler\n");
+        ring_free(&ring);
+        return 1;
+    }
+
+    for (int t = 1; t <= seconds; ++t) {
+        Sleep(1000);
+        // Resumo do último segundo: média e máximo de cada sensor
+        double sum[SAMPLER_MAX_SENSORS] = {0}, max[SAMPLER_MAX_SENSORS] = {0};
+        int count[SAMPLER_MAX_SENSORS] = {0};
+        size_t n;
+        while ((n = ring_read(&ring, &rd, buf, sizeof(buf)/sizeof(buf[0]))) > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                int s = buf[i].sensor;
+                sum[s] += buf[i].value;
+                if (buf[i].value > max[s]) max[s] = buf[i].value;
+                count[s]++;
+            }
+        }
+        printf("%4ds", t);
+        for (int s = 0; s < sampler.nsensors; ++s) {
+            if (count[s] == 0) continue;
+            printf("  %s avg %.1f max %.1f", sampler_sensor_name(&sampler, s), sum[s] / count[s], max[s]);
+        }
+        printf("\n");
+    }
+
+    sampler_stop(&sampler);
+    print_sampler_stats(&sampler);
+    if (rd.lost) printf("| %-22s : %llu\n", "Lost samples", (unsigned long long)rd.lost);
+    ring_free(&ring);
+    return 0;
+}
+
+// cpuz-cli ring-bench [iteracoes]
+static int cmd_ring_bench(int argc, wchar_t **argv) {
+    long long it = argc > 0 ? _wtoi64(argv[0]) : 10000000;
+    if (it <= 0) it = 10000000;
+    RingBench b;
+    if (!ring_bench_publish((uint64_t)it, &b)) {
+        fprintf(stderr, "ring-bench: falhou\n");
+        return 1;
+    }
+    printf("| %-22s : %llu\n", "Publishes", (unsigned long long)b.iterations);
+    printf("| %-22s : %.1f ns\n", "Publish (no reader)", b.ns_per_publish);
+    printf("| %-22s : %.1f ns\n", "Publish (1 reader)", b.ns_per_publish_reader);
+    printf("| %-22s : %llu\n", "Reader lost", (unsigned long long)b.reader_lost);
+    bool ok = b.ns_per_publish < 100.0 && b.ns_per_publish_reader < 100.0;
+    printf("| %-22s : %s (limite 100 ns)\n", "Result", ok ? "OK" : "LENTO");
+    return ok ? 0 : 1;
+}
+
+static volatile LONG g_stop = 0;
+
+static BOOL WINAPI on_console_ctrl(DWORD type) {
+    (void)type;
+    InterlockedExchange(&g_stop, 1);
+    return TRUE;
+}
+
+// Reagrupa os registros do anel em frames (mesmo t_ns) e grava os completos
+static void drain_to_recorder(SampleRing *ring, RingReader *rd, Recorder *rec,
+                              SensorSample *frame, size_t *nframe) {
+    static SensorSample buf[4096];
+    size_t n;
+    while ((n = ring_read(ring, rd, buf, sizeof(buf)/sizeof(buf[0]))) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            if (*nframe && (buf[i].t_ns != frame[0].t_ns || *nframe == RECORD_MAX_SERIES)) {
+                recorder_append(rec, frame, *nframe);
+                *nframe = 0;
+            }
+            frame[(*nframe)++] = buf[i];
+        }
+    }
+}
+
+// cpuz-cli record <arquivo> [--max-mb N] [--seconds S]
+static int cmd_record(int argc, wchar_t **argv) {
+    if (argc < 1) {
+        fprintf(stderr, "uso: cpuz-cli record <arquivo> [--max-mb N] [--seconds S]\n");
+        return 2;
+    }
+    const wchar_t *path = argv[0];
+    uint64_t max_mb = RECORD_DEFAULT_MAX_MB;
+    int seconds = 0;    // 0 = até Ctrl+C
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--max-mb") == 0)       max_mb = (uint64_t)_wtoi64(argv[i + 1]);
+        else if (wcscmp(argv[i], L"--seconds") == 0) seconds = _wtoi(argv[i + 1]);
+    }
+
+    static Sampler sampler;
+    static SampleRing ring;
+    static Recorder rec;
+    static SensorSample frame[RECORD_MAX_SERIES];
+
+    if (!ring_init(&ring, 65536)) {
+        fprintf(stderr, "record: memoria insuficiente\n");
+        return 1;
+    }
+    sampler_init(&sampler, ring_sink, &ring);
+    sensors_register_defaults(&sampler);
+    if (!recorder_open(&rec, path, max_mb * 1024 * 1024, &sampler)) {
+        fprintf(stderr, "record: nao foi possivel abrir o arquivo (ou ele foi gravado com outros sensores)\n");
+        ring_free(&ring);
+        return 1;
+    }
+    RingReader rd;
+    ring_reader_init(&ring, &rd, false);
+    if (!sampler_start(&sampler)) {
+        fprintf(stderr, "record: nao foi possivel iniciar o sampler\n");
+        recorder_close(&rec);
+        ring_free(&ring);
+        return 1;
+    }
+    SetConsoleCtrlHandler(on_console_ctrl, TRUE);
+
+    size_t nframe = 0;
+    DWORD start = GetTickCount();
+    while (!g_stop && (seconds <= 0 || GetTickCount() - start < (DWORD)seconds * 1000)) {
+        Sleep(250);
+        drain_to_recorder(&ring, &rd, &rec, frame, &nframe);
+    }
+    sampler_stop(&sampler);
+    drain_to_recorder(&ring, &rd, &rec, frame, &nframe);
+    if (nframe) recorder_append(&rec, frame, nframe);
+
+    printf("| %-22s : %llu\n", "Samples", (unsigned long long)rec.samples_written);
+    printf("| %-22s : %llu bytes (%.2f bytes/amostra)\n", "Encoded", (unsigned long long)rec.bytes_written,
+           rec.samples_written ? (double)rec.bytes_written / (double)rec.samples_written : 0.0);
+    printf("| %-22s : %llu bytes\n", "Rollups", (unsigned long long)rec.rollup_bytes_written);
+    printf("| %-22s : %llu MB (%u + %u blocos de %u KB)\n", "Disk limit", (unsigned long long)max_mb,
+           rec.raw.hdr.max_blocks, rec.rollup.hdr.max_blocks, RECORD_BLOCK_SIZE / 1024);
+    if (rd.lost) printf("| %-22s : %llu\n", "Lost samples", (unsigned long long)rd.lost);
+    recorder_close(&rec);
+    print_sampler_stats(&sampler);
+    ring_free(&ring);
+    return 0;
+}
+
+// Instante em segundos Unix; negativo = relativo a agora (ex.: -3600)
+static uint64_t parse_time_ns(const wchar_t *arg) {
+    long long v = _wtoi64(arg);
+    if (v < 0) {
+        uint64_t back = (uint64_t)(-v) * 1000000000ULL, now = sampler_now_ns();
+        return back < now ? now - back : 1;
+    }
+    return (uint64_t)v * 1000000000ULL;
+}
+
+static void print_hist(const char *label, const RollupHist *h) {
+    printf("| %-22s : p50 %.1f  p99 %.1f  min %.1f  max %.1f  avg %.1f  (%llu amostras)\n", label,
+           rollup_hist_percentile(h, 50.0), rollup_hist_percentile(h, 99.0), h->min, h->max,
+           h->sum / (double)h->count, (unsigned long long)h->count);
+}
+
+// cpuz-cli query <arquivo> <sensor> [--cores A-B] [--from T1] [--to T2] [--per-core]
+static int cmd_query(int argc, wchar_t **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: cpuz-cli query <arquivo> <sensor> [--cores A-B] [--from T1] [--to T2] [--per-core]\n");
+        return 2;
+    }
+    char sensor[24];
+    wcstombs(sensor, argv[1], sizeof(sensor) - 1);
+    sensor[sizeof(sensor) - 1] = '\0';
+
+    QueryRequest q;
+    memset(&q, 0, sizeof(q));
+    q.sensor = sensor;
+    q.first_index = 0;
+    q.last_index = SAMPLER_MAX_VALUES - 1;
+    for (int i = 2; i < argc; ++i) {
+        if (wcscmp(argv[i], L"--per-core") == 0) { q.per_index = true; continue; }
+        if (i + 1 >= argc) break;
+        if (wcscmp(argv[i], L"--cores") == 0) {
+            int a = 0, b = 0;
+            int n = swscanf(argv[++i], L"%d-%d", &a, &b);
+            q.first_index = a;
+            q.last_index = n == 2 ? b : a;
+        }
+        else if (wcscmp(argv[i], L"--from") == 0) q.from_ns = parse_time_ns(argv[++i]);
+        else if (wcscmp(argv[i], L"--to") == 0)   q.to_ns = parse_time_ns(argv[++i]);
+    }
+
+    QueryResult r;
+    if (!query_run(argv[0], &q, &r)) {
+        fprintf(stderr, "query: nao foi possivel ler os resumos (arquivo, sensor ou faixa invalidos)\n");
+        return 1;
+    }
+    if (r.total.count == 0) {
+        printf("| %-22s : nenhuma amostra na janela\n", sensor);
+    } else {
+        time_t from = (time_t)(r.first_minute * 60), to = (time_t)(r.last_minute * 60 + 59);
+        char a[32], b[32];
+        strftime(a, sizeof(a), "%Y-%m-%d %H:%M", localtime(&from));
+        strftime(b, sizeof(b), "%Y-%m-%d %H:%M", localtime(&to));
+        printf("| %-22s : %s .. %s\n", "Window", a, b);
+        print_hist(sensor, &r.total);
+        for (int i = 0; r.per_index && i <= q.last_index - q.first_index; ++i) {
+            if (r.per_index[i].count == 0) continue;
+            char label[32];
+            snprintf(label, sizeof(label), "  #%d", q.first_index + i);
+            print_hist(label, &r.per_index[i]);
+        }
+    }
+    printf("| %-22s : %u lidos, %u pulados\n", "Blocks", r.blocks_read, r.blocks_skipped);
+    printf("| %-22s : %.2f ms\n", "Query time", r.elapsed_ms);
+    query_free(&r);
+    return 0;
+}
+
+static void print_throttle_event(void *ctx, const ThrottleEvent *ev) {
+    (void)ctx;
+    time_t secs = (time_t)(ev->t_ns / 1000000000ULL);
+    char when[16];
+    strftime(when, sizeof(when), "%H:%M:%S", localtime(&secs));
+    if (!ev->begin) {
+        printf("%s.%03u  core %u back from %s after %llu ms\n", when, (unsigned)(ev->t_ns / 1000000ULL % 1000),
+               ev->core, throttle_reason_name((ThrottleReason)ev->reason), (unsigned long long)ev->duration_ms);
+        return;
+    }
+    printf("%s.%03u  core %u throttled for reason %s (%.0f/%.0f MHz", when, (unsigned)(ev->t_ns / 1000000ULL % 1000),
+           ev->core, throttle_reason_name((ThrottleReason)ev->reason), ev->clock_mhz, ev->nominal_mhz);
+    if (ev->load_pct >= 0)  printf(", load %.0f%%", ev->load_pct);
+    if (ev->temp_c >= 0)    printf(", %.0f C", ev->temp_c);
+    if (ev->package_w >= 0) printf(", %.1f W", ev->package_w);
+    printf(")\n");
+}
+
+// cpuz-cli throttle [segundos]
+static int cmd_throttle(int argc, wchar_t **argv) {
+    int seconds = argc > 0 ? _wtoi(argv[0]) : 0;     // 0 = até Ctrl+C
+
+    DWORD cur = 0, nominal = 0, limit = 0;
+    if (!get_cpu0_clock(&cur, &nominal, &limit) || nominal == 0) {
+        fprintf(stderr, "throttle: nao foi possivel ler o clock nominal\n");
+        return 1;
+    }
+    printf("| %-22s : %lu MHz\n", "Nominal clock", (unsigned long)nominal);
+    printf("| %-22s : %s\n", "MSR (temp/limits/RAPL)", msr_available() ? "disponivel" : msr_unavailable_reason());
+
+    static Sampler sampler;
+    static SampleRing ring;
+    static ThrottleDetector det;
+    static SensorSample buf[4096];
+    if (!ring_init(&ring, 65536)) {
+        fprintf(stderr, "throttle: memoria insuficiente\n");
+        return 1;
+    }
+    sampler_init(&sampler, ring_sink, &ring);
+    sensors_register_defaults(&sampler);
+    throttle_init(&det, &sampler, (double)nominal, print_throttle_event, NULL);
+    RingReader rd;
+    ring_reader_init(&ring, &rd, false);
+    if (!sampler_start(&sampler)) {
+        fprintf(stderr, "throttle: nao foi possivel iniciar o sampler\n");
+        ring_free(&ring);
+        return 1;
+    }
+    SetConsoleCtrlHandler(on_console_ctrl, TRUE);
+
+    DWORD start = GetTickCount();
+    size_t n;
+    while (!g_stop && (seconds <= 0 || GetTickCount() - start < (DWORD)seconds * 1000)) {
+        Sleep(100);
+        while ((n = ring_read(&ring, &rd, buf, sizeof(buf)/sizeof(buf[0]))) > 0) throttle_feed(&det, buf, n);
+    }
+    sampler_stop(&sampler);
+    while ((n = ring_read(&ring, &rd, buf, sizeof(buf)/sizeof(buf[0]))) > 0) throttle_feed(&det, buf, n);
+    throttle_finish(&det, sampler_now_ns());
+
+    printf("| ----------------------------------------------\n");
+    printf("| Throttling (eventos, tempo somado dos nucleos)\n");
+    for (int r = THROTTLE_THERMAL; r < THROTTLE_REASONS; ++r) {
+        if (det.events[r] == 0) continue;
+        printf("| %-22s : %llu eventos, %.1f s\n", throttle_reason_name((ThrottleReason)r),
+               (unsigned long long)det.events[r], det.time_ms[r] / 1000.0);
+    }
+    print_sampler_stats(&sampler);
+    ring_free(&ring);
+    return 0;
+}
+
+// Sensores lidos a cada segundo durante o stress
+typedef struct {
+    SampleRing       *ring;
+    RingReader        rd;           // resumo do segundo e detector de throttling
+    RingReader        rec_rd;       // gravação em disco (--record)
+    Recorder         *rec;
+    SensorSample     *frame;
+    size_t            nframe;
+    ThrottleDetector *det;          // NULL sem clock nominal
+    int               s_clock, s_temp, s_power;
+    double            clock_min, clock_sum, temp_max, power_max, power_sum;
+    DWORD             clock_secs, power_secs;
+} StressMonitor;
+
+static int find_sensor(const Sampler *s, const char *name) {
+    for (int i = 0; i < s->nsensors; ++i)
+        if (strcmp(sampler_sensor_name(s, i), name) == 0) return i;
+    return -1;
+}
+
+static void stress_drain(StressMonitor *m, double *clock_avg, double *clock_min, double *temp, double *power) {
+    static SensorSample buf[4096];
+    double sum = 0;
+    int count = 0;
+    *clock_min = *temp = *power = -1;
+    if (m->rec) drain_to_recorder(m->ring, &m->rec_rd, m->rec, m->frame, &m->nframe);
+    size_t n;
+    while ((n = ring_read(m->ring, &m->rd, buf, sizeof(buf)/sizeof(buf[0]))) > 0) {
+        if (m->det) throttle_feed(m->det, buf, n);
+        for (size_t i = 0; i < n; ++i) {
+            const SensorSample *x = &buf[i];
+            if (x->sensor == m->s_clock && x->value > 0) {
+                sum += x->value;
+                count++;
+                if (*clock_min < 0 || x->value < *clock_min) *clock_min = x->value;
+            } else if (x->sensor == m->s_temp && x->value > *temp) {
+                *temp = x->value;
+            } else if (x->sensor == m->s_power && x->index == 0) {
+                *power = x->value;
+            }
+        }
+    }
+    *clock_avg = count ? sum / count : -1;
+}
+
+static bool stress_tick(void *ctx, const BenchStressStatus *st) {
+    StressMonitor *m = (StressMonitor*)ctx;
+    double clock, clock_min, temp, power;
+    stress_drain(m, &clock, &clock_min, &temp, &power);
+    printf("%5lus", (unsigned long)st->elapsed_s);
+    if (clock > 0) {
+        printf("  %5.0f MHz (min %5.0f)", clock, clock_min);
+        m->clock_sum += clock;
+        m->clock_secs++;
+        if (m->clock_min == 0 || clock_min < m->clock_min) m->clock_min = clock_min;
+    }
+    if (temp >= 0) {
+        printf("  %3.0f C", temp);
+        if (temp > m->temp_max) m->temp_max = temp;
+    }
+    if (power >= 0) {
+        printf("  %6.1f W", power);
+        m->power_sum += power;
+        m->power_secs++;
+        if (power > m->power_max) m->power_max = power;
+    }
+    uint64_t rounds = 0;
+    for (int k = 0; k < BENCH_STRESS_KERNELS; ++k) rounds += st->rounds[k];
+    printf("  rodadas %llu  erros %llu\n", (unsigned long long)rounds, (unsigned long long)st->errors);
+    fflush(stdout);
+    return !g_stop;
+}
+
+// cpuz-cli stress [--seconds S] [--record arq]
+static int cmd_stress(int argc, wchar_t **argv) {
+    DWORD seconds = BENCH_STRESS_DEFAULT_SECS;
+    const wchar_t *path = NULL;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--seconds") == 0)     seconds = (DWORD)_wtoi(argv[i + 1]);
+        else if (wcscmp(argv[i], L"--record") == 0) path = argv[i + 1];
+    }
+
+    static Sampler sampler;
+    static SampleRing ring;
+    static Recorder rec;
+    static ThrottleDetector det;
+    static SensorSample frame[RECORD_MAX_SERIES];
+    static StressMonitor m;
+    if (!ring_init(&ring, 65536)) {
+        fprintf(stderr, "stress: memoria insuficiente\n");
+        return 1;
+    }
+    sampler_init(&sampler, ring_sink, &ring);
+    sensors_register_defaults(&sampler);
+    memset(&m, 0, sizeof(m));
+    m.ring = &ring;
+    m.frame = frame;
+    m.s_clock = find_sensor(&sampler, SENSOR_NAME_CLOCK);
+    m.s_temp = find_sensor(&sampler, SENSOR_NAME_TEMP);
+    m.s_power = find_sensor(&sampler, SENSOR_NAME_POWER);
+    DWORD cur = 0, nominal = 0, limit = 0;
+    if (get_cpu0_clock(&cur, &nominal, &limit) && nominal > 0) {
+        throttle_init(&det, &sampler, (double)nominal, NULL, NULL);
+        m.det = &det;
+    }
+    if (path) {
+        if (!recorder_open(&rec, path, (uint64_t)RECORD_DEFAULT_MAX_MB * 1024 * 1024, &sampler)) {
+            fprintf(stderr, "stress: nao foi possivel abrir o arquivo (ou ele foi gravado com outros sensores)\n");
+            ring_free(&ring);
+            return 1;
+        }
+        m.rec = &rec;
+    }
+    ring_reader_init(&ring, &m.rd, false);
+    ring_reader_init(&ring, &m.rec_rd, false);
+    if (!sampler_start(&sampler)) {
+        fprintf(stderr, "stress: nao foi possivel iniciar o sampler\n");
+        if (m.rec) recorder_close(&rec);
+        ring_free(&ring);
+        return 1;
+    }
+    SetConsoleCtrlHandler(on_console_ctrl, TRUE);
+
+    BenchStressResult r;
+    bool ok = bench_stress_run(seconds, &r, stress_tick, &m);
+    sampler_stop(&sampler);
+    double clock, clock_min, temp, power;
+    stress_drain(&m, &clock, &clock_min, &temp, &power);
+    if (m.rec) {
+        if (m.nframe) recorder_append(&rec, frame, m.nframe);
+        recorder_close(&rec);
+    }
+    if (m.det) throttle_finish(&det, sampler_now_ns());
+    ring_free(&ring);
+    if (!ok) {
+        fprintf(stderr, "stress: nao foi possivel iniciar as threads ou alocar a memoria\n");
+        return 1;
+    }
+
+    printf("| ----------------------------------------------\n");
+    printf("| %-22s : %lu\n", "Threads", (unsigned long)r.threads);
+    printf("| %-22s : %lu de %lu s\n", "Duracao", (unsigned long)r.elapsed_s, (unsigned long)r.seconds);
+    printf("| %-22s : %s\n", "Variante fpu", bench_vec_variant_name(r.variant));
+    printf("| %-22s : %lu MB\n", "Memoria verificada", (unsigned long)r.memory_mb);
+    for (int k = 0; k < BENCH_STRESS_KERNELS; ++k)
+        printf("| %-22s : %llu rodadas, %llu erros\n", bench_stress_kernel_name(k),
+               (unsigned long long)r.rounds[k], (unsigned long long)r.errors[k]);
+    if (m.clock_secs)
+        printf("| %-22s : media %.0f MHz, minimo %.0f MHz\n", "Clock", m.clock_sum / m.clock_secs, m.clock_min);
+    if (m.temp_max > 0) printf("| %-22s : %.0f C\n", "Temperatura maxima", m.temp_max);
+    else printf("| %-22s : %s\n", "Temperatura/potencia", msr_available() ? "sem leitura" : msr_unavailable_reason());
+    if (m.power_secs)
+        printf("| %-22s : media %.1f W, maxima %.1f W\n", "Potencia do pacote", m.power_sum / m.power_secs, m.power_max);
+
+    printf("| ----------------------------------------------\n");
+    printf("| Throttling (eventos, tempo somado dos nucleos)\n");
+    int shown = 0;
+    for (int t = THROTTLE_THERMAL; m.det && t < THROTTLE_REASONS; ++t) {
+        if (det.events[t] == 0) continue;
+        printf("| %-22s : %llu eventos, %.1f s\n", throttle_reason_name((ThrottleReason)t),
+               (unsigned long long)det.events[t], det.time_ms[t] / 1000.0);
+        shown++;
+    }
+    if (!m.det) printf("| %-22s : clock nominal desconhecido\n", "Indisponivel");
+    else if (!shown) printf("| %-22s : nenhum\n", "Eventos");
+
+    printf("| ----------------------------------------------\n");
+    if (r.has_error)
+        printf("| %-22s : processador %lu, %s, rodada %llu\n", "Primeiro erro", (unsigned long)r.first_error_thread,
+               bench_stress_kernel_name(r.first_error_kernel), (unsigned long long)r.first_error_round);
+    printf("| %-22s : %s\n", "Resultado", r.passed ? "APROVADO" : r.has_error ? "REPROVADO" : "INTERROMPIDO");
+    return r.passed ? 0 : r.has_error ? 3 : 1;
+}
+
+// cpuz-cli counters [segundos]
+static int cmd_counters(int argc, wchar_t **argv) {
+    int seconds = argc > 0 ? _wtoi(argv[0]) : 5;
+    if (seconds <= 0) seconds = 5;
+
+    static CpuCounters pmu;
+    static CpuCounterRates rates[CPU_COUNTERS_MAX];
+    if (!cpu_counters_open(&pmu)) {
+        fprintf(stderr, "counters: contadores de hardware indisponiveis: %s\n", cpu_counters_reason(&pmu));
+        return 1;
+    }
+    // Ctrl+C interrompe o laço, e os contadores são desligados na saída
+    SetConsoleCtrlHandler(on_console_ctrl, TRUE);
+    for (int t = 1; t <= seconds && !g_stop; ++t) {
+        Sleep(1000);
+        DWORD n = cpu_counters_read(&pmu, rates, CPU_COUNTERS_MAX);
+        printf("%4ds   cpu    IPC  LLC miss  LLC MPKI  br MPKI  Gcycles\n", t);
+        for (DWORD i = 0; i < n; ++i) {
+            const CpuCounterRates *r = &rates[i];
+            // Núcleo praticamente parado: as taxas seriam só ruído
+            if (r->cycles < 1e6) { printf("        %3lu      -\n", (unsigned long)i); continue; }
+            if (pmu.has_llc)
+                printf("        %3lu  %5.2f  %7.1f%%  %8.2f  %7.2f  %7.2f\n", (unsigned long)i, r->ipc,
+                       r->llc_miss_pct, r->llc_mpki, r->branch_mpki, r->cycles / 1e9);
+            else
+                printf("        %3lu  %5.2f         -         -  %7.2f  %7.2f\n", (unsigned long)i, r->ipc,
+                       r->branch_mpki, r->cycles / 1e9);
+        }
+    }
+    cpu_counters_close(&pmu);
+    return 0;
+}
+
+static void print_bench_progress(void *ctx, const char *stage, int pct) {
+    (void)ctx;
+    fprintf(stderr, "\r%3d%% %-16s", pct, stage);
+    if (pct >= 100) fprintf(stderr, "\n");
+}
+
+// Percentil desta máquina entre as do mesmo modelo na base de referência
+static void print_bench_percentiles(const wchar_t *path, const RefDbSample *me) {
+    RefDb db;
+    printf("| ----------------------------------------------\n");
+    if (!refdb_open(&db, path)) { printf("| %-22s : base invalida ou ausente\n", "Referencia"); return; }
+    bool exact = false;
+    const RefDbEntry *e = refdb_find(&db, &me->key, &exact);
+    if (!e || db.hdr->bench_version != BENCH_CPU_VERSION) {
+        printf("| %-22s : %s nao esta na base (%lu modelos)\n", "Referencia", me->key.brand, (unsigned long)db.count);
+        refdb_close(&db);
+        return;
+    }
+    printf("| %-22s : %s, %lu maquinas%s\n", "Referencia", e->brand, (unsigned long)e->machines,
+           exact ? "" : " (outro stepping)");
+    printf("| %-22s   %10s %10s %10s %6s\n", "", "Este host", "Mediana", "p25-p75", "Pct");
+    for (int m = 0; m < REFDB_METRICS; ++m) {
+        const RefDbStat *st = &e->stat[m];
+        char name[32], iqr[24];
+        snprintf(iqr, sizeof(iqr), "%.0f-%.0f", st->q[3], st->q[5]);
+        printf("| %-22s : %10.0f %10.0f %10s %5.0f%%\n", refdb_metric_name(m, name, sizeof(name)),
+               me->v[m], st->q[4], iqr, refdb_percentile(st, me->v[m]));
+    }
+    printf("| %-22s : percentil %.0f (ST) e %.0f (MT) do seu modelo\n", "Este host",
+           refdb_percentile(&e->stat[REFDB_ST], me->v[REFDB_ST]), refdb_percentile(&e->stat[REFDB_MT], me->v[REFDB_MT]));
+    refdb_close(&db);
+}
+
+// cpuz-cli bench [--seconds S] [--csv arq] [--ref base]
+static int cmd_bench(int argc, wchar_t **argv) {
+    double seconds = BENCH_CPU_DEFAULT_SECS;
+    const wchar_t *csv = NULL, *ref = NULL;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--seconds") == 0)  seconds = _wtof(argv[i + 1]);
+        else if (wcscmp(argv[i], L"--csv") == 0) csv = argv[i + 1];
+        else if (wcscmp(argv[i], L"--ref") == 0) ref = argv[i + 1];
+    }
+
+    BenchCpuResult r;
+    if (!bench_cpu_run(seconds, &r, print_bench_progress, NULL)) {
+        fprintf(stderr, "bench: falhou\n");
+        return 1;
+    }
+    printf("| %-22s : %lu\n", "Version", (unsigned long)r.version);
+    printf("| %-22s : %lu\n", "Threads", (unsigned long)r.threads);
+    printf("| %-22s : %.3f GHz%s\n", "TSC", r.tsc_ghz, r.tsc_invariant ? "" : " (nao invariante, usando QPC)");
+    printf("| ----------------------------------------------\n");
+    printf("| %-22s   %10s %10s %8s\n", "", "ST", "MT", "MT/ST");
+    for (int k = 0; k < BENCH_CPU_KERNELS; ++k) {
+        printf("| %-22s : %10.0f %10.0f %7.2fx\n", bench_cpu_kernel_name(k), r.st_score[k], r.mt_score[k],
+               r.st_score[k] > 0 ? r.mt_score[k] / r.st_score[k] : 0.0);
+    }
+    printf("| %-22s : %10.0f %10.0f %7.2fx\n", "Score", r.st_total, r.mt_total, r.mt_ratio);
+
+    RefDbKey key;
+    RefDbSample me;
+    refdb_key_current(&key);
+    refdb_sample_from_result(&me, &key, &r);
+    if (csv && !refdb_append_csv(csv, &me)) fprintf(stderr, "bench: nao foi possivel gravar o CSV\n");
+    if (ref) print_bench_percentiles(ref, &me);
+    return 0;
+}
+
+// cpuz-cli refdb merge <base> <csv>... | refdb info <base>
+static int cmd_refdb(int argc, wchar_t **argv) {
+    if (argc >= 3 && wcscmp(argv[0], L"merge") == 0) {
+        DWORD added_total = 0, updated_total = 0;
+        for (int i = 2; i < argc; ++i) {
+            RefDbSample *s;
+            size_t skipped;
+            size_t n = refdb_read_csv(argv[i], &s, &skipped);
+            DWORD added, updated;
+            bool ok = n > 0 && refdb_merge(argv[1], s, n, &added, &updated);
+            free(s);
+            if (!ok) {
+                fprintf(stderr, "refdb: falhou ao mesclar %ls (CSV vazio, base invalida ou de outra versao)\n", argv[i]);
+                return 1;
+            }
+            printf("| %-22s : %lu maquinas, %lu linhas ignoradas\n", "CSV", (unsigned long)n, (unsigned long)skipped);
+            added_total += added;
+            updated_total += updated;
+        }
+        printf("| %-22s : %lu novos, %lu atualizados\n", "Modelos", (unsigned long)added_total, (unsigned long)updated_total);
+        argv++;             // cai no info da base mesclada
+        argc = 2;
+    } else if (argc < 2 || wcscmp(argv[0], L"info") != 0) {
+        fprintf(stderr, "uso: cpuz-cli refdb merge <base> <csv>... | refdb info <base>\n");
+        return 2;
+    }
+
+    RefDb db;
+    if (!refdb_open(&db, argv[1])) {
+        fprintf(stderr, "refdb: base invalida ou ausente\n");
+        return 1;
+    }
+    uint64_t machines = 0;
+    for (uint32_t i = 0; i < db.count; ++i) machines += db.entries[i].machines;
+    printf("| %-22s : %lu modelos, %llu maquinas, benchmark versao %lu\n", "Base", (unsigned long)db.count,
+           (unsigned long long)machines, (unsigned long)db.hdr->bench_version);
+    RefDbKey key;
+    refdb_key_current(&key);
+    bool exact;
+    const RefDbEntry *e = refdb_find(&db, &key, &exact);
+    if (e) {
+        printf("| %-22s : %s, %lu maquinas%s\n", "Este modelo", e->brand, (unsigned long)e->machines,
+               exact ? "" : " (outro stepping)");
+        printf("| %-22s : mediana %.0f (p25-p75 %.0f-%.0f)\n", "ST", e->stat[REFDB_ST].q[4], e->stat[REFDB_ST].q[3],
+               e->stat[REFDB_ST].q[5]);
+        printf("| %-22s : mediana %.0f (p25-p75 %.0f-%.0f)\n", "MT", e->stat[REFDB_MT].q[4], e->stat[REFDB_MT].q[3],
+               e->stat[REFDB_MT].q[5]);
+    } else {
+        printf("| %-22s : %s nao esta na base\n", "Este modelo", key.brand);
+    }
+    refdb_close(&db);
+    return 0;
+}
+
+// ---- stat: repetições até o IC alvo, com linha de base ----
+
+#define STAT_REP_SECS     0.1               // duração de uma repetição das cargas de bench_cpu
+#define STAT_TRIAD_ELEMS  (8u << 20)        // 64 MB por vetor
+#define STAT_CHAIN_BYTES  ((size_t)256 << 20)
+#define STAT_CHAIN_LOADS  (1u << 20)
+#define STAT_WHOLE_SECS   0.25              // duração de cada carga numa repetição do bench completo
+
+// Benchmarks completos: cada repetição é uma execução inteira do comando
+enum {
+    STAT_WHOLE_NONE = 0,
+    STAT_WHOLE_BENCH_ST,
+    STAT_WHOLE_BENCH_MT,
+    STAT_WHOLE_MEMBENCH,
+    STAT_WHOLE_CACHEBW,
+    STAT_WHOLE_LATENCY,
+    STAT_WHOLE_TLB,
+};
+
+typedef struct {
+    const wchar_t *arg;
+    const char    *name;
+    const char    *unit;
+    bool           higher_is_better;
+    int            kernel;                  // BENCH_CPU_* (-1 nas demais)
+    int            whole;                   // STAT_WHOLE_*
+    int            level;                   // carga ou nível acompanhado no resultado do benchmark
+} StatTarget;
+
+static const StatTarget stat_targets[] = {
+    { L"integer",      "integer",      "unid/s", true,  BENCH_CPU_INTEGER,  STAT_WHOLE_NONE,      0 },
+    { L"float",        "float",        "unid/s", true,  BENCH_CPU_FLOAT,    STAT_WHOLE_NONE,      0 },
+    { L"branch",       "branch",       "unid/s", true,  BENCH_CPU_BRANCH,   STAT_WHOLE_NONE,      0 },
+    { L"memory",       "memory",       "unid/s", true,  BENCH_CPU_MEMORY,   STAT_WHOLE_NONE,      0 },
+    { L"triad",        "triad",        "GB/s",   true,  -1,                 STAT_WHOLE_NONE,      0 },
+    { L"dram-latency", "dram-latency", "ns",     false, -1,                 STAT_WHOLE_NONE,      0 },
+    { L"bench-st",     "bench-st",     "pontos", true,  -1,                 STAT_WHOLE_BENCH_ST,  0 },
+    { L"bench-mt",     "bench-mt",     "pontos", true,  -1,                 STAT_WHOLE_BENCH_MT,  0 },
+    { L"membench",     "membench",     "GB/s",   true,  -1,                 STAT_WHOLE_MEMBENCH,  BENCH_MEM_READ },
+    { L"cachebw-l1",   "cachebw-l1",   "GB/s",   true,  -1,                 STAT_WHOLE_CACHEBW,   BENCH_LAT_L1 },
+    { L"cachebw-l2",   "cachebw-l2",   "GB/s",   true,  -1,                 STAT_WHOLE_CACHEBW,   BENCH_LAT_L2 },
+    { L"cachebw-l3",   "cachebw-l3",   "GB/s",   true,  -1,                 STAT_WHOLE_CACHEBW,   BENCH_LAT_L3 },
+    { L"cachebw-dram", "cachebw-dram", "GB/s",   true,  -1,                 STAT_WHOLE_CACHEBW,   BENCH_LAT_DRAM },
+    { L"latency-l1",   "latency-l1",   "ns",     false, -1,                 STAT_WHOLE_LATENCY,   BENCH_LAT_L1 },
+    { L"latency-l2",   "latency-l2",   "ns",     false, -1,                 STAT_WHOLE_LATENCY,   BENCH_LAT_L2 },
+    { L"latency-l3",   "latency-l3",   "ns",     false, -1,                 STAT_WHOLE_LATENCY,   BENCH_LAT_L3 },
+    { L"latency-dram", "latency-dram", "ns",     false, -1,                 STAT_WHOLE_LATENCY,   BENCH_LAT_DRAM },
+    { L"tlb-walk",     "tlb-walk",     "ciclos", false, -1,                 STAT_WHOLE_TLB,       0 },
+};
+
+typedef struct {
+    const StatTarget *target;
+    double           *buf;                  // triad: a, b e c seguidos; latência: a cadeia
+    void             *chain;
+    BenchMemKernelFn  triad;
+    uint64_t          checksum;
+    bool              unsupported;          // tlb-walk: a STLB não estourou na varredura
+} StatCtx;
+
+// Uma execução inteira de um benchmark; devolve o número que o alvo acompanha
+static double stat_whole(StatCtx *c) {
+    const StatTarget *t = c->target;
+    switch (t->whole) {
+    case STAT_WHOLE_BENCH_ST:
+    case STAT_WHOLE_BENCH_MT: {
+        static BenchCpuResult r;
+        if (!bench_cpu_run(STAT_WHOLE_SECS, &r, NULL, NULL)) return 0;
+        c->checksum += r.checksum;
+        return t->whole == STAT_WHOLE_BENCH_ST ? r.st_total : r.mt_total;
+    }
+    case STAT_WHOLE_MEMBENCH: {
+        static BenchMemResult r;
+        if (!bench_memory_run(-1, &r, NULL, NULL)) return 0;
+        c->checksum += (uint64_t)r.checksum;
+        return r.gbs[t->level];
+    }
+    case STAT_WHOLE_CACHEBW: {
+        static BenchCacheBwResult r;
+        if (!bench_cachebw_run(-1, &r, NULL, NULL)) return 0;
+        c->checksum += (uint64_t)r.checksum;
+        return r.st.cell[t->level][BENCH_BW_LOAD].gbs;
+    }
+    case STAT_WHOLE_LATENCY: {
+        static BenchLatResult r;
+        return bench_latency_run(&r, NULL, NULL) ? r.plateau_ns[t->level] : 0;
+    }
+    case STAT_WHOLE_TLB: {
+        static BenchTlbResult r;
+        if (!bench_tlb_run(&r, NULL, NULL)) return 0;
+        if (r.walk_cycles <= 0) c->unsupported = true;
+        return r.walk_cycles;
+    }
+    }
+    return 0;
+}
+
+static double stat_rep(void *p) {
+    StatCtx *c = (StatCtx*)p;
+    if (c->target->whole) return stat_whole(c);
+    if (c->target->kernel >= 0) return bench_cpu_kernel_rate(c->target->kernel, STAT_REP_SECS, &c->checksum);
+    if (c->triad) {
+        double *a = c->buf, *b = a + STAT_TRIAD_ELEMS, *x = b + STAT_TRIAD_ELEMS;
+        uint64_t t0 = bench_now();
+        double r = c->triad(a, b, x, STAT_TRIAD_ELEMS);
+        uint64_t t1 = bench_now();
+        c->checksum += (uint64_t)r;
+        return t1 > t0 ? 24.0 * STAT_TRIAD_ELEMS / ((double)(t1 - t0) / bench_hz()) / 1e9 : 0;
+    }
+    return bench_chain_ticks(c->chain, STAT_CHAIN_LOADS, 1) * 1e9 / bench_hz();
+}
+
+static void print_stats(const StatTarget *t, const BenchStats *s) {
+    printf("| %-22s : %s (%s, %s e melhor)\n", "Alvo", t->name, t->unit, t->higher_is_better ? "maior" : "menor");
+    printf("| %-22s : %lu (+%lu de aquecimento) em %.1f s\n", "Repeticoes", (unsigned long)s->reps,
+           (unsigned long)s->warmup, s->seconds);
+    printf("| %-22s : %.6g %s\n", "Mediana", s->median, t->unit);
+    printf("| %-22s : %.4g (%.2f%%)\n", "MAD", s->mad, s->median > 0 ? 100.0 * s->mad / s->median : 0.0);
+    printf("| %-22s : %.6g - %.6g (+-%.2f%%)%s\n", "IC 95% da mediana", s->ci_lo, s->ci_hi, s->ci_pct,
+           s->converged ? "" : "  NAO CONVERGIU");
+    printf("| %-22s : %.2f - %.2f GHz (%.1f%%)\n", "Clock", s->clock_min_ghz, s->clock_max_ghz, s->clock_spread_pct);
+    printf("| %-22s : %.1f%% da CPU\n", "Outros processos", s->other_load_pct);
+    printf("| %-22s : %lu\n", "Migracoes", (unsigned long)s->migrations);
+    if (!s->noise) { printf("| %-22s : nenhum\n", "Ruido"); return; }
+    for (DWORD f = 1; f <= BENCH_NOISE_NOT_CONVERGED; f <<= 1)
+        if (s->noise & f) printf("| %-22s : %s\n", "Ruido", bench_noise_name(f));
+}
+
+// cpuz-cli stat <alvo> [--baseline arq] [--save arq] [--ci pct] [--budget s]
+static int cmd_stat(int argc, wchar_t **argv) {
+    const StatTarget *t = NULL;
+    for (size_t i = 0; argc > 0 && i < sizeof(stat_targets) / sizeof(stat_targets[0]); ++i)
+        if (wcscmp(argv[0], stat_targets[i].arg) == 0) t = &stat_targets[i];
+    if (!t) {
+        fprintf(stderr, "uso: cpuz-cli stat <alvo> [--baseline arq] [--save arq] [--ci pct] [--budget s]\n"
+                        "alvos:");
+        for (size_t i = 0; i < sizeof(stat_targets) / sizeof(stat_targets[0]); ++i)
+            fprintf(stderr, " %ls", stat_targets[i].arg);
+        fprintf(stderr, "\n");
+        return 2;
+    }
+    BenchStatsConfig cfg;
+    bench_stats_default_config(&cfg);
+    if (t->whole) cfg.warmup = 1;       // a execução inteira já passa pelo aquecimento do benchmark
+    const wchar_t *baseline = NULL, *save = NULL;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--baseline") == 0)    baseline = argv[i + 1];
+        else if (wcscmp(argv[i], L"--save") == 0)   save = argv[i + 1];
+        else if (wcscmp(argv[i], L"--ci") == 0)     cfg.ci_pct = _wtof(argv[i + 1]);
+        else if (wcscmp(argv[i], L"--budget") == 0) cfg.budget_secs = _wtof(argv[i + 1]);
+    }
+
+    static CpuTopology topo;
+    if (!get_cpu_topology(&topo)) { fprintf(stderr, "stat: falhou\n"); return 1; }
+    // membench e cachebw medem num pool que inclui o núcleo mais rápido: a
+    // chamadora fixada nele disputaria o núcleo com a thread do pool
+    bool pool = t->whole == STAT_WHOLE_MEMBENCH || t->whole == STAT_WHOLE_CACHEBW;
+    cfg.cpu = pool ? NULL : topology_fastest_cpu(&topo);
+
+    // Buffers alocados antes: a primeira repetição não paga as faltas de página
+    StatCtx c;
+    memset(&c, 0, sizeof(c));
+    c.target = t;
+    size_t page;
+    if (t->kernel < 0 && !t->whole) {
+        bool triad = wcscmp(t->arg, L"triad") == 0;
+        size_t bytes = triad ? 3 * (size_t)STAT_TRIAD_ELEMS * sizeof(double) : STAT_CHAIN_BYTES;
+        c.buf = (double*)bench_pages_alloc(bytes, !triad, BENCH_NODE_ANY, &page);
+        if (c.buf && triad) {
+            c.triad = bench_memory_kernel(bench_isa_best(), BENCH_MEM_TRIAD);
+            for (size_t i = 0; i < 3 * (size_t)STAT_TRIAD_ELEMS; ++i) c.buf[i] = 1.0;
+        } else if (c.buf) {
+            c.chain = bench_chain_build(c.buf, bytes, BENCH_LAT_LINE, 0x5EED);
+        }
+        if (!c.buf || (!c.triad && !c.chain)) {
+            if (c.buf) bench_pages_free(c.buf);
+            fprintf(stderr, "stat: memoria insuficiente\n");
+            return 1;
+        }
+    }
+
+    // tlb-walk só existe se a STLB estourar dentro da varredura: uma execução
+    // antes diz se a máquina tem o que medir (e já serve de aquecimento)
+    if (t->whole == STAT_WHOLE_TLB) {
+        if (stat_whole(&c) <= 0) {
+            if (c.unsupported) fprintf(stderr, "stat: tlb-walk nao suportado (a STLB nao estourou na varredura)\n");
+            else fprintf(stderr, "stat: falhou\n");
+            return 1;
+        }
+        cfg.warmup = 0;
+    }
+
+    static BenchStats s;
+    bool ok = bench_stats_run(&cfg, stat_rep, &c, &s);
+    if (c.buf) bench_pages_free(c.buf);
+    if (!ok) { fprintf(stderr, "stat: falhou\n"); return 1; }
+    print_stats(t, &s);
+
+    int rc = 0;
+    if (baseline) {
+        static BenchStats base;
+        printf("| ----------------------------------------------\n");
+        if (!bench_stats_load(baseline, t->name, &base)) {
+            printf("| %-22s : %s nao esta no arquivo\n", "Linha de base", t->name);
+        } else {
+            BenchCompare cmp;
+            bench_stats_compare(&base, &s, t->higher_is_better, &cmp);
+            printf("| %-22s : mediana %.6g %s, %lu repeticoes\n", "Linha de base", base.median, t->unit,
+                   (unsigned long)base.reps);
+            printf("| %-22s : %+.2f%% (Mann-Whitney p = %.2g)\n", "Diferenca", cmp.delta_pct, cmp.p_value);
+            const char *verdict = cmp.verdict == BENCH_CMP_WORSE  ? "REGRESSAO"
+                                : cmp.verdict == BENCH_CMP_BETTER ? "MELHORA"
+                                                                  : "sem diferenca significativa";
+            printf("| %-22s : %s%s\n", "Veredito", verdict,
+                   cmp.verdict != BENCH_CMP_SAME && s.noise ? " (medicao ruidosa, repetir)" : "");
+            if (cmp.verdict == BENCH_CMP_WORSE) rc = 3;
+        }
+    }
+    if (save && !bench_stats_save(save, t->name, &s)) fprintf(stderr, "stat: nao foi possivel gravar %ls\n", save);
+    return rc;
+}
+
+// cpuz-cli selfbench [--calls N] [--only nome|grupo] [--baseline arq] [--save arq] [--threshold pct]
+static int cmd_selfbench(int argc, wchar_t **argv) {
+    DWORD calls = BENCH_PROV_DEFAULT_CALLS;
+    double threshold = BENCH_PROV_THRESHOLD_PCT;
+    const wchar_t *baseline = NULL, *save = NULL;
+    char only[64] = "";
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--calls") == 0)          calls = (DWORD)_wtoi(argv[i + 1]);
+        else if (wcscmp(argv[i], L"--only") == 0)      snprintf(only, sizeof(only), "%ls", argv[i + 1]);
+        else if (wcscmp(argv[i], L"--baseline") == 0)  baseline = argv[i + 1];
+        else if (wcscmp(argv[i], L"--save") == 0)      save = argv[i + 1];
+        else if (wcscmp(argv[i], L"--threshold") == 0) threshold = _wtof(argv[i + 1]);
+    }
+
+    static BenchProvReport r;
+    if (!bench_providers_run(calls, only[0] ? only : NULL, &r, print_bench_progress, NULL)) {
+        fprintf(stderr, "selfbench: nenhum provedor %s\n", only);
+        return 1;
+    }
+    printf("| %-22s : %lu a quente por provedor, depois de uma a frio\n", "Chamadas", (unsigned long)r.calls);
+    printf("| ----------------------------------------------\n");
+    printf("| %-28s %-3s %10s %10s %8s %10s %8s %9s\n", "Provedor", "ok", "frio us", "mediana us", "MAD", "max us",
+           "blocos", "bytes");
+    for (DWORD i = 0; i < r.count; ++i) {
+        const BenchProvResult *p = &r.p[i];
+        printf("| %-28s %-3s %10.1f %10.2f %8.2f %10.1f %8.2f %9.0f%s\n", p->name, p->ok ? "sim" : "nao", p->cold_us,
+               p->warm.median, p->warm.mad, p->warm.max, p->warm_blocks, p->warm_bytes,
+               p->warm_blocks >= 1.0 ? "  retem memoria" : "");
+    }
+    printf("| ----------------------------------------------\n");
+    printf("| %-22s : %.1f ms\n", "Coleta a frio", r.cold_ms);
+    printf("| %-22s : %.2f ms (soma das medianas)\n", "Coleta a quente", r.warm_ms);
+    if (!r.heap_ok) printf("| %-22s : HeapWalk falhou, blocos nao contados\n", "Heap");
+
+    int rc = 0;
+    if (baseline) {
+        DWORD compared = 0, worse = 0;
+        printf("| ----------------------------------------------\n");
+        for (DWORD i = 0; i < r.count; ++i) {
+            static BenchStats base;
+            const BenchProvResult *p = &r.p[i];
+            if (!bench_stats_load(baseline, p->name, &base)) continue;
+            compared++;
+            BenchCompare cmp;
+            bench_stats_compare(&base, &p->warm, false, &cmp);
+            if (cmp.verdict == BENCH_CMP_SAME) continue;
+            bool fail = cmp.verdict == BENCH_CMP_WORSE && cmp.delta_pct > threshold;
+            if (fail) worse++;
+            printf("| %-28s : %.2f -> %.2f us (%+.1f%%, p = %.2g)%s\n", p->name, base.median, p->warm.median,
+                   cmp.delta_pct, cmp.p_value, fail ? "  REGRESSAO" : cmp.verdict == BENCH_CMP_WORSE ? "  abaixo do limite" : "");
+        }
+        printf("| %-22s : %lu comparados, %lu acima de %.0f%%\n", "Linha de base", (unsigned long)compared,
+               (unsigned long)worse, threshold);
+        if (worse) rc = 3;
+    }
+    if (save) {
+        for (DWORD i = 0; i < r.count; ++i) {
+            if (bench_stats_save(save, r.p[i].name, &r.p[i].warm)) continue;
+            fprintf(stderr, "selfbench: nao foi possivel gravar %ls\n", save);
+            break;
+        }
+    }
+    return rc;
+}
+
+static void print_membench(const BenchMemResult *r) {
+    printf("| %-22s : %s\n", "ISA", bench_isa_name(r->isa));
+    printf("| %-22s : %lu em %lu no(s) NUMA\n", "Threads", (unsigned long)r->threads, (unsigned long)r->nodes);
+    printf("| %-22s : %lu MB\n", "Vetor", (unsigned long)r->array_mb);
+    if (r->peak_gbs > 0)
+        printf("| %-22s : %.1f GB/s (%lu MT/s x %lu x %lu-bit, 1 modulo por canal)\n", "Pico teorico",
+               r->peak_gbs, (unsigned long)r->dram_mts, (unsigned long)r->channels, (unsigned long)r->width_bits);
+    else
+        printf("| %-22s : desconhecido\n", "Pico teorico");
+    for (int k = 0; k < BENCH_MEM_KERNELS; ++k) {
+        if (r->peak_gbs > 0)
+            printf("| %-22s : %8.2f GB/s %5.1f%%\n", bench_memory_kernel_name(k), r->gbs[k], r->pct_peak[k]);
+        else
+            printf("| %-22s : %8.2f GB/s\n", bench_memory_kernel_name(k), r->gbs[k]);
+    }
+}
+
+// cpuz-cli membench [--isa sse2|avx2|avx512|all]
+static int cmd_membench(int argc, wchar_t **argv) {
+    int first = bench_isa_best(), last = first;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--isa") != 0) continue;
+        if (_wcsicmp(argv[i + 1], L"all") == 0) { first = 0; last = BENCH_ISA_COUNT - 1; continue; }
+        if (_wcsicmp(argv[i + 1], L"sse2") == 0) first = last = BENCH_ISA_SSE2;
+        else if (_wcsicmp(argv[i + 1], L"avx2") == 0) first = last = BENCH_ISA_AVX2;
+        else if (_wcsicmp(argv[i + 1], L"avx512") == 0) first = last = BENCH_ISA_AVX512;
+        else { fprintf(stderr, "membench: ISA desconhecida\n"); return 2; }
+    }
+
+    int ran = 0;
+    for (int isa = first; isa <= last; ++isa) {
+        if (!bench_isa_supported((BenchIsa)isa)) {
+            if (first == last) { fprintf(stderr, "membench: %s nao suportado\n", bench_isa_name((BenchIsa)isa)); return 1; }
+            continue;
+        }
+        BenchMemResult r;
+        if (!bench_memory_run(isa, &r, print_bench_progress, NULL)) {
+            fprintf(stderr, "membench: falhou\n");
+            return 1;
+        }
+        if (ran++) printf("| ----------------------------------------------\n");
+        print_membench(&r);
+    }
+    return 0;
+}
+
+// cpuz-cli isabench [--seconds S]
+static int cmd_isabench(int argc, wchar_t **argv) {
+    double seconds = BENCH_LICENSE_DEFAULT_SECS;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--seconds") == 0) seconds = _wtof(argv[i + 1]);
+    }
+
+    static BenchLicenseResult r;
+    if (!bench_license_run(seconds, &r, print_bench_progress, NULL)) {
+        fprintf(stderr, "isabench: falhou\n");
+        return 1;
+    }
+    printf("| %-22s : %lu nucleos fisicos\n", "Threads (MT)", (unsigned long)r.threads);
+    printf("| %-22s : %.2f GHz\n", "Clock antes da carga", r.idle_ghz);
+    printf("| ----------------------------------------------\n");
+    printf("| %-8s %9s %6s %5s %6s | %9s %6s %5s %6s\n", "", "ST GFLOPS", "GHz", "clock", "ganho",
+           "MT GFLOPS", "GHz", "clock", "ganho");
+    for (int v = 0; v < BENCH_VEC_VARIANTS; ++v) {
+        const BenchLicenseVariant *x = &r.v[v];
+        if (!x->available) { printf("| %-8s indisponivel nesta CPU/SO\n", bench_vec_variant_name(v)); continue; }
+        printf("| %-8s %9.1f %6.2f %4.0f%% %5.2fx | %9.1f %6.2f %4.0f%% %5.2fx\n", bench_vec_variant_name(v),
+               x->st.gflops, x->st.ghz, x->st.clock_pct, x->st.speedup,
+               x->mt.gflops, x->mt.ghz, x->mt.clock_pct, x->mt.speedup);
+    }
+    printf("| ----------------------------------------------\n");
+    printf("| %-22s : %s (%s)\n", "Melhor variante", bench_vec_variant_name(r.best_st), "uma thread");
+    printf("| %-22s : %s (%s)\n", "", bench_vec_variant_name(r.best_mt), "todos os nucleos");
+    // Licença: clock mais baixo que o da variante escalar na mesma fase
+    for (int v = BENCH_VEC_SSE2; v < BENCH_VEC_VARIANTS; ++v) {
+        const BenchLicenseVariant *x = &r.v[v];
+        if (!x->available) continue;
+        if (x->st.clock_pct > 0 && x->st.clock_pct < 97)
+            printf("| %-22s : %s baixa o clock de uma thread em %.0f%%\n", "Licenca de frequencia",
+                   bench_vec_variant_name(v), 100 - x->st.clock_pct);
+        if (x->mt.clock_pct > 0 && x->mt.clock_pct < 97)
+            printf("| %-22s : %s baixa o clock de todos os nucleos em %.0f%%\n", "Licenca de frequencia",
+                   bench_vec_variant_name(v), 100 - x->mt.clock_pct);
+    }
+    return 0;
+}
+
+static void format_bytes(size_t bytes, char *out, size_t n) {
+    if (bytes >= (1u << 20) && bytes % (1u << 20) == 0) snprintf(out, n, "%lu MB", (unsigned long)(bytes >> 20));
+    else snprintf(out, n, "%lu KB", (unsigned long)(bytes >> 10));
+}
+
+// Uma linha por nível; em cada carga GB/s (e GB/s por núcleo com várias threads) e bytes/ciclo
+static void print_bw_phase(const BenchBwPhase *ph, bool mt) {
+    char a[16];
+    printf("| %-5s %10s", "Nivel", mt ? "Por thread" : "Tamanho");
+    for (int k = 0; k < BENCH_BW_KERNELS; ++k) {
+        if (mt) printf(" | %-5s %7s %7s %5s", bench_cachebw_kernel_name(k), "GB/s", "/nucleo", "B/cic");
+        else    printf(" | %-5s %7s %5s", bench_cachebw_kernel_name(k), "GB/s", "B/cic");
+    }
+    printf("\n");
+    for (int l = 0; l < BENCH_LAT_LEVELS; ++l) {
+        if (!ph->bytes[l]) continue;
+        format_bytes(ph->bytes[l], a, sizeof(a));
+        printf("| %-5s %10s", bench_latency_level_name(l), a);
+        for (int k = 0; k < BENCH_BW_KERNELS; ++k) {
+            const BenchBwCell *c = &ph->cell[l][k];
+            if (mt) printf(" | %-5s %7.1f %7.1f %5.1f", "", c->gbs, c->gbs_per_core, c->bytes_per_cycle);
+            else    printf(" | %-5s %7.1f %5.1f", "", c->gbs, c->bytes_per_cycle);
+        }
+        printf("%s\n", ph->fits_l2[l] ? "  (quase todo no L2)" : "");
+    }
+}
+
+// cpuz-cli cachebw [--isa sse2|avx2|avx512]
+static int cmd_cachebw(int argc, wchar_t **argv) {
+    int isa = -1;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--isa") != 0) continue;
+        if (_wcsicmp(argv[i + 1], L"sse2") == 0) isa = BENCH_ISA_SSE2;
+        else if (_wcsicmp(argv[i + 1], L"avx2") == 0) isa = BENCH_ISA_AVX2;
+        else if (_wcsicmp(argv[i + 1], L"avx512") == 0) isa = BENCH_ISA_AVX512;
+        else { fprintf(stderr, "cachebw: ISA desconhecida\n"); return 2; }
+    }
+    if (isa >= 0 && !bench_isa_supported((BenchIsa)isa)) {
+        fprintf(stderr, "cachebw: %s nao suportado\n", bench_isa_name((BenchIsa)isa));
+        return 1;
+    }
+
+    static BenchCacheBwResult r;
+    if (!bench_cachebw_run(isa, &r, print_bench_progress, NULL)) {
+        fprintf(stderr, "cachebw: falhou\n");
+        return 1;
+    }
+    char a[16], b[16], c[16];
+    format_bytes(r.cache_bytes[0], a, sizeof(a));
+    format_bytes(r.cache_bytes[1], b, sizeof(b));
+    format_bytes(r.cache_bytes[2], c, sizeof(c));
+    printf("| %-22s : %s\n", "ISA", bench_isa_name(r.isa));
+    printf("| %-22s : L1 %s, L2 %s, L3 %s\n", "Caches", a, b, r.cache_bytes[2] ? c : "-");
+    printf("| ----------------------------------------------\n");
+    printf("| Uma thread (%.2f GHz)\n", r.st.ghz);
+    print_bw_phase(&r.st, false);
+    printf("| ----------------------------------------------\n");
+    printf("| %lu nucleos do dominio de L3 %lu (%.2f GHz)\n", (unsigned long)r.threads, (unsigned long)r.l3_domain, r.mt.ghz);
+    print_bw_phase(&r.mt, true);
+    printf("| ----------------------------------------------\n");
+    if (r.cache_bytes[2]) {
+        const BenchBwCell *l3 = &r.mt.cell[BENCH_LAT_L3][BENCH_BW_LOAD];
+        printf("| %-22s : %.1f GB/s por nucleo com %lu nucleos (%.1f GB/s sozinho)\n", "Leitura do L3", l3->gbs_per_core,
+               (unsigned long)r.threads, r.st.cell[BENCH_LAT_L3][BENCH_BW_LOAD].gbs);
+    }
+    const BenchBwCell *dram = &r.mt.cell[BENCH_LAT_DRAM][BENCH_BW_LOAD];
+    printf("| %-22s : %.1f GB/s por nucleo com %lu nucleos (%.1f GB/s sozinho)\n", "Leitura da DRAM", dram->gbs_per_core,
+           (unsigned long)r.threads, r.st.cell[BENCH_LAT_DRAM][BENCH_BW_LOAD].gbs);
+    return 0;
+}
+
+// cpuz-cli latency
+static int cmd_latency(int argc, wchar_t **argv) {
+    (void)argc; (void)argv;
+    static BenchLatResult r;
+    if (!bench_latency_run(&r, print_bench_progress, NULL)) {
+        fprintf(stderr, "latency: falhou\n");
+        return 1;
+    }
+    char a[16], b[16], c[16];
+    printf("| %-22s : %.2f GHz (medido)\n", "Nucleo", r.core_ghz);
+    if (r.large_pages) {
+        format_bytes(r.page_bytes, a, sizeof(a));
+        printf("| %-22s : %s\n", "Paginas", a);
+    } else {
+        printf("| %-22s : 4 KB (paginas grandes: %s)\n", "Paginas", r.large_pages_reason);
+    }
+    format_bytes(r.cache_bytes[0], a, sizeof(a));
+    format_bytes(r.cache_bytes[1], b, sizeof(b));
+    format_bytes(r.cache_bytes[2], c, sizeof(c));
+    printf("| %-22s : L1 %s, L2 %s, L3 %s\n", "Caches", a, b, r.cache_bytes[2] ? c : "-");
+    printf("| ----------------------------------------------\n");
+
+    // Curva em escala logarítmica; uma linha marca o fim de cada nível
+    double min_ns = r.points[0].ns;
+    for (DWORD i = 0; i < r.npoints; ++i) if (r.points[i].ns < min_ns) min_ns = r.points[i].ns;
+    printf("| %10s %9s %8s  %-5s\n", "Tamanho", "ns", "ciclos", "Nivel");
+    for (DWORD i = 0; i < r.npoints; ++i) {
+        const BenchLatPoint *p = &r.points[i];
+        int bar = 1 + (min_ns > 0 ? (int)(8.0 * log2(p->ns / min_ns)) : 0);
+        if (bar > 50) bar = 50;
+        format_bytes(p->bytes, a, sizeof(a));
+        printf("| %10s %9.2f %8.1f  %-5s %.*s\n", a, p->ns, p->cycles, bench_latency_level_name(p->level),
+               bar, "##################################################");
+        if (i + 1 < r.npoints && r.points[i + 1].level != p->level) {
+            format_bytes(r.cache_bytes[p->level], b, sizeof(b));
+            printf("| %10s ---- fim do %s (%s)\n", "", bench_latency_level_name(p->level), b);
+        }
+    }
+    printf("| ----------------------------------------------\n");
+    for (int l = 0; l < BENCH_LAT_LEVELS; ++l) {
+        if (r.plateau_ns[l] <= 0) continue;
+        char label[32];
+        snprintf(label, sizeof(label), "Plato %s", bench_latency_level_name(l));
+        printf("| %-22s : %.2f ns, %.1f ciclos\n", label, r.plateau_ns[l], r.plateau_cycles[l]);
+    }
+    return 0;
+}
+
+static void format_count(DWORD v, char *out, size_t n) {
+    if (v) snprintf(out, n, "%lu", (unsigned long)v);
+    else snprintf(out, n, "-");
+}
+
+// cpuz-cli cachegeo
+static int cmd_cachegeo(int argc, wchar_t **argv) {
+    (void)argc; (void)argv;
+    static BenchCacheGeoResult r;
+    if (!bench_cachegeo_run(&r, print_bench_progress, NULL)) {
+        fprintf(stderr, "cachegeo: falhou\n");
+        return 1;
+    }
+    static const char *const names[3] = { "L1 Data", "Level 2", "Level 3" };
+    printf("| %-10s %21s %13s %13s\n", "", "Tamanho (SO/medido)", "Vias", "Linha");
+    for (int i = 0; i < 3; ++i) {
+        const BenchCacheGeoLevel *l = &r.level[i];
+        if (!l->present) continue;
+        char rs[16], ms[16], ra[8], ma[8], rl[8], ml[8], size[40], assoc[24], line[24];
+        if (l->reported_size) format_bytes(l->reported_size, rs, sizeof(rs)); else snprintf(rs, sizeof(rs), "-");
+        if (l->measured_size) format_bytes(l->measured_size, ms, sizeof(ms)); else snprintf(ms, sizeof(ms), "-");
+        format_count(l->reported_assoc, ra, sizeof(ra));
+        format_count(l->measured_assoc, ma, sizeof(ma));
+        format_count(l->reported_line, rl, sizeof(rl));
+        format_count(r.measured_line, ml, sizeof(ml));
+        snprintf(size, sizeof(size), "%s / %s%s", rs, ms, l->size_mismatch ? " !" : "");
+        snprintf(assoc, sizeof(assoc), "%s / %s%s", ra, ma, l->assoc_mismatch ? " !" : "");
+        snprintf(line, sizeof(line), "%s / %s%s", rl, ml, l->line_mismatch ? " !" : "");
+        printf("| %-10s %21s %13s %13s", names[i], size, assoc, line);
+        if (!l->measured_assoc && l->assoc_note) printf("  (vias: %s)", l->assoc_note);
+        printf("\n");
+    }
+    printf("| ----------------------------------------------\n");
+    if (r.mismatches)
+        printf("| %-22s : %d (marcadas com !)\n", "Divergencias", r.mismatches);
+    else
+        printf("| %-22s : nenhuma\n", "Divergencias");
+    return r.mismatches ? 3 : 0;
+}
+
+// cpuz-cli c2c [--csv arq] [--bmp arq]
+static int cmd_c2c(int argc, wchar_t **argv) {
+    const wchar_t *csv = NULL, *bmp = NULL;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--csv") == 0) csv = argv[i + 1];
+        else if (wcscmp(argv[i], L"--bmp") == 0) bmp = argv[i + 1];
+    }
+
+    static BenchC2cResult r;
+    if (!bench_c2c_run(&r, print_bench_progress, NULL)) {
+        fprintf(stderr, "c2c: falhou (sao necessarios pelo menos 2 nucleos)\n");
+        return 1;
+    }
+    printf("| %-22s : %lu (primeira thread de cada um)\n", "Nucleos", (unsigned long)r.count);
+    printf("| %-22s : %.1f / %.1f ns\n", "Minimo / maximo", r.min_ns, r.max_ns);
+    if (r.avg_same_l3 > 0)       printf("| %-22s : %.1f ns\n", "Mesmo L3", r.avg_same_l3);
+    if (r.avg_cross_l3 > 0)      printf("| %-22s : %.1f ns\n", "L3 diferente", r.avg_cross_l3);
+    if (r.avg_cross_package > 0) printf("| %-22s : %.1f ns\n", "Pacote diferente", r.avg_cross_package);
+
+    // Matriz inteira só enquanto cabe na tela
+    if (r.count <= 32) {
+        printf("| ----------------------------------------------\n|      ");
+        for (DWORD j = 0; j < r.count; ++j) printf("%5lu", (unsigned long)j);
+        printf("\n");
+        for (DWORD i = 0; i < r.count; ++i) {
+            printf("| %4lu ", (unsigned long)i);
+            for (DWORD j = 0; j < r.count; ++j) {
+                if (i == j) printf("    -");
+                else printf("%5.0f", bench_c2c_at(&r, i, j));
+            }
+            printf("\n");
+        }
+    }
+
+    // Pares mais rápidos: candidatos para produtor/consumidor
+    printf("| ----------------------------------------------\n");
+    static bool used[CPU_TOPO_MAX * CPU_TOPO_MAX];
+    memset(used, 0, sizeof(used));
+    for (int k = 0; k < 5; ++k) {
+        DWORD bi = 0, bj = 0;
+        double best = 0;
+        for (DWORD i = 0; i < r.count; ++i)
+            for (DWORD j = i + 1; j < r.count; ++j) {
+                double v = bench_c2c_at(&r, i, j);
+                if (v > 0 && !used[i * r.count + j] && (best == 0 || v < best)) { best = v; bi = i; bj = j; }
+            }
+        if (best == 0) break;
+        used[bi * r.count + bj] = true;
+        char label[32];
+        snprintf(label, sizeof(label), "Par rapido %d", k + 1);
+        printf("| %-22s : CPU %u:%u <-> CPU %u:%u  %.1f ns\n", label, r.cpus[bi].group, r.cpus[bi].number,
+               r.cpus[bj].group, r.cpus[bj].number, best);
+    }
+
+    int rc = 0;
+    if (csv && !bench_c2c_write_csv(&r, csv)) { fprintf(stderr, "c2c: erro gravando CSV\n"); rc = 1; }
+    if (bmp && !bench_c2c_write_bmp(&r, bmp)) { fprintf(stderr, "c2c: erro gravando BMP\n"); rc = 1; }
+    bench_c2c_free(&r);
+    return rc;
+}
+
+// Uma linha de uma das matrizes NUMA: 0 = GB/s, 1 = ns, 2 = SLIT
+static void print_numa_cells(const BenchNumaResult *r, DWORD c, int kind) {
+    for (DWORD m = 0; m < r->info.count; ++m) {
+        if (kind == 2) {
+            if (r->info.has_slit) printf("%5u", r->info.distance[c][m]);
+            else printf("    ?");
+            continue;
+        }
+        double v = kind == 0 ? r->gbs[c][m] : r->ns[c][m];
+        if (v <= 0) printf("    -");
+        else printf("%5.0f", v);
+    }
+}
+
+// cpuz-cli numa
+static int cmd_numa(int argc, wchar_t **argv) {
+    (void)argc; (void)argv;
+    static BenchNumaResult r;
+    if (!bench_numa_run(&r, print_bench_progress, NULL)) {
+        fprintf(stderr, "numa: falhou\n");
+        return 1;
+    }
+    const MemNumaInfo *info = &r.info;
+    printf("| %-22s : %lu\n", "Nos NUMA", (unsigned long)info->count);
+    printf("| %-22s : %s\n", "ISA (leitura)", bench_isa_name(r.isa));
+    printf("| %-22s : %lu MB por par\n", "Vetor", (unsigned long)r.array_mb);
+    printf("| %-22s : %lu MB por par\n", "Cadeia (latencia)", (unsigned long)r.chain_mb);
+    if (r.large_pages)
+        printf("| %-22s : sim (%lu KB)\n", "Paginas grandes", (unsigned long)(r.page_bytes >> 10));
+    else
+        printf("| %-22s : nao (%s)\n", "Paginas grandes", r.large_pages_reason);
+    if (!info->has_slit)
+        printf("| %-22s : indisponivel\n", "SLIT");
+    if (r.skipped)
+        printf("| %-22s : %lu (memoria do no insuficiente ou em outro no, marcados com -)\n", "Pares pulados", (unsigned long)r.skipped);
+    for (DWORD i = 0; i < info->count; ++i) {
+        char label[32];
+        snprintf(label, sizeof(label), "No %u", info->node[i]);
+        printf("| %-22s : %llu MB livres, %lu nucleo(s)\n", label, (unsigned long long)(info->available[i] >> 20),
+               (unsigned long)r.threads[i]);
+    }
+
+    // Linhas: nó da CPU; colunas: nó da memória. Até 8 nós as três matrizes
+    // ficam lado a lado, acima disso uma embaixo da outra.
+    static const char *const titles[3] = { "Leitura GB/s", "Latencia ns", "SLIT" };
+    int per_line = info->count <= 8 ? 3 : 1;
+    for (int first = 0; first < 3; first += per_line) {
+        printf("| ----------------------------------------------\n|      ");
+        for (int k = first; k < first + per_line; ++k) {
+            printf("%-*s", (int)(5 * info->count), titles[k]);
+            if (k + 1 < first + per_line) printf("  | ");
+        }
+        printf("\n| cpu\\m");
+        for (int k = first; k < first + per_line; ++k) {
+            for (DWORD m = 0; m < info->count; ++m) printf("%5u", info->node[m]);
+            if (k + 1 < first + per_line) printf("  | ");
+        }
+        printf("\n");
+        for (DWORD c = 0; c < info->count; ++c) {
+            if (!info->has_cpus[c]) continue;
+            printf("| %4u ", info->node[c]);
+            for (int k = first; k < first + per_line; ++k) {
+                print_numa_cells(&r, c, k);
+                if (k + 1 < first + per_line) printf("  | ");
+            }
+            printf("\n");
+        }
+    }
+
+    // Penalidade média do acesso remoto em relação ao local
+    double lbw = 0, rbw = 0, lns = 0, rns = 0;
+    DWORD nl = 0, nr = 0;
+    for (DWORD c = 0; c < info->count; ++c)
+        for (DWORD m = 0; m < info->count; ++m) {
+            if (r.gbs[c][m] <= 0 || r.ns[c][m] <= 0) continue;
+            if (c == m) { lbw += r.gbs[c][m]; lns += r.ns[c][m]; nl++; }
+            else { rbw += r.gbs[c][m]; rns += r.ns[c][m]; nr++; }
+        }
+    if (nl && nr) {
+        printf("| ----------------------------------------------\n");
+        printf("| %-22s : %.1f GB/s, %.0f ns\n", "Local (media)", lbw / nl, lns / nl);
+        printf("| %-22s : %.1f GB/s, %.0f ns (%.0f%% da banda, %.2fx a latencia)\n", "Remoto (media)",
+               rbw / nr, rns / nr, 100.0 * (rbw / nr) / (lbw / nl), (rns / nr) / (lns / nl));
+    }
+    return 0;
+}
+
+// cpuz-cli turbo [--seconds S] [--vector]
+static int cmd_turbo(int argc, wchar_t **argv) {
+    double seconds = BENCH_TURBO_DEFAULT_SECS;
+    bool vector = false;
+    for (int i = 0; i < argc; ++i) {
+        if (wcscmp(argv[i], L"--vector") == 0) { vector = true; continue; }
+        if (i + 1 >= argc) break;
+        if (wcscmp(argv[i], L"--seconds") == 0) seconds = _wtof(argv[++i]);
+    }
+
+    static BenchTurboResult r;
+    if (!bench_turbo_run(seconds, vector, &r, print_bench_progress, NULL)) {
+        fprintf(stderr, "turbo: falhou\n");
+        return 1;
+    }
+    DWORD cur = 0, max = 0, limit = 0;
+    printf("| %-22s : %lu (%lu de maior classe de eficiencia)\n", "Nucleos fisicos",
+           (unsigned long)r.ncores, (unsigned long)r.fast_cores);
+    if (get_cpu0_clock(&cur, &max, &limit) && max > 0)
+        printf("| %-22s : %lu MHz\n", "Max informado", (unsigned long)max);
+    printf("| %-22s : %.2f GHz\n", "Clock antes da carga", r.idle_ghz);
+    printf("| ----------------------------------------------\n");
+
+    // Multiplicador sobre BCLK de 100 MHz; % em relação ao degrau de 1 núcleo
+    printf("| %6s", "ativos");
+    for (int v = 0; v < BENCH_VEC_VARIANTS; ++v)
+        if (r.measured[v]) printf(" | %-7s %5s %5s %4s", bench_vec_variant_name(v), "min", "mult", "%");
+    printf("\n");
+    for (DWORD i = 0; i < r.nsteps; ++i) {
+        const BenchTurboStep *st = &r.steps[i];
+        printf("| %6lu", (unsigned long)st->cores);
+        for (int v = 0; v < BENCH_VEC_VARIANTS; ++v) {
+            if (!r.measured[v]) continue;
+            double one = r.steps[0].ghz[v];
+            printf(" | %7.2f %5.2f %4.0fx %3.0f%%", st->ghz[v], st->ghz_min[v], st->ghz[v] * 10,
+                   one > 0 ? 100 * st->ghz[v] / one : 0);
+        }
+        printf("\n");
+    }
+    printf("| ----------------------------------------------\n");
+    const BenchTurboStep *all = &r.steps[r.nsteps - 1];
+    for (int v = 0; v < BENCH_VEC_VARIANTS; ++v) {
+        if (!r.measured[v]) continue;
+        char label[32];
+        snprintf(label, sizeof(label), "Turbo (%s)", bench_vec_variant_name(v));
+        printf("| %-22s : %.2f GHz com 1 nucleo, %.2f GHz com %lu", label, r.steps[0].ghz[v], all->ghz[v],
+               (unsigned long)all->cores);
+        if (max > 0 && r.steps[0].ghz[v] > 0)
+            printf(" (%.0f%% e %.0f%% do Max)", 100 * r.steps[0].ghz[v] * 1000 / max, 100 * all->ghz[v] * 1000 / max);
+        printf("\n");
+    }
+    if (vector && !r.measured[BENCH_VEC_AVX512])
+        printf("| %-22s : AVX-512 nao suportado\n", "");
+    return 0;
+}
+
+// Uma linha por degrau: vazão (Mops/s) ou ns por operação de cada primitiva
+static void print_atomic_table(const BenchAtomicResult *r, bool ns) {
+    printf("| %5s %-8s", "thr", "escopo");
+    for (int k = 0; k < BENCH_ATOMIC_KINDS; ++k) printf(" %9s", bench_atomic_kind_name(k));
+    printf("\n");
+    for (DWORD i = 0; i < r->nsteps; ++i) {
+        const BenchAtomicStep *st = &r->steps[i];
+        printf("| %5lu %-8s", (unsigned long)st->threads, bench_atomic_scope_name(st->scope));
+        for (int k = 0; k < BENCH_ATOMIC_KINDS; ++k) printf(" %9.1f", ns ? st->ns[k] : st->mops[k]);
+        printf("\n");
+    }
+}
+
+// cpuz-cli atomics
+static int cmd_atomics(int argc, wchar_t **argv) {
+    (void)argc; (void)argv;
+    static BenchAtomicResult r;
+    if (!bench_atomic_run(&r, print_bench_progress, NULL)) {
+        fprintf(stderr, "atomics: falhou\n");
+        return 1;
+    }
+    printf("| %-22s :", "Ordem de entrada");
+    DWORD prev = 0;
+    for (int s = BENCH_ATOMIC_SCOPE_L3; s <= BENCH_ATOMIC_SCOPE_SMT; ++s) {
+        if (r.scope_end[s] == prev) continue;
+        printf(" %s ate %lu", bench_atomic_scope_name(s), (unsigned long)r.scope_end[s]);
+        prev = r.scope_end[s];
+    }
+    printf("\n");
+    printf("| %-22s : %s\n", "Travas", r.locks_ok ? "contador conferido" : "CONTADOR ERRADO (trava falhou)");
+    printf("| ----------------------------------------------\n");
+    printf("| Vazao total (Mops/s)\n");
+    print_atomic_table(&r, false);
+    printf("| ----------------------------------------------\n");
+    printf("| Tempo de uma operacao numa thread (ns)\n");
+    print_atomic_table(&r, true);
+    printf("| ----------------------------------------------\n");
+    for (int k = 0; k < BENCH_ATOMIC_KINDS; ++k) {
+        char label[32];
+        snprintf(label, sizeof(label), "Pico (%s)", bench_atomic_kind_name(k));
+        printf("| %-22s : %.1f Mops/s com %lu thread(s)", label, r.peak_mops[k], (unsigned long)r.peak_threads[k]);
+        if (r.collapse_threads[k]) {
+            DWORD c = 0;
+            while (c < r.nsteps && r.steps[c].threads != r.collapse_threads[k]) ++c;
+            printf("; abaixo de %.0f%% do pico com %lu (%s)", 100 * BENCH_ATOMIC_COLLAPSE,
+                   (unsigned long)r.collapse_threads[k], bench_atomic_scope_name(r.steps[c].scope));
+        }
+        printf("\n");
+    }
+    return r.locks_ok ? 0 : 1;
+}
+
+// Matriz de cargas: linha = carga medida, coluna = carga na thread vizinha
+static void print_smt_matrix(const double m[BENCH_CPU_KERNELS][BENCH_CPU_KERNELS], bool pct) {
+    printf("| %-8s", "");
+    for (int b = 0; b < BENCH_CPU_KERNELS; ++b) printf(" %8s", bench_cpu_kernel_name(b));
+    printf("\n");
+    for (int a = 0; a < BENCH_CPU_KERNELS; ++a) {
+        printf("| %-8s", bench_cpu_kernel_name(a));
+        for (int b = 0; b < BENCH_CPU_KERNELS; ++b) {
+            if (pct) printf(" %7.0f%%", 100 * m[a][b]);
+            else printf(" %7.2fx", m[a][b]);
+        }
+        printf("\n");
+    }
+}
+
+// cpuz-cli smt [--seconds S]
+static int cmd_smt(int argc, wchar_t **argv) {
+    double seconds = BENCH_SMT_DEFAULT_SECS;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--seconds") == 0) seconds = _wtof(argv[i + 1]);
+    }
+
+    static BenchSmtResult r;
+    if (!bench_smt_run(seconds, &r, print_bench_progress, NULL)) {
+        if (!r.has_smt)
+            fprintf(stderr, "smt: nenhum nucleo com SMT ativo\n");
+        else
+            fprintf(stderr, "smt: falhou\n");
+        return 1;
+    }
+    printf("| %-22s : CPU %u:%u + CPU %u:%u (nucleo %u, pacote %u)\n", "Nucleo medido",
+           r.cpus[0].group, r.cpus[0].number, r.cpus[1].group, r.cpus[1].number, r.cpus[0].core, r.cpus[0].package);
+    printf("| %-22s : %.1f s por carga\n", "Medicao", r.seconds);
+    printf("| ----------------------------------------------\n");
+    printf("| Vazao mantida (linha com a coluna na thread vizinha, 100%% = sozinha)\n");
+    print_smt_matrix(r.retained, true);
+    printf("| ----------------------------------------------\n");
+    printf("| Rendimento do nucleo (soma das duas fracoes, 1.00x = uma thread so)\n");
+    print_smt_matrix(r.yield, false);
+    printf("| ----------------------------------------------\n");
+    for (int a = 0; a < BENCH_CPU_KERNELS; ++a) {
+        int worst = 0;
+        for (int b = 1; b < BENCH_CPU_KERNELS; ++b) if (r.retained[a][b] < r.retained[a][worst]) worst = b;
+        char label[32];
+        snprintf(label, sizeof(label), "Pior vizinha (%s)", bench_cpu_kernel_name(a));
+        printf("| %-22s : %s, mantem %.0f%% (rendimento %.2fx)\n", label, bench_cpu_kernel_name(worst),
+               100 * r.retained[a][worst], r.yield[a][worst]);
+    }
+    return 0;
+}
+
+// cpuz-cli loadlat [--mix read|rw]
+static int cmd_loadlat(int argc, wchar_t **argv) {
+    BenchLoadedMix mix = BENCH_LOADED_READ;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        if (wcscmp(argv[i], L"--mix") != 0) continue;
+        if (_wcsicmp(argv[i + 1], L"read") == 0) mix = BENCH_LOADED_READ;
+        else if (_wcsicmp(argv[i + 1], L"rw") == 0) mix = BENCH_LOADED_RW;
+        else { fprintf(stderr, "loadlat: mistura desconhecida\n"); return 2; }
+    }
+
+    static BenchLoadedResult r;
+    if (!bench_loaded_run(mix, &r, print_bench_progress, NULL) && r.nnodes == 0) {
+        fprintf(stderr, r.nskipped ? "loadlat: nenhum no comporta a medicao na propria memoria\n" : "loadlat: falhou\n");
+        return 1;
+    }
+    printf("| %-22s : %s\n", "Injetores", mix == BENCH_LOADED_RW ? "2 leituras : 1 escrita (triad)" : "so leitura");
+    printf("| %-22s : %s\n", "ISA (injetores)", bench_isa_name(r.isa));
+    printf("| %-22s : %lu MB por no\n", "Cadeia (sonda)", (unsigned long)r.chain_mb);
+    if (r.large_pages)
+        printf("| %-22s : sim (%lu KB)\n", "Paginas grandes", (unsigned long)(r.page_bytes >> 10));
+    else
+        printf("| %-22s : nao (%s)\n", "Paginas grandes", r.large_pages_reason);
+    for (DWORD i = 0; i < r.nskipped; ++i)
+        printf("| %-22s : no %u (memoria do no insuficiente ou em outro no)\n", "Pulado", r.skipped[i]);
+
+    for (DWORD i = 0; i < r.nnodes; ++i) {
+        const BenchLoadedNode *nd = &r.nodes[i];
+        printf("| ----------------------------------------------\n");
+        printf("| No %u: sonda em 1 nucleo, %lu injetor(es)\n", nd->node, (unsigned long)nd->injectors);
+        printf("| %7s %8s %8s %8s %11s\n", "pausas", "GB/s", "ns", "p99 ns", "p99/ocioso");
+        for (DWORD p = 0; p < nd->npoints; ++p) {
+            const BenchLoadedPoint *pt = &nd->points[p];
+            char delay[16];
+            if (pt->delay < 0) snprintf(delay, sizeof(delay), "ocioso");
+            else snprintf(delay, sizeof(delay), "%d", pt->delay);
+            printf("| %7s %8.1f %8.0f %8.0f %11.2f\n", delay, pt->gbs, pt->ns, pt->p99_ns,
+                   nd->idle_p99_ns > 0 ? pt->p99_ns / nd->idle_p99_ns : 0);
+        }
+        if (nd->injectors == 0)
+            printf("| %-22s : sem outros nucleos no no, so a latencia ociosa\n", "Banda util");
+        else if (nd->knee_found)
+            printf("| %-22s : p99 passa de %.0fx o p99 ocioso a partir de %.1f GB/s\n", "Banda util",
+                   BENCH_LOADED_KNEE, nd->knee_gbs);
+        else
+            printf("| %-22s : p99 abaixo de %.0fx o p99 ocioso ate %.1f GB/s (maximo injetado)\n", "Banda util",
+                   BENCH_LOADED_KNEE, nd->points[nd->npoints - 1].gbs);
+    }
+    return 0;
+}
+
+// Um plano de energia: configurações do processador e a tabela por tempo de ociosidade
+static void print_wake_plan(const BenchWakeResult *r, const BenchWakePlan *p) {
+    printf("| ----------------------------------------------\n");
+    printf("| Plano: %ls\n", p->name);
+    if (p->settings_ok)
+        printf("| %-22s : estado minimo %lu%%, ocioso %s, boost %lu (%s)\n", "Processador",
+               (unsigned long)p->min_state_pct, p->idle_disabled ? "desabilitado" : "habilitado",
+               (unsigned long)p->boost_mode, r->on_battery ? "bateria" : "tomada");
+    else
+        printf("| %-22s : configuracoes indisponiveis\n", "Processador");
+    printf("| %-22s : %.2f GHz\n", "Clock quente", p->hot_ghz);
+
+    printf("| %8s %8s %8s %8s %9s %10s", "ocioso", "obtido", "lat us", "p99 us", "1a GHz", "ate 90%");
+    for (int st = 0; st < BENCH_WAKE_STATES; ++st)
+        if (r->state_msr || st == BENCH_WAKE_UNKNOWN) printf(" %5s", bench_wake_state_name(st));
+    printf("\n");
+    for (DWORD i = 0; i < p->nidle; ++i) {
+        const BenchWakeIdle *id = &p->idle[i];
+        char ramp[16];
+        if (id->ramp_reached == 0) snprintf(ramp, sizeof(ramp), "-");
+        else snprintf(ramp, sizeof(ramp), "%.0f us", id->ramp_us);
+        printf("| %6lu us %8.0f %8.1f %8.1f %9.2f %10s", (unsigned long)id->idle_us, id->idle_real_us, id->lat_us,
+               id->lat_p99_us, id->first_ghz, ramp);
+        for (int st = 0; st < BENCH_WAKE_STATES; ++st)
+            if (r->state_msr || st == BENCH_WAKE_UNKNOWN) printf(" %5lu", (unsigned long)id->state_count[st]);
+        printf("\n");
+    }
+
+    // Curva de subida: clock médio em cada faixa depois de acordar
+    printf("| %-22s :", "Subida (GHz) ate us");
+    for (int b = 0; b < BENCH_WAKE_BINS; ++b) printf(" %6lu", (unsigned long)bench_wake_bin_end_us(b));
+    printf("\n");
+    for (DWORD i = 0; i < p->nidle; ++i) {
+        const BenchWakeIdle *id = &p->idle[i];
+        char label[32];
+        snprintf(label, sizeof(label), "ocioso %lu us", (unsigned long)id->idle_us);
+        printf("| %-22s :", label);
+        for (int b = 0; b < BENCH_WAKE_BINS; ++b) {
+            if (id->bin_ghz[b] > 0) printf(" %6.2f", id->bin_ghz[b]);
+            else printf(" %6s", "-");
+        }
+        printf("\n");
+    }
+
+    // Latência mediana por estado, quando os contadores separam as acordadas
+    if (!r->state_msr) return;
+    for (DWORD i = 0; i < p->nidle; ++i) {
+        const BenchWakeIdle *id = &p->idle[i];
+        char label[32];
+        snprintf(label, sizeof(label), "Lat. ocioso %lu us", (unsigned long)id->idle_us);
+        printf("| %-22s :", label);
+        for (int st = 0; st < BENCH_WAKE_UNKNOWN; ++st)
+            if (id->state_count[st]) printf(" %s %.1f us", bench_wake_state_name(st), id->state_lat_us[st]);
+        printf("\n");
+    }
+}
+
+// cpuz-cli wake [--idle us,us,...] [--samples N] [--plans]
+static int cmd_wake(int argc, wchar_t **argv) {
+    DWORD idle[BENCH_WAKE_MAX_IDLES], nidle = 0, samples = BENCH_WAKE_DEFAULT_SAMPLES;
+    bool plans = false;
+    for (int i = 0; i < argc; ++i) {
+        if (wcscmp(argv[i], L"--plans") == 0) { plans = true; continue; }
+        if (i + 1 >= argc) break;
+        if (wcscmp(argv[i], L"--samples") == 0) samples = (DWORD)_wtoi(argv[++i]);
+        else if (wcscmp(argv[i], L"--idle") == 0) {
+            for (wchar_t *s = argv[++i]; *s && nidle < BENCH_WAKE_MAX_IDLES; ) {
+                wchar_t *end;
+                unsigned long v = wcstoul(s, &end, 10);
+                if (end == s || v == 0) { fprintf(stderr, "wake: tempo de ociosidade invalido\n"); return 2; }
+                idle[nidle++] = (DWORD)v;
+                s = *end == L',' ? end + 1 : end;
+            }
+        }
+    }
+
+    // Com --plans o plano de energia do sistema é trocado: Ctrl+C para entre
+    // dois tempos de ociosidade e o plano original volta antes de sair
+    SetConsoleCtrlHandler(on_console_ctrl, TRUE);
+    static BenchWakeResult r;
+    bool ok = bench_wake_run(nidle ? idle : NULL, nidle, samples, plans, &g_stop, &r, print_bench_progress, NULL);
+    if (plans && !r.plans_restored)
+        fprintf(stderr, "wake: nao foi possivel restaurar o plano de energia original\n");
+    if (!ok) {
+        fprintf(stderr, r.interrupted ? "wake: interrompido\n" : "wake: falhou\n");
+        return 1;
+    }
+    printf("| %-22s : CPU %u:%u\n", "Nucleo que dorme", r.target.group, r.target.number);
+    printf("| %-22s : CPU %u:%u\n", "Nucleo que acorda", r.waker.group, r.waker.number);
+    if (r.state_msr)
+        printf("| %-22s : residencia C3/C6/C7 (MSR)\n", "Estado ocioso");
+    else
+        printf("| %-22s : indisponivel (%s)\n", "Estado ocioso", r.state_reason ? r.state_reason : "?");
+    printf("| %-22s : %s\n", "Espera", r.hires_timer ? "timer de alta resolucao" : "timer comum + giro de 16 ms");
+    if (plans)
+        printf("| %-22s : %s\n", "Plano original", r.plans_restored ? "restaurado" : "NAO RESTAURADO");
+    if (r.interrupted)
+        printf("| %-22s : INTERROMPIDO (resultados parciais)\n", "Medicao");
+    for (DWORD i = 0; i < r.nplans; ++i) print_wake_plan(&r, &r.plans[i]);
+    return 0;
+}
+
+// Alcance medido x CPUID: páginas de 4 KB cobertas pela TLB
+static void print_tlb_reach(const char *label, DWORD measured, DWORD cpuid) {
+    char m[24], c[24];
+    if (measured) snprintf(m, sizeof(m), "%lu pag (%lu KB)", (unsigned long)measured, (unsigned long)measured * 4);
+    else snprintf(m, sizeof(m), "-");
+    if (cpuid) snprintf(c, sizeof(c), "%lu entradas", (unsigned long)cpuid);
+    else snprintf(c, sizeof(c), "-");
+    printf("| %-22s : %-22s CPUID: %s\n", label, m, c);
+}
+
+// cpuz-cli tlb
+static int cmd_tlb(int argc, wchar_t **argv) {
+    (void)argc; (void)argv;
+    static BenchTlbResult r;
+    if (!bench_tlb_run(&r, print_bench_progress, NULL)) {
+        fprintf(stderr, "tlb: falhou\n");
+        return 1;
+    }
+    printf("| %-22s : %.2f GHz (medido)\n", "Nucleo", r.core_ghz);
+    for (size_t i = 0; i < r.ntlb; ++i) {
+        const TlbInfo *t = &r.tlb[i];
+        char label[32], pages[24], ways[16];
+        snprintf(label, sizeof(label), "TLB L%u %s", t->level, tlb_type_name(t->type));
+        tlb_pages_string(t->pages, pages, sizeof(pages));
+        if (t->ways) snprintf(ways, sizeof(ways), "%u vias", t->ways);
+        else snprintf(ways, sizeof(ways), "associativa");
+        printf("| %-22s : %-12s %5u entradas, %s\n", label, pages, t->entries, ways);
+    }
+    if (r.ntlb == 0) printf("| %-22s : nao informadas pela CPUID\n", "TLB");
+
+    // Varredura: uma carga por página de 4 KB
+    printf("| ----------------------------------------------\n");
+    printf("| %8s %10s %9s %9s %9s\n", "Paginas", "Alcance", "cic 4 KB", "cic 2 MB", "Diferenca");
+    for (DWORD i = 0; i < r.npoints; ++i) {
+        const BenchTlbPoint *p = &r.points[i];
+        char reach[16];
+        format_bytes((size_t)p->pages * 4096, reach, sizeof(reach));
+        if (r.has_baseline)
+            printf("| %8lu %10s %9.1f %9.1f %9.1f\n", (unsigned long)p->pages, reach, p->cycles_small,
+                   p->cycles_large, p->cycles_small - p->cycles_large);
+        else
+            printf("| %8lu %10s %9.1f %9s %9s\n", (unsigned long)p->pages, reach, p->cycles_small, "-", "-");
+    }
+    printf("| ----------------------------------------------\n");
+    if (r.has_baseline) {
+        print_tlb_reach("Alcance DTLB (4 KB)", r.dtlb_reach_pages, r.cpuid_dtlb_4k);
+        print_tlb_reach("Alcance STLB (4 KB)", r.stlb_reach_pages, r.cpuid_stlb_4k);
+        if (r.stlb_hit_cycles > 0) printf("| %-22s : +%.1f ciclos por carga\n", "Falta DTLB, acerto STLB", r.stlb_hit_cycles);
+        if (r.walk_cycles > 0)     printf("| %-22s : +%.1f ciclos por carga\n", "Page walk", r.walk_cycles);
+    } else {
+        printf("| %-22s : sem paginas grandes para comparar (%s)\n", "Alcance", r.baseline_reason);
+    }
+
+    // Buffer grande: latência e banda aleatória por tamanho de página
+    printf("| ----------------------------------------------\n");
+    printf("| %-22s : %lu MB, %d cadeias para a banda\n", "Buffer aleatorio", (unsigned long)r.buffer_mb, BENCH_TLB_CHAINS);
+    for (int k = 0; k < BENCH_PAGE_KINDS; ++k) {
+        char label[32];
+        snprintf(label, sizeof(label), "Paginas de %s", bench_page_kind_name(k));
+        if (!r.available[k]) { printf("| %-22s : indisponivel (%s)\n", label, r.reason[k]); continue; }
+        if (k > 0 && r.available[0] && r.lat_ns[0] > 0 && r.gbs[0] > 0)
+            printf("| %-22s : %7.1f ns %7.2f GB/s  (%+.0f%% latencia, %+.0f%% banda)\n", label, r.lat_ns[k], r.gbs[k],
+                   100.0 * (r.lat_ns[k] / r.lat_ns[0] - 1), 100.0 * (r.gbs[k] / r.gbs[0] - 1));
+        else
+            printf("| %-22s : %7.1f ns %7.2f GB/s\n", label, r.lat_ns[k], r.gbs[k]);
+    }
+    return 0;
+}
+
+// Lista de nomes quebrada em linhas com o rótulo só na primeira
+static void print_feature_list(const char *label, const CpuFeatures *f, bool usable) {
+    char line[80];
+    size_t len = 0;
+    bool any = false;
+    line[0] = '\0';
+    for (int id = CPU_FEAT_NONE + 1; id < CPU_FEAT_COUNT; ++id) {
+        bool present = cpu_feature_present(f, (CpuFeature)id);
+        bool ok = cpu_feature_usable(f, (CpuFeature)id);
+        if (!present || ok != usable) continue;
+        const char *name = cpu_feature_name((CpuFeature)id);
+        if (len && len + 2 + strlen(name) > 52) {
+            printf("| %-22s : %s\n", any ? "" : label, line);
+            any = true;
+            len = 0;
+        }
+        len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%s", len ? ", " : "", name);
+    }
+    if (len) printf("| %-22s : %s\n", any ? "" : label, line);
+    else if (!any) printf("| %-22s : -\n", label);
+}
+
+// cpuz-cli features [--all]
+static int cmd_features(int argc, wchar_t **argv) {
+    bool all = argc > 0 && wcscmp(argv[0], L"--all") == 0;
+    CpuFeatures f;
+    if (!get_cpu_features(&f)) {
+        fprintf(stderr, "features: CPUID indisponivel\n");
+        return 1;
+    }
+    printf("| %-22s : %s\n", "Fabricante", f.vendor);
+    printf("| %-22s : %lXh / %lXh / %lu\n", "Familia/modelo/stepping", (unsigned long)f.family,
+           (unsigned long)f.model, (unsigned long)f.stepping);
+    printf("| %-22s : %lXh / %lXh\n", "Folhas max (basica/ext)", (unsigned long)f.max_leaf, (unsigned long)f.max_ext_leaf);
+    if (f.phys_addr_bits)
+        printf("| %-22s : %u fisicos, %u virtuais\n", "Bits de endereco", f.phys_addr_bits, f.virt_addr_bits);
+    printf("| %-22s : %llXh (CPU: %llXh)\n", "XCR0 habilitado", (unsigned long long)f.xcr0,
+           (unsigned long long)f.xcr0_supported);
+    printf("| %-22s : x86-64-v%d\n", "Nivel psABI", cpu_x86_64_level(&f));
+    if (f.avx10_version)
+        printf("| %-22s : AVX10.%u, vetores de ate %u bits\n", "AVX10", f.avx10_version, f.avx10_max_bits);
+    printf("| %-22s : %s\n", "Variante dos benchmarks", bench_isa_name(bench_isa_best()));
+    printf("| ----------------------------------------------\n");
+    print_feature_list("Utilizaveis", &f, true);
+    print_feature_list("Desligadas pelo SO", &f, false);
+
+    if (all) {
+        printf("| ----------------------------------------------\n");
+        for (int id = CPU_FEAT_NONE + 1; id < CPU_FEAT_COUNT; ++id) {
+            bool present = cpu_feature_present(&f, (CpuFeature)id);
+            bool ok = cpu_feature_usable(&f, (CpuFeature)id);
+            printf("| %-22s : %s\n", cpu_feature_name((CpuFeature)id),
+                   ok ? "sim" : present ? "CPU sim, SO nao" : "nao");
+        }
+    }
+    return 0;
+}
+
+typedef struct {
+    const wchar_t *name;
+    int (*run)(int argc, wchar_t **argv);
+    const char *help;
+} CliCommand;
+
+static const CliCommand commands[] = {
+    { L"monitor",    cmd_monitor,    "monitor [segundos]        amostra os sensores e mostra o custo do sampler" },
+    { L"record",     cmd_record,     "record <arq> [--max-mb N] [--seconds S]  grava as amostras em disco" },
+    { L"query",      cmd_query,      "query <arq> <sensor> [--cores A-B] [--from T1] [--to T2] [--per-core]  percentis dos resumos por minuto" },
+    { L"bench",      cmd_bench,      "bench [--seconds S] [--csv arq] [--ref base]  benchmark de CPU: nota ST, MT, razao MT/ST e percentil no modelo" },
+    { L"refdb",      cmd_refdb,      "refdb merge <base> <csv>... | refdb info <base>  base de referencia das notas por modelo de CPU" },
+    { L"stat",       cmd_stat,       "stat <alvo> [--baseline arq] [--save arq] [--ci pct] [--budget s]  repete ate o IC alvo; mediana, MAD, ruido e regressao" },
+    { L"selfbench",  cmd_selfbench,  "selfbench [--calls N] [--only nome|grupo] [--baseline arq] [--save arq] [--threshold pct]  custo de cada getter, a frio e a quente" },
+    { L"membench",   cmd_membench,   "membench [--isa sse2|avx2|avx512|all]  banda de memoria (STREAM) e % do pico teorico" },
+    { L"isabench",   cmd_isabench,   "isabench [--seconds S]    mesma carga em escalar, SSE2, AVX2 e AVX-512: GFLOPS e clock de cada uma" },
+    { L"latency",    cmd_latency,    "latency                   latencia por carga de 4 KB a 4x a ultima cache (cadeia de ponteiros)" },
+    { L"cachebw",    cmd_cachebw,    "cachebw [--isa sse2|avx2|avx512]  banda de leitura, escrita e copia em L1, L2, L3 e DRAM: GB/s e bytes/ciclo" },
+    { L"cachegeo",   cmd_cachegeo,   "cachegeo                  mede tamanho, vias e linha de cada cache e aponta divergencias com o SO" },
+    { L"c2c",        cmd_c2c,        "c2c [--csv arq] [--bmp arq]  latencia entre cada par de nucleos (ping-pong de uma linha)" },
+    { L"numa",       cmd_numa,       "numa                      banda de leitura e latencia entre cada par de nos NUMA, ao lado da SLIT" },
+    { L"smt",        cmd_smt,        "smt [--seconds S]         cada carga sozinha e com cada carga na thread vizinha do mesmo nucleo: vazao mantida" },
+    { L"turbo",      cmd_turbo,      "turbo [--seconds S] [--vector]  clock sustentado com 1, 2, 4... N nucleos ativos (escalar; AVX2/AVX-512 com --vector)" },
+    { L"atomics",    cmd_atomics,    "atomics                   add, CAS, trava de senha e SRWLOCK com 1..N threads, do dominio de L3 aos outros pacotes" },
+    { L"loadlat",    cmd_loadlat,    "loadlat [--mix read|rw]   latencia da memoria de cada no NUMA com banda injetada crescente: mediana, p99 e banda util" },
+    { L"wake",       cmd_wake,       "wake [--idle us,us,...] [--samples N] [--plans]  latencia para acordar um nucleo ocioso e subida do clock, por estado ocioso e plano de energia" },
+    { L"tlb",        cmd_tlb,        "tlb                       custo de acesso em paginas de 4 KB, 2 MB e 1 GB e alcance das TLBs x CPUID" },
+    { L"features",   cmd_features,   "features [--all]          instrucoes informadas pela CPUID e habilitadas pelo SO, nivel x86-64-vN" },
+    { L"stress",     cmd_stress,     "stress [--seconds S] [--record arq]  estresse verificado em todos os nucleos, aprovado/reprovado e throttling" },
+    { L"counters",   cmd_counters,   "counters [segundos]       IPC, falhas no LLC e desvios mal previstos por nucleo (PMU)" },
+    { L"throttle",   cmd_throttle,   "throttle [segundos]       mostra quando e por que cada nucleo perdeu clock" },
+    { L"ring-bench", cmd_ring_bench, "ring-bench [iteracoes]    mede a latencia de publicacao no anel de amostras" },
+};
+
+static void usage(void) {
+    printf("uso: cpuz-cli <comando> [argumentos]\n\n");
+    for (size_t i = 0; i < sizeof(commands)/sizeof(commands[0]); ++i)
+        printf("  %s\n", commands[i].help);
+}
+
+int wmain(int argc, wchar_t **argv) {
+    if (argc < 2) { usage(); return 2; }
+    for (size_t i = 0; i < sizeof(commands)/sizeof(commands[0]); ++i) {
+        if (wcscmp(argv[1], commands[i].name) == 0)
+            return commands[i].run(argc - 2, argv + 2);
+    }
+    usage();
+    return 2;
+}
@@ -1,10 +1,24 @@
 gcc -O2 -Wall -municode \
   -o "UMBAHIU 2025 Edition XYZ.exe" \
   app_win.c \
-  cpu/cpu_basic.c cpu/cpu_cores.c cpu/cpu_cache.c cpu/cpu_clock.c \
+  cpu/cpu_basic.c cpu/cpu_cores.c cpu/cpu_cache.c cpu/cpu_clock.c cpu/cpu_msr.c cpu/cpu_counters.c cpu/cpu_topology.c cpu/cpu_features.c \
   mainboard/mainboard_basic.c mainboard/mainboard_chipset.c mainboard/mainboard_bios.c \
   memory/memory_general.c memory/memory_timings.c \
   graphics/graphics.c \
+  bench/bench_timer.c bench/bench_cpu.c bench/bench_isa.c bench/bench_pool.c bench/bench_memory.c \
   -Icpu -Imainboard -Imemory \
-  -Igraphics \
-  -lcomctl32 -lPowrProf -lsetupapi -lole32 -loleaut32 -lwbemuuid -lgdi32 -luser32
+  -Igraphics -Ibench \
+  -lcomctl32 -lPowrProf -lsynchronization -lsetupapi -lole32 -loleaut32 -lwbemuuid -lgdi32 -luser32
+
+gcc -O2 -Wall -municode \
+  -o "cpuz-cli.exe" \
+  cli_win.c \
+  cpu/cpu_basic.c cpu/cpu_cores.c cpu/cpu_cache.c cpu/cpu_clock.c cpu/cpu_load.c cpu/cpu_msr.c cpu/cpu_thermal.c cpu/cpu_counters.c cpu/cpu_topology.c cpu/cpu_tlb.c cpu/cpu_features.c \
+  memory/memory_general.c memory/memory_timings.c memory/memory_numa.c \
+  mainboard/mainboard_basic.c mainboard/mainboard_chipset.c mainboard/mainboard_bios.c \
+  graphics/graphics.c \
+  monitor/monitor_sampler.c monitor/monitor_sensors.c monitor/monitor_ring.c monitor/monitor_recorder.c \
+  monitor/monitor_varint.c monitor/monitor_rollup.c monitor/monitor_query.c monitor/monitor_throttle.c \
+  bench/bench_timer.c bench/bench_cpu.c bench/bench_isa.c bench/bench_pool.c bench/bench_memory.c \
+  bench/bench_pages.c bench/bench_latency.c bench/bench_cachebw.c bench/bench_cachegeo.c bench/bench_c2c.c bench/bench_numa.c bench/bench_loaded.c bench/bench_smt.c bench/bench_atomic.c bench/bench_turbo.c bench/bench_wake.c bench/bench_tlb.c bench/bench_license.c bench/bench_stress.c bench/bench_refdb.c bench/bench_stats.c bench/bench_providers.c \
+  -lPowrProf -lsynchronization -lpsapi -lsetupapi -lole32 -loleaut32 -lwbemuuid
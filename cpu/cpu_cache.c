@@ -4,12 +4,16 @@
 #include <windows.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "cpu_cache.h"
 
 typedef struct {
     UINT8 level;
     PROCESSOR_CACHE_TYPE type;
     DWORD cacheSize;
     DWORD associativity;
+    DWORD lineSize;
     DWORD count;
 } CacheAgg;
 
@@ -196,15 +200,8 @@ void build_cache_string(wchar_t *out, size_t cchOut) {
     }
 }
 
-size_t build_cache_rows_kv2(
-    wchar_t labels[][32],
-    wchar_t sizes[][32],
-    wchar_t assoc[][16],
-    size_t  maxRows
-) {
-    if (!labels || !sizes || !assoc || maxRows == 0) return 0;
-
-    // ----- monta rows[] como você já faz -----
+// Agrega as caches iguais (mesmo nível, tipo, tamanho e vias) e ordena L1D, L1I, L2, L3
+static size_t collect_rows(CacheAgg *rows, size_t maxRows) {
     DWORD len = 0;
     if (!GetLogicalProcessorInformationEx(RelationCache, NULL, &len) &&
         GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
@@ -217,7 +214,7 @@ size_t build_cache_rows_kv2(
         free(buf); return 0;
     }
 
-    CacheAgg rows[64]; size_t nrows = 0;
+    size_t nrows = 0;
     for (BYTE* p = buf; p < buf + len; ) {
         PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX ex =
             (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)p;
@@ -228,10 +225,11 @@ size_t build_cache_rows_kv2(
             cur.type  = c->Type;
             cur.cacheSize = c->CacheSize;
             cur.associativity = c->Associativity ? c->Associativity : 0;
+            cur.lineSize = c->LineSize;
             if (desired_row(&cur)) {
                 size_t i;
                 for (i = 0; i < nrows; ++i) if (same_key(&rows[i], &cur)) { rows[i].count++; break; }
-                if (i == nrows && nrows < sizeof(rows)/sizeof(rows[0])) { cur.count = 1; rows[nrows++] = cur; }
+                if (i == nrows && nrows < maxRows) { cur.count = 1; rows[nrows++] = cur; }
             }
         }
         p += ex->Size;
@@ -241,6 +239,19 @@ size_t build_cache_rows_kv2(
     for (size_t i = 0; i + 1 < nrows; ++i)
         for (size_t j = i + 1; j < nrows; ++j)
             if (order_key(&rows[i], &rows[j]) > 0) { CacheAgg t = rows[i]; rows[i] = rows[j]; rows[j] = t; }
+    return nrows;
+}
+
+size_t build_cache_rows_kv2(
+    wchar_t labels[][32],
+    wchar_t sizes[][32],
+    wchar_t assoc[][16],
+    size_t  maxRows
+) {
+    if (!labels || !sizes || !assoc || maxRows == 0) return 0;
+
+    CacheAgg rows[64];
+    size_t nrows = collect_rows(rows, sizeof(rows)/sizeof(rows[0]));
 
     // ----- preenche label / size / assoc separadamente -----
     size_t outCount = 0;
@@ -270,3 +281,27 @@ size_t build_cache_rows_kv2(
     return outCount;
 }
 
+size_t get_cache_levels(CacheLevelInfo *out, size_t maxRows) {
+    if (!out || maxRows == 0) return 0;
+    CacheAgg rows[64];
+    size_t nrows = collect_rows(rows, sizeof(rows)/sizeof(rows[0]));
+    size_t n = 0;
+    for (size_t i = 0; i < nrows && n < maxRows; ++i, ++n) {
+        CacheLevelInfo *c = &out[n];
+        memset(c, 0, sizeof(*c));
+        c->level = rows[i].level;
+        c->instruction = rows[i].type == CacheInstruction;
+        snprintf(c->label, sizeof(c->label), "%s", cache_label(rows[i].level, rows[i].type));
+        c->size = rows[i].cacheSize;
+        c->assoc = rows[i].associativity;
+        c->line = rows[i].lineSize;
+        c->count = rows[i].count;
+    }
+    return n;
+}
+
+DWORD cache_level_bytes(const CacheLevelInfo *rows, size_t n, unsigned level) {
+    for (size_t i = 0; i < n; ++i)
+        if (rows[i].level == level && !rows[i].instruction) return rows[i].size;
+    return 0;
+}
@@ -1,5 +1,9 @@
 // cpu_cache.h
 #pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
 void print_cache_rows_pretty(void);
 
 void build_cache_string(wchar_t *out, size_t cchOut);
@@ -9,4 +13,20 @@ size_t build_cache_rows_kv2(
     wchar_t sizes[][32],
     wchar_t assoc[][16],
     size_t  maxRows
-);
\ No newline at end of file
+);
+
+// Mesmas linhas de build_cache_rows_kv2 (mesma ordem), em números
+typedef struct {
+    unsigned level;         // 1, 2 ou 3
+    bool     instruction;   // L1 de instruções
+    char     label[16];     // "L1 Data", "Level 2"...
+    DWORD    size;          // bytes de uma instância
+    DWORD    assoc;         // vias (0 = desconhecida, 0xFF = totalmente associativa)
+    DWORD    line;          // bytes por linha
+    DWORD    count;         // instâncias
+} CacheLevelInfo;
+
+size_t get_cache_levels(CacheLevelInfo *out, size_t maxRows);
+
+// Tamanho de uma instância da cache de dados/unificada do nível (0 se não houver)
+DWORD cache_level_bytes(const CacheLevelInfo *rows, size_t n, unsigned level);
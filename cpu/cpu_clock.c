@@ -5,6 +5,7 @@
 #include <powrprof.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include "cpu_clock.h"
 
 #ifdef _MSC_VER
 #pragma comment(lib, "PowrProf.lib")
@@ -54,3 +55,39 @@ bool get_cpu0_clock(DWORD *current_mhz, DWORD *max_mhz, DWORD *limit_mhz) {
     free(ppi);
     return true;
 }
+
+// Obtém as frequências de todos os núcleos lógicos numa única chamada
+DWORD get_cpu_clocks(CpuClock *out, DWORD max_count) {
+    if (!out || max_count == 0) return 0;
+
+    DWORD nprocs = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    if (nprocs == 0) {
+        SYSTEM_INFO si; GetSystemInfo(&si);
+        nprocs = si.dwNumberOfProcessors;
+        if (nprocs == 0) return 0;
+    }
+
+    PROCESSOR_POWER_INFORMATION* ppi = (PROCESSOR_POWER_INFORMATION*)malloc(sizeof(PROCESSOR_POWER_INFORMATION) * nprocs);
+    if (!ppi) return 0;
+
+    NTSTATUS st = CallNtPowerInformation(
+        ProcessorInformation,
+        NULL, 0,
+        ppi, sizeof(*ppi) * nprocs
+    );
+
+    if (st != 0) {
+        free(ppi);
+        return 0;
+    }
+
+    DWORD n = nprocs < max_count ? nprocs : max_count;
+    for (DWORD i = 0; i < n; ++i) {
+        out[i].current_mhz = ppi[i].CurrentMhz;
+        out[i].max_mhz     = ppi[i].MaxMhz;
+        out[i].limit_mhz   = ppi[i].MhzLimit;
+    }
+
+    free(ppi);
+    return n;
+}
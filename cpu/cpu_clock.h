@@ -2,5 +2,15 @@
 #include <windows.h>
 #include <stdbool.h>
 
+// Frequências de um processador lógico, em MHz
+typedef struct {
+    DWORD current_mhz;
+    DWORD max_mhz;
+    DWORD limit_mhz;
+} CpuClock;
+
 // Retorna true em sucesso e preenche MHz do CPU lógico 0
 bool get_cpu0_clock(DWORD *current_mhz, DWORD *max_mhz, DWORD *limit_mhz);
+
+// Preenche as frequências de até max_count processadores lógicos; retorna quantos foram lidos
+DWORD get_cpu_clocks(CpuClock *out, DWORD max_count);
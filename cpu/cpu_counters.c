@@ -0,0 +1,223 @@
+// cpu_counters.c - Contadores de hardware por núcleo (PMU)
+// Intel: contadores fixos (instruções, ciclos) + 3 programáveis com eventos
+// arquiteturais (CPUID 0xA), iguais em todas as gerações.
+// AMD: 3 contadores de núcleo (ciclos, instruções, desvios mal previstos); o L3
+// fica num PMU separado e não é lido aqui.
+#define _CRT_SECURE_NO_WARNINGS
+#include <windows.h>
+#include <intrin.h>
+#include <string.h>
+#include "cpu_counters.h"
+#include "cpu_msr.h"
+#include "cpu_basic.h"
+
+#define EVTSEL_USR   (1u << 16)
+#define EVTSEL_OS    (1u << 17)
+#define EVTSEL_EN    (1u << 22)
+#define EVTSEL(ev, umask) ((uint64_t)(ev) | ((uint64_t)(umask) << 8) | EVTSEL_USR | EVTSEL_OS | EVTSEL_EN)
+
+// Eventos arquiteturais da Intel (SDM vol. 3, 20.2.1.2)
+#define INTEL_LLC_REFERENCES   EVTSEL(0x2E, 0x4F)
+#define INTEL_LLC_MISSES       EVTSEL(0x2E, 0x41)
+#define INTEL_BRANCH_MISSES    EVTSEL(0xC5, 0x00)
+
+// Eventos de núcleo da AMD (família 17h em diante)
+#define AMD_CYCLES             EVTSEL(0x76, 0x00)
+#define AMD_INSTRUCTIONS       EVTSEL(0xC0, 0x00)
+#define AMD_BRANCH_MISSES      EVTSEL(0xC3, 0x00)
+
+static DWORD cpu_count(void) {
+    DWORD n = GetActiveProcessorCount(0);
+    return n > CPU_COUNTERS_MAX ? CPU_COUNTERS_MAX : n;
+}
+
+// Registradores de controle que o provedor escreve; o estado anterior de cada
+// um é salvo por processador em open e devolvido em close
+static const DWORD intel_regs[CPU_COUNTERS_REGS] = {
+    MSR_IA32_PERF_GLOBAL_CTRL, MSR_IA32_PERFEVTSEL0 + 0, MSR_IA32_PERFEVTSEL0 + 1, MSR_IA32_PERFEVTSEL0 + 2,
+    MSR_IA32_FIXED_CTR_CTRL
+};
+static const DWORD amd_regs[3] = { MSR_AMD_PERF_CTL0 + 0, MSR_AMD_PERF_CTL0 + 2, MSR_AMD_PERF_CTL0 + 4 };
+
+static int reg_count(const CpuCounters *c) {
+    return c->intel ? CPU_COUNTERS_REGS : 3;
+}
+
+static bool save_state(CpuCounters *c) {
+    const DWORD *regs = c->intel ? intel_regs : amd_regs;
+    for (DWORD i = 0; i < c->ncpus; ++i) {
+        // Sem o estado de todos, close não tem o que devolver: nada foi escrito
+        if (!msr_read_group(i, regs, c->saved[i], reg_count(c))) { c->nsaved = 0; return false; }
+        c->nsaved = i + 1;
+    }
+    return true;
+}
+
+// Algum programa (VTune, HWiNFO, outro perfilador) já usa o PMU? Confere em
+// todos os processadores cada registrador que o provedor programa. O
+// GLOBAL_CTRL só conta além do valor de reset (os programáveis ligados).
+static bool pmu_busy(const CpuCounters *c) {
+    for (DWORD i = 0; i < c->nsaved; ++i) {
+        const uint64_t *v = c->saved[i];
+        if (c->intel) {
+            uint64_t reset = c->ngp >= 64 ? ~0ull : (1ull << c->ngp) - 1;
+            if (v[0] & ~reset) return true;                             // GLOBAL_CTRL
+            for (int k = 1; k <= 3; ++k) if (v[k] & EVTSEL_EN) return true;
+            if (v[4] & 0x333) return true;                              // FIXED_CTR_CTRL, contadores 0-2
+        } else {
+            for (int k = 0; k < 3; ++k) if (v[k] & EVTSEL_EN) return true;
+        }
+    }
+    return false;
+}
+
+static bool open_intel(CpuCounters *c) {
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 0xA) { c->reason = "CPUID sem a folha 0xA (PMU)"; return false; }
+    __cpuid(r, 0xA);
+    int version = r[0] & 0xFF, ngp = (r[0] >> 8) & 0xFF, gp_width = (r[0] >> 16) & 0xFF;
+    int nfixed = r[3] & 0x1F, fixed_width = (r[3] >> 5) & 0xFF;
+    // Bits de EBX = evento indisponível (só os primeiros EAX[31:24] valem)
+    int vec_len = (r[0] >> 24) & 0xFF;
+    unsigned unavailable = (unsigned)r[1] | (vec_len < 32 ? ~0u << vec_len : 0);
+    if (version < 2 || nfixed < 2) { c->reason = "PMU nao exposto (maquina virtual?)"; return false; }
+    if (ngp < 3) { c->reason = "menos de 3 contadores programaveis"; return false; }
+
+    c->fixed_mask = fixed_width >= 64 ? ~0ull : (1ull << fixed_width) - 1;
+    c->gp_mask = gp_width >= 64 ? ~0ull : (1ull << gp_width) - 1;
+    c->has_llc = !(unavailable & (1u << 3)) && !(unavailable & (1u << 4));
+    c->has_branch = !(unavailable & (1u << 6));
+    c->ngp = ngp;
+    if (!save_state(c)) { c->reason = "falha ao ler o PMU"; return false; }
+    if (pmu_busy(c)) { c->busy = true; c->reason = "PMU em uso por outro programa"; return false; }
+
+    for (DWORD i = 0; i < c->ncpus; ++i) {
+        bool ok = msr_write(i, MSR_IA32_PERF_GLOBAL_CTRL, 0) &&
+                  msr_write(i, MSR_IA32_PERFEVTSEL0 + 0, c->has_llc ? INTEL_LLC_REFERENCES : 0) &&
+                  msr_write(i, MSR_IA32_PERFEVTSEL0 + 1, c->has_llc ? INTEL_LLC_MISSES : 0) &&
+                  msr_write(i, MSR_IA32_PERFEVTSEL0 + 2, c->has_branch ? INTEL_BRANCH_MISSES : 0) &&
+                  msr_write(i, MSR_IA32_FIXED_CTR_CTRL, 0x33) &&          // fixos 0 e 1, anéis 0 e 3
+                  msr_write(i, MSR_IA32_PERF_GLOBAL_CTRL, 0x7ull | (0x3ull << 32));
+        if (!ok) { c->reason = "falha ao programar o PMU"; return false; }
+    }
+    return true;
+}
+
+static bool open_amd(CpuCounters *c) {
+    int r[4];
+    __cpuid(r, 0x80000001);
+    if (!(r[2] & (1 << 23))) { c->reason = "PMU de nucleo estendido ausente (PerfCtrExtCore)"; return false; }
+    c->gp_mask = (1ull << 48) - 1;
+    c->has_llc = false;
+    c->has_branch = true;
+    if (!save_state(c)) { c->reason = "falha ao ler o PMU"; return false; }
+    if (pmu_busy(c)) { c->busy = true; c->reason = "PMU em uso por outro programa"; return false; }
+
+    for (DWORD i = 0; i < c->ncpus; ++i) {
+        bool ok = msr_write(i, MSR_AMD_PERF_CTL0 + 0, AMD_CYCLES) &&
+                  msr_write(i, MSR_AMD_PERF_CTL0 + 2, AMD_INSTRUCTIONS) &&
+                  msr_write(i, MSR_AMD_PERF_CTL0 + 4, AMD_BRANCH_MISSES);
+        if (!ok) { c->reason = "falha ao programar o PMU"; return false; }
+    }
+    return true;
+}
+
+bool cpu_counters_open(CpuCounters *c) {
+    if (!c) return false;
+    memset(c, 0, sizeof(*c));
+    if (!msr_available()) { c->reason = msr_unavailable_reason(); return false; }
+
+    char vendor[13];
+    get_cpu_vendor(vendor);
+    c->intel = strcmp(vendor, "GenuineIntel") == 0;
+    bool amd = strcmp(vendor, "AuthenticAMD") == 0 || strcmp(vendor, "HygonGenuine") == 0;
+    if (!c->intel && !amd) { c->reason = "fabricante sem suporte"; return false; }
+
+    c->ncpus = cpu_count();
+    c->open = c->intel ? open_intel(c) : open_amd(c);
+    if (!c->open) {
+        cpu_counters_close(c);
+        return false;
+    }
+    c->reason = "";
+    CpuCounterRates discard[CPU_COUNTERS_MAX];
+    cpu_counters_read(c, discard, CPU_COUNTERS_MAX);
+    return true;
+}
+
+// Lê o grupo de contadores de um processador
+static bool read_values(const CpuCounters *c, DWORD cpu, CpuCounterValues *v) {
+    uint64_t raw[5] = {0};
+    if (c->intel) {
+        static const DWORD idx[5] = {
+            MSR_IA32_FIXED_CTR1, MSR_IA32_FIXED_CTR0, MSR_IA32_PMC0 + 0, MSR_IA32_PMC0 + 1, MSR_IA32_PMC0 + 2
+        };
+        if (!msr_read_group(cpu, idx, raw, 5)) return false;
+        v->cycles = raw[0];
+        v->instructions = raw[1];
+        v->llc_refs = raw[2];
+        v->llc_misses = raw[3];
+        v->branch_misses = raw[4];
+    } else {
+        static const DWORD idx[3] = { MSR_AMD_PERF_CTL0 + 1, MSR_AMD_PERF_CTL0 + 3, MSR_AMD_PERF_CTL0 + 5 };
+        if (!msr_read_group(cpu, idx, raw, 3)) return false;
+        v->cycles = raw[0];
+        v->instructions = raw[1];
+        v->llc_refs = v->llc_misses = 0;
+        v->branch_misses = raw[2];
+    }
+    return true;
+}
+
+DWORD cpu_counters_read(CpuCounters *c, CpuCounterRates *out, DWORD max) {
+    if (!c || !c->open || !out) return 0;
+    uint64_t fm = c->intel ? c->fixed_mask : c->gp_mask, gm = c->gp_mask;
+    DWORD n = c->ncpus < max ? c->ncpus : max;
+    for (DWORD i = 0; i < n; ++i) {
+        CpuCounterValues v;
+        if (!read_values(c, i, &v)) return i;
+        CpuCounterValues *p = &c->last[i];
+        // Os contadores têm 48 bits: a diferença mascarada já trata a volta
+        double cyc   = (double)((v.cycles - p->cycles) & fm);
+        double ins   = (double)((v.instructions - p->instructions) & fm);
+        double refs  = (double)((v.llc_refs - p->llc_refs) & gm);
+        double miss  = (double)((v.llc_misses - p->llc_misses) & gm);
+        double brmis = (double)((v.branch_misses - p->branch_misses) & gm);
+        bool first = p->cycles == 0 && p->instructions == 0;
+        *p = v;
+
+        CpuCounterRates *r = &out[i];
+        memset(r, 0, sizeof(*r));
+        if (first) continue;
+        r->cycles = cyc;
+        r->ipc = cyc > 0 ? ins / cyc : 0;
+        r->llc_miss_pct = refs > 0 ? 100.0 * miss / refs : 0;
+        r->llc_mpki = ins > 0 ? 1000.0 * miss / ins : 0;
+        r->branch_mpki = ins > 0 ? 1000.0 * brmis / ins : 0;
+    }
+    return n;
+}
+
+void cpu_counters_close(CpuCounters *c) {
+    if (!c || !msr_available()) return;
+    // O PMU é de outro programa: devolver o "estado anterior" pisaria nele
+    if (c->busy) {
+        c->nsaved = 0;
+        c->open = false;
+        return;
+    }
+    const DWORD *regs = c->intel ? intel_regs : amd_regs;
+    for (DWORD i = 0; i < c->nsaved; ++i) {
+        // Intel: para tudo, devolve a configuração e só então o GLOBAL_CTRL
+        if (c->intel) msr_write(i, MSR_IA32_PERF_GLOBAL_CTRL, 0);
+        for (int k = reg_count(c) - 1; k >= 0; --k) msr_write(i, regs[k], c->saved[i][k]);
+    }
+    c->nsaved = 0;
+    c->open = false;
+}
+
+const char *cpu_counters_reason(const CpuCounters *c) {
+    if (!c) return "";
+    return c->reason ? c->reason : "";
+}
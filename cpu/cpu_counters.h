@@ -0,0 +1,61 @@
+// cpu_counters.h - Contadores de hardware por núcleo (PMU)
+// Ciclos, instruções, referências/falhas no LLC e desvios mal previstos, para
+// IPC e taxas de falha por processador lógico. Os contadores são programados
+// por MSR (cpu_msr.h); sem driver, em máquina virtual sem PMU exposto ou com
+// o PMU em uso por outro programa, cpu_counters_open falha e
+// cpu_counters_reason diz o porquê.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CPU_COUNTERS_MAX  64
+#define CPU_COUNTERS_REGS 5     // registradores de controle programados por processador
+
+// Valores brutos de um processador lógico
+typedef struct {
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t llc_refs;
+    uint64_t llc_misses;
+    uint64_t branch_misses;
+} CpuCounterValues;
+
+// Taxas desde a leitura anterior
+typedef struct {
+    double ipc;
+    double llc_miss_pct;    // falhas / referências ao LLC
+    double llc_mpki;        // falhas no LLC por mil instruções
+    double branch_mpki;     // desvios mal previstos por mil instruções
+    double cycles;          // ciclos no intervalo (0 = núcleo parado)
+} CpuCounterRates;
+
+typedef struct {
+    bool             open;
+    bool             intel;
+    bool             has_llc;       // eventos de LLC disponíveis
+    bool             has_branch;
+    DWORD            ncpus;
+    uint64_t         fixed_mask;    // largura dos contadores fixos (Intel)
+    uint64_t         gp_mask;       // largura dos contadores programáveis
+    int              ngp;           // contadores programáveis (Intel)
+    bool             busy;          // PMU de outro programa: nenhum MSR é escrito, nem no close
+    const char      *reason;
+    CpuCounterValues last[CPU_COUNTERS_MAX];
+    DWORD            nsaved;        // processadores com o estado anterior salvo
+    uint64_t         saved[CPU_COUNTERS_MAX][CPU_COUNTERS_REGS];
+} CpuCounters;
+
+// Programa e liga os contadores em todos os processadores lógicos (até 64)
+bool cpu_counters_open(CpuCounters *c);
+
+// Lê todos os processadores (um grupo de MSRs por processador) e preenche as
+// taxas desde a leitura anterior; a primeira leitura após open zera as taxas
+DWORD cpu_counters_read(CpuCounters *c, CpuCounterRates *out, DWORD max);
+
+// Devolve os registradores de controle aos valores de antes de open (nada
+// escreve se o PMU estava em uso por outro programa)
+void cpu_counters_close(CpuCounters *c);
+
+// Motivo da indisponibilidade ("" se abertos)
+const char *cpu_counters_reason(const CpuCounters *c);
@@ -0,0 +1,278 @@
+// cpu_features.c - Conjuntos de instruções informados pela CPUID
+#include <intrin.h>
+#include <stdio.h>
+#include <string.h>
+#include "cpu_features.h"
+
+enum { EAX, EBX, ECX, EDX };
+
+// Uma instrução: onde está o bit e que estado do XCR0 ela exige
+typedef struct {
+    CpuFeature  id;
+    const char *name;
+    DWORD       leaf;
+    DWORD       sub;
+    BYTE        reg;
+    BYTE        bit;
+    uint64_t    xstate;
+} FeatureBit;
+
+static const FeatureBit feature_bits[] = {
+    { CPU_FEAT_MMX,        "MMX",         1, 0, EDX, 23, 0 },
+    { CPU_FEAT_SSE,        "SSE",         1, 0, EDX, 25, CPU_XSTATE_SSE },
+    { CPU_FEAT_SSE2,       "SSE2",        1, 0, EDX, 26, CPU_XSTATE_SSE },
+    { CPU_FEAT_SSE3,       "SSE3",        1, 0, ECX,  0, CPU_XSTATE_SSE },
+    { CPU_FEAT_PCLMULQDQ,  "PCLMULQDQ",   1, 0, ECX,  1, CPU_XSTATE_SSE },
+    { CPU_FEAT_SSSE3,      "SSSE3",       1, 0, ECX,  9, CPU_XSTATE_SSE },
+    { CPU_FEAT_FMA,        "FMA3",        1, 0, ECX, 12, CPU_XSTATE_AVX },
+    { CPU_FEAT_CX16,       "CMPXCHG16B",  1, 0, ECX, 13, 0 },
+    { CPU_FEAT_SSE41,      "SSE4.1",      1, 0, ECX, 19, CPU_XSTATE_SSE },
+    { CPU_FEAT_SSE42,      "SSE4.2",      1, 0, ECX, 20, CPU_XSTATE_SSE },
+    { CPU_FEAT_MOVBE,      "MOVBE",       1, 0, ECX, 22, 0 },
+    { CPU_FEAT_POPCNT,     "POPCNT",      1, 0, ECX, 23, 0 },
+    { CPU_FEAT_AES,        "AES",         1, 0, ECX, 25, CPU_XSTATE_SSE },
+    { CPU_FEAT_XSAVE,      "XSAVE",       1, 0, ECX, 26, 0 },
+    { CPU_FEAT_OSXSAVE,    "OSXSAVE",     1, 0, ECX, 27, 0 },
+    { CPU_FEAT_AVX,        "AVX",         1, 0, ECX, 28, CPU_XSTATE_AVX },
+    { CPU_FEAT_F16C,       "F16C",        1, 0, ECX, 29, CPU_XSTATE_AVX },
+    { CPU_FEAT_RDRAND,     "RDRAND",      1, 0, ECX, 30, 0 },
+    { CPU_FEAT_HYPERVISOR, "HYPERVISOR",  1, 0, ECX, 31, 0 },
+
+    { CPU_FEAT_FSGSBASE,   "FSGSBASE",    7, 0, EBX,  0, 0 },
+    { CPU_FEAT_SGX,        "SGX",         7, 0, EBX,  2, 0 },
+    { CPU_FEAT_BMI1,       "BMI1",        7, 0, EBX,  3, 0 },
+    { CPU_FEAT_HLE,        "HLE",         7, 0, EBX,  4, 0 },
+    { CPU_FEAT_AVX2,       "AVX2",        7, 0, EBX,  5, CPU_XSTATE_AVX },
+    { CPU_FEAT_BMI2,       "BMI2",        7, 0, EBX,  8, 0 },
+    { CPU_FEAT_ERMS,       "ERMS",        7, 0, EBX,  9, 0 },
+    { CPU_FEAT_RTM,        "RTM",         7, 0, EBX, 11, 0 },
+    { CPU_FEAT_AVX512F,    "AVX-512F",    7, 0, EBX, 16, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_AVX512DQ,   "AVX-512DQ",   7, 0, EBX, 17, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_RDSEED,     "RDSEED",      7, 0, EBX, 18, 0 },
+    { CPU_FEAT_ADX,        "ADX",         7, 0, EBX, 19, 0 },
+    { CPU_FEAT_AVX512IFMA, "AVX-512IFMA", 7, 0, EBX, 21, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_CLFLUSHOPT, "CLFLUSHOPT",  7, 0, EBX, 23, 0 },
+    { CPU_FEAT_CLWB,       "CLWB",        7, 0, EBX, 24, 0 },
+    { CPU_FEAT_PT,         "PT",          7, 0, EBX, 25, 0 },
+    { CPU_FEAT_AVX512CD,   "AVX-512CD",   7, 0, EBX, 28, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_SHA,        "SHA",         7, 0, EBX, 29, CPU_XSTATE_SSE },
+    { CPU_FEAT_AVX512BW,   "AVX-512BW",   7, 0, EBX, 30, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_AVX512VL,   "AVX-512VL",   7, 0, EBX, 31, CPU_XSTATE_AVX512 },
+
+    { CPU_FEAT_AVX512VBMI,      "AVX-512VBMI",      7, 0, ECX,  1, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_WAITPKG,         "WAITPKG",          7, 0, ECX,  5, 0 },
+    { CPU_FEAT_AVX512VBMI2,     "AVX-512VBMI2",     7, 0, ECX,  6, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_GFNI,            "GFNI",             7, 0, ECX,  8, CPU_XSTATE_SSE },
+    { CPU_FEAT_VAES,            "VAES",             7, 0, ECX,  9, CPU_XSTATE_AVX },
+    { CPU_FEAT_VPCLMULQDQ,      "VPCLMULQDQ",       7, 0, ECX, 10, CPU_XSTATE_AVX },
+    { CPU_FEAT_AVX512VNNI,      "AVX-512VNNI",      7, 0, ECX, 11, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_AVX512BITALG,    "AVX-512BITALG",    7, 0, ECX, 12, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_AVX512VPOPCNTDQ, "AVX-512VPOPCNTDQ", 7, 0, ECX, 14, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_LA57,            "LA57",             7, 0, ECX, 16, 0 },
+    { CPU_FEAT_RDPID,           "RDPID",            7, 0, ECX, 22, 0 },
+    { CPU_FEAT_KL,              "KL",               7, 0, ECX, 23, 0 },
+    { CPU_FEAT_CLDEMOTE,        "CLDEMOTE",         7, 0, ECX, 25, 0 },
+    { CPU_FEAT_MOVDIRI,         "MOVDIRI",          7, 0, ECX, 27, 0 },
+    { CPU_FEAT_MOVDIR64B,       "MOVDIR64B",        7, 0, ECX, 28, 0 },
+
+    { CPU_FEAT_FSRM,                "FSRM",                7, 0, EDX,  4, 0 },
+    { CPU_FEAT_AVX512VP2INTERSECT,  "AVX-512VP2INTERSECT", 7, 0, EDX,  8, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_SERIALIZE,           "SERIALIZE",           7, 0, EDX, 14, 0 },
+    { CPU_FEAT_HYBRID,              "HYBRID",              7, 0, EDX, 15, 0 },
+    { CPU_FEAT_AMX_BF16,            "AMX-BF16",            7, 0, EDX, 22, CPU_XSTATE_AMX },
+    { CPU_FEAT_AVX512FP16,          "AVX-512FP16",         7, 0, EDX, 23, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_AMX_TILE,            "AMX-TILE",            7, 0, EDX, 24, CPU_XSTATE_AMX },
+    { CPU_FEAT_AMX_INT8,            "AMX-INT8",            7, 0, EDX, 25, CPU_XSTATE_AMX },
+
+    { CPU_FEAT_SHA512,         "SHA512",         7, 1, EAX,  0, CPU_XSTATE_AVX },
+    { CPU_FEAT_SM3,            "SM3",            7, 1, EAX,  1, CPU_XSTATE_AVX },
+    { CPU_FEAT_SM4,            "SM4",            7, 1, EAX,  2, CPU_XSTATE_AVX },
+    { CPU_FEAT_AVX_VNNI,       "AVX-VNNI",       7, 1, EAX,  4, CPU_XSTATE_AVX },
+    { CPU_FEAT_AVX512BF16,     "AVX-512BF16",    7, 1, EAX,  5, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_CMPCCXADD,      "CMPCCXADD",      7, 1, EAX,  7, 0 },
+    { CPU_FEAT_AMX_FP16,       "AMX-FP16",       7, 1, EAX, 21, CPU_XSTATE_AMX },
+    { CPU_FEAT_AVX_IFMA,       "AVX-IFMA",       7, 1, EAX, 23, CPU_XSTATE_AVX },
+    { CPU_FEAT_AVX_VNNI_INT8,  "AVX-VNNI-INT8",  7, 1, EDX,  4, CPU_XSTATE_AVX },
+    { CPU_FEAT_AVX_NE_CONVERT, "AVX-NE-CONVERT", 7, 1, EDX,  5, CPU_XSTATE_AVX },
+    { CPU_FEAT_AMX_COMPLEX,    "AMX-COMPLEX",    7, 1, EDX,  8, CPU_XSTATE_AMX },
+    { CPU_FEAT_AVX_VNNI_INT16, "AVX-VNNI-INT16", 7, 1, EDX, 10, CPU_XSTATE_AVX },
+    { CPU_FEAT_AVX10,          "AVX10",          7, 1, EDX, 19, CPU_XSTATE_AVX512 },
+    { CPU_FEAT_APX,            "APX",            7, 1, EDX, 21, CPU_XSTATE_APX },
+
+    { CPU_FEAT_XSAVEOPT, "XSAVEOPT", 0xD, 1, EAX, 0, 0 },
+    { CPU_FEAT_XSAVEC,   "XSAVEC",   0xD, 1, EAX, 1, 0 },
+    { CPU_FEAT_XSAVES,   "XSAVES",   0xD, 1, EAX, 3, 0 },
+    { CPU_FEAT_XFD,      "XFD",      0xD, 1, EAX, 4, 0 },
+
+    { CPU_FEAT_PTWRITE,  "PTWRITE",  0x14, 0, EBX, 4, 0 },
+    { CPU_FEAT_AESKLE,   "AESKLE",   0x19, 0, EBX, 0, 0 },
+    { CPU_FEAT_WIDE_KL,  "WIDE_KL",  0x19, 0, EBX, 2, 0 },
+
+    { CPU_FEAT_LAHF,      "LAHF-SAHF", 0x80000001, 0, ECX,  0, 0 },
+    { CPU_FEAT_LZCNT,     "LZCNT",     0x80000001, 0, ECX,  5, 0 },
+    { CPU_FEAT_SSE4A,     "SSE4A",     0x80000001, 0, ECX,  6, CPU_XSTATE_SSE },
+    { CPU_FEAT_PREFETCHW, "PREFETCHW", 0x80000001, 0, ECX,  8, 0 },
+    { CPU_FEAT_XOP,       "XOP",       0x80000001, 0, ECX, 11, CPU_XSTATE_AVX },
+    { CPU_FEAT_FMA4,      "FMA4",      0x80000001, 0, ECX, 16, CPU_XSTATE_AVX },
+    { CPU_FEAT_TBM,       "TBM",       0x80000001, 0, ECX, 21, 0 },
+    { CPU_FEAT_NX,        "NX",        0x80000001, 0, EDX, 20, 0 },
+    { CPU_FEAT_PDPE1GB,   "PDPE1GB",   0x80000001, 0, EDX, 26, 0 },
+    { CPU_FEAT_RDTSCP,    "RDTSCP",    0x80000001, 0, EDX, 27, 0 },
+    { CPU_FEAT_LM,        "x86-64",    0x80000001, 0, EDX, 29, 0 },
+    { CPU_FEAT_CLZERO,    "CLZERO",    0x80000008, 0, EBX,  0, 0 },
+    { CPU_FEAT_RDPRU,     "RDPRU",     0x80000008, 0, EBX,  4, 0 },
+    { CPU_FEAT_WBNOINVD,  "WBNOINVD",  0x80000008, 0, EBX,  9, 0 },
+};
+
+#define FEATURE_BITS (sizeof(feature_bits) / sizeof(feature_bits[0]))
+
+static void set_bit(uint32_t *words, CpuFeature id) {
+    words[id / 32] |= 1u << (id % 32);
+}
+
+// Folha disponível? Subfolhas de 7 dependem de 7.0 EAX; 0x14/0x19/0x24 da instrução que as define
+static bool leaf_valid(const CpuFeatures *f, DWORD leaf, DWORD sub, DWORD leaf7_max_sub) {
+    if (leaf >= 0x80000000u) return leaf <= f->max_ext_leaf;
+    if (leaf > f->max_leaf) return false;
+    if (leaf == 7) return sub <= leaf7_max_sub;
+    if (leaf == 0x14) return cpu_feature_present(f, CPU_FEAT_PT);
+    if (leaf == 0x19) return cpu_feature_present(f, CPU_FEAT_KL);
+    return true;
+}
+
+bool get_cpu_features(CpuFeatures *out) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    int r[4];
+    __cpuid(r, 0);
+    out->max_leaf = (DWORD)r[0];
+    memcpy(out->vendor + 0, &r[1], 4);
+    memcpy(out->vendor + 4, &r[3], 4);
+    memcpy(out->vendor + 8, &r[2], 4);
+    out->vendor[12] = '\0';
+    if (out->max_leaf < 1) return false;
+    __cpuid(r, 0x80000000);
+    out->max_ext_leaf = (unsigned)r[0] >= 0x80000000u ? (DWORD)r[0] : 0;
+
+    __cpuid(r, 1);
+    DWORD eax = (DWORD)r[0];
+    out->stepping = eax & 0xF;
+    out->family = (eax >> 8) & 0xF;
+    out->model = (eax >> 4) & 0xF;
+    if (out->family == 0xF) out->family += (eax >> 20) & 0xFF;
+    if (out->family == 0x6 || out->family >= 0xF) out->model += ((eax >> 16) & 0xF) << 4;
+
+    DWORD leaf7_max_sub = 0;
+    if (out->max_leaf >= 7) {
+        __cpuidex(r, 7, 0);
+        leaf7_max_sub = (DWORD)r[0];
+    }
+
+    // Folhas na ordem da tabela: 7.0 antes de 0x14/0x19, que dependem dela
+    DWORD cur_leaf = 0xFFFFFFFFu, cur_sub = 0;
+    bool cur_ok = false;
+    for (size_t i = 0; i < FEATURE_BITS; ++i) {
+        const FeatureBit *b = &feature_bits[i];
+        if (b->leaf != cur_leaf || b->sub != cur_sub) {
+            cur_leaf = b->leaf;
+            cur_sub = b->sub;
+            cur_ok = leaf_valid(out, cur_leaf, cur_sub, leaf7_max_sub);
+            if (cur_ok) __cpuidex(r, (int)cur_leaf, (int)cur_sub);
+        }
+        if (cur_ok && (((unsigned)r[b->reg] >> b->bit) & 1)) set_bit(out->present, b->id);
+    }
+
+    // Estados salvos pelo SO; sem OSXSAVE só o SSE (FXSAVE) é garantido
+    if (cpu_feature_present(out, CPU_FEAT_OSXSAVE)) out->xcr0 = _xgetbv(0);
+    if (out->max_leaf >= 0xD) {
+        __cpuidex(r, 0xD, 0);
+        out->xcr0_supported = (uint64_t)(unsigned)r[0] | ((uint64_t)(unsigned)r[3] << 32);
+    }
+    uint64_t enabled = out->xcr0 ? out->xcr0 : CPU_XSTATE_SSE;
+    for (size_t i = 0; i < FEATURE_BITS; ++i) {
+        const FeatureBit *b = &feature_bits[i];
+        if (cpu_feature_present(out, b->id) && (enabled & b->xstate) == b->xstate) set_bit(out->usable, b->id);
+    }
+
+    // AVX10: versão e maior vetor (folha 0x24)
+    if (cpu_feature_present(out, CPU_FEAT_AVX10) && out->max_leaf >= 0x24) {
+        __cpuidex(r, 0x24, 0);
+        out->avx10_version = (BYTE)(r[1] & 0xFF);
+        out->avx10_max_bits = (r[1] >> 18) & 1 ? 512 : (r[1] >> 17) & 1 ? 256 : 128;
+    }
+    if (out->max_ext_leaf >= 0x80000008) {
+        __cpuid(r, 0x80000008);
+        out->phys_addr_bits = (BYTE)(r[0] & 0xFF);
+        out->virt_addr_bits = (BYTE)((r[0] >> 8) & 0xFF);
+    }
+    return true;
+}
+
+static CpuFeatures g_features;
+static INIT_ONCE g_features_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK features_init(PINIT_ONCE once, PVOID param, PVOID *ctx) {
+    (void)once; (void)param; (void)ctx;
+    get_cpu_features(&g_features);
+    return TRUE;
+}
+
+const CpuFeatures *cpu_features(void) {
+    InitOnceExecuteOnce(&g_features_once, features_init, NULL, NULL);
+    return &g_features;
+}
+
+bool cpu_has(CpuFeature id) {
+    if (id <= CPU_FEAT_NONE || id >= CPU_FEAT_COUNT) return false;
+    return cpu_feature_usable(cpu_features(), id);
+}
+
+const char *cpu_feature_name(CpuFeature id) {
+    for (size_t i = 0; i < FEATURE_BITS; ++i)
+        if (feature_bits[i].id == id) return feature_bits[i].name;
+    return "?";
+}
+
+int cpu_x86_64_level(const CpuFeatures *f) {
+    static const CpuFeature v2[] = { CPU_FEAT_CX16, CPU_FEAT_LAHF, CPU_FEAT_POPCNT, CPU_FEAT_SSE3,
+                                     CPU_FEAT_SSE41, CPU_FEAT_SSE42, CPU_FEAT_SSSE3 };
+    static const CpuFeature v3[] = { CPU_FEAT_AVX, CPU_FEAT_AVX2, CPU_FEAT_BMI1, CPU_FEAT_BMI2, CPU_FEAT_F16C,
+                                     CPU_FEAT_FMA, CPU_FEAT_LZCNT, CPU_FEAT_MOVBE, CPU_FEAT_OSXSAVE };
+    static const CpuFeature v4[] = { CPU_FEAT_AVX512F, CPU_FEAT_AVX512BW, CPU_FEAT_AVX512CD,
+                                     CPU_FEAT_AVX512DQ, CPU_FEAT_AVX512VL };
+    const CpuFeature *levels[3] = { v2, v3, v4 };
+    const size_t counts[3] = { sizeof(v2) / sizeof(v2[0]), sizeof(v3) / sizeof(v3[0]), sizeof(v4) / sizeof(v4[0]) };
+    int level = 1;
+    for (int l = 0; l < 3; ++l) {
+        for (size_t i = 0; i < counts[l]; ++i)
+            if (!cpu_feature_usable(f, levels[l][i])) return level;
+        level++;
+    }
+    return level;
+}
+
+void build_feature_string(char *out, size_t n) {
+    if (!out || n == 0) return;
+    const CpuFeatures *f = cpu_features();
+    size_t len = 0;
+    out[0] = '\0';
+    for (size_t i = 0; i < FEATURE_BITS; ++i) {
+        const FeatureBit *b = &feature_bits[i];
+        if (b->id == CPU_FEAT_HYPERVISOR || b->id == CPU_FEAT_OSXSAVE || !cpu_feature_usable(f, b->id)) continue;
+        int w = snprintf(out + len, n - len, "%s%s", len ? ", " : "", b->name);
+        if (w < 0 || (size_t)w >= n - len) break;
+        len += (size_t)w;
+    }
+}
+
+bool cpu_dispatch_ok(const CpuDispatchEntry *e) {
+    for (int i = 0; i < CPU_DISPATCH_MAX_NEEDS && e->needs[i] != CPU_FEAT_NONE; ++i)
+        if (!cpu_has(e->needs[i])) return false;
+    return true;
+}
+
+int cpu_dispatch(const CpuDispatchEntry *table, int count) {
+    for (int i = 0; i < count; ++i)
+        if (cpu_dispatch_ok(&table[i])) return i;
+    return -1;
+}
@@ -0,0 +1,108 @@
+// cpu_features.h - Conjuntos de instruções informados pela CPUID
+// Folhas 1, 7 (subfolhas 0 e 1), 0xD, 0x14, 0x19, 0x24, 0x80000001 e
+// 0x80000008. Cada instrução tem dois estados: presente (a CPU informa) e
+// utilizável (presente e, para as extensões com registradores novos, o
+// sistema habilitou o estado correspondente no XCR0, lido com XGETBV).
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    CPU_FEAT_NONE = 0,
+    // Folha 1
+    CPU_FEAT_MMX, CPU_FEAT_SSE, CPU_FEAT_SSE2, CPU_FEAT_SSE3, CPU_FEAT_SSSE3,
+    CPU_FEAT_SSE41, CPU_FEAT_SSE42, CPU_FEAT_CX16, CPU_FEAT_POPCNT, CPU_FEAT_MOVBE,
+    CPU_FEAT_AES, CPU_FEAT_PCLMULQDQ, CPU_FEAT_XSAVE, CPU_FEAT_OSXSAVE, CPU_FEAT_AVX,
+    CPU_FEAT_F16C, CPU_FEAT_FMA, CPU_FEAT_RDRAND, CPU_FEAT_HYPERVISOR,
+    // Folha 7.0
+    CPU_FEAT_FSGSBASE, CPU_FEAT_SGX, CPU_FEAT_BMI1, CPU_FEAT_HLE, CPU_FEAT_AVX2,
+    CPU_FEAT_BMI2, CPU_FEAT_ERMS, CPU_FEAT_RTM, CPU_FEAT_RDSEED, CPU_FEAT_ADX,
+    CPU_FEAT_CLFLUSHOPT, CPU_FEAT_CLWB, CPU_FEAT_PT, CPU_FEAT_SHA,
+    CPU_FEAT_AVX512F, CPU_FEAT_AVX512DQ, CPU_FEAT_AVX512IFMA, CPU_FEAT_AVX512CD,
+    CPU_FEAT_AVX512BW, CPU_FEAT_AVX512VL, CPU_FEAT_AVX512VBMI, CPU_FEAT_AVX512VBMI2,
+    CPU_FEAT_AVX512VNNI, CPU_FEAT_AVX512BITALG, CPU_FEAT_AVX512VPOPCNTDQ,
+    CPU_FEAT_AVX512VP2INTERSECT, CPU_FEAT_AVX512FP16,
+    CPU_FEAT_WAITPKG, CPU_FEAT_GFNI, CPU_FEAT_VAES, CPU_FEAT_VPCLMULQDQ, CPU_FEAT_LA57,
+    CPU_FEAT_RDPID, CPU_FEAT_KL, CPU_FEAT_CLDEMOTE, CPU_FEAT_MOVDIRI, CPU_FEAT_MOVDIR64B,
+    CPU_FEAT_FSRM, CPU_FEAT_SERIALIZE, CPU_FEAT_HYBRID,
+    CPU_FEAT_AMX_BF16, CPU_FEAT_AMX_TILE, CPU_FEAT_AMX_INT8,
+    // Folha 7.1
+    CPU_FEAT_SHA512, CPU_FEAT_SM3, CPU_FEAT_SM4, CPU_FEAT_AVX_VNNI, CPU_FEAT_AVX512BF16,
+    CPU_FEAT_CMPCCXADD, CPU_FEAT_AMX_FP16, CPU_FEAT_AVX_IFMA, CPU_FEAT_AVX_VNNI_INT8,
+    CPU_FEAT_AVX_NE_CONVERT, CPU_FEAT_AMX_COMPLEX, CPU_FEAT_AVX_VNNI_INT16,
+    CPU_FEAT_AVX10, CPU_FEAT_APX,
+    // Folha 0xD.1
+    CPU_FEAT_XSAVEOPT, CPU_FEAT_XSAVEC, CPU_FEAT_XSAVES, CPU_FEAT_XFD,
+    // Folhas 0x14 e 0x19
+    CPU_FEAT_PTWRITE, CPU_FEAT_AESKLE, CPU_FEAT_WIDE_KL,
+    // Folhas 0x80000001 e 0x80000008
+    CPU_FEAT_LAHF, CPU_FEAT_LZCNT, CPU_FEAT_SSE4A, CPU_FEAT_PREFETCHW, CPU_FEAT_XOP,
+    CPU_FEAT_FMA4, CPU_FEAT_TBM, CPU_FEAT_NX, CPU_FEAT_PDPE1GB, CPU_FEAT_RDTSCP,
+    CPU_FEAT_LM, CPU_FEAT_CLZERO, CPU_FEAT_RDPRU, CPU_FEAT_WBNOINVD,
+    CPU_FEAT_COUNT
+} CpuFeature;
+
+#define CPU_FEAT_WORDS ((CPU_FEAT_COUNT + 31) / 32)
+
+// Bits do XCR0
+#define CPU_XSTATE_SSE      0x2ull
+#define CPU_XSTATE_AVX      0x6ull                  // SSE + YMM
+#define CPU_XSTATE_AVX512   0xE6ull                 // + opmask, ZMM_Hi256, Hi16_ZMM
+#define CPU_XSTATE_AMX      0x60000ull              // XTILECFG + XTILEDATA
+#define CPU_XSTATE_APX      0x80000ull              // EGPR
+
+typedef struct {
+    char     vendor[13];
+    DWORD    family, model, stepping;           // já combinados com os campos estendidos
+    DWORD    max_leaf, max_ext_leaf;
+    uint64_t xcr0;                              // estados habilitados pelo SO (0 sem OSXSAVE)
+    uint64_t xcr0_supported;                    // estados que a CPU sabe salvar (folha 0xD)
+    BYTE     avx10_version;                     // 0 = sem AVX10
+    WORD     avx10_max_bits;                    // maior vetor AVX10 (128, 256 ou 512)
+    BYTE     phys_addr_bits, virt_addr_bits;
+    uint32_t present[CPU_FEAT_WORDS];
+    uint32_t usable[CPU_FEAT_WORDS];
+} CpuFeatures;
+
+// Lê todas as folhas; false se a CPU não tiver CPUID suficiente
+bool get_cpu_features(CpuFeatures *out);
+
+// Leitura feita uma vez por processo
+const CpuFeatures *cpu_features(void);
+
+static inline bool cpu_feature_present(const CpuFeatures *f, CpuFeature id) {
+    return (f->present[id / 32] >> (id % 32)) & 1;
+}
+
+static inline bool cpu_feature_usable(const CpuFeatures *f, CpuFeature id) {
+    return (f->usable[id / 32] >> (id % 32)) & 1;
+}
+
+// Utilizável nesta máquina (atalho para cpu_feature_usable(cpu_features(), id))
+bool cpu_has(CpuFeature id);
+
+const char *cpu_feature_name(CpuFeature id);
+
+// Nível da psABI x86-64 atendido (1 a 4, como em -march=x86-64-v3)
+int cpu_x86_64_level(const CpuFeatures *f);
+
+// Lista das instruções utilizáveis, separadas por vírgula
+void build_feature_string(char *out, size_t n);
+
+// ---- Despacho ----
+// Variantes de uma rotina em ordem de preferência; cada uma lista as
+// instruções de que precisa (a lista termina em CPU_FEAT_NONE).
+#define CPU_DISPATCH_MAX_NEEDS 6
+
+typedef struct {
+    const char *name;
+    CpuFeature  needs[CPU_DISPATCH_MAX_NEEDS];
+} CpuDispatchEntry;
+
+// true se todas as instruções da variante são utilizáveis
+bool cpu_dispatch_ok(const CpuDispatchEntry *e);
+
+// Índice da primeira variante utilizável (-1 se nenhuma)
+int cpu_dispatch(const CpuDispatchEntry *table, int count);
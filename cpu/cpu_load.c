@@ -0,0 +1,86 @@
+// cpu_load.c - Utilização de cada processador lógico
+// Lê os tempos ocioso/kernel/usuário por núcleo via NtQuerySystemInformationEx
+// (ntdll), um grupo de processadores por vez: a versão sem Ex só vê o grupo da
+// thread chamadora (até 64 processadores). A ordem é a de get_cpu_clocks:
+// grupo 0 inteiro, depois o grupo 1, e assim por diante.
+#include <windows.h>
+#include <string.h>
+#include "cpu_load.h"
+
+#define SystemProcessorPerformanceInformation 8
+
+typedef struct {
+    LARGE_INTEGER IdleTime;
+    LARGE_INTEGER KernelTime;   // inclui o tempo ocioso
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER DpcTime;
+    LARGE_INTEGER InterruptTime;
+    ULONG         InterruptCount;
+} SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION;
+
+typedef LONG (WINAPI *NtQuerySystemInformationFunc)(int, PVOID, ULONG, ULONG*);
+typedef LONG (WINAPI *NtQuerySystemInformationExFunc)(int, PVOID, ULONG, PVOID, ULONG, ULONG*);
+
+// Resolve as duas funções uma única vez (ntdll está sempre carregada)
+static NtQuerySystemInformationFunc nt_query(NtQuerySystemInformationExFunc *query_ex) {
+    static NtQuerySystemInformationFunc fn = NULL;
+    static NtQuerySystemInformationExFunc fn_ex = NULL;
+    if (!fn) {
+        HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+        if (ntdll) {
+            fn_ex = (NtQuerySystemInformationExFunc)GetProcAddress(ntdll, "NtQuerySystemInformationEx");
+            fn = (NtQuerySystemInformationFunc)GetProcAddress(ntdll, "NtQuerySystemInformation");
+        }
+    }
+    *query_ex = fn_ex;
+    return fn;
+}
+
+// Tempos de todos os processadores, grupo a grupo; retorna quantos foram lidos
+static DWORD read_times(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION *info, DWORD max) {
+    NtQuerySystemInformationExFunc query_ex;
+    NtQuerySystemInformationFunc query = nt_query(&query_ex);
+    WORD groups = GetActiveProcessorGroupCount();
+    ULONG len = 0;
+    if (!query_ex || groups <= 1) {
+        // Um grupo só (ou Windows sem a versão Ex): a consulta simples basta
+        if (!query || query(SystemProcessorPerformanceInformation, info, max * sizeof(info[0]), &len) != 0) return 0;
+        return (DWORD)(len / sizeof(info[0]));
+    }
+    // Um grupo tem no máximo 64 processadores; o que passar de max fica de fora
+    SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION group[64];
+    DWORD n = 0;
+    for (USHORT g = 0; g < groups && n < max; ++g) {
+        len = 0;
+        if (query_ex(SystemProcessorPerformanceInformation, &g, sizeof(g), group, sizeof(group), &len) != 0) return 0;
+        DWORD k = (DWORD)(len / sizeof(group[0]));
+        if (k > max - n) k = max - n;
+        memcpy(info + n, group, k * sizeof(group[0]));
+        n += k;
+    }
+    return n;
+}
+
+DWORD get_cpu_loads(CpuLoadState *st, double *load_pct, DWORD max) {
+    if (!st || !load_pct || max == 0) return 0;
+    SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION info[CPU_LOAD_MAX];
+    DWORD n = read_times(info, CPU_LOAD_MAX);
+    if (n == 0) return 0;
+
+    bool first = (st->count != n);
+    DWORD out = 0;
+    for (DWORD i = 0; i < n; ++i) {
+        ULONGLONG idle  = (ULONGLONG)info[i].IdleTime.QuadPart;
+        ULONGLONG total = (ULONGLONG)info[i].KernelTime.QuadPart + (ULONGLONG)info[i].UserTime.QuadPart;
+        if (!first && i < max) {
+            ULONGLONG dIdle  = idle - st->idle[i];
+            ULONGLONG dTotal = total - st->total[i];
+            double busy = dTotal ? 100.0 * (double)(dTotal - (dIdle < dTotal ? dIdle : dTotal)) / (double)dTotal : 0.0;
+            load_pct[out++] = busy;
+        }
+        st->idle[i]  = idle;
+        st->total[i] = total;
+    }
+    st->count = n;
+    return out;
+}
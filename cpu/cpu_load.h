@@ -0,0 +1,17 @@
+// cpu_load.h - Utilização de cada processador lógico
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+
+#define CPU_LOAD_MAX 256
+
+// Contadores acumulados da última leitura (a carga é a diferença entre duas leituras)
+typedef struct {
+    ULONGLONG idle[CPU_LOAD_MAX];
+    ULONGLONG total[CPU_LOAD_MAX];
+    DWORD     count;
+} CpuLoadState;
+
+// Preenche a carga (0-100%) de até max processadores desde a leitura anterior.
+// Na primeira chamada só guarda os contadores e retorna 0.
+DWORD get_cpu_loads(CpuLoadState *st, double *load_pct, DWORD max);
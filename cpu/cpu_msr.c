@@ -0,0 +1,101 @@
+// cpu_msr.c - Leitura de MSRs via WinRing0
+#define _CRT_SECURE_NO_WARNINGS
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "cpu_msr.h"
+
+// Interface exportada pela WinRing0x64.dll
+typedef BOOL  (WINAPI *OLS_INITIALIZE)(void);
+typedef DWORD (WINAPI *OLS_GET_DLL_STATUS)(void);
+typedef BOOL  (WINAPI *OLS_RDMSR)(DWORD index, PDWORD eax, PDWORD edx);
+typedef BOOL  (WINAPI *OLS_RDMSR_TX)(DWORD index, PDWORD eax, PDWORD edx, DWORD_PTR affinity);
+typedef BOOL  (WINAPI *OLS_WRMSR_TX)(DWORD index, DWORD eax, DWORD edx, DWORD_PTR affinity);
+
+#define OLS_DLL_NO_ERROR                0
+#define OLS_DLL_DRIVER_NOT_LOADED       4
+#define OLS_DLL_DRIVER_NOT_FOUND        5
+
+typedef struct {
+    HMODULE       lib;
+    OLS_RDMSR     Rdmsr;
+    OLS_RDMSR_TX  RdmsrTx;
+    OLS_WRMSR_TX  WrmsrTx;
+    const char   *reason;
+    bool          ok;
+} MsrContext;
+
+static MsrContext g_msr;
+static INIT_ONCE  g_msr_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK msr_load(PINIT_ONCE once, PVOID param, PVOID *ctx) {
+    (void)once; (void)param; (void)ctx;
+    g_msr.lib = LoadLibraryA(sizeof(void*) == 8 ? "WinRing0x64.dll" : "WinRing0.dll");
+    if (!g_msr.lib) {
+        g_msr.reason = "WinRing0 nao encontrado ao lado do executavel";
+        return TRUE;
+    }
+    OLS_INITIALIZE InitializeOls = (OLS_INITIALIZE)GetProcAddress(g_msr.lib, "InitializeOls");
+    OLS_GET_DLL_STATUS GetDllStatus = (OLS_GET_DLL_STATUS)GetProcAddress(g_msr.lib, "GetDllStatus");
+    g_msr.Rdmsr   = (OLS_RDMSR)GetProcAddress(g_msr.lib, "Rdmsr");
+    g_msr.RdmsrTx = (OLS_RDMSR_TX)GetProcAddress(g_msr.lib, "RdmsrTx");
+    g_msr.WrmsrTx = (OLS_WRMSR_TX)GetProcAddress(g_msr.lib, "WrmsrTx");
+    if (!InitializeOls || !GetDllStatus || !g_msr.Rdmsr || !g_msr.RdmsrTx || !g_msr.WrmsrTx) {
+        g_msr.reason = "WinRing0 incompativel";
+        FreeLibrary(g_msr.lib);
+        g_msr.lib = NULL;
+        return TRUE;
+    }
+
+    // O driver só carrega com privilégio de administrador
+    if (!InitializeOls() || GetDllStatus() != OLS_DLL_NO_ERROR) {
+        switch (GetDllStatus()) {
+            case OLS_DLL_DRIVER_NOT_FOUND:  g_msr.reason = "driver WinRing0x64.sys nao encontrado"; break;
+            case OLS_DLL_DRIVER_NOT_LOADED: g_msr.reason = "driver nao carregado (execute como administrador)"; break;
+            default:                        g_msr.reason = "driver WinRing0 nao inicializou"; break;
+        }
+        FreeLibrary(g_msr.lib);
+        g_msr.lib = NULL;
+        return TRUE;
+    }
+    g_msr.ok = true;
+    return TRUE;
+}
+
+bool msr_available(void) {
+    InitOnceExecuteOnce(&g_msr_once, msr_load, NULL, NULL);
+    return g_msr.ok;
+}
+
+const char *msr_unavailable_reason(void) {
+    if (msr_available()) return "";
+    return g_msr.reason ? g_msr.reason : "indisponivel";
+}
+
+bool msr_read(DWORD cpu, DWORD index, uint64_t *value) {
+    if (!value || cpu >= 64 || !msr_available()) return false;
+    DWORD eax = 0, edx = 0;
+    // RdmsrTx troca a afinidade da thread para o processador pedido e restaura
+    if (!g_msr.RdmsrTx(index, &eax, &edx, (DWORD_PTR)1 << cpu)) return false;
+    *value = ((uint64_t)edx << 32) | eax;
+    return true;
+}
+
+bool msr_read_group(DWORD cpu, const DWORD *index, uint64_t *values, int n) {
+    if (!index || !values || cpu >= 64 || !msr_available()) return false;
+    DWORD_PTR old = SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+    if (!old) return false;
+    bool ok = true;
+    for (int i = 0; i < n && ok; ++i) {
+        DWORD eax = 0, edx = 0;
+        ok = g_msr.Rdmsr(index[i], &eax, &edx) != FALSE;
+        values[i] = ((uint64_t)edx << 32) | eax;
+    }
+    SetThreadAffinityMask(GetCurrentThread(), old);
+    return ok;
+}
+
+bool msr_write(DWORD cpu, DWORD index, uint64_t value) {
+    if (cpu >= 64 || !msr_available()) return false;
+    return g_msr.WrmsrTx(index, (DWORD)value, (DWORD)(value >> 32), (DWORD_PTR)1 << cpu) != FALSE;
+}
@@ -0,0 +1,45 @@
+// cpu_msr.h - Leitura de MSRs (Model Specific Registers)
+// O Windows não expõe RDMSR ao modo usuário; usamos o driver do WinRing0
+// (WinRing0x64.dll + WinRing0x64.sys ao lado do executável, como o CPU-Z e o
+// HWiNFO fazem). Sem o driver ou sem privilégio de administrador, as leituras
+// falham e msr_unavailable_reason() explica o motivo.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Registradores usados pelo programa
+#define MSR_IA32_THERM_STATUS          0x19C
+#define MSR_IA32_TEMPERATURE_TARGET    0x1A2
+#define MSR_IA32_PACKAGE_THERM_STATUS  0x1B1
+#define MSR_RAPL_POWER_UNIT            0x606
+#define MSR_PKG_POWER_LIMIT            0x610
+#define MSR_PKG_ENERGY_STATUS          0x611
+#define MSR_CORE_PERF_LIMIT_REASONS    0x64F
+#define MSR_CORE_C3_RESIDENCY          0x3FC       // ciclos do TSC em cada estado ocioso do núcleo
+#define MSR_CORE_C6_RESIDENCY          0x3FD
+#define MSR_CORE_C7_RESIDENCY          0x3FE
+#define MSR_IA32_PMC0                  0x0C1
+#define MSR_IA32_PERFEVTSEL0           0x186
+#define MSR_IA32_FIXED_CTR0            0x309       // instruções retiradas
+#define MSR_IA32_FIXED_CTR1            0x30A       // ciclos do núcleo
+#define MSR_IA32_FIXED_CTR_CTRL        0x38D
+#define MSR_IA32_PERF_GLOBAL_CTRL      0x38F
+#define MSR_AMD_PERF_CTL0              0xC0010200  // PerfCtlN = 0xC0010200 + 2N, PerfCtrN = +1
+#define MSR_AMD_RAPL_POWER_UNIT        0xC0010299
+#define MSR_AMD_PKG_ENERGY_STATUS      0xC001029B
+
+// Carrega o driver na primeira chamada; retorna true se RDMSR está disponível
+bool msr_available(void);
+
+// Motivo da indisponibilidade (texto curto, para exibição)
+const char *msr_unavailable_reason(void);
+
+// Lê um MSR no processador lógico cpu (0-63)
+bool msr_read(DWORD cpu, DWORD index, uint64_t *value);
+
+// Lê n MSRs no mesmo processador com uma única troca de afinidade
+bool msr_read_group(DWORD cpu, const DWORD *index, uint64_t *values, int n);
+
+// Escreve um MSR no processador lógico cpu (0-63)
+bool msr_write(DWORD cpu, DWORD index, uint64_t value);
@@ -0,0 +1,156 @@
+// cpu_thermal.c - Temperatura, potência e limites ativos do processador
+// IA32_THERM_STATUS (por núcleo) dá a distância até o TjMax e os limites do
+// núcleo; MSR_CORE_PERF_LIMIT_REASONS (pacote) diz qual limite está cortando o
+// clock; RAPL dá a energia do pacote.
+#define _CRT_SECURE_NO_WARNINGS
+#include <windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu_thermal.h"
+#include "cpu_msr.h"
+#include "cpu_basic.h"
+
+static bool is_intel(void) {
+    static int intel = -1;
+    if (intel < 0) {
+        char vendor[13];
+        get_cpu_vendor(vendor);
+        intel = strcmp(vendor, "GenuineIntel") == 0;
+    }
+    return intel == 1;
+}
+
+// Primeiro processador lógico do núcleo de cada processador lógico: um RDMSR
+// por núcleo basta, já que os irmãos SMT compartilham o sensor
+static const BYTE *core_leaders(void) {
+    static BYTE leader[CPU_THERMAL_MAX];
+    static bool done = false;
+    if (done) return leader;
+    for (int i = 0; i < CPU_THERMAL_MAX; ++i) leader[i] = (BYTE)i;
+
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &len);
+    BYTE *buf = len ? (BYTE*)malloc(len) : NULL;
+    if (buf && GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buf, &len)) {
+        for (BYTE *p = buf; p < buf + len; ) {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX ex = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)p;
+            if (ex->Relationship == RelationProcessorCore && ex->Processor.GroupMask[0].Group == 0) {
+                KAFFINITY m = ex->Processor.GroupMask[0].Mask;
+                int first = -1;
+                for (int i = 0; i < CPU_THERMAL_MAX; ++i) {
+                    if (!(m & ((KAFFINITY)1 << i))) continue;
+                    if (first < 0) first = i;
+                    leader[i] = (BYTE)first;
+                }
+            }
+            p += ex->Size;
+        }
+    }
+    free(buf);
+    done = true;
+    return leader;
+}
+
+// Bits de MSR_CORE_PERF_LIMIT_REASONS (status atual; os de log ficam em 16+)
+static DWORD decode_perf_limit_reasons(uint64_t v) {
+    DWORD r = 0;
+    if (v & (1u << 0))  r |= CPU_LIMIT_PROCHOT;
+    if (v & (1u << 1))  r |= CPU_LIMIT_THERMAL;     // thermal status
+    if (v & (1u << 5))  r |= CPU_LIMIT_THERMAL;     // média térmica (RATL)
+    if (v & (1u << 6))  r |= CPU_LIMIT_THERMAL;     // VR therm alert
+    if (v & (1u << 7))  r |= CPU_LIMIT_CURRENT;     // VR TDC
+    if (v & (1u << 8))  r |= CPU_LIMIT_CURRENT;     // EDP / ICCmax
+    if (v & (1u << 10)) r |= CPU_LIMIT_PL1;
+    if (v & (1u << 11)) r |= CPU_LIMIT_PL2;
+    if (v & (1u << 4))  r |= CPU_LIMIT_OTHER;       // residency state regulation
+    if (v & (1u << 13)) r |= CPU_LIMIT_OTHER;       // turbo transition attenuation
+    return r;
+}
+
+// Bits de IA32_THERM_STATUS / IA32_PACKAGE_THERM_STATUS
+static DWORD decode_therm_status(uint64_t v) {
+    DWORD r = 0;
+    if (v & (1u << 0))  r |= CPU_LIMIT_THERMAL;
+    if (v & (1u << 2))  r |= CPU_LIMIT_PROCHOT;
+    if (v & (1u << 10)) r |= CPU_LIMIT_POWER;
+    if (v & (1u << 12)) r |= CPU_LIMIT_CURRENT;
+    return r;
+}
+
+DWORD get_cpu_thermals(CpuThermal *out, DWORD max) {
+    if (!out || max == 0 || !is_intel() || !msr_available()) return 0;
+
+    static int tjmax = -1;
+    if (tjmax < 0) {
+        uint64_t v;
+        tjmax = msr_read(0, MSR_IA32_TEMPERATURE_TARGET, &v) ? (int)((v >> 16) & 0xFF) : 0;
+        if (tjmax == 0) tjmax = 100;    // valor típico quando o MSR não informa
+    }
+
+    // Limites do pacote valem para todos os núcleos
+    uint64_t v;
+    DWORD pkg = 0;
+    if (msr_read(0, MSR_CORE_PERF_LIMIT_REASONS, &v)) pkg |= decode_perf_limit_reasons(v);
+    if (msr_read(0, MSR_IA32_PACKAGE_THERM_STATUS, &v)) pkg |= decode_therm_status(v);
+    // Com o motivo exato do PL, a indicação genérica de potência é redundante
+    if (pkg & (CPU_LIMIT_PL1 | CPU_LIMIT_PL2)) pkg &= ~(DWORD)CPU_LIMIT_POWER;
+
+    DWORD n = GetActiveProcessorCount(0);
+    if (n > max) n = max;
+    if (n > CPU_THERMAL_MAX) n = CPU_THERMAL_MAX;
+    const BYTE *leader = core_leaders();
+    DWORD got = 0;
+    for (DWORD i = 0; i < n; ++i) {
+        if (leader[i] < i) {
+            out[i] = out[leader[i]];
+            got++;
+            continue;
+        }
+        if (!msr_read(i, MSR_IA32_THERM_STATUS, &v) || !(v & (1u << 31))) break;   // bit 31: leitura válida
+        out[i].temp_c = (double)(tjmax - (int)((v >> 16) & 0x7F));
+        DWORD core = decode_therm_status(v);
+        if (pkg & (CPU_LIMIT_PL1 | CPU_LIMIT_PL2)) core &= ~(DWORD)CPU_LIMIT_POWER;
+        out[i].limits = pkg | core;
+        got++;
+    }
+    return got;
+}
+
+bool get_cpu_power(CpuPowerState *st, CpuPower *out) {
+    if (!st || !out || !msr_available()) return false;
+    bool intel = is_intel();
+
+    if (st->energy_unit_j == 0) {
+        uint64_t u;
+        if (!msr_read(0, intel ? MSR_RAPL_POWER_UNIT : MSR_AMD_RAPL_POWER_UNIT, &u)) return false;
+        st->power_unit_w = 1.0 / (double)(1u << (u & 0xF));
+        st->energy_unit_j = 1.0 / (double)(1u << ((u >> 8) & 0x1F));
+    }
+
+    uint64_t e;
+    if (!msr_read(0, intel ? MSR_PKG_ENERGY_STATUS : MSR_AMD_PKG_ENERGY_STATUS, &e)) return false;
+    LARGE_INTEGER now, freq;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&freq);
+
+    bool ok = false;
+    if (st->primed) {
+        // Contador de 32 bits: a subtração sem sinal já trata a volta
+        uint32_t delta = (uint32_t)e - st->last_energy;
+        double secs = (double)(now.QuadPart - st->last_qpc) / (double)freq.QuadPart;
+        if (secs > 0) {
+            out->package_w = (double)delta * st->energy_unit_j / secs;
+            out->pl1_w = out->pl2_w = 0;
+            uint64_t pl;
+            if (intel && msr_read(0, MSR_PKG_POWER_LIMIT, &pl)) {
+                if (pl & (1ull << 15)) out->pl1_w = (double)(pl & 0x7FFF) * st->power_unit_w;
+                if (pl & (1ull << 47)) out->pl2_w = (double)((pl >> 32) & 0x7FFF) * st->power_unit_w;
+            }
+            ok = true;
+        }
+    }
+    st->last_energy = (uint32_t)e;
+    st->last_qpc = now.QuadPart;
+    st->primed = true;
+    return ok;
+}
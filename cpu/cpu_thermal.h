@@ -0,0 +1,45 @@
+// cpu_thermal.h - Temperatura, potência e limites ativos do processador
+// Lidos por MSR (cpu_msr.h); sem o driver, as funções retornam 0/false.
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Limites ativos no momento da leitura (máscara de bits)
+#define CPU_LIMIT_THERMAL   0x01    // temperatura no limite (TjMax, média térmica, VR quente)
+#define CPU_LIMIT_PROCHOT   0x02    // PROCHOT# externo (placa-mãe/VRM)
+#define CPU_LIMIT_POWER     0x04    // limite de potência sem PL identificado
+#define CPU_LIMIT_PL1       0x08    // limite de potência sustentada
+#define CPU_LIMIT_PL2       0x10    // limite de potência de curta duração
+#define CPU_LIMIT_CURRENT   0x20    // corrente (ICCmax, VR TDC, EDP)
+#define CPU_LIMIT_OTHER     0x40
+
+#define CPU_THERMAL_MAX 64
+
+// Temperatura e limites de um processador lógico (irmãos SMT repetem o núcleo)
+typedef struct {
+    double temp_c;
+    DWORD  limits;
+} CpuThermal;
+
+// Preenche até max processadores lógicos (só Intel); retorna quantos foram lidos
+DWORD get_cpu_thermals(CpuThermal *out, DWORD max);
+
+// Energia acumulada da leitura anterior (a potência é a diferença entre duas leituras)
+typedef struct {
+    uint32_t  last_energy;
+    LONGLONG  last_qpc;
+    double    energy_unit_j;
+    double    power_unit_w;
+    bool      primed;
+} CpuPowerState;
+
+typedef struct {
+    double package_w;
+    double pl1_w;       // 0 = desconhecido/desabilitado
+    double pl2_w;
+} CpuPower;
+
+// Potência média do pacote desde a leitura anterior (RAPL, Intel e AMD).
+// Na primeira chamada só guarda o contador e retorna false.
+bool get_cpu_power(CpuPowerState *st, CpuPower *out);
@@ -0,0 +1,205 @@
+// cpu_tlb.c - TLBs informadas pela CPUID
+#include <intrin.h>
+#include <stdio.h>
+#include <string.h>
+#include "cpu_tlb.h"
+
+// Descritores de TLB da folha 2 (Intel SDM, tabela 3-12); os de cache são ignorados
+typedef struct {
+    BYTE code;
+    BYTE level;
+    BYTE type;
+    BYTE pages;
+    WORD entries;
+    WORD ways;
+} TlbDescriptor;
+
+static const TlbDescriptor descriptors[] = {
+    { 0x01, 1, TLB_INSTRUCTION, TLB_PAGE_4K,                             32, 4 },
+    { 0x02, 1, TLB_INSTRUCTION, TLB_PAGE_4M,                              2, 0 },
+    { 0x03, 1, TLB_DATA,        TLB_PAGE_4K,                             64, 4 },
+    { 0x04, 1, TLB_DATA,        TLB_PAGE_4M,                              8, 4 },
+    { 0x05, 2, TLB_DATA,        TLB_PAGE_4M,                             32, 4 },
+    { 0x0B, 1, TLB_INSTRUCTION, TLB_PAGE_4M,                              4, 4 },
+    { 0x4F, 1, TLB_INSTRUCTION, TLB_PAGE_4K,                             32, 0 },
+    { 0x50, 1, TLB_INSTRUCTION, TLB_PAGE_4K | TLB_PAGE_2M | TLB_PAGE_4M, 64, 0 },
+    { 0x51, 1, TLB_INSTRUCTION, TLB_PAGE_4K | TLB_PAGE_2M | TLB_PAGE_4M, 128, 0 },
+    { 0x52, 1, TLB_INSTRUCTION, TLB_PAGE_4K | TLB_PAGE_2M | TLB_PAGE_4M, 256, 0 },
+    { 0x55, 1, TLB_INSTRUCTION, TLB_PAGE_2M | TLB_PAGE_4M,                7, 0 },
+    { 0x56, 1, TLB_DATA,        TLB_PAGE_4M,                             16, 4 },
+    { 0x57, 1, TLB_DATA,        TLB_PAGE_4K,                             16, 4 },
+    { 0x59, 1, TLB_DATA,        TLB_PAGE_4K,                             16, 0 },
+    { 0x5A, 1, TLB_DATA,        TLB_PAGE_2M | TLB_PAGE_4M,               32, 4 },
+    { 0x5B, 1, TLB_DATA,        TLB_PAGE_4K | TLB_PAGE_4M,               64, 0 },
+    { 0x5C, 1, TLB_DATA,        TLB_PAGE_4K | TLB_PAGE_4M,              128, 0 },
+    { 0x5D, 1, TLB_DATA,        TLB_PAGE_4K | TLB_PAGE_4M,              256, 0 },
+    { 0x61, 1, TLB_INSTRUCTION, TLB_PAGE_4K,                             48, 0 },
+    { 0x63, 1, TLB_DATA,        TLB_PAGE_2M | TLB_PAGE_4M,               32, 4 },
+    { 0x63, 1, TLB_DATA,        TLB_PAGE_1G,                              4, 4 },
+    { 0x64, 1, TLB_DATA,        TLB_PAGE_4K,                            512, 4 },
+    { 0x6A, 1, TLB_DATA,        TLB_PAGE_4K,                             64, 8 },
+    { 0x6B, 1, TLB_DATA,        TLB_PAGE_4K,                            256, 8 },
+    { 0x6C, 1, TLB_DATA,        TLB_PAGE_2M | TLB_PAGE_4M,              128, 8 },
+    { 0x6D, 1, TLB_DATA,        TLB_PAGE_1G,                             16, 0 },
+    { 0x76, 1, TLB_INSTRUCTION, TLB_PAGE_2M | TLB_PAGE_4M,                8, 0 },
+    { 0xA0, 1, TLB_DATA,        TLB_PAGE_4K,                             32, 0 },
+    { 0xB0, 1, TLB_INSTRUCTION, TLB_PAGE_4K,                            128, 4 },
+    { 0xB1, 1, TLB_INSTRUCTION, TLB_PAGE_2M,                              8, 4 },
+    { 0xB2, 1, TLB_INSTRUCTION, TLB_PAGE_4K,                             64, 4 },
+    { 0xB3, 1, TLB_DATA,        TLB_PAGE_4K,                            128, 4 },
+    { 0xB4, 2, TLB_DATA,        TLB_PAGE_4K,                            256, 4 },
+    { 0xB5, 1, TLB_INSTRUCTION, TLB_PAGE_4K,                             64, 8 },
+    { 0xB6, 1, TLB_INSTRUCTION, TLB_PAGE_4K,                            128, 8 },
+    { 0xBA, 2, TLB_DATA,        TLB_PAGE_4K,                             64, 4 },
+    { 0xC0, 1, TLB_DATA,        TLB_PAGE_4K | TLB_PAGE_4M,                8, 4 },
+    { 0xC1, 2, TLB_UNIFIED,     TLB_PAGE_4K | TLB_PAGE_2M,             1024, 8 },
+    { 0xC2, 1, TLB_DATA,        TLB_PAGE_4K | TLB_PAGE_2M,               16, 4 },
+    { 0xC3, 2, TLB_UNIFIED,     TLB_PAGE_4K | TLB_PAGE_2M,             1536, 6 },
+    { 0xC3, 2, TLB_UNIFIED,     TLB_PAGE_1G,                             16, 4 },
+    { 0xC4, 1, TLB_DATA,        TLB_PAGE_2M | TLB_PAGE_4M,               32, 4 },
+    { 0xCA, 2, TLB_UNIFIED,     TLB_PAGE_4K,                            512, 4 },
+};
+
+static size_t add(TlbInfo *out, size_t n, size_t max, BYTE level, BYTE type, BYTE pages, DWORD entries, DWORD ways) {
+    if (n >= max || entries == 0) return n;
+    out[n].level = level;
+    out[n].type = type;
+    out[n].pages = pages;
+    out[n].entries = (WORD)entries;
+    out[n].ways = (WORD)ways;
+    return n + 1;
+}
+
+// Folha 0x18: uma subfolha por estrutura
+static size_t intel_leaf18(TlbInfo *out, size_t n, size_t max) {
+    int r[4];
+    __cpuidex(r, 0x18, 0);
+    unsigned last = (unsigned)r[0];
+    for (unsigned sub = 0; sub <= last && n < max; ++sub) {
+        __cpuidex(r, 0x18, (int)sub);
+        unsigned ebx = (unsigned)r[1], ecx = (unsigned)r[2], edx = (unsigned)r[3];
+        BYTE type = (BYTE)(edx & 0x1F);
+        if (type == 0) continue;
+        bool full = (edx >> 8) & 1;
+        DWORD ways = ebx >> 16;
+        n = add(out, n, max, (BYTE)((edx >> 5) & 7), type, (BYTE)(ebx & 0xF), ways * ecx, full ? 0 : ways);
+    }
+    return n;
+}
+
+// Folha 2: até 15 descritores de um byte em EAX..EDX (AL é o contador)
+static size_t intel_leaf2(TlbInfo *out, size_t n, size_t max, unsigned max_leaf, bool *use_leaf18) {
+    int r[4];
+    __cpuid(r, 2);
+    for (int reg = 0; reg < 4; ++reg) {
+        unsigned v = (unsigned)r[reg];
+        if (v & 0x80000000u) continue;          // registrador sem descritores
+        for (int b = reg == 0 ? 1 : 0; b < 4; ++b) {
+            BYTE code = (BYTE)(v >> (8 * b));
+            if (code == 0xFF && max_leaf >= 0x18) *use_leaf18 = true;
+            for (size_t d = 0; d < sizeof(descriptors) / sizeof(descriptors[0]); ++d)
+                if (descriptors[d].code == code)
+                    n = add(out, n, max, descriptors[d].level, descriptors[d].type, descriptors[d].pages,
+                            descriptors[d].entries, descriptors[d].ways);
+        }
+    }
+    return n;
+}
+
+// Associatividade codificada das folhas 0x80000006/0x80000019
+static DWORD amd_ways(unsigned code) {
+    static const WORD ways[16] = { 0, 1, 2, 3, 4, 6, 8, 0, 16, 0, 32, 48, 64, 96, 128, 0 };
+    return ways[code & 0xF];
+}
+
+// Formato das folhas 0x80000006/0x80000019: assoc[31:28] entradas[27:16] (dados), [15:12] [11:0] (instruções)
+static size_t amd_l2_format(TlbInfo *out, size_t n, size_t max, unsigned v, BYTE level, BYTE pages) {
+    unsigned da = v >> 28, de = (v >> 16) & 0xFFF, ia = (v >> 12) & 0xF, ie = v & 0xFFF;
+    if (da) n = add(out, n, max, level, TLB_DATA, pages, de, da == 0xF ? 0 : amd_ways(da));
+    if (ia) n = add(out, n, max, level, TLB_INSTRUCTION, pages, ie, ia == 0xF ? 0 : amd_ways(ia));
+    return n;
+}
+
+static size_t amd_tlbs(TlbInfo *out, size_t n, size_t max) {
+    int r[4];
+    __cpuid(r, 0x80000000);
+    unsigned max_ext = (unsigned)r[0];
+    if (max_ext >= 0x80000005) {
+        // L1: assoc[31:24] entradas[23:16] (dados), [15:8] [7:0] (instruções); 0xFF = totalmente associativa
+        __cpuid(r, 0x80000005);
+        unsigned large = (unsigned)r[0], small = (unsigned)r[1];
+        unsigned regs[2] = { small, large };
+        BYTE pages[2] = { TLB_PAGE_4K, TLB_PAGE_2M | TLB_PAGE_4M };
+        for (int k = 0; k < 2; ++k) {
+            unsigned v = regs[k];
+            unsigned da = v >> 24, ia = (v >> 8) & 0xFF;
+            n = add(out, n, max, 1, TLB_DATA, pages[k], (v >> 16) & 0xFF, da == 0xFF ? 0 : da);
+            n = add(out, n, max, 1, TLB_INSTRUCTION, pages[k], v & 0xFF, ia == 0xFF ? 0 : ia);
+        }
+    }
+    if (max_ext >= 0x80000006) {
+        __cpuid(r, 0x80000006);
+        n = amd_l2_format(out, n, max, (unsigned)r[1], 2, TLB_PAGE_4K);
+        n = amd_l2_format(out, n, max, (unsigned)r[0], 2, TLB_PAGE_2M | TLB_PAGE_4M);
+    }
+    if (max_ext >= 0x80000019) {
+        __cpuid(r, 0x80000019);
+        n = amd_l2_format(out, n, max, (unsigned)r[0], 1, TLB_PAGE_1G);
+        n = amd_l2_format(out, n, max, (unsigned)r[1], 2, TLB_PAGE_1G);
+    }
+    return n;
+}
+
+size_t get_tlb_info(TlbInfo *out, size_t max) {
+    if (!out || max == 0) return 0;
+    int r[4];
+    __cpuid(r, 0);
+    unsigned max_leaf = (unsigned)r[0];
+    char vendor[13];
+    memcpy(vendor + 0, &r[1], 4);
+    memcpy(vendor + 4, &r[3], 4);
+    memcpy(vendor + 8, &r[2], 4);
+    vendor[12] = '\0';
+
+    if (strcmp(vendor, "GenuineIntel") == 0) {
+        bool use_leaf18 = false;
+        size_t n = max_leaf >= 2 ? intel_leaf2(out, 0, max, max_leaf, &use_leaf18) : 0;
+        // 0xFF na folha 2: os descritores de TLB ficam na folha 0x18
+        if (use_leaf18) n = intel_leaf18(out, n, max);
+        return n;
+    }
+    return amd_tlbs(out, 0, max);
+}
+
+DWORD tlb_data_entries(const TlbInfo *t, size_t n, BYTE level, BYTE page) {
+    DWORD best = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (t[i].level != level || !(t[i].pages & page)) continue;
+        if (t[i].type == TLB_INSTRUCTION || t[i].type == TLB_STORE) continue;
+        if (t[i].entries > best) best = t[i].entries;
+    }
+    return best;
+}
+
+const char *tlb_type_name(BYTE type) {
+    switch (type) {
+    case TLB_DATA:        return "dados";
+    case TLB_INSTRUCTION: return "instrucoes";
+    case TLB_UNIFIED:     return "unificada";
+    case TLB_LOAD:        return "leituras";
+    case TLB_STORE:       return "escritas";
+    default:              return "?";
+    }
+}
+
+void tlb_pages_string(BYTE pages, char *out, size_t n) {
+    static const char *const names[4] = { "4K", "2M", "4M", "1G" };
+    size_t len = 0;
+    out[0] = '\0';
+    for (int b = 0; b < 4; ++b) {
+        if (!(pages & (1 << b))) continue;
+        int w = snprintf(out + len, n - len, "%s%s", len ? "/" : "", names[b]);
+        if (w < 0 || (size_t)w >= n - len) break;
+        len += (size_t)w;
+    }
+}
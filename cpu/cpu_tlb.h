@@ -0,0 +1,45 @@
+// cpu_tlb.h - TLBs informadas pela CPUID
+// Intel: descritores da folha 2 e, quando ela manda consultar, a folha 0x18
+// (tradução de endereços determinística). AMD: folhas 0x80000005 (L1),
+// 0x80000006 (L2) e 0x80000019 (páginas de 1 GB).
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define TLB_MAX 32
+
+// Tipos (mesmos códigos da folha 0x18)
+enum {
+    TLB_DATA = 1,
+    TLB_INSTRUCTION = 2,
+    TLB_UNIFIED = 3,
+    TLB_LOAD = 4,
+    TLB_STORE = 5
+};
+
+// Tamanhos de página (bits, mesmos da folha 0x18)
+#define TLB_PAGE_4K 0x1
+#define TLB_PAGE_2M 0x2
+#define TLB_PAGE_4M 0x4
+#define TLB_PAGE_1G 0x8
+
+typedef struct {
+    BYTE  level;            // 1 = L1 (DTLB/ITLB), 2 = segundo nível (STLB)
+    BYTE  type;             // TLB_DATA..TLB_STORE
+    BYTE  pages;            // TLB_PAGE_* aceitos
+    WORD  entries;
+    WORD  ways;             // 0 = totalmente associativa
+} TlbInfo;
+
+// Lista as TLBs; retorna quantas foram preenchidas
+size_t get_tlb_info(TlbInfo *out, size_t max);
+
+// Entradas da TLB de dados do nível para o tamanho de página (maior entre
+// dados, unificada e de leitura; 0 se não informada)
+DWORD tlb_data_entries(const TlbInfo *t, size_t n, BYTE level, BYTE page);
+
+const char *tlb_type_name(BYTE type);
+
+// "4K/2M", "1G"...
+void tlb_pages_string(BYTE pages, char *out, size_t n);
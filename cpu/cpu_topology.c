@@ -0,0 +1,104 @@
+// cpu_topology.c - Topologia dos processadores lógicos
+// Monta a tabela a partir de GetLogicalProcessorInformationEx(RelationAll)
+#include <windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu_topology.h"
+
+// Índice do processador (grupo, número) na tabela; -1 se não estiver
+static int find_cpu(const CpuTopology *t, WORD group, BYTE number) {
+    for (DWORD i = 0; i < t->count; ++i)
+        if (t->cpus[i].group == group && t->cpus[i].number == number) return (int)i;
+    return -1;
+}
+
+// Percorre os processadores de uma máscara de grupo que estão na tabela
+#define FOR_EACH_IN_MASK(t, gm, idx)                                          \
+    for (BYTE _b = 0; _b < sizeof(KAFFINITY) * 8; ++_b)                       \
+        if (((gm).Mask >> _b) & 1)                                             \
+            for (int idx = find_cpu((t), (gm).Group, _b); idx >= 0; idx = -1)
+
+static int cmp_cpu(const void *a, const void *b) {
+    const CpuLogical *x = (const CpuLogical*)a, *y = (const CpuLogical*)b;
+    if (x->group != y->group) return x->group - y->group;
+    return x->number - y->number;
+}
+
+bool get_cpu_topology(CpuTopology *t) {
+    if (!t) return false;
+    memset(t, 0, sizeof(*t));
+
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationAll, NULL, &len);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || len == 0) return false;
+    BYTE *buf = (BYTE*)malloc(len);
+    if (!buf) return false;
+    if (!GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buf, &len)) {
+        free(buf);
+        return false;
+    }
+
+    // 1ª passada: núcleos (define a lista de processadores lógicos)
+    for (BYTE *p = buf; p < buf + len; ) {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX ex = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)p;
+        if (ex->Relationship == RelationProcessorCore) {
+            BYTE smt = 0;
+            for (WORD g = 0; g < ex->Processor.GroupCount; ++g) {
+                GROUP_AFFINITY gm = ex->Processor.GroupMask[g];
+                for (BYTE b = 0; b < sizeof(KAFFINITY) * 8 && t->count < CPU_TOPO_MAX; ++b) {
+                    if (!((gm.Mask >> b) & 1)) continue;
+                    CpuLogical *c = &t->cpus[t->count++];
+                    c->group = gm.Group;
+                    c->number = b;
+                    c->smt = smt++;
+                    c->core = (WORD)t->ncores;
+                    c->efficiency = ex->Processor.EfficiencyClass;
+                }
+            }
+            if (ex->Processor.EfficiencyClass > t->max_efficiency) t->max_efficiency = ex->Processor.EfficiencyClass;
+            t->ncores++;
+        }
+        p += ex->Size;
+    }
+    qsort(t->cpus, t->count, sizeof(t->cpus[0]), cmp_cpu);
+
+    // 2ª passada: pacotes, L3 e nós NUMA
+    for (BYTE *p = buf; p < buf + len; ) {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX ex = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)p;
+        if (ex->Relationship == RelationProcessorPackage) {
+            for (WORD g = 0; g < ex->Processor.GroupCount; ++g)
+                FOR_EACH_IN_MASK(t, ex->Processor.GroupMask[g], i) t->cpus[i].package = (WORD)t->npackages;
+            t->npackages++;
+        } else if (ex->Relationship == RelationCache && ex->Cache.Level == 3) {
+            FOR_EACH_IN_MASK(t, ex->Cache.GroupMask, i) t->cpus[i].l3 = (WORD)t->nl3;
+            if (ex->Cache.CacheSize > t->l3_bytes) t->l3_bytes = ex->Cache.CacheSize;
+            t->nl3++;
+        } else if (ex->Relationship == RelationCache && ex->Cache.Level == 2) {
+            if (ex->Cache.CacheSize > t->l2_bytes) t->l2_bytes = ex->Cache.CacheSize;
+        } else if (ex->Relationship == RelationNumaNode) {
+            FOR_EACH_IN_MASK(t, ex->NumaNode.GroupMask, i) t->cpus[i].node = (WORD)ex->NumaNode.NodeNumber;
+            if (ex->NumaNode.NodeNumber + 1 > t->nnodes) t->nnodes = ex->NumaNode.NodeNumber + 1;
+        }
+        p += ex->Size;
+    }
+    if (t->npackages == 0) t->npackages = 1;
+    if (t->nnodes == 0) t->nnodes = 1;
+    free(buf);
+    return t->count > 0;
+}
+
+bool topology_pin_thread(HANDLE thread, const CpuLogical *cpu) {
+    if (!cpu) return false;
+    GROUP_AFFINITY ga;
+    memset(&ga, 0, sizeof(ga));
+    ga.Group = cpu->group;
+    ga.Mask = (KAFFINITY)1 << cpu->number;
+    return SetThreadGroupAffinity(thread, &ga, NULL) != FALSE;
+}
+
+const CpuLogical *topology_fastest_cpu(const CpuTopology *t) {
+    if (!t || t->count == 0) return NULL;
+    for (DWORD i = 0; i < t->count; ++i)
+        if (t->cpus[i].efficiency == t->max_efficiency && t->cpus[i].smt == 0) return &t->cpus[i];
+    return &t->cpus[0];
+}
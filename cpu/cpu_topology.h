@@ -0,0 +1,42 @@
+// cpu_topology.h - Topologia dos processadores lógicos
+// Para cada processador lógico: grupo/número (para fixar threads), núcleo,
+// posição SMT dentro do núcleo, pacote, domínio de L3, nó NUMA e classe de
+// eficiência (núcleos P/E).
+#pragma once
+#include <windows.h>
+#include <stdbool.h>
+
+#define CPU_TOPO_MAX 256
+
+typedef struct {
+    WORD group;             // grupo de processadores do Windows
+    BYTE number;            // número dentro do grupo
+    BYTE smt;               // 0 = primeira thread do núcleo
+    WORD core;              // índice do núcleo físico (0..ncores-1)
+    WORD package;
+    WORD l3;                // domínio de L3 (CCX/cluster), 0 se não houver L3
+    WORD node;              // nó NUMA
+    BYTE efficiency;        // classe de eficiência (maior = núcleo mais rápido)
+} CpuLogical;
+
+typedef struct {
+    CpuLogical cpus[CPU_TOPO_MAX];  // ordenados por grupo/número
+    DWORD      count;
+    DWORD      ncores;
+    DWORD      npackages;
+    DWORD      nl3;
+    DWORD      l3_bytes;            // tamanho de um domínio de L3 (0 = sem L3)
+    DWORD      l2_bytes;            // L2 de um núcleo
+    DWORD      nnodes;
+    BYTE       max_efficiency;
+} CpuTopology;
+
+// Lê a topologia; retorna false se a API falhar
+bool get_cpu_topology(CpuTopology *t);
+
+// Fixa uma thread no processador lógico indicado
+bool topology_pin_thread(HANDLE thread, const CpuLogical *cpu);
+
+// Processador lógico para o teste de uma thread: primeira thread do primeiro
+// núcleo da classe mais rápida
+const CpuLogical *topology_fastest_cpu(const CpuTopology *t);
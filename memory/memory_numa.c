@@ -0,0 +1,68 @@
+// memory_numa.c - Nós NUMA: memória de cada nó e distâncias da tabela ACPI SLIT
+// A SLIT é indexada por domínio de proximidade; GetNumaProximityNodeEx traduz
+// cada domínio para o número de nó usado pelo Windows.
+
+#include "memory_numa.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define ACPI_PROVIDER      0x41435049u      // 'ACPI'
+#define ACPI_SIG_SLIT      0x54494C53u      // "SLIT" em little-endian
+#define ACPI_HEADER_BYTES  36
+
+int numa_index(const MemNumaInfo *info, USHORT node) {
+    for (DWORD i = 0; i < info->count; ++i)
+        if (info->node[i] == node) return (int)i;
+    return -1;
+}
+
+// Tabela SLIT: cabeçalho ACPI, UINT64 com o número de domínios e a matriz N x N
+static void read_slit(MemNumaInfo *out) {
+    UINT size = GetSystemFirmwareTable(ACPI_PROVIDER, ACPI_SIG_SLIT, NULL, 0);
+    if (size < ACPI_HEADER_BYTES + 8) return;
+    BYTE *buf = (BYTE*)malloc(size);
+    if (!buf) return;
+    if (GetSystemFirmwareTable(ACPI_PROVIDER, ACPI_SIG_SLIT, buf, size) == size) {
+        ULONGLONG n;
+        memcpy(&n, buf + ACPI_HEADER_BYTES, sizeof(n));
+        const BYTE *m = buf + ACPI_HEADER_BYTES + 8;
+        if (n > 0 && n <= 256 && ACPI_HEADER_BYTES + 8 + n * n <= size) {
+            for (ULONGLONG i = 0; i < n; ++i) {
+                USHORT ni;
+                if (!GetNumaProximityNodeEx((ULONG)i, &ni)) continue;
+                int a = numa_index(out, ni);
+                if (a < 0) continue;
+                for (ULONGLONG j = 0; j < n; ++j) {
+                    USHORT nj;
+                    if (!GetNumaProximityNodeEx((ULONG)j, &nj)) continue;
+                    int b = numa_index(out, nj);
+                    if (b < 0) continue;
+                    out->distance[a][b] = m[i * n + j];
+                    out->has_slit = true;
+                }
+            }
+        }
+    }
+    free(buf);
+}
+
+bool get_numa_info(MemNumaInfo *out) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest)) return false;
+    for (ULONG n = 0; n <= highest && out->count < MEM_NUMA_MAX; ++n) {
+        GROUP_AFFINITY ga;
+        ULONGLONG avail = 0;
+        bool cpus = GetNumaNodeProcessorMaskEx((USHORT)n, &ga) && ga.Mask != 0;
+        bool mem = GetNumaAvailableMemoryNodeEx((USHORT)n, &avail) && avail > 0;
+        if (!cpus && !mem) continue;
+        out->node[out->count] = (USHORT)n;
+        out->has_cpus[out->count] = cpus;
+        out->available[out->count] = avail;
+        out->count++;
+    }
+    read_slit(out);
+    return out->count > 0;
+}
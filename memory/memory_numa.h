@@ -0,0 +1,24 @@
+// memory_numa.h - Nós NUMA: memória de cada nó e distâncias da tabela ACPI SLIT
+// Funções retornam false se não conseguirem obter os dados
+
+#pragma once
+
+#include <windows.h>
+#include <stdbool.h>
+
+#define MEM_NUMA_MAX 64
+
+typedef struct {
+    DWORD     count;
+    USHORT    node[MEM_NUMA_MAX];           // número do nó no Windows
+    bool      has_cpus[MEM_NUMA_MAX];
+    ULONGLONG available[MEM_NUMA_MAX];      // bytes livres no nó
+    bool      has_slit;
+    BYTE      distance[MEM_NUMA_MAX][MEM_NUMA_MAX];  // SLIT, por posição em node[] (10 = local)
+} MemNumaInfo;
+
+// Lista os nós (em ordem crescente) e lê a SLIT quando o firmware a fornece
+bool get_numa_info(MemNumaInfo *out);
+
+// Posição de um número de nó em out->node[] (-1 se não existir)
+int numa_index(const MemNumaInfo *info, USHORT node);
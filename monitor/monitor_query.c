@@ -0,0 +1,96 @@
+// monitor_query.c - Consultas sobre os resumos por minuto de uma gravação
+#define _CRT_SECURE_NO_WARNINGS
+#include "monitor_query.h"
+#include "monitor_recorder.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#define NS_PER_MINUTE 60000000000ULL
+
+typedef struct {
+    const QueryRequest *q;
+    QueryResult        *r;
+    int                 sensor;
+    uint64_t            from_minute;
+    uint64_t            to_minute;
+} QueryCtx;
+
+static void on_series(void *ctx, uint64_t minute, uint16_t series, const RollupAcc *acc) {
+    QueryCtx *c = (QueryCtx*)ctx;
+    int sensor = series / SAMPLER_MAX_VALUES, index = series % SAMPLER_MAX_VALUES;
+    if (sensor != c->sensor || index < c->q->first_index || index > c->q->last_index) return;
+    if (minute < c->from_minute || minute > c->to_minute) return;
+
+    rollup_hist_merge(&c->r->total, acc);
+    if (c->r->per_index) rollup_hist_merge(&c->r->per_index[index - c->q->first_index], acc);
+    if (c->r->first_minute == 0 || minute < c->r->first_minute) c->r->first_minute = minute;
+    if (minute > c->r->last_minute) c->r->last_minute = minute;
+}
+
+bool query_run(const wchar_t *path, const QueryRequest *q, QueryResult *out) {
+    if (!path || !q || !q->sensor || !out) return false;
+    memset(out, 0, sizeof(*out));
+    if (q->first_index < 0 || q->last_index >= SAMPLER_MAX_VALUES || q->first_index > q->last_index) return false;
+
+    LARGE_INTEGER freq, t0, t1;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t0);
+
+    wchar_t rollup_path[MAX_PATH];
+    if (wcslen(path) + wcslen(RECORD_ROLLUP_SUFFIX) >= MAX_PATH) return false;
+    wcscpy(rollup_path, path);
+    wcscat(rollup_path, RECORD_ROLLUP_SUFFIX);
+
+    static RecordReader rd;
+    if (!record_reader_open(&rd, rollup_path)) return false;
+    if (rd.hdr.kind != RECORD_BLOCK_ROLLUP) { record_reader_close(&rd); return false; }
+
+    QueryCtx c;
+    c.q = q;
+    c.r = out;
+    c.sensor = -1;
+    for (uint32_t i = 0; i < rd.hdr.nsensors && i < SAMPLER_MAX_SENSORS; ++i) {
+        if (strncmp(rd.hdr.sensors[i], q->sensor, sizeof(rd.hdr.sensors[i])) == 0) { c.sensor = (int)i; break; }
+    }
+    if (c.sensor < 0) { record_reader_close(&rd); return false; }
+    c.from_minute = q->from_ns / NS_PER_MINUTE;
+    c.to_minute = q->to_ns ? q->to_ns / NS_PER_MINUTE : UINT64_MAX;
+
+    rollup_hist_reset(&out->total);
+    if (q->per_index) {
+        size_t n = (size_t)(q->last_index - q->first_index + 1);
+        out->per_index = (RollupHist*)malloc(sizeof(RollupHist) * n);
+        if (!out->per_index) { record_reader_close(&rd); return false; }
+        for (size_t i = 0; i < n; ++i) rollup_hist_reset(&out->per_index[i]);
+    }
+
+    RecordBlockInfo *blocks = NULL;
+    size_t nblocks = record_reader_list(&rd, &blocks);
+    for (size_t i = 0; i < nblocks; ++i) {
+        // O cabeçalho diz quais minutos o bloco cobre: fora da janela nem é lido
+        const RecordBlockHeader *bh = &blocks[i].h;
+        if (bh->t_last_ns / NS_PER_MINUTE < c.from_minute || bh->t_first_ns / NS_PER_MINUTE > c.to_minute) {
+            out->blocks_skipped++;
+            continue;
+        }
+        RecordBlockHeader h;
+        const uint8_t *payload = record_reader_load(&rd, blocks[i].slot, &h);
+        if (!payload) continue;
+        record_decode_rollup(&h, payload, on_series, &c);
+        out->blocks_read++;
+    }
+    free(blocks);
+    record_reader_close(&rd);
+
+    QueryPerformanceCounter(&t1);
+    out->elapsed_ms = (double)(t1.QuadPart - t0.QuadPart) * 1000.0 / (double)freq.QuadPart;
+    return true;
+}
+
+void query_free(QueryResult *r) {
+    if (!r) return;
+    free(r->per_index);
+    r->per_index = NULL;
+}
@@ -0,0 +1,36 @@
+// monitor_query.h - Consultas sobre os resumos por minuto de uma gravação
+// Percentis e extremos de um sensor numa faixa de núcleos e de tempo, somando os
+// histogramas dos minutos em vez de reler as amostras brutas.
+
+#pragma once
+
+#include <windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "monitor_rollup.h"
+
+#define QUERY_MAX_CORES 256
+
+typedef struct {
+    const char *sensor;         // nome do sensor (ex.: "clock")
+    int         first_index;    // faixa de núcleos/canais, inclusiva
+    int         last_index;
+    uint64_t    from_ns;        // janela [from_ns, to_ns]; 0 = sem limite
+    uint64_t    to_ns;
+    bool        per_index;      // também um histograma por núcleo
+} QueryRequest;
+
+typedef struct {
+    RollupHist  total;
+    RollupHist *per_index;      // last_index - first_index + 1 entradas (NULL se !per_index)
+    uint64_t    first_minute;   // minutos efetivamente cobertos
+    uint64_t    last_minute;
+    uint32_t    blocks_read;
+    uint32_t    blocks_skipped;
+    double      elapsed_ms;
+} QueryResult;
+
+// Executa a consulta sobre "<arquivo>.rollup"; libere com query_free
+bool query_run(const wchar_t *path, const QueryRequest *q, QueryResult *out);
+void query_free(QueryResult *r);
@@ -0,0 +1,436 @@
+// monitor_recorder.c - Gravação compacta das amostras em disco
+//
+// Frame (um despertar do sampler):
+//   varint  zigzag_encode(delta-of-delta do timestamp, em ms)
+//   varint  máscara dos sensores presentes
+//   por sensor presente, em ordem crescente:
+//     varint  quantidade de valores (núcleos/canais)
+//     pares   varint(n iguais ao anterior) + valor alterado em XOR
+// Valor alterado: 1 byte de controle (bytes zero à esquerda << 4 | à direita)
+// seguido só dos bytes significativos do XOR com o valor anterior da série.
+// O estado (timestamp e valores anteriores) recomeça a cada bloco, então cada
+// bloco é decodificável sozinho e pode ser descartado na rotação.
+// A cada virada de minuto os acumuladores de cada série viram um registro de
+// resumo (monitor_rollup.c) no arquivo "<arquivo>.rollup".
+#define _CRT_SECURE_NO_WARNINGS
+#include "monitor_recorder.h"
+#include "monitor_varint.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---- Codificação ----
+
+// Arredonda para 1/2^RECORD_FRAC_BITS: zera os bits baixos da mantissa e
+// deixa o XOR entre leituras vizinhas com muitos bytes zero
+static uint64_t quantize_bits(double v) {
+    double q = ldexp(nearbyint(ldexp(v, RECORD_FRAC_BITS)), -RECORD_FRAC_BITS);
+    uint64_t bits;
+    memcpy(&bits, &q, sizeof(bits));
+    return bits;
+}
+
+static double bits_to_double(uint64_t bits) {
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static uint8_t *put_xor(uint8_t *p, uint64_t x) {
+    int lz = __builtin_clzll(x) / 8;
+    int tz = __builtin_ctzll(x) / 8;
+    *p++ = (uint8_t)((lz << 4) | tz);
+    for (int i = 7 - lz; i >= tz; --i) *p++ = (uint8_t)(x >> (8 * i));
+    return p;
+}
+
+static const uint8_t *get_xor(const uint8_t *p, const uint8_t *end, uint64_t *x) {
+    if (p >= end) return NULL;
+    int lz = *p >> 4, tz = *p & 0x0F;
+    p++;
+    if (lz + tz > 8 || end - p < 8 - lz - tz) return NULL;
+    uint64_t r = 0;
+    for (int i = 7 - lz; i >= tz; --i) r |= (uint64_t)*p++ << (8 * i);
+    *x = r;
+    return p;
+}
+
+// ---- Escrita ----
+
+#define NS_PER_MINUTE 60000000000ULL
+
+static uint64_t block_offset(uint32_t slot) {
+    return (uint64_t)(slot + 1) * RECORD_BLOCK_SIZE;
+}
+
+static void unmap_block(RecordStream *st) {
+    if (st->view) UnmapViewOfFile(st->view);
+    st->view = NULL;
+    st->blk = NULL;
+}
+
+// Mapeia um slot para escrita, estendendo o arquivo se necessário
+static bool map_block(RecordStream *st, uint32_t slot) {
+    uint64_t end = block_offset(slot) + RECORD_BLOCK_SIZE;
+    HANDLE map = CreateFileMappingW(st->file, NULL, PAGE_READWRITE,
+                                    (DWORD)(end >> 32), (DWORD)end, NULL);
+    if (!map) return false;
+    uint64_t off = block_offset(slot);
+    st->view = (uint8_t*)MapViewOfFile(map, FILE_MAP_WRITE, (DWORD)(off >> 32), (DWORD)off, RECORD_BLOCK_SIZE);
+    CloseHandle(map);   // a view mantém o mapeamento vivo
+    if (!st->view) return false;
+    st->blk = (RecordBlockHeader*)st->view;
+    st->slot = slot;
+    return true;
+}
+
+// Fecha o bloco atual e abre o próximo slot do anel
+static bool start_block(RecordStream *st, uint64_t t_ns) {
+    uint32_t slot = st->blk ? (st->slot + 1) % st->hdr.max_blocks : st->slot;
+    unmap_block(st);
+    if (!map_block(st, slot)) return false;
+
+    // seq por último: um bloco pela metade nunca parece válido
+    memset(st->blk, 0, sizeof(*st->blk));
+    st->blk->magic = RECORD_BLOCK_MAGIC;
+    st->blk->kind = (uint16_t)st->hdr.kind;
+    st->blk->t_first_ns = t_ns;
+    st->blk->t_last_ns = t_ns;
+    st->blk->seq = st->next_seq++;
+    return true;
+}
+
+static bool write_header(HANDLE f, const RecordFileHeader *h) {
+    LARGE_INTEGER zero = {0};
+    DWORD wr = 0;
+    return SetFilePointerEx(f, zero, NULL, FILE_BEGIN) &&
+           WriteFile(f, h, sizeof(*h), &wr, NULL) && wr == sizeof(*h);
+}
+
+static bool read_at(HANDLE f, uint64_t off, void *buf, DWORD len) {
+    LARGE_INTEGER li;
+    li.QuadPart = (LONGLONG)off;
+    DWORD rd = 0;
+    return SetFilePointerEx(f, li, NULL, FILE_BEGIN) && ReadFile(f, buf, len, &rd, NULL) && rd == len;
+}
+
+static void stream_close(RecordStream *st) {
+    unmap_block(st);
+    if (st->file) CloseHandle(st->file);
+    st->file = NULL;
+}
+
+// Abre (ou continua) um arquivo de blocos; o próximo bloco vai para o slot
+// seguinte ao de maior seq
+static bool stream_open(RecordStream *st, const wchar_t *path, uint64_t max_bytes,
+                        uint32_t kind, const Sampler *s) {
+    memset(st, 0, sizeof(*st));
+    st->file = CreateFileW(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (st->file == INVALID_HANDLE_VALUE) { st->file = NULL; return false; }
+
+    RecordFileHeader want;
+    memset(&want, 0, sizeof(want));
+    memcpy(want.magic, RECORD_MAGIC, 8);
+    want.version = RECORD_VERSION;
+    want.block_size = RECORD_BLOCK_SIZE;
+    want.max_blocks = (uint32_t)(max_bytes / RECORD_BLOCK_SIZE);
+    if (want.max_blocks < 2) want.max_blocks = 2;
+    want.nsensors = (uint32_t)s->nsensors;
+    want.frac_bits = RECORD_FRAC_BITS;
+    want.kind = kind;
+    for (int i = 0; i < s->nsensors; ++i)
+        strncpy(want.sensors[i], s->sensors[i].name, sizeof(want.sensors[i]) - 1);
+
+    RecordFileHeader have;
+    if (read_at(st->file, 0, &have, sizeof(have)) && memcmp(have.magic, RECORD_MAGIC, 8) == 0) {
+        // Continuação: os índices dos sensores precisam significar o mesmo
+        if (have.version != RECORD_VERSION || have.block_size != RECORD_BLOCK_SIZE || have.kind != kind ||
+            have.nsensors != want.nsensors || memcmp(have.sensors, want.sensors, sizeof(want.sensors)) != 0) {
+            stream_close(st);
+            return false;
+        }
+        // O limite pode mudar entre execuções; blocos além dele ficam órfãos
+        uint32_t scan = have.max_blocks > want.max_blocks ? have.max_blocks : want.max_blocks;
+        uint64_t best_seq = 0;
+        uint32_t best_slot = 0;
+        for (uint32_t i = 0; i < scan; ++i) {
+            RecordBlockHeader bh;
+            if (!read_at(st->file, block_offset(i), &bh, sizeof(bh))) break;
+            if (bh.magic == RECORD_BLOCK_MAGIC && bh.seq > best_seq) { best_seq = bh.seq; best_slot = i; }
+        }
+        st->next_seq = best_seq + 1;
+        st->slot = best_seq ? (best_slot + 1) % want.max_blocks : 0;
+    } else {
+        st->next_seq = 1;
+        st->slot = 0;
+    }
+    st->hdr = want;
+    if (!write_header(st->file, &st->hdr)) { stream_close(st); return false; }
+    return true;
+}
+
+bool recorder_open(Recorder *r, const wchar_t *path, uint64_t max_bytes, const Sampler *s) {
+    if (!r || !path || !s) return false;
+    memset(r, 0, sizeof(*r));
+
+    wchar_t rollup_path[MAX_PATH];
+    if (wcslen(path) + wcslen(RECORD_ROLLUP_SUFFIX) >= MAX_PATH) return false;
+    wcscpy(rollup_path, path);
+    wcscat(rollup_path, RECORD_ROLLUP_SUFFIX);
+
+    uint64_t rollup_bytes = max_bytes / RECORD_ROLLUP_SHARE;
+    if (!stream_open(&r->raw, path, max_bytes - rollup_bytes, RECORD_BLOCK_RAW, s)) return false;
+    if (!stream_open(&r->rollup, rollup_path, rollup_bytes, RECORD_BLOCK_ROLLUP, s)) {
+        stream_close(&r->raw);
+        return false;
+    }
+    return true;
+}
+
+// Grava os acumuladores do minuto corrente e zera todos
+static void flush_rollups(Recorder *r) {
+    static RollupAcc *accs[RECORD_MAX_SERIES];
+    static uint16_t ids[RECORD_MAX_SERIES];
+    size_t n = 0;
+    for (int i = 0; i < RECORD_MAX_SERIES; ++i) {
+        if (r->acc[i] && r->acc[i]->count) { accs[n] = r->acc[i]; ids[n] = (uint16_t)i; n++; }
+    }
+    if (n == 0) return;
+
+    // Um minuto com muitas séries é dividido em vários registros que caibam num bloco
+    size_t per_record = (RECORD_PAYLOAD_SIZE - 32) / rollup_minute_max_bytes(1);
+    uint64_t minute_ns = r->minute * NS_PER_MINUTE;
+    for (size_t first = 0; first < n; first += per_record) {
+        size_t cnt = n - first < per_record ? n - first : per_record;
+        RecordStream *st = &r->rollup;
+        if (!st->blk || st->blk->used + rollup_minute_max_bytes(cnt) > RECORD_PAYLOAD_SIZE) {
+            if (!start_block(st, minute_ns)) break;
+        }
+        uint8_t *payload = st->view + sizeof(RecordBlockHeader);
+        uint8_t *p = payload + st->blk->used;
+        uint64_t base_minute = st->blk->t_first_ns / NS_PER_MINUTE;
+        uint8_t *e = rollup_encode_minute(p, r->minute - base_minute, &accs[first], &ids[first], cnt);
+        st->blk->used += (uint32_t)(e - p);
+        st->blk->records++;
+        st->blk->t_last_ns = minute_ns;
+        r->rollup_bytes_written += (uint64_t)(e - p);
+    }
+    for (size_t i = 0; i < n; ++i) rollup_acc_reset(accs[i]);
+}
+
+// Acumula as amostras do frame no resumo do minuto corrente
+static void accumulate_rollups(Recorder *r, const SensorSample *samples, size_t count) {
+    uint64_t minute = samples[0].t_ns / NS_PER_MINUTE;
+    if (minute != r->minute) {
+        flush_rollups(r);
+        r->minute = minute;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const SensorSample *s = &samples[i];
+        if (s->sensor >= SAMPLER_MAX_SENSORS || s->index >= SAMPLER_MAX_VALUES) continue;
+        int id = s->sensor * SAMPLER_MAX_VALUES + s->index;
+        if (!r->acc[id]) {
+            r->acc[id] = (RollupAcc*)malloc(sizeof(RollupAcc));
+            if (!r->acc[id]) continue;
+            rollup_acc_reset(r->acc[id]);
+        }
+        rollup_acc_add(r->acc[id], s->value);
+    }
+}
+
+bool recorder_append(Recorder *r, const SensorSample *samples, size_t count) {
+    if (!r || !r->raw.file || !samples || count == 0) return false;
+    uint64_t t_ns = samples[0].t_ns;
+    accumulate_rollups(r, samples, count);
+
+    // Agrupa por sensor; cada sensor entrega índices contíguos a partir de 0
+    int nvals[SAMPLER_MAX_SENSORS] = {0};
+    uint32_t mask = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const SensorSample *s = &samples[i];
+        if (s->sensor >= SAMPLER_MAX_SENSORS || s->index >= SAMPLER_MAX_VALUES) continue;
+        r->scratch[s->sensor][s->index] = s->value;
+        if (s->index + 1 > nvals[s->sensor]) nvals[s->sensor] = s->index + 1;
+        mask |= 1u << s->sensor;
+    }
+    if (!mask) return false;
+
+    // Pior caso: 12 bytes por valor + cabeçalhos
+    RecordStream *st = &r->raw;
+    size_t need = 32 + (size_t)SAMPLER_MAX_SENSORS * 4 + count * 12;
+    if (!st->blk || st->blk->used + need > RECORD_PAYLOAD_SIZE) {
+        if (!start_block(st, t_ns)) return false;
+        r->prev_t_ms = t_ns / 1000000ULL;
+        r->prev_delta_ms = 0;
+        memset(r->prev_bits, 0, sizeof(r->prev_bits));
+    }
+
+    uint8_t *payload = st->view + sizeof(RecordBlockHeader);
+    uint8_t *p = payload + st->blk->used;
+
+    uint64_t t_ms = t_ns / 1000000ULL;
+    int64_t delta = (int64_t)(t_ms - r->prev_t_ms);
+    p = varint_put(p, zigzag_encode(delta - r->prev_delta_ms));
+    r->prev_delta_ms = delta;
+    r->prev_t_ms = t_ms;
+
+    p = varint_put(p, mask);
+    for (int s = 0; s < SAMPLER_MAX_SENSORS; ++s) {
+        if (!(mask & (1u << s))) continue;
+        p = varint_put(p, (uint64_t)nvals[s]);
+        uint64_t *prev = &r->prev_bits[s * SAMPLER_MAX_VALUES];
+        uint64_t run = 0;
+        for (int i = 0; i < nvals[s]; ++i) {
+            uint64_t bits = quantize_bits(r->scratch[s][i]);
+            if (bits == prev[i]) { run++; continue; }
+            p = varint_put(p, run);
+            p = put_xor(p, bits ^ prev[i]);
+            prev[i] = bits;
+            run = 0;
+        }
+        if (run) p = varint_put(p, run);
+    }
+
+    uint32_t written = (uint32_t)(p - (payload + st->blk->used));
+    st->blk->used += written;
+    st->blk->records++;
+    st->blk->t_last_ns = t_ns;
+    r->bytes_written += written;
+    r->samples_written += count;
+    return true;
+}
+
+void recorder_close(Recorder *r) {
+    if (!r) return;
+    if (r->rollup.file) flush_rollups(r);
+    for (int i = 0; i < RECORD_MAX_SERIES; ++i) { free(r->acc[i]); r->acc[i] = NULL; }
+    stream_close(&r->raw);
+    stream_close(&r->rollup);
+}
+
+// ---- Leitura ----
+
+bool record_reader_open(RecordReader *rd, const wchar_t *path) {
+    if (!rd || !path) return false;
+    memset(rd, 0, sizeof(*rd));
+    rd->file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (rd->file == INVALID_HANDLE_VALUE) { rd->file = NULL; return false; }
+    if (!read_at(rd->file, 0, &rd->hdr, sizeof(rd->hdr)) ||
+        memcmp(rd->hdr.magic, RECORD_MAGIC, 8) != 0 ||
+        rd->hdr.version != RECORD_VERSION || rd->hdr.block_size != RECORD_BLOCK_SIZE) {
+        record_reader_close(rd);
+        return false;
+    }
+    rd->buf = (uint8_t*)malloc(RECORD_BLOCK_SIZE);
+    if (!rd->buf) { record_reader_close(rd); return false; }
+    return true;
+}
+
+void record_reader_close(RecordReader *rd) {
+    if (!rd) return;
+    if (rd->file) CloseHandle(rd->file);
+    free(rd->buf);
+    rd->file = NULL;
+    rd->buf = NULL;
+}
+
+static int cmp_block_seq(const void *a, const void *b) {
+    uint64_t x = ((const RecordBlockInfo*)a)->h.seq, y = ((const RecordBlockInfo*)b)->h.seq;
+    return x < y ? -1 : x > y;
+}
+
+size_t record_reader_list(RecordReader *rd, RecordBlockInfo **out) {
+    if (!rd || !rd->file || !out) return 0;
+    *out = NULL;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(rd->file, &size)) return 0;
+    uint64_t slots = (uint64_t)size.QuadPart / RECORD_BLOCK_SIZE;
+    if (slots <= 1) return 0;
+    slots -= 1;
+
+    RecordBlockInfo *list = (RecordBlockInfo*)malloc(sizeof(RecordBlockInfo) * (size_t)slots);
+    if (!list) return 0;
+    size_t n = 0;
+    for (uint32_t i = 0; i < slots; ++i) {
+        RecordBlockHeader bh;
+        if (!read_at(rd->file, block_offset(i), &bh, sizeof(bh))) break;
+        if (bh.magic != RECORD_BLOCK_MAGIC || bh.seq == 0 || bh.used > RECORD_PAYLOAD_SIZE) continue;
+        list[n].slot = i;
+        list[n].h = bh;
+        n++;
+    }
+    qsort(list, n, sizeof(list[0]), cmp_block_seq);
+    *out = list;
+    return n;
+}
+
+const uint8_t *record_reader_load(RecordReader *rd, uint32_t slot, RecordBlockHeader *h) {
+    if (!rd || !rd->buf) return NULL;
+    if (!read_at(rd->file, block_offset(slot), rd->buf, RECORD_BLOCK_SIZE)) return NULL;
+    RecordBlockHeader *bh = (RecordBlockHeader*)rd->buf;
+    if (bh->magic != RECORD_BLOCK_MAGIC || bh->used > RECORD_PAYLOAD_SIZE) return NULL;
+    if (h) *h = *bh;
+    return rd->buf + sizeof(RecordBlockHeader);
+}
+
+bool record_decode_raw(const RecordBlockHeader *h, const uint8_t *payload, RecordFrameFn fn, void *ctx) {
+    if (!h || !payload || !fn || h->kind != RECORD_BLOCK_RAW) return false;
+    uint64_t *prev = (uint64_t*)calloc(RECORD_MAX_SERIES, sizeof(uint64_t));
+    SensorSample *frame = (SensorSample*)malloc(sizeof(SensorSample) * RECORD_MAX_SERIES);
+    if (!prev || !frame) { free(prev); free(frame); return false; }
+
+    const uint8_t *p = payload, *end = payload + h->used;
+    uint64_t t_ms = h->t_first_ns / 1000000ULL;
+    int64_t delta = 0;
+    bool ok = true;
+    for (uint32_t f = 0; f < h->records && ok; ++f) {
+        uint64_t v, mask;
+        if (!(p = varint_get(p, end, &v))) { ok = false; break; }
+        delta += zigzag_decode(v);
+        t_ms += (uint64_t)delta;
+        if (!(p = varint_get(p, end, &mask))) { ok = false; break; }
+
+        size_t n = 0;
+        for (int s = 0; s < SAMPLER_MAX_SENSORS && ok; ++s) {
+            if (!(mask & (1u << s))) continue;
+            uint64_t nv;
+            if (!(p = varint_get(p, end, &nv)) || nv > SAMPLER_MAX_VALUES) { ok = false; break; }
+            uint64_t *sp = &prev[s * SAMPLER_MAX_VALUES];
+            uint64_t i = 0;
+            while (i < nv) {
+                uint64_t run, x;
+                if (!(p = varint_get(p, end, &run)) || i + run > nv) { ok = false; break; }
+                for (uint64_t k = 0; k < run; ++k, ++i) {
+                    frame[n].t_ns = t_ms * 1000000ULL;
+                    frame[n].sensor = (uint16_t)s;
+                    frame[n].index = (uint16_t)i;
+                    frame[n].reserved = 0;
+                    frame[n].value = bits_to_double(sp[i]);
+                    n++;
+                }
+                if (i == nv) break;
+                if (!(p = get_xor(p, end, &x))) { ok = false; break; }
+                sp[i] ^= x;
+                frame[n].t_ns = t_ms * 1000000ULL;
+                frame[n].sensor = (uint16_t)s;
+                frame[n].index = (uint16_t)i;
+                frame[n].reserved = 0;
+                frame[n].value = bits_to_double(sp[i]);
+                n++;
+                i++;
+            }
+        }
+        if (ok && n) fn(ctx, frame, n);
+    }
+    free(prev);
+    free(frame);
+    return ok;
+}
+
+bool record_decode_rollup(const RecordBlockHeader *h, const uint8_t *payload, RollupSeriesFn fn, void *ctx) {
+    if (!h || !payload || !fn || h->kind != RECORD_BLOCK_ROLLUP) return false;
+    return rollup_decode(payload, h->used, h->records, h->t_first_ns / NS_PER_MINUTE, fn, ctx);
+}
@@ -0,0 +1,118 @@
+// monitor_recorder.h - Gravação compacta das amostras em disco
+// Arquivo de blocos de tamanho fixo mapeados em memória. Cada bloco guarda frames
+// (todas as amostras de um mesmo despertar do sampler) com timestamps em
+// delta-of-delta e valores em XOR/varint. Ao atingir o limite de disco, o bloco
+// mais antigo é reaproveitado (rotação em anel). Um arquivo irmão
+// "<arquivo>.rollup", no mesmo formato de blocos, guarda os resumos por minuto.
+
+#pragma once
+
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "monitor_sampler.h"
+#include "monitor_rollup.h"
+
+#define RECORD_MAGIC          "CPZREC01"
+#define RECORD_VERSION        2
+#define RECORD_BLOCK_SIZE     (256u * 1024u)     // múltiplo da granularidade de MapViewOfFile
+#define RECORD_BLOCK_MAGIC    0x4B4C4250u        // "PBLK"
+#define RECORD_BLOCK_RAW      1
+#define RECORD_BLOCK_ROLLUP   2
+#define RECORD_ROLLUP_SUFFIX  L".rollup"
+#define RECORD_ROLLUP_SHARE   4                  // 1/4 do limite de disco vai para os resumos
+#define RECORD_FRAC_BITS      4                  // valores arredondados para 1/16
+#define RECORD_MAX_SERIES     (SAMPLER_MAX_SENSORS * SAMPLER_MAX_VALUES)
+#define RECORD_DEFAULT_MAX_MB 64
+
+// Cabeçalho do arquivo (ocupa o primeiro RECORD_BLOCK_SIZE do arquivo)
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t block_size;
+    uint32_t max_blocks;
+    uint32_t nsensors;
+    uint32_t frac_bits;
+    uint32_t kind;          // RECORD_BLOCK_RAW ou RECORD_BLOCK_ROLLUP
+    char     sensors[SAMPLER_MAX_SENSORS][24];
+} RecordFileHeader;
+
+// Cabeçalho de cada bloco (64 bytes, seguido do payload)
+typedef struct {
+    uint32_t magic;
+    uint16_t kind;
+    uint16_t reserved;
+    uint64_t seq;           // ordem de escrita (0 = slot nunca usado)
+    uint64_t t_first_ns;    // resumos: início do primeiro minuto do bloco
+    uint64_t t_last_ns;
+    uint32_t used;          // bytes válidos de payload
+    uint32_t records;       // frames (ou minutos de resumo) gravados
+    uint8_t  pad[24];
+} RecordBlockHeader;
+
+#define RECORD_PAYLOAD_SIZE (RECORD_BLOCK_SIZE - sizeof(RecordBlockHeader))
+
+// Um arquivo de blocos em anel sendo escrito
+typedef struct {
+    HANDLE             file;
+    RecordFileHeader   hdr;
+    uint8_t           *view;        // bloco atual mapeado
+    RecordBlockHeader *blk;
+    uint32_t           slot;        // slot do bloco atual
+    uint64_t           next_seq;
+} RecordStream;
+
+typedef struct {
+    RecordStream       raw;
+    RecordStream       rollup;
+    uint64_t           prev_t_ms;
+    int64_t            prev_delta_ms;
+    uint64_t           prev_bits[RECORD_MAX_SERIES];
+    double             scratch[SAMPLER_MAX_SENSORS][SAMPLER_MAX_VALUES];
+    uint64_t           minute;      // minuto corrente dos acumuladores
+    RollupAcc         *acc[RECORD_MAX_SERIES];  // alocado na primeira amostra da série
+    uint64_t           bytes_written;
+    uint64_t           rollup_bytes_written;
+    uint64_t           samples_written;
+} Recorder;
+
+// Abre (ou continua) uma gravação limitada a max_bytes em disco (somando os dois arquivos)
+bool recorder_open(Recorder *r, const wchar_t *path, uint64_t max_bytes, const Sampler *s);
+
+// Grava um frame: amostras de um mesmo instante (mesmo t_ns)
+bool recorder_append(Recorder *r, const SensorSample *samples, size_t count);
+
+void recorder_close(Recorder *r);
+
+// ---- Leitura ----
+
+typedef struct {
+    HANDLE           file;
+    RecordFileHeader hdr;
+    uint8_t         *buf;           // um bloco
+} RecordReader;
+
+typedef struct {
+    uint32_t          slot;
+    RecordBlockHeader h;
+} RecordBlockInfo;
+
+// Recebe cada frame decodificado
+typedef void (*RecordFrameFn)(void *ctx, const SensorSample *samples, size_t count);
+
+bool record_reader_open(RecordReader *rd, const wchar_t *path);
+void record_reader_close(RecordReader *rd);
+
+// Lista os blocos em uso em ordem de escrita; o chamador libera *out com free()
+size_t record_reader_list(RecordReader *rd, RecordBlockInfo **out);
+
+// Carrega o payload de um bloco; retorna NULL em erro
+const uint8_t *record_reader_load(RecordReader *rd, uint32_t slot, RecordBlockHeader *h);
+
+// Decodifica os frames de um bloco bruto
+bool record_decode_raw(const RecordBlockHeader *h, const uint8_t *payload, RecordFrameFn fn, void *ctx);
+
+// Decodifica os resumos de um bloco de rollup
+bool record_decode_rollup(const RecordBlockHeader *h, const uint8_t *payload, RollupSeriesFn fn, void *ctx);
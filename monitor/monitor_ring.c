@@ -0,0 +1,152 @@
+// monitor_ring.c - Anel de amostras entre o sampler e os consumidores
+// Seqlock por registro: o produtor marca o slot como "em escrita" (seq ímpar),
+// copia o registro e publica (seq par). O leitor confere seq antes e depois da
+// cópia; se mudou, o registro foi sobrescrito e conta como perdido.
+
+#include "monitor_ring.h"
+
+#include <windows.h>
+#include <string.h>
+
+_Static_assert(sizeof(RingSlot) == RING_CACHE_LINE, "RingSlot deve ocupar uma linha de cache");
+
+bool ring_init(SampleRing *r, uint64_t capacity) {
+    if (!r || capacity == 0) return false;
+    memset(r, 0, sizeof(*r));
+    uint64_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+
+    // VirtualAlloc já devolve memória alinhada a página; o memset toca todas as
+    // páginas agora para não haver page fault na primeira volta do produtor
+    r->slots = (RingSlot*)VirtualAlloc(NULL, (SIZE_T)(cap * sizeof(RingSlot)), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!r->slots) return false;
+    memset(r->slots, 0, (size_t)(cap * sizeof(RingSlot)));
+    r->capacity = cap;
+    r->mask = cap - 1;
+    atomic_store_explicit(&r->head, 0, memory_order_relaxed);
+    return true;
+}
+
+void ring_free(SampleRing *r) {
+    if (!r || !r->slots) return;
+    VirtualFree(r->slots, 0, MEM_RELEASE);
+    r->slots = NULL;
+    r->capacity = r->mask = 0;
+}
+
+void ring_publish(SampleRing *r, const SensorSample *rec) {
+    uint64_t n = atomic_load_explicit(&r->head, memory_order_relaxed);
+    RingSlot *s = &r->slots[n & r->mask];
+    atomic_store_explicit(&s->seq, 2 * n + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    s->rec = *rec;
+    atomic_store_explicit(&s->seq, 2 * n + 2, memory_order_release);
+    atomic_store_explicit(&r->head, n + 1, memory_order_release);
+}
+
+void ring_publish_batch(SampleRing *r, const SensorSample *recs, size_t count) {
+    for (size_t i = 0; i < count; ++i) ring_publish(r, &recs[i]);
+}
+
+void ring_reader_init(const SampleRing *r, RingReader *rd, bool from_oldest) {
+    uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    rd->lost = 0;
+    if (!from_oldest) rd->next = head;
+    else rd->next = head > r->capacity ? head - r->capacity : 0;
+}
+
+size_t ring_read(const SampleRing *r, RingReader *rd, SensorSample *out, size_t max) {
+    size_t n = 0;
+    while (n < max) {
+        uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+        if (rd->next >= head) break;
+
+        // O produtor já deu uma volta inteira sobre o cursor
+        if (head - rd->next > r->capacity) {
+            rd->lost += head - r->capacity - rd->next;
+            rd->next = head - r->capacity;
+        }
+
+        const RingSlot *s = &r->slots[rd->next & r->mask];
+        uint64_t expect = 2 * rd->next + 2;
+        uint64_t s1 = atomic_load_explicit(&s->seq, memory_order_acquire);
+        if (s1 != expect) {
+            // Slot já reaproveitado (ou em reescrita) por uma volta mais nova
+            rd->lost++;
+            rd->next++;
+            continue;
+        }
+        out[n] = s->rec;
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t s2 = atomic_load_explicit(&s->seq, memory_order_relaxed);
+        if (s2 != s1) {
+            rd->lost++;
+            rd->next++;
+            continue;
+        }
+        n++;
+        rd->next++;
+    }
+    return n;
+}
+
+typedef struct {
+    SampleRing      *ring;
+    volatile LONG    stop;
+    RingReader       rd;
+} BenchReader;
+
+static DWORD WINAPI bench_reader_thread(LPVOID arg) {
+    BenchReader *b = (BenchReader*)arg;
+    SensorSample buf[256];
+    ring_reader_init(b->ring, &b->rd, false);
+    while (!b->stop) {
+        if (ring_read(b->ring, &b->rd, buf, 256) == 0) YieldProcessor();
+    }
+    return 0;
+}
+
+static double time_publishes(SampleRing *r, uint64_t iterations) {
+    SensorSample rec = {0};
+    LARGE_INTEGER f, t0, t1;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t0);
+    for (uint64_t i = 0; i < iterations; ++i) {
+        rec.index = (uint16_t)i;
+        rec.value = (double)i;
+        ring_publish(r, &rec);
+    }
+    QueryPerformanceCounter(&t1);
+    return (double)(t1.QuadPart - t0.QuadPart) * 1e9 / (double)f.QuadPart / (double)iterations;
+}
+
+bool ring_bench_publish(uint64_t iterations, RingBench *out) {
+    if (!out || iterations == 0) return false;
+    memset(out, 0, sizeof(*out));
+    SampleRing ring;
+    if (!ring_init(&ring, 4096)) return false;
+
+    time_publishes(&ring, ring.capacity * 4);   // aquecimento
+    out->iterations = iterations;
+    out->ns_per_publish = time_publishes(&ring, iterations);
+
+    // Repete com um leitor girando em outra thread (disputa pelas linhas de cache)
+    BenchReader br;
+    memset(&br, 0, sizeof(br));
+    br.ring = &ring;
+    HANDLE th = CreateThread(NULL, 0, bench_reader_thread, &br, 0, NULL);
+    if (!th) {
+        // Sem o leitor a segunda medição não existe: não é um resultado válido
+        ring_free(&ring);
+        return false;
+    }
+    Sleep(10);
+    out->ns_per_publish_reader = time_publishes(&ring, iterations);
+    br.stop = 1;
+    WaitForSingleObject(th, INFINITE);
+    CloseHandle(th);
+    out->reader_lost = br.rd.lost;
+
+    ring_free(&ring);
+    return true;
+}
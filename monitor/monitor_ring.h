@@ -0,0 +1,62 @@
+// monitor_ring.h - Anel de amostras entre o sampler e os consumidores
+// Um produtor (a thread do sampler) e vários leitores independentes. O produtor
+// nunca espera: leitores lentos perdem os registros mais antigos e detectam a
+// perda pelos números de sequência.
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "monitor_sampler.h"
+
+#define RING_CACHE_LINE 64
+
+// Um registro por linha de cache; seq = 2n+1 durante a escrita, 2n+2 publicado
+typedef struct {
+    _Alignas(RING_CACHE_LINE) _Atomic uint64_t seq;
+    SensorSample rec;
+    char pad[RING_CACHE_LINE - sizeof(uint64_t) - sizeof(SensorSample)];
+} RingSlot;
+
+typedef struct {
+    _Alignas(RING_CACHE_LINE) _Atomic uint64_t head;    // próximo número de sequência
+    char      pad[RING_CACHE_LINE - sizeof(uint64_t)];
+    RingSlot *slots;
+    uint64_t  mask;
+    uint64_t  capacity;
+} SampleRing;
+
+// Cursor de um leitor
+typedef struct {
+    uint64_t next;      // próximo número de sequência a ler
+    uint64_t lost;      // registros sobrescritos antes de serem lidos
+} RingReader;
+
+// Aloca o anel (capacidade arredondada para potência de 2). Única alocação.
+bool ring_init(SampleRing *r, uint64_t capacity);
+void ring_free(SampleRing *r);
+
+// Publica registros; nunca bloqueia
+void ring_publish(SampleRing *r, const SensorSample *rec);
+void ring_publish_batch(SampleRing *r, const SensorSample *recs, size_t count);
+
+// Posiciona o leitor no registro mais novo (ou no mais antigo ainda disponível)
+void ring_reader_init(const SampleRing *r, RingReader *rd, bool from_oldest);
+
+// Copia até max registros a partir do cursor; retorna quantos foram lidos
+size_t ring_read(const SampleRing *r, RingReader *rd, SensorSample *out, size_t max);
+
+// Resultado do microbenchmark de publicação
+typedef struct {
+    uint64_t iterations;
+    double   ns_per_publish;            // sem leitores
+    double   ns_per_publish_reader;     // com um leitor ativo em outra thread
+    uint64_t reader_lost;               // registros perdidos pelo leitor
+} RingBench;
+
+// Mede a latência média de publicação; false se o ring ou a thread leitora
+// não puderem ser criados
+bool ring_bench_publish(uint64_t iterations, RingBench *out);
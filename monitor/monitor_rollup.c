@@ -0,0 +1,175 @@
+// monitor_rollup.c - Resumos por minuto das séries gravadas
+//
+// Bins: 0 guarda valores <= 0; os demais cobrem [2^e, 2^(e+1)) divididos em
+// ROLLUP_SUB_BINS partes iguais, para e em [ROLLUP_MIN_EXP, ROLLUP_MAX_EXP).
+//
+// Minuto codificado:
+//   varint  minuto - minuto base do bloco
+//   varint  quantidade de séries
+//   por série: varint(delta do id), varint(count), float min, float max,
+//              double sum, varint(nbins), pares varint(delta do bin) + varint(count)
+
+#include "monitor_rollup.h"
+#include "monitor_varint.h"
+
+#include <math.h>
+#include <string.h>
+
+int rollup_bin(double v) {
+    if (!(v > 0)) return 0;
+    int e;
+    double m = frexp(v, &e);        // v = m * 2^e, m em [0.5, 1)
+    e -= 1;                         // v = (2m) * 2^e, 2m em [1, 2)
+    if (e < ROLLUP_MIN_EXP) return 1;
+    if (e >= ROLLUP_MAX_EXP) return ROLLUP_BINS - 1;
+    int sub = (int)((2.0 * m - 1.0) * ROLLUP_SUB_BINS);
+    if (sub >= ROLLUP_SUB_BINS) sub = ROLLUP_SUB_BINS - 1;
+    return 1 + (e - ROLLUP_MIN_EXP) * ROLLUP_SUB_BINS + sub;
+}
+
+double rollup_bin_low(int bin) {
+    if (bin <= 0) return 0.0;
+    int e = (bin - 1) / ROLLUP_SUB_BINS + ROLLUP_MIN_EXP;
+    int sub = (bin - 1) % ROLLUP_SUB_BINS;
+    return ldexp(1.0 + (double)sub / ROLLUP_SUB_BINS, e);
+}
+
+double rollup_bin_high(int bin) {
+    if (bin <= 0) return 0.0;
+    int e = (bin - 1) / ROLLUP_SUB_BINS + ROLLUP_MIN_EXP;
+    int sub = (bin - 1) % ROLLUP_SUB_BINS;
+    return ldexp(1.0 + (double)(sub + 1) / ROLLUP_SUB_BINS, e);
+}
+
+void rollup_acc_reset(RollupAcc *a) {
+    a->count = 0;
+    a->nbins = 0;
+    a->sum = 0;
+    a->min = a->max = 0;
+}
+
+void rollup_acc_add(RollupAcc *a, double v) {
+    float f = (float)v;
+    if (a->count == 0 || f < a->min) a->min = f;
+    if (a->count == 0 || f > a->max) a->max = f;
+    a->count++;
+    a->sum += v;
+
+    // Lista de bins mantida ordenada; cheia, o valor vai para o bin mais próximo
+    uint16_t b = (uint16_t)rollup_bin(v);
+    int i = 0;
+    while (i < a->nbins && a->bins[i] < b) i++;
+    if (i < a->nbins && a->bins[i] == b) { a->counts[i]++; return; }
+    if (a->nbins < ROLLUP_MAX_ACC_BINS) {
+        memmove(&a->bins[i + 1], &a->bins[i], (size_t)(a->nbins - i) * sizeof(a->bins[0]));
+        memmove(&a->counts[i + 1], &a->counts[i], (size_t)(a->nbins - i) * sizeof(a->counts[0]));
+        a->bins[i] = b;
+        a->counts[i] = 1;
+        a->nbins++;
+        return;
+    }
+    if (i == a->nbins) i--;
+    else if (i > 0 && b - a->bins[i - 1] < a->bins[i] - b) i--;
+    a->counts[i]++;
+}
+
+size_t rollup_minute_max_bytes(size_t nseries) {
+    return 20 + nseries * (3 + 5 + 16 + 3 + ROLLUP_MAX_ACC_BINS * (3 + 5));
+}
+
+static uint8_t *put_raw(uint8_t *p, const void *v, size_t n) {
+    memcpy(p, v, n);
+    return p + n;
+}
+
+uint8_t *rollup_encode_minute(uint8_t *p, uint64_t minute_delta, RollupAcc *const *accs,
+                              const uint16_t *series, size_t nseries) {
+    p = varint_put(p, minute_delta);
+    p = varint_put(p, nseries);
+    int prev_id = -1;
+    for (size_t i = 0; i < nseries; ++i) {
+        const RollupAcc *a = accs[i];
+        p = varint_put(p, (uint64_t)(series[i] - prev_id - 1));
+        prev_id = series[i];
+        p = varint_put(p, a->count);
+        p = put_raw(p, &a->min, sizeof(a->min));
+        p = put_raw(p, &a->max, sizeof(a->max));
+        p = put_raw(p, &a->sum, sizeof(a->sum));
+        p = varint_put(p, a->nbins);
+        int prev_bin = 0;
+        for (int b = 0; b < a->nbins; ++b) {
+            p = varint_put(p, (uint64_t)(a->bins[b] - prev_bin));
+            prev_bin = a->bins[b];
+            p = varint_put(p, a->counts[b]);
+        }
+    }
+    return p;
+}
+
+bool rollup_decode(const uint8_t *payload, size_t used, uint32_t records, uint64_t base_minute,
+                   RollupSeriesFn fn, void *ctx) {
+    const uint8_t *p = payload, *end = payload + used;
+    RollupAcc a;
+    for (uint32_t r = 0; r < records; ++r) {
+        uint64_t md, ns;
+        if (!(p = varint_get(p, end, &md)) || !(p = varint_get(p, end, &ns))) return false;
+        int prev_id = -1;
+        for (uint64_t s = 0; s < ns; ++s) {
+            uint64_t d, count, nb;
+            if (!(p = varint_get(p, end, &d)) || !(p = varint_get(p, end, &count))) return false;
+            if (end - p < 16) return false;
+            memcpy(&a.min, p, sizeof(a.min)); p += sizeof(a.min);
+            memcpy(&a.max, p, sizeof(a.max)); p += sizeof(a.max);
+            memcpy(&a.sum, p, sizeof(a.sum)); p += sizeof(a.sum);
+            if (!(p = varint_get(p, end, &nb)) || nb > ROLLUP_MAX_ACC_BINS) return false;
+            a.count = (uint32_t)count;
+            a.nbins = (uint16_t)nb;
+            uint64_t bin = 0;
+            for (uint64_t b = 0; b < nb; ++b) {
+                uint64_t bd, c;
+                if (!(p = varint_get(p, end, &bd)) || !(p = varint_get(p, end, &c))) return false;
+                bin += bd;
+                if (bin >= ROLLUP_BINS) return false;
+                a.bins[b] = (uint16_t)bin;
+                a.counts[b] = (uint32_t)c;
+            }
+            int id = prev_id + 1 + (int)d;
+            prev_id = id;
+            fn(ctx, base_minute + md, (uint16_t)id, &a);
+        }
+    }
+    return true;
+}
+
+void rollup_hist_reset(RollupHist *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+void rollup_hist_merge(RollupHist *h, const RollupAcc *a) {
+    if (a->count == 0) return;
+    if (h->count == 0 || a->min < h->min) h->min = a->min;
+    if (h->count == 0 || a->max > h->max) h->max = a->max;
+    h->count += a->count;
+    h->sum += a->sum;
+    for (int b = 0; b < a->nbins; ++b) h->bins[a->bins[b]] += a->counts[b];
+}
+
+double rollup_hist_percentile(const RollupHist *h, double pct) {
+    if (h->count == 0) return 0.0;
+    if (pct <= 0) return h->min;
+    if (pct >= 100) return h->max;
+    double rank = pct / 100.0 * (double)h->count;
+    uint64_t cum = 0;
+    for (int b = 0; b < ROLLUP_BINS; ++b) {
+        if (!h->bins[b]) continue;
+        if ((double)(cum + h->bins[b]) >= rank) {
+            double lo = rollup_bin_low(b), hi = rollup_bin_high(b);
+            if (lo < h->min) lo = h->min;
+            if (hi > h->max) hi = h->max;
+            double frac = (rank - (double)cum) / (double)h->bins[b];
+            return lo + (hi - lo) * frac;
+        }
+        cum += h->bins[b];
+    }
+    return h->max;
+}
@@ -0,0 +1,67 @@
+// monitor_rollup.h - Resumos por minuto das séries gravadas
+// Cada série (sensor, núcleo) ganha por minuto: contagem, mínimo, máximo, soma e
+// um histograma de bins fixos log-lineares. Histogramas de minutos e núcleos
+// diferentes se somam, então percentis de qualquer janela saem sem reler as
+// amostras brutas.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ROLLUP_SUB_BITS      4                          // 16 bins por oitava (~4% de resolução)
+#define ROLLUP_SUB_BINS      (1 << ROLLUP_SUB_BITS)
+#define ROLLUP_MIN_EXP       (-32)
+#define ROLLUP_MAX_EXP       32
+#define ROLLUP_BINS          (1 + (ROLLUP_MAX_EXP - ROLLUP_MIN_EXP) * ROLLUP_SUB_BINS)
+#define ROLLUP_MAX_ACC_BINS  64                         // bins distintos por série/minuto
+
+// Acumulador de uma série no minuto corrente
+typedef struct {
+    uint32_t count;
+    float    min;
+    float    max;
+    double   sum;
+    uint16_t nbins;
+    uint16_t bins[ROLLUP_MAX_ACC_BINS];
+    uint32_t counts[ROLLUP_MAX_ACC_BINS];
+} RollupAcc;
+
+// Histograma denso usado nas consultas
+typedef struct {
+    uint64_t count;
+    double   min;
+    double   max;
+    double   sum;
+    uint64_t bins[ROLLUP_BINS];
+} RollupHist;
+
+// Bin de um valor e limites de um bin
+int    rollup_bin(double v);
+double rollup_bin_low(int bin);
+double rollup_bin_high(int bin);
+
+void rollup_acc_reset(RollupAcc *a);
+void rollup_acc_add(RollupAcc *a, double v);
+
+// Codifica um minuto: séries com contagem > 0 em ordem crescente de id.
+// Retorna o ponteiro após o último byte escrito.
+uint8_t *rollup_encode_minute(uint8_t *p, uint64_t minute_delta, RollupAcc *const *accs,
+                              const uint16_t *series, size_t nseries);
+
+// Pior caso de bytes de um minuto com nseries séries
+size_t rollup_minute_max_bytes(size_t nseries);
+
+// Recebe cada série de um minuto decodificado
+typedef void (*RollupSeriesFn)(void *ctx, uint64_t minute, uint16_t series, const RollupAcc *acc);
+
+// Decodifica 'records' minutos de um payload; minutos relativos a base_minute
+bool rollup_decode(const uint8_t *payload, size_t used, uint32_t records, uint64_t base_minute,
+                   RollupSeriesFn fn, void *ctx);
+
+void   rollup_hist_reset(RollupHist *h);
+void   rollup_hist_merge(RollupHist *h, const RollupAcc *a);
+
+// Percentil (0-100) interpolado dentro do bin e limitado a [min, max]
+double rollup_hist_percentile(const RollupHist *h, double pct);
@@ -0,0 +1,246 @@
+// monitor_sampler.c - Agendador único de leitura dos sensores
+// Roda de timers com resolução de SAMPLER_TICK_MS: cada slot guarda a lista dos
+// sensores que vencem nos ticks congruentes a ele. A thread dorme até o próximo
+// tick ocupado com um waitable timer de prazo absoluto (sem deriva acumulada) e
+// lê de uma vez todos os sensores vencidos.
+
+#include "monitor_sampler.h"
+
+#include <string.h>
+
+#define FILETIME_UNIX_EPOCH 116444736000000000ULL    // 1970-01-01 em unidades de 100 ns
+#define TICK_100NS          ((uint64_t)SAMPLER_TICK_MS * 10000ULL)
+
+static uint64_t filetime_now(void) {
+    FILETIME ft;
+    GetSystemTimePreciseAsFileTime(&ft);
+    return ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+}
+
+static uint64_t filetime_to_u64(const FILETIME *ft) {
+    return ((uint64_t)ft->dwHighDateTime << 32) | ft->dwLowDateTime;
+}
+
+uint64_t sampler_now_ns(void) {
+    return (filetime_now() - FILETIME_UNIX_EPOCH) * 100ULL;
+}
+
+// Período do sensor em ticks (arredondado para cima, mínimo 1)
+static uint64_t period_ticks(const SamplerSensor *ss) {
+    uint64_t t = (ss->period_ms + SAMPLER_TICK_MS - 1) / SAMPLER_TICK_MS;
+    return t ? t : 1;
+}
+
+static void wheel_insert(Sampler *s, int id) {
+    int slot = (int)(s->sensors[id].due_tick % SAMPLER_WHEEL_SLOTS);
+    s->sensors[id].next = s->wheel[slot];
+    s->wheel[slot] = id;
+}
+
+// Retira da roda todos os sensores vencidos até o tick 'now'
+static int collect_due(Sampler *s, uint64_t now, int *due) {
+    uint64_t span = now - s->tick;
+    if (span > SAMPLER_WHEEL_SLOTS) span = SAMPLER_WHEEL_SLOTS;
+    int n = 0;
+    for (uint64_t k = 1; k <= span; ++k) {
+        int *link = &s->wheel[(s->tick + k) % SAMPLER_WHEEL_SLOTS];
+        while (*link >= 0) {
+            SamplerSensor *ss = &s->sensors[*link];
+            if (ss->due_tick <= now) {
+                due[n++] = *link;
+                *link = ss->next;
+            } else {
+                link = &ss->next;
+            }
+        }
+    }
+    return n;
+}
+
+// Próximo tick com algum sensor vencendo; UINT64_MAX se a roda estiver vazia
+static uint64_t next_due_tick(const Sampler *s) {
+    for (uint64_t k = 1; k <= SAMPLER_WHEEL_SLOTS; ++k) {
+        uint64_t t = s->tick + k;
+        for (int id = s->wheel[t % SAMPLER_WHEEL_SLOTS]; id >= 0; id = s->sensors[id].next)
+            if (s->sensors[id].due_tick == t) return t;
+    }
+    // Nada dentro do horizonte: procura o vencimento mais próximo além dele
+    uint64_t best = UINT64_MAX;
+    for (int slot = 0; slot < SAMPLER_WHEEL_SLOTS; ++slot)
+        for (int id = s->wheel[slot]; id >= 0; id = s->sensors[id].next)
+            if (s->sensors[id].due_tick < best) best = s->sensors[id].due_tick;
+    return best;
+}
+
+// Lê os sensores indicados e entrega todas as amostras num único lote
+static void read_sensors(Sampler *s, const int *ids, int n) {
+    uint64_t t_ns = sampler_now_ns();
+    size_t count = 0;
+    for (int i = 0; i < n; ++i) {
+        SamplerSensor *ss = &s->sensors[ids[i]];
+        size_t got = ss->read(ss->ctx, s->values, SAMPLER_MAX_VALUES);
+        if (got > SAMPLER_MAX_VALUES) got = SAMPLER_MAX_VALUES;
+        for (size_t v = 0; v < got; ++v) {
+            SensorSample *out = &s->batch[count++];
+            out->t_ns     = t_ns;
+            out->sensor   = (uint16_t)ids[i];
+            out->index    = (uint16_t)v;
+            out->reserved = 0;
+            out->value    = s->values[v];
+        }
+    }
+    if (count && s->sink) s->sink(s->sink_ctx, s->batch, count);
+
+    AcquireSRWLockExclusive(&s->stats_lock);
+    s->stats.reads   += (uint64_t)n;
+    s->stats.samples += count;
+    ReleaseSRWLockExclusive(&s->stats_lock);
+}
+
+// Atualiza o custo de CPU da thread em relação ao tempo decorrido
+static void update_overhead(Sampler *s) {
+    FILETIME c, e, k, u;
+    if (!GetThreadTimes(GetCurrentThread(), &c, &e, &k, &u)) return;
+    double cpu_ms  = (double)(filetime_to_u64(&k) + filetime_to_u64(&u)) / 10000.0;
+    double wall_ms = (double)(filetime_now() - s->start_100ns) / 10000.0;
+
+    AcquireSRWLockExclusive(&s->stats_lock);
+    s->stats.wakeups++;
+    s->stats.cpu_ms  = cpu_ms;
+    s->stats.wall_ms = wall_ms;
+    s->stats.overhead_pct = wall_ms > 0 ? 100.0 * cpu_ms / wall_ms : 0.0;
+    s->stats.over_budget  = s->stats.overhead_pct > SAMPLER_BUDGET_PCT;
+    ReleaseSRWLockExclusive(&s->stats_lock);
+}
+
+// Programa o timer para um instante absoluto. Se o timer de alta resolução
+// recusar o prazo, troca por um timer comum.
+static bool arm_timer(Sampler *s, uint64_t deadline_100ns) {
+    LARGE_INTEGER due;
+    due.QuadPart = (LONGLONG)deadline_100ns;    // positivo = absoluto
+    if (SetWaitableTimer(s->timer, &due, 0, NULL, NULL, FALSE)) return true;
+    CloseHandle(s->timer);
+    s->timer = CreateWaitableTimerW(NULL, FALSE, NULL);
+    return s->timer && SetWaitableTimer(s->timer, &due, 0, NULL, NULL, FALSE);
+}
+
+static DWORD WINAPI sampler_thread(LPVOID arg) {
+    Sampler *s = (Sampler*)arg;
+    int ids[SAMPLER_MAX_SENSORS];
+
+    // Leitura inicial de todos os sensores, inclusive os de leitura única
+    for (int i = 0; i < s->nsensors; ++i) ids[i] = i;
+    read_sensors(s, ids, s->nsensors);
+    for (int i = 0; i < s->nsensors; ++i) {
+        if (s->sensors[i].period_ms == 0) continue;
+        s->sensors[i].due_tick = period_ticks(&s->sensors[i]);
+        wheel_insert(s, i);
+    }
+    update_overhead(s);
+
+    for (;;) {
+        uint64_t next = next_due_tick(s);
+        DWORD w;
+        if (next == UINT64_MAX) {
+            w = WaitForSingleObject(s->stop_event, INFINITE);
+        } else {
+            if (!arm_timer(s, s->start_100ns + next * TICK_100NS)) break;
+            HANDLE hs[2] = { s->stop_event, s->timer };
+            w = WaitForMultipleObjects(2, hs, FALSE, INFINITE);
+        }
+        if (w != WAIT_OBJECT_0 + 1) break;
+
+        // O tick atual pode estar adiante de 'next' se o despertar atrasou
+        uint64_t now = (filetime_now() - s->start_100ns) / TICK_100NS;
+        if (now < next) now = next;
+        if (now > next) {
+            AcquireSRWLockExclusive(&s->stats_lock);
+            s->stats.late_ticks += now - next;
+            ReleaseSRWLockExclusive(&s->stats_lock);
+        }
+
+        int n = collect_due(s, now, ids);
+        s->tick = now;
+        read_sensors(s, ids, n);
+
+        // Reagenda mantendo a fase; ticks perdidos são pulados, não recuperados
+        for (int i = 0; i < n; ++i) {
+            SamplerSensor *ss = &s->sensors[ids[i]];
+            uint64_t p = period_ticks(ss);
+            do { ss->due_tick += p; } while (ss->due_tick <= now);
+            wheel_insert(s, ids[i]);
+        }
+        update_overhead(s);
+    }
+    return 0;
+}
+
+void sampler_init(Sampler *s, SampleSinkFn sink, void *sink_ctx) {
+    if (!s) return;
+    memset(s, 0, sizeof(*s));
+    for (int i = 0; i < SAMPLER_WHEEL_SLOTS; ++i) s->wheel[i] = -1;
+    s->sink = sink;
+    s->sink_ctx = sink_ctx;
+    InitializeSRWLock(&s->stats_lock);
+}
+
+int sampler_add_sensor(Sampler *s, const char *name, DWORD period_ms, SensorReadFn read, void *ctx) {
+    if (!s || !read || s->thread || s->nsensors >= SAMPLER_MAX_SENSORS) return -1;
+    SamplerSensor *ss = &s->sensors[s->nsensors];
+    memset(ss, 0, sizeof(*ss));
+    strncpy(ss->name, name ? name : "?", sizeof(ss->name) - 1);
+    ss->period_ms = period_ms;
+    ss->read = read;
+    ss->ctx = ctx;
+    ss->next = -1;
+    return s->nsensors++;
+}
+
+const char *sampler_sensor_name(const Sampler *s, int sensor) {
+    if (!s || sensor < 0 || sensor >= s->nsensors) return "?";
+    return s->sensors[sensor].name;
+}
+
+bool sampler_start(Sampler *s) {
+    if (!s || s->thread || s->nsensors == 0) return false;
+
+    s->stop_event = CreateEventW(NULL, TRUE, FALSE, NULL);
+    s->timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!s->timer) s->timer = CreateWaitableTimerW(NULL, FALSE, NULL);
+    if (!s->stop_event || !s->timer) {
+        if (s->stop_event) CloseHandle(s->stop_event);
+        if (s->timer) CloseHandle(s->timer);
+        s->stop_event = s->timer = NULL;
+        return false;
+    }
+
+    for (int i = 0; i < SAMPLER_WHEEL_SLOTS; ++i) s->wheel[i] = -1;
+    memset(&s->stats, 0, sizeof(s->stats));
+    s->start_100ns = filetime_now();
+    s->tick = 0;
+    s->thread = CreateThread(NULL, 0, sampler_thread, s, 0, NULL);
+    if (!s->thread) {
+        CloseHandle(s->stop_event);
+        CloseHandle(s->timer);
+        s->stop_event = s->timer = NULL;
+        return false;
+    }
+    return true;
+}
+
+void sampler_stop(Sampler *s) {
+    if (!s || !s->thread) return;
+    SetEvent(s->stop_event);
+    WaitForSingleObject(s->thread, INFINITE);
+    CloseHandle(s->thread);
+    CloseHandle(s->stop_event);
+    if (s->timer) CloseHandle(s->timer);
+    s->thread = s->stop_event = s->timer = NULL;
+}
+
+void sampler_get_stats(Sampler *s, SamplerStats *out) {
+    if (!s || !out) return;
+    AcquireSRWLockShared(&s->stats_lock);
+    *out = s->stats;
+    ReleaseSRWLockShared(&s->stats_lock);
+}
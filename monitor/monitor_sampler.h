@@ -0,0 +1,90 @@
+// monitor_sampler.h - Agendador único de leitura dos sensores
+// Uma roda de timers com período por sensor; sensores que vencem juntos
+// são lidos no mesmo despertar e entregues ao consumidor num só lote.
+
+#pragma once
+
+#include <windows.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SAMPLER_MAX_SENSORS  16
+#define SAMPLER_MAX_VALUES   256    // valores por leitura (um por núcleo/canal)
+#define SAMPLER_TICK_MS      10     // resolução da roda de timers
+#define SAMPLER_WHEEL_SLOTS  128    // horizonte da roda: 1,28 s
+#define SAMPLER_BUDGET_PCT   0.1    // orçamento de CPU, em % de um núcleo
+
+// Uma leitura de um sensor
+typedef struct {
+    uint64_t t_ns;      // instante da leitura (ns desde 1970, UTC)
+    uint16_t sensor;    // índice do sensor no sampler
+    uint16_t index;     // núcleo/canal dentro do sensor
+    uint32_t reserved;
+    double   value;
+} SensorSample;
+
+// Lê um sensor: preenche até max valores e retorna quantos foram lidos
+typedef size_t (*SensorReadFn)(void *ctx, double *values, size_t max);
+
+// Recebe todas as amostras de um mesmo despertar (mesmo t_ns)
+typedef void (*SampleSinkFn)(void *ctx, const SensorSample *samples, size_t count);
+
+typedef struct {
+    char         name[24];
+    DWORD        period_ms;     // 0 = lido uma única vez, na partida
+    SensorReadFn read;
+    void        *ctx;
+    uint64_t     due_tick;      // próximo tick em que vence
+    int          next;          // próximo sensor no mesmo slot da roda (-1 = fim)
+} SamplerSensor;
+
+// Custo do próprio sampler
+typedef struct {
+    uint64_t wakeups;
+    uint64_t reads;
+    uint64_t samples;
+    uint64_t late_ticks;        // ticks perdidos por atraso do despertar
+    double   cpu_ms;            // tempo de CPU da thread do sampler
+    double   wall_ms;
+    double   overhead_pct;      // cpu / wall, em % de um núcleo
+    bool     over_budget;       // overhead_pct > SAMPLER_BUDGET_PCT
+} SamplerStats;
+
+typedef struct {
+    SamplerSensor sensors[SAMPLER_MAX_SENSORS];
+    int           nsensors;
+    int           wheel[SAMPLER_WHEEL_SLOTS];   // cabeça da lista de cada slot
+    SampleSinkFn  sink;
+    void         *sink_ctx;
+    HANDLE        thread;
+    HANDLE        timer;
+    HANDLE        stop_event;
+    uint64_t      start_100ns;                  // FILETIME do tick 0
+    uint64_t      tick;                         // último tick processado
+    SRWLOCK       stats_lock;
+    SamplerStats  stats;
+    double        values[SAMPLER_MAX_VALUES];
+    SensorSample  batch[SAMPLER_MAX_SENSORS * SAMPLER_MAX_VALUES];
+} Sampler;
+
+// Prepara o sampler; as amostras de cada despertar vão para sink
+void sampler_init(Sampler *s, SampleSinkFn sink, void *sink_ctx);
+
+// Registra um sensor; retorna o índice (usado em SensorSample.sensor) ou -1
+int sampler_add_sensor(Sampler *s, const char *name, DWORD period_ms, SensorReadFn read, void *ctx);
+
+// Nome de um sensor registrado ("?" se o índice for inválido)
+const char *sampler_sensor_name(const Sampler *s, int sensor);
+
+// Inicia a thread do sampler
+bool sampler_start(Sampler *s);
+
+// Para a thread e libera os handles
+void sampler_stop(Sampler *s);
+
+// Copia as estatísticas de custo atuais
+void sampler_get_stats(Sampler *s, SamplerStats *out);
+
+// Relógio comum das amostras: ns desde 1970 (UTC)
+uint64_t sampler_now_ns(void);
@@ -0,0 +1,104 @@
+// monitor_sensors.c - Sensores padrão registrados no sampler
+// Adapta os getters de cpu/ e memory/ ao formato de leitura do sampler
+
+#include "monitor_sensors.h"
+
+#include <stdlib.h>
+
+#include "../cpu/cpu_clock.h"
+#include "../cpu/cpu_load.h"
+#include "../cpu/cpu_msr.h"
+#include "../cpu/cpu_thermal.h"
+#include "../memory/memory_timings.h"
+
+// Frequência atual de cada processador lógico (MHz)
+static size_t read_clock(void *ctx, double *values, size_t max) {
+    (void)ctx;
+    CpuClock clocks[SAMPLER_MAX_VALUES];
+    DWORD n = get_cpu_clocks(clocks, (DWORD)(max < SAMPLER_MAX_VALUES ? max : SAMPLER_MAX_VALUES));
+    for (DWORD i = 0; i < n; ++i) values[i] = (double)clocks[i].current_mhz;
+    return n;
+}
+
+// Frequência máxima permitida pelo Windows a cada processador lógico (MHz)
+static size_t read_limit(void *ctx, double *values, size_t max) {
+    (void)ctx;
+    CpuClock clocks[SAMPLER_MAX_VALUES];
+    DWORD n = get_cpu_clocks(clocks, (DWORD)(max < SAMPLER_MAX_VALUES ? max : SAMPLER_MAX_VALUES));
+    for (DWORD i = 0; i < n; ++i) values[i] = (double)clocks[i].limit_mhz;
+    return n;
+}
+
+// Temperatura e limites saem dos mesmos RDMSRs: o primeiro sensor do despertar
+// lê, o outro reaproveita
+typedef struct {
+    CpuThermal v[CPU_THERMAL_MAX];
+    DWORD      n;
+    ULONGLONG  tick;
+} ThermalCache;
+
+static DWORD thermal_refresh(ThermalCache *c) {
+    ULONGLONG now = GetTickCount64();
+    if (c->tick == 0 || now - c->tick >= SAMPLER_TICK_MS) {
+        c->n = get_cpu_thermals(c->v, CPU_THERMAL_MAX);
+        c->tick = now;
+    }
+    return c->n;
+}
+
+static size_t read_temp(void *ctx, double *values, size_t max) {
+    ThermalCache *c = (ThermalCache*)ctx;
+    DWORD n = thermal_refresh(c);
+    if (n > max) n = (DWORD)max;
+    for (DWORD i = 0; i < n; ++i) values[i] = c->v[i].temp_c;
+    return n;
+}
+
+static size_t read_limits(void *ctx, double *values, size_t max) {
+    ThermalCache *c = (ThermalCache*)ctx;
+    DWORD n = thermal_refresh(c);
+    if (n > max) n = (DWORD)max;
+    for (DWORD i = 0; i < n; ++i) values[i] = (double)c->v[i].limits;
+    return n;
+}
+
+// Potência do pacote e limites PL1/PL2 (W)
+static size_t read_power(void *ctx, double *values, size_t max) {
+    CpuPower p;
+    if (max < 3 || !get_cpu_power((CpuPowerState*)ctx, &p)) return 0;
+    values[0] = p.package_w;
+    values[1] = p.pl1_w;
+    values[2] = p.pl2_w;
+    return 3;
+}
+
+// Carga de cada processador lógico (%) desde a leitura anterior
+static size_t read_load(void *ctx, double *values, size_t max) {
+    return get_cpu_loads((CpuLoadState*)ctx, values, (DWORD)max);
+}
+
+// Frequência da DRAM (MHz); não muda em execução, então é lida uma vez
+static size_t read_dram(void *ctx, double *values, size_t max) {
+    (void)ctx;
+    char buf[64];
+    if (max == 0 || !get_dram_frequency(buf, sizeof(buf))) return 0;
+    values[0] = strtod(buf, NULL);
+    return values[0] > 0 ? 1 : 0;
+}
+
+int sensors_register_defaults(Sampler *s) {
+    static CpuLoadState load_state;
+    static ThermalCache thermal;
+    static CpuPowerState power_state;
+    int n = 0;
+    if (sampler_add_sensor(s, SENSOR_NAME_CLOCK, SENSOR_PERIOD_CLOCK_MS, read_clock, NULL) >= 0) n++;
+    if (sampler_add_sensor(s, SENSOR_NAME_LOAD,  SENSOR_PERIOD_LOAD_MS,  read_load,  &load_state) >= 0) n++;
+    if (sampler_add_sensor(s, SENSOR_NAME_DRAM,  SENSOR_PERIOD_DRAM_MS,  read_dram,  NULL) >= 0) n++;
+    if (sampler_add_sensor(s, SENSOR_NAME_LIMIT, SENSOR_PERIOD_LIMIT_MS, read_limit, NULL) >= 0) n++;
+    if (msr_available()) {
+        if (sampler_add_sensor(s, SENSOR_NAME_TEMP,   SENSOR_PERIOD_MSR_MS, read_temp,   &thermal) >= 0) n++;
+        if (sampler_add_sensor(s, SENSOR_NAME_LIMITS, SENSOR_PERIOD_MSR_MS, read_limits, &thermal) >= 0) n++;
+        if (sampler_add_sensor(s, SENSOR_NAME_POWER,  SENSOR_PERIOD_MSR_MS, read_power,  &power_state) >= 0) n++;
+    }
+    return n;
+}
@@ -0,0 +1,25 @@
+// monitor_sensors.h - Sensores padrão registrados no sampler
+
+#pragma once
+
+#include "monitor_sampler.h"
+
+// Períodos padrão de cada sensor (0 = leitura única)
+#define SENSOR_PERIOD_CLOCK_MS  100
+#define SENSOR_PERIOD_LOAD_MS   100
+#define SENSOR_PERIOD_DRAM_MS   0
+#define SENSOR_PERIOD_LIMIT_MS  1000
+#define SENSOR_PERIOD_MSR_MS    1000    // temperatura, limites ativos e potência (MSR)
+
+// Nomes dos sensores (usados para localizar as séries nas análises)
+#define SENSOR_NAME_CLOCK   "clock"     // MHz por processador lógico
+#define SENSOR_NAME_LOAD    "load"      // % por processador lógico
+#define SENSOR_NAME_DRAM    "dram"      // MHz
+#define SENSOR_NAME_LIMIT   "limit"     // MHz máximo permitido pelo Windows, por processador lógico
+#define SENSOR_NAME_TEMP    "temp"      // °C por processador lógico
+#define SENSOR_NAME_LIMITS  "limits"    // máscara CPU_LIMIT_* por processador lógico
+#define SENSOR_NAME_POWER   "power"     // W: [0] pacote, [1] PL1, [2] PL2
+
+// Registra os sensores disponíveis no sistema; retorna quantos foram registrados.
+// Os sensores de MSR só entram com o driver carregado (ver cpu_msr.h).
+int sensors_register_defaults(Sampler *s);
@@ -0,0 +1,134 @@
+// monitor_throttle.c - Causa do clock baixo de cada núcleo
+#include "monitor_throttle.h"
+
+#include <string.h>
+
+#include "monitor_sensors.h"
+#include "../cpu/cpu_thermal.h"
+
+static const char *const reason_names[THROTTLE_REASONS] = {
+    "none", "idle", "thermal", "prochot", "current-limit", "power-pl1", "power-pl2",
+    "power-limit", "os-limit", "governor", "unknown",
+};
+
+const char *throttle_reason_name(ThrottleReason r) {
+    return (unsigned)r < THROTTLE_REASONS ? reason_names[r] : "?";
+}
+
+static int find_sensor(const Sampler *s, const char *name) {
+    for (int i = 0; i < s->nsensors; ++i)
+        if (strcmp(s->sensors[i].name, name) == 0) return i;
+    return -1;
+}
+
+void throttle_init(ThrottleDetector *d, const Sampler *s, double nominal_mhz, ThrottleEventFn fn, void *ctx) {
+    memset(d, 0, sizeof(*d));
+    d->s_clock  = find_sensor(s, SENSOR_NAME_CLOCK);
+    d->s_load   = find_sensor(s, SENSOR_NAME_LOAD);
+    d->s_limit  = find_sensor(s, SENSOR_NAME_LIMIT);
+    d->s_temp   = find_sensor(s, SENSOR_NAME_TEMP);
+    d->s_limits = find_sensor(s, SENSOR_NAME_LIMITS);
+    d->s_power  = find_sensor(s, SENSOR_NAME_POWER);
+    d->nominal_mhz = nominal_mhz;
+    d->fn = fn;
+    d->ctx = ctx;
+}
+
+static bool fresh(uint64_t t, uint64_t now) {
+    return t && now - t <= (uint64_t)THROTTLE_STALE_MS * 1000000ULL;
+}
+
+// Causa do clock desta leitura; a ordem vai da evidência mais direta à mais fraca
+static ThrottleReason classify(const ThrottleDetector *d, const ThrottleCore *c, double clock, uint64_t now) {
+    if (clock >= d->nominal_mhz * THROTTLE_LOW_CLOCK_PCT / 100.0) return THROTTLE_NONE;
+
+    bool have_msr = fresh(c->t_limits, now);
+    if (have_msr) {
+        uint32_t l = c->limits;
+        if (l & CPU_LIMIT_THERMAL) return THROTTLE_THERMAL;
+        if (l & CPU_LIMIT_PROCHOT) return THROTTLE_PROCHOT;
+        if (l & CPU_LIMIT_CURRENT) return THROTTLE_CURRENT;
+        if (l & CPU_LIMIT_PL2)     return THROTTLE_POWER_PL2;
+        if (l & CPU_LIMIT_PL1)     return THROTTLE_POWER_PL1;
+        if (l & CPU_LIMIT_POWER)   return THROTTLE_POWER;
+    }
+    if (fresh(c->t_temp, now) && c->temp >= THROTTLE_HOT_C) return THROTTLE_THERMAL;
+    if (fresh(d->t_power, now) && d->pl1_w > 0 && d->package_w >= d->pl1_w * THROTTLE_PL_PCT / 100.0)
+        return THROTTLE_POWER_PL1;
+    if (fresh(c->t_limit, now) && c->limit > 0 && c->limit < d->nominal_mhz * THROTTLE_LOW_CLOCK_PCT / 100.0)
+        return THROTTLE_OS_LIMIT;
+    if (fresh(c->t_load, now) && c->load < THROTTLE_BUSY_LOAD_PCT) return THROTTLE_IDLE;
+    return have_msr ? THROTTLE_GOVERNOR : THROTTLE_UNKNOWN;
+}
+
+// Ociosidade não é estrangulamento: não gera evento
+static bool is_throttle(int r) {
+    return r != THROTTLE_NONE && r != THROTTLE_IDLE;
+}
+
+static void emit(ThrottleDetector *d, int core, uint8_t reason, bool begin, double clock, uint64_t now) {
+    ThrottleCore *c = &d->core[core];
+    ThrottleEvent ev;
+    ev.t_ns = now;
+    ev.core = (uint16_t)core;
+    ev.reason = reason;
+    ev.begin = begin;
+    ev.clock_mhz = clock;
+    ev.nominal_mhz = d->nominal_mhz;
+    ev.load_pct  = fresh(c->t_load, now) ? c->load : -1;
+    ev.temp_c    = fresh(c->t_temp, now) ? c->temp : -1;
+    ev.package_w = fresh(d->t_power, now) ? d->package_w : -1;
+    ev.duration_ms = begin ? 0 : (now - c->since_ns) / 1000000ULL;
+    if (begin) d->events[reason]++;
+    else d->time_ms[reason] += ev.duration_ms;
+    if (d->fn) d->fn(d->ctx, &ev);
+}
+
+static void on_clock(ThrottleDetector *d, int core, double clock, uint64_t now) {
+    ThrottleCore *c = &d->core[core];
+    if (core >= d->ncores) d->ncores = core + 1;
+
+    uint8_t r = (uint8_t)classify(d, c, clock, now);
+    if (r == THROTTLE_NONE) c->low_since = 0;
+    else if (!c->low_since) c->low_since = now;
+    // Os limites do MSR são lidos mais devagar que o clock: sem uma leitura feita
+    // depois da queda, "governador" seria só falta de informação
+    if (r == THROTTLE_GOVERNOR && c->t_limits < c->low_since) return;
+    if (r == c->reason) { c->pending_count = 0; return; }
+    // Histerese: a nova causa precisa se repetir antes de valer
+    if (r != c->pending) { c->pending = r; c->pending_count = 0; }
+    if (++c->pending_count < THROTTLE_CONFIRM) return;
+
+    if (is_throttle(c->reason)) emit(d, core, c->reason, false, clock, now);
+    c->reason = r;
+    c->since_ns = now;
+    c->pending_count = 0;
+    if (is_throttle(r)) emit(d, core, r, true, clock, now);
+}
+
+void throttle_feed(ThrottleDetector *d, const SensorSample *samples, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const SensorSample *s = &samples[i];
+        if (s->index >= SAMPLER_MAX_VALUES) continue;
+        ThrottleCore *c = &d->core[s->index];
+        int id = s->sensor;
+        if (id == d->s_clock)       on_clock(d, s->index, s->value, s->t_ns);
+        else if (id == d->s_load)   { c->load = s->value;  c->t_load = s->t_ns; }
+        else if (id == d->s_limit)  { c->limit = s->value; c->t_limit = s->t_ns; }
+        else if (id == d->s_temp)   { c->temp = s->value;  c->t_temp = s->t_ns; }
+        else if (id == d->s_limits) { c->limits = (uint32_t)s->value; c->t_limits = s->t_ns; }
+        else if (id == d->s_power) {
+            // Índices do sensor de potência: 0 = pacote, 1 = PL1, 2 = PL2
+            if (s->index == 0) { d->package_w = s->value; d->t_power = s->t_ns; }
+            else if (s->index == 1) d->pl1_w = s->value;
+        }
+    }
+}
+
+void throttle_finish(ThrottleDetector *d, uint64_t t_ns) {
+    for (int i = 0; i < d->ncores; ++i) {
+        ThrottleCore *c = &d->core[i];
+        if (is_throttle(c->reason)) emit(d, i, c->reason, false, 0, t_ns);
+        c->reason = THROTTLE_NONE;
+    }
+}
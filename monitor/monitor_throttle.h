@@ -0,0 +1,87 @@
+// monitor_throttle.h - Causa do clock baixo de cada núcleo
+// Junta as séries de clock, carga, limite do Windows, temperatura, potência e
+// limites ativos (MSR) e classifica cada leitura de clock de cada núcleo. A
+// classificação é incremental (só usa o último valor de cada série), então roda
+// no ritmo do sampler; uma mudança de causa confirmada vira um evento de
+// início/fim.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "monitor_sampler.h"
+
+#define THROTTLE_LOW_CLOCK_PCT  90      // abaixo disso (% do nominal) o clock é "baixo"
+#define THROTTLE_BUSY_LOAD_PCT  50      // acima disso o núcleo não está ocioso
+#define THROTTLE_HOT_C          95      // temperatura tratada como limite térmico sem flag do MSR
+#define THROTTLE_PL_PCT         95      // potência do pacote (% do PL1) tratada como limite
+#define THROTTLE_CONFIRM        3       // leituras seguidas para confirmar uma mudança
+#define THROTTLE_STALE_MS       3000    // valores mais velhos que isso são ignorados
+
+typedef enum {
+    THROTTLE_NONE = 0,
+    THROTTLE_IDLE,          // clock baixo com o núcleo ocioso: economia de energia normal
+    THROTTLE_THERMAL,
+    THROTTLE_PROCHOT,
+    THROTTLE_CURRENT,
+    THROTTLE_POWER_PL1,
+    THROTTLE_POWER_PL2,
+    THROTTLE_POWER,         // limite de potência sem PL identificado
+    THROTTLE_OS_LIMIT,      // Windows limitou a frequência (plano de energia, _PPC do firmware)
+    THROTTLE_GOVERNOR,      // ocupado, sem limite de hardware ativo: decisão do governador
+    THROTTLE_UNKNOWN,       // ocupado e sem dados de MSR para explicar
+    THROTTLE_REASONS
+} ThrottleReason;
+
+typedef struct {
+    uint64_t t_ns;
+    uint16_t core;
+    uint8_t  reason;        // ThrottleReason
+    bool     begin;         // true = início, false = fim
+    double   clock_mhz;
+    double   nominal_mhz;
+    double   load_pct;      // < 0 = desconhecido (idem temp_c e package_w)
+    double   temp_c;
+    double   package_w;
+    uint64_t duration_ms;   // só nos eventos de fim
+} ThrottleEvent;
+
+typedef void (*ThrottleEventFn)(void *ctx, const ThrottleEvent *ev);
+
+// Último valor de cada série de um núcleo
+typedef struct {
+    double   load, limit, temp;
+    uint32_t limits;
+    uint64_t t_load, t_limit, t_temp, t_limits;
+    uint8_t  reason;        // causa confirmada
+    uint8_t  pending;       // candidata a nova causa
+    uint8_t  pending_count;
+    uint64_t since_ns;      // início da causa confirmada
+    uint64_t low_since;     // primeira leitura da sequência atual de clock baixo (0 = clock normal)
+} ThrottleCore;
+
+typedef struct {
+    int             s_clock, s_load, s_limit, s_temp, s_limits, s_power;   // -1 = ausente
+    double          nominal_mhz;
+    double          package_w, pl1_w;
+    uint64_t        t_power;
+    ThrottleCore    core[SAMPLER_MAX_VALUES];
+    int             ncores;
+    ThrottleEventFn fn;
+    void           *ctx;
+    uint64_t        events[THROTTLE_REASONS];
+    uint64_t        time_ms[THROTTLE_REASONS];     // tempo somado de todos os núcleos
+} ThrottleDetector;
+
+// Localiza as séries pelo nome dos sensores do sampler; nominal_mhz = clock base
+void throttle_init(ThrottleDetector *d, const Sampler *s, double nominal_mhz, ThrottleEventFn fn, void *ctx);
+
+// Consome amostras em ordem de tempo (um ou mais frames)
+void throttle_feed(ThrottleDetector *d, const SensorSample *samples, size_t count);
+
+// Fecha os eventos abertos em t_ns (fim da execução)
+void throttle_finish(ThrottleDetector *d, uint64_t t_ns);
+
+const char *throttle_reason_name(ThrottleReason r);
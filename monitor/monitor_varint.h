@@ -0,0 +1,15 @@
+// monitor_varint.h - Inteiros de tamanho variável (LEB128) usados nos arquivos de gravação
+
+#pragma once
+
+#include <stdint.h>
+
+// Escreve v e retorna o ponteiro após o último byte
+uint8_t *varint_put(uint8_t *p, uint64_t v);
+
+// Lê um valor; retorna NULL se os dados terminarem antes do fim do varint
+const uint8_t *varint_get(const uint8_t *p, const uint8_t *end, uint64_t *v);
+
+// Mapeia inteiros com sinal para sem sinal (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+uint64_t zigzag_encode(int64_t v);
+int64_t  zigzag_decode(uint64_t v);